@@ -0,0 +1,131 @@
+// ファイル: bench/bench_corpus.hpp
+// 役割:
+// 計測用の局面コーパスを読み込み、局面ごとに名前付きのベンチマークを登録するための共通部品を提供する。
+// 背景:
+// 合法手生成や得点計算の速さは局面で桁が変わるため、同じ名前の局面で測り続けないと前後の結果を比べられない。
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+#include "tsge/core/position_text.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace bench {
+
+// BenchPosition: コーパスの1局面と、その局面でstepが処理する状態の名前。
+struct BenchPosition {
+  std::string name;
+  std::string cardpool;
+  std::string text;
+  // 状態スタックの先頭(最後のstate行)。最後がcommand行ならREQUEST
+  std::string state;
+
+  // ARの局面なら手番の陣営
+  [[nodiscard]] std::optional<Side> arSide() const {
+    if (state == "AR_USSR") {
+      return Side::USSR;
+    }
+    if (state == "AR_USA") {
+      return Side::USA;
+    }
+    return std::nullopt;
+  }
+
+  // 局面を読み込んだ新しい盤面。計測の繰り返しの外で呼ぶ。
+  [[nodiscard]] Board load() const {
+    Board board(cardpoolByName(cardpool));
+    readPositionText(text, board);
+    return board;
+  }
+};
+
+// 局面テキストの最後のstate/command行から状態の名前を決める
+inline std::string topStateName(const std::string& text) {
+  std::string top = "EMPTY";
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream words(line.substr(0, line.find('#')));
+    std::string key;
+    std::string value;
+    words >> key >> value;
+    if (key == "state") {
+      top = value;
+    } else if (key == "command") {
+      top = "REQUEST";
+    }
+  }
+  return top;
+}
+
+// コーパス(既定は同梱のもの、環境変数TSGE_BENCH_CORPUSで差し替え)の全局面。
+// 計測は盤面を書き換えるものがあるため、盤面は計測ごとにload()で作る。
+// 読めなければ標準エラーへ理由を出して空を返し、コーパス依存の計測は登録されない。
+inline const std::vector<BenchPosition>& corpusPositions() {
+  static const std::vector<BenchPosition> positions = [] {
+    std::vector<BenchPosition> loaded;
+    const char* override_path = std::getenv("TSGE_BENCH_CORPUS");
+    const std::string path =
+        override_path != nullptr ? override_path : TSGE_POSITION_CORPUS;
+    try {
+      for (auto& position : loadPositionCorpus(path)) {
+        std::string state = topStateName(position.text);
+        loaded.push_back(BenchPosition{std::move(position.name),
+                                       std::move(position.cardpool),
+                                       std::move(position.text),
+                                       std::move(state)});
+      }
+    } catch (const std::exception& error) {
+      std::fprintf(stderr, "tsge_bench: corpus %s: %s\n", path.c_str(),
+                   error.what());
+      loaded.clear();
+    }
+    return loaded;
+  }();
+  return positions;
+}
+
+// 全ての局面を選ぶregisterPerPositionのselect
+inline bool anyPosition(const BenchPosition& /*position*/) { return true; }
+
+// 局面ごとに「prefix/局面名」のベンチマークを時間の単位unitで登録する。
+// selectがfalseを返した局面は登録しない。
+template <typename Select, typename Run>
+void registerPerPosition(const std::string& prefix, Select select, Run run,
+                         benchmark::TimeUnit unit = benchmark::kMicrosecond) {
+  for (const auto& position : corpusPositions()) {
+    if (!select(position)) {
+      continue;
+    }
+    const std::string name = prefix + "/" + position.name;
+    benchmark::RegisterBenchmark(
+        name.c_str(),
+        [&position, run](benchmark::State& state) { run(state, position); })
+        ->Unit(unit);
+  }
+}
+
+// 計測用の乱数を盤面へ繋ぐ。盤面の複製は同じ乱数を指す。
+inline void attachRng(Board& board, std::mt19937_64& rng) {
+  board.getRandomizer().setRng(&rng);
+}
+
+// コーパスの局面ごとの計測を登録する(bench_main.cppのmainから呼ぶ)。
+// 登録は盤面を作るため、静的初期化ではなくmainの中で行う。
+void registerBoardBenchmarks();
+void registerLegalMovesBenchmarks();
+void registerPhaseMachineBenchmarks();
+
+}  // namespace bench
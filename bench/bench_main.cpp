@@ -0,0 +1,27 @@
+// ファイル: bench/bench_main.cpp
+// 役割:
+// コーパスの局面ごとの計測を登録してからGoogle Benchmarkを実行するtsge_benchのmain。
+// 背景:
+// 局面ごとの計測は盤面を作って手札などを確かめてから登録するため、静的初期化の順序に頼らずmainの中で登録する。
+//
+// 使い方:
+//   tsge_bench --benchmark_out=result.json --benchmark_out_format=json
+//   tools/bench_compare.py baseline.json result.json --threshold=0.05
+
+#include <benchmark/benchmark.h>
+
+#include "bench_corpus.hpp"
+
+int main(int argc, char** argv) {
+  bench::registerBoardBenchmarks();
+  bench::registerLegalMovesBenchmarks();
+  bench::registerPhaseMachineBenchmarks();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,76 @@
+// ファイル: bench/board_bench.cpp
+// 役割:
+// コーパスの局面ごとに、MCTS用の盤面の複製・地域得点と最終得点・影響力を置ける国の列挙の時間を計測する。
+// 背景:
+// これらは探索の1反復やロールアウトの1手ごとに呼ばれ、局面の影響力の広がりで時間が変わるため、局面を揃えて比べる。
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+#include "bench_corpus.hpp"
+#include "tsge/core/board.hpp"
+
+namespace bench {
+namespace {
+
+// Board::finalScoringが得点を数える6地域
+constexpr std::array<Region, 6> SCORING_REGIONS = {
+    Region::EUROPE, Region::ASIA,          Region::MIDDLE_EAST,
+    Region::AFRICA, Region::SOUTH_AMERICA, Region::CENTRAL_AMERICA,
+};
+
+void copyForMcts(benchmark::State& state, const BenchPosition& position) {
+  const Board board = position.load();
+  const Side viewer = position.arSide().value_or(Side::USSR);
+  for (auto _ : state) {
+    Board copy = board.copyForMCTS(viewer);
+    benchmark::DoNotOptimize(&copy);
+  }
+}
+
+void scoreRegions(benchmark::State& state, const BenchPosition& position) {
+  const Board board = position.load();
+  for (auto _ : state) {
+    for (const auto region : SCORING_REGIONS) {
+      benchmark::DoNotOptimize(board.scoreRegion(region, false));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(SCORING_REGIONS.size()));
+}
+
+void finalScoring(benchmark::State& state, const BenchPosition& position) {
+  Board board = position.load();
+  for (auto _ : state) {
+    board.finalScoring();
+    // finalScoringは得点をChangeVpCommandとして積むだけなので、取り除けば元に戻る
+    board.getStates().pop_back();
+  }
+}
+
+void placeableCountries(benchmark::State& state,
+                        const BenchPosition& position) {
+  const Board board = position.load();
+  const auto& world_map = board.getWorldMap();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(world_map.placeableCountries(Side::USSR));
+    benchmark::DoNotOptimize(world_map.placeableCountries(Side::USA));
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+}  // namespace
+
+void registerBoardBenchmarks() {
+  registerPerPosition("BM_CopyForMCTS", anyPosition, copyForMcts,
+                      benchmark::kNanosecond);
+  registerPerPosition("BM_ScoreRegion", anyPosition, scoreRegions,
+                      benchmark::kNanosecond);
+  registerPerPosition("BM_FinalScoring", anyPosition, finalScoring,
+                      benchmark::kNanosecond);
+  registerPerPosition("BM_PlaceableCountries", anyPosition,
+                      placeableCountries, benchmark::kNanosecond);
+}
+
+}  // namespace bench
@@ -0,0 +1,88 @@
+// ファイル: bench/cpu_mlp_engine_bench.cpp
+// 役割:
+// CPU推論の順伝播1回分を、バッチ幅・重み形式・カーネル(スカラー/AVX2)ごとに計測する。
+// 背景:
+// 入力ブロック幅や量子化の効果を、自己対戦で使う規模(入力1503・隠れ256×3層・方策1024)で比べるため。
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "tsge/players/cpu_mlp_engine.hpp"
+#include "tsge/players/feature_encoder.hpp"
+
+namespace {
+
+constexpr uint32_t HIDDEN = 256;
+constexpr uint32_t POLICY = 1024;
+
+CpuMlpLayer benchLayer(uint32_t inputs, uint32_t outputs, std::mt19937& rng) {
+  std::normal_distribution<float> dist(0.0F, 0.05F);
+  CpuMlpLayer layer;
+  layer.inputs = inputs;
+  layer.outputs = outputs;
+  layer.activation = CpuMlpActivation::RELU;
+  layer.residual = inputs == outputs;
+  layer.weights_f32.resize(static_cast<size_t>(inputs) * outputs);
+  for (auto& weight : layer.weights_f32) {
+    weight = dist(rng);
+  }
+  layer.bias.assign(outputs, 0.0F);
+  return layer;
+}
+
+CpuMlpModel benchModel(CpuMlpWeightType type) {
+  std::mt19937 rng(1);
+  std::vector<CpuMlpLayer> trunk;
+  trunk.push_back(
+      benchLayer(FeatureEncoder::SIZE, HIDDEN, rng).quantized(type));
+  trunk.push_back(benchLayer(HIDDEN, HIDDEN, rng).quantized(type));
+  trunk.push_back(benchLayer(HIDDEN, HIDDEN, rng).quantized(type));
+  auto policy = benchLayer(HIDDEN, POLICY, rng);
+  policy.activation = CpuMlpActivation::NONE;
+  auto value = benchLayer(HIDDEN, 1, rng);
+  value.activation = CpuMlpActivation::NONE;
+  return {std::move(trunk), policy.quantized(type), value.quantized(type)};
+}
+
+void runForward(benchmark::State& state, CpuMlpWeightType type,
+                CpuMlpKernelIsa isa) {
+  if (!isCpuMlpKernelIsaSupported(isa)) {
+    state.SkipWithError("kernel ISA is not supported on this CPU");
+    return;
+  }
+  const auto model = benchModel(type);
+  const auto batch = static_cast<size_t>(state.range(0));
+  std::vector<float> inputs(batch * model.getInputSize(), 0.5F);
+  std::vector<float> logits(batch * model.getPolicySize());
+  std::vector<float> values(batch);
+  for (auto _ : state) {
+    model.forward(inputs, batch, logits, values, isa);
+    benchmark::DoNotOptimize(logits.data());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+
+void BM_CpuMlpForwardScalarF32(benchmark::State& state) {
+  runForward(state, CpuMlpWeightType::FLOAT32, CpuMlpKernelIsa::SCALAR);
+}
+BENCHMARK(BM_CpuMlpForwardScalarF32)->Arg(1)->Arg(16);
+
+void BM_CpuMlpForwardAvx2F32(benchmark::State& state) {
+  runForward(state, CpuMlpWeightType::FLOAT32, CpuMlpKernelIsa::AVX2_FMA);
+}
+BENCHMARK(BM_CpuMlpForwardAvx2F32)->Arg(1)->Arg(16)->Arg(64);
+
+void BM_CpuMlpForwardAvx2Bf16(benchmark::State& state) {
+  runForward(state, CpuMlpWeightType::BFLOAT16, CpuMlpKernelIsa::AVX2_FMA);
+}
+BENCHMARK(BM_CpuMlpForwardAvx2Bf16)->Arg(1)->Arg(16)->Arg(64);
+
+void BM_CpuMlpForwardAvx2Int8(benchmark::State& state) {
+  runForward(state, CpuMlpWeightType::INT8, CpuMlpKernelIsa::AVX2_FMA);
+}
+BENCHMARK(BM_CpuMlpForwardAvx2Int8)->Arg(1)->Arg(16)->Arg(64);
+
+}  // namespace
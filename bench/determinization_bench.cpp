@@ -0,0 +1,82 @@
+// ファイル: bench/determinization_bench.cpp
+// 役割:
+// 決定化1回分(相手の手札と山札の同時標本化)の所要時間を、手札の枚数と重み付けの有無で計測する。
+// 背景:
+// MCTSの反復ごとに決定化し直すため、1標本が数百ナノ秒に収まることを回帰的に確認する。
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+#include "tsge/players/determinization.hpp"
+
+namespace {
+
+class BenchCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  BenchCard(CardEnum id, WarPeriod war_period)
+      : Card(id, "Bench", 2, Side::NEUTRAL, war_period, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+const std::array<std::unique_ptr<Card>, 111>& benchCardpool() {
+  static const auto cardpool = [] {
+    std::array<std::unique_ptr<Card>, 111> pool{};
+    for (int i = 0; i < 111; ++i) {
+      pool[static_cast<size_t>(i)] = std::make_unique<BenchCard>(
+          static_cast<CardEnum>(i), WarPeriod::EARLY_WAR);
+    }
+    return pool;
+  }();
+  return cardpool;
+}
+
+void runSample(benchmark::State& state, bool weighted) {
+  Board board(benchCardpool());
+  const auto hand_size = static_cast<int>(state.range(0));
+  for (int i = 0; i < hand_size; ++i) {
+    board.addCardToHand(Side::USA, static_cast<CardEnum>(20 + i));
+  }
+  mcts::DeterminizationConstraints constraints;
+  if (weighted) {
+    constraints.hand_weights.assign(mcts::CardSet::CAPACITY, 1.0);
+    constraints.hand_weights[30] = 5.0;
+  }
+  const mcts::DeterminizationSampler sampler(board, Side::USSR, constraints);
+  std::mt19937_64 rng(1);
+  std::vector<CardEnum> hand;
+  std::vector<CardEnum> deck;
+  hand.reserve(9);
+  deck.reserve(111);
+  for (auto _ : state) {
+    sampler.sample(rng, hand, deck);
+    benchmark::DoNotOptimize(hand.data());
+    benchmark::DoNotOptimize(deck.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_DeterminizationSampleUniform(benchmark::State& state) {
+  runSample(state, false);
+}
+BENCHMARK(BM_DeterminizationSampleUniform)->Arg(1)->Arg(8)->Arg(9);
+
+void BM_DeterminizationSampleWeighted(benchmark::State& state) {
+  runSample(state, true);
+}
+BENCHMARK(BM_DeterminizationSampleWeighted)->Arg(1)->Arg(8)->Arg(9);
+
+}  // namespace
@@ -0,0 +1,123 @@
+// ファイル: bench/legal_moves_bench.cpp
+// 役割:
+// コーパスの局面ごとに、ARの合法手生成(手札全体とOps別の1枚)、影響力配置の深さ優先列挙、影響力除去のパターン列挙の時間を計測する。
+// 背景:
+// 合法手の数はOpsに対して組合せ的に増え、探索の時間の大半を占めるため、Opsごとに分けて変化を追えるようにする。
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <string>
+
+#include "bench_corpus.hpp"
+#include "tsge/actions/card_effect_legal_move_generator.hpp"
+#include "tsge/actions/game_logic_legal_moves_generator.hpp"
+
+namespace bench {
+namespace {
+
+constexpr int MAX_CARD_OPS = 4;
+
+bool isArPosition(const BenchPosition& position) {
+  return position.arSide().has_value();
+}
+
+// AR側の手札からOpsがopsの最初のカード。無ければnullopt。
+std::optional<CardEnum> cardWithOps(const BenchPosition& position, int ops) {
+  const Board board = position.load();
+  const Side side = *position.arSide();
+  for (const CardEnum card : board.getPlayerHand(side)) {
+    if (board.getCardpool()[static_cast<size_t>(card)]->getOps() == ops) {
+      return card;
+    }
+  }
+  return std::nullopt;
+}
+
+void arLegalMoves(benchmark::State& state, const BenchPosition& position) {
+  const Board board = position.load();
+  const Side side = *position.arSide();
+  size_t count = 0;
+  for (auto _ : state) {
+    auto moves = GameLogicLegalMovesGenerator::arLegalMoves(board, side);
+    count = moves.size();
+    benchmark::DoNotOptimize(moves);
+  }
+  state.counters["legal_moves"] = static_cast<double>(count);
+}
+
+// generateは盤面とAR側と選んだカードから合法手を作る
+template <typename Generate>
+void registerPerOps(const std::string& prefix, Generate generate) {
+  for (const auto& position : corpusPositions()) {
+    if (!isArPosition(position)) {
+      continue;
+    }
+    for (int ops = 1; ops <= MAX_CARD_OPS; ++ops) {
+      const auto card = cardWithOps(position, ops);
+      if (!card.has_value()) {
+        continue;
+      }
+      const std::string name =
+          prefix + "/ops:" + std::to_string(ops) + "/" + position.name;
+      benchmark::RegisterBenchmark(
+          name.c_str(),
+          [&position, card = *card, generate](benchmark::State& state) {
+            const Board board = position.load();
+            const Side side = *position.arSide();
+            size_t count = 0;
+            for (auto _ : state) {
+              auto moves = generate(board, side, card);
+              count = moves.size();
+              benchmark::DoNotOptimize(moves);
+            }
+            state.counters["legal_moves"] = static_cast<double>(count);
+          })
+          ->Unit(benchmark::kMicrosecond);
+    }
+  }
+}
+
+void removeInfluencePatterns(benchmark::State& state,
+                             const BenchPosition& position, int total) {
+  const Board board = position.load();
+  size_t count = 0;
+  for (auto _ : state) {
+    // De-Stalinizationと同じ条件(USSRの影響力、1か国の上限なし、ちょうどtotal)
+    auto patterns =
+        CardEffectLegalMoveGenerator::enumerateRemoveInfluencePatterns(
+            board, Side::USSR, total, 0, std::nullopt, std::nullopt,
+            RemovalSaturationStrategy::kRequireExact);
+    count = patterns.size();
+    benchmark::DoNotOptimize(patterns);
+  }
+  state.counters["patterns"] = static_cast<double>(count);
+}
+
+}  // namespace
+
+void registerLegalMovesBenchmarks() {
+  registerPerPosition("BM_ArLegalMoves", isArPosition, arLegalMoves);
+  registerPerOps("BM_ArLegalMovesForCard",
+                 [](const Board& board, Side side, CardEnum card) {
+                   return GameLogicLegalMovesGenerator::actionLegalMovesForCard(
+                       board, side, card);
+                 });
+  // 影響力配置の合法手は配置の深さ優先列挙(placeInfluenceDfs)が大半を占める
+  registerPerOps("BM_PlaceInfluenceDfs",
+                 [](const Board& board, Side side, CardEnum card) {
+                   return GameLogicLegalMovesGenerator::
+                       actionPlaceInfluenceLegalMovesForCard(board, side,
+                                                             card);
+                 });
+  for (const int total : {2, 4}) {
+    registerPerPosition(
+        "BM_EnumerateRemoveInfluencePatterns/total:" + std::to_string(total),
+        anyPosition,
+        [total](benchmark::State& state, const BenchPosition& position) {
+          removeInfluencePatterns(state, position, total);
+        });
+  }
+}
+
+}  // namespace bench
@@ -0,0 +1,137 @@
+// ファイル: bench/mcts_select_kernel_bench.cpp
+// 役割:
+// PUCT/UCB1選択カーネルを子数10〜5000で計測し、従来の子ごとdouble計算と比較する。
+// 背景:
+// 影響力配置ノードの子数帯で、SoA化とAVX2化の効果を回帰的に確認するため。
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "tsge/players/mcts_select_kernel.hpp"
+
+namespace {
+
+struct ChildStats {
+  std::vector<float> q;
+  std::vector<float> prior;
+  std::vector<int32_t> visits;
+};
+
+ChildStats makeStats(size_t size) {
+  std::mt19937_64 rng(size);
+  std::uniform_real_distribution<float> q_dist(-1.0F, 1.0F);
+  std::uniform_real_distribution<float> prior_dist(0.0F, 1.0F);
+  std::uniform_int_distribution<int32_t> visit_dist(1, 200);
+  ChildStats stats;
+  for (size_t i = 0; i < size; ++i) {
+    stats.q.push_back(q_dist(rng));
+    stats.prior.push_back(prior_dist(rng) / static_cast<float>(size));
+    stats.visits.push_back(visit_dist(rng));
+  }
+  return stats;
+}
+
+void applyChildCounts(benchmark::internal::Benchmark* bench) {
+  for (int64_t children : {10, 50, 100, 500, 1000, 5000}) {
+    bench->Arg(children);
+  }
+}
+
+// 従来実装相当: 子ごとにsqrtと除算をdoubleで行う。
+void BM_PuctLegacyDouble(benchmark::State& state) {
+  const auto stats = makeStats(static_cast<size_t>(state.range(0)));
+  const int parent_visits = 10000;
+  for (auto _ : state) {
+    size_t best_index = 0;
+    double best_score = -INFINITY;
+    for (size_t i = 0; i < stats.q.size(); ++i) {
+      const double u_value = 1.5 * stats.prior[i] *
+                             std::sqrt(static_cast<double>(parent_visits)) /
+                             (1.0 + static_cast<double>(stats.visits[i]));
+      const double score = stats.q[i] + u_value;
+      if (score > best_score) {
+        best_score = score;
+        best_index = i;
+      }
+    }
+    benchmark::DoNotOptimize(best_index);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PuctLegacyDouble)->Apply(applyChildCounts);
+
+void runPuct(benchmark::State& state, mcts::SelectKernelIsa isa) {
+  if (!mcts::isSelectKernelIsaSupported(isa)) {
+    state.SkipWithError("ISA not supported on this CPU");
+    return;
+  }
+  const auto stats = makeStats(static_cast<size_t>(state.range(0)));
+  const float scale = 1.5F * std::sqrt(10000.0F);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        mcts::puctArgmax(stats.q, stats.prior, stats.visits, scale, isa));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PuctScalar(benchmark::State& state) {
+  runPuct(state, mcts::SelectKernelIsa::SCALAR);
+}
+BENCHMARK(BM_PuctScalar)->Apply(applyChildCounts);
+
+void BM_PuctAvx2(benchmark::State& state) {
+  runPuct(state, mcts::SelectKernelIsa::AVX2);
+}
+BENCHMARK(BM_PuctAvx2)->Apply(applyChildCounts);
+
+// 従来実装相当: 子ごとにlogとsqrtを計算するUCB1。
+void BM_UcbLegacyDouble(benchmark::State& state) {
+  const auto stats = makeStats(static_cast<size_t>(state.range(0)));
+  const int parent_visits = 10000;
+  for (auto _ : state) {
+    size_t best_index = 0;
+    double best_score = -INFINITY;
+    for (size_t i = 0; i < stats.q.size(); ++i) {
+      const double score =
+          stats.q[i] + std::sqrt(2.0) * std::sqrt(std::log(parent_visits + 1) /
+                                                  stats.visits[i]);
+      if (score > best_score) {
+        best_score = score;
+        best_index = i;
+      }
+    }
+    benchmark::DoNotOptimize(best_index);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UcbLegacyDouble)->Apply(applyChildCounts);
+
+void runUcb(benchmark::State& state, mcts::SelectKernelIsa isa) {
+  if (!mcts::isSelectKernelIsaSupported(isa)) {
+    state.SkipWithError("ISA not supported on this CPU");
+    return;
+  }
+  const auto stats = makeStats(static_cast<size_t>(state.range(0)));
+  const float scale = std::sqrt(2.0F) * std::sqrt(std::log(10001.0F));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        mcts::ucbArgmax(stats.q, stats.visits, scale, isa));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_UcbScalar(benchmark::State& state) {
+  runUcb(state, mcts::SelectKernelIsa::SCALAR);
+}
+BENCHMARK(BM_UcbScalar)->Apply(applyChildCounts);
+
+void BM_UcbAvx2(benchmark::State& state) {
+  runUcb(state, mcts::SelectKernelIsa::AVX2);
+}
+BENCHMARK(BM_UcbAvx2)->Apply(applyChildCounts);
+
+}  // namespace
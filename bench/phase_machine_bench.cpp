@@ -0,0 +1,133 @@
+// ファイル: bench/phase_machine_bench.cpp
+// 役割:
+// コーパスの局面ごとに、PhaseMachine::stepの1回(局面の状態ごと)、ActionRealigmentCommand::apply、局面から終局までの一様ランダムなプレイアウトの時間を計測する。
+// 背景:
+// stepの時間は処理する状態で桁が変わり、プレイアウトはそれらの合計になるため、状態ごとの内訳と全体を同じ局面で並べる。
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "bench_corpus.hpp"
+#include "tsge/actions/action_index.hpp"
+#include "tsge/actions/command.hpp"
+#include "tsge/core/phase_machine.hpp"
+
+namespace bench {
+namespace {
+
+constexpr int MAX_PLAYOUT_STEPS = 5000;
+
+void step(benchmark::State& state, const BenchPosition& position) {
+  const Board board = position.load();
+  std::mt19937_64 rng(1);
+  size_t count = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Board copy(board);
+    attachRng(copy, rng);
+    state.ResumeTiming();
+    auto result = PhaseMachine::step(copy);
+    count = std::get<0>(result).size();
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["legal_moves"] = static_cast<double>(count);
+}
+
+// AR側が手札の最初のOpsのあるカードで、相手の影響力がある最初の国を再編する
+void realignmentApply(benchmark::State& state,
+                      const BenchPosition& position) {
+  Board board = position.load();
+  std::mt19937_64 rng(2);
+  attachRng(board, rng);
+  const Side side = *position.arSide();
+  const Side opponent = getOpponentSide(side);
+  const auto& cardpool = board.getCardpool();
+  const auto& hand = board.getPlayerHand(side);
+  const auto card = std::ranges::find_if(hand, [&](CardEnum id) {
+    return cardpool[static_cast<size_t>(id)]->getOps() > 0;
+  });
+  std::optional<CountryEnum> target;
+  for (size_t i = static_cast<size_t>(CountryEnum::USA) + 1;
+       i < ActionIndex::COUNTRY_COUNT && !target.has_value(); ++i) {
+    const auto country = static_cast<CountryEnum>(i);
+    if (board.getWorldMap().getCountry(country).getInfluence(opponent) > 0) {
+      target = country;
+    }
+  }
+  if (card == hand.end() || !target.has_value()) {
+    state.SkipWithError("no realignment target in this position");
+    return;
+  }
+
+  const ActionRealigmentCommand command(
+      side, cardpool[static_cast<size_t>(*card)], *target);
+  auto& country = board.getWorldMap().getCountry(*target);
+  const int ussr = country.getInfluence(Side::USSR);
+  const int usa = country.getInfluence(Side::USA);
+  for (auto _ : state) {
+    command.apply(board);
+    // 取り除かれた影響力を戻して同じ局面で測り続ける
+    country.addInfluence(Side::USSR, ussr - country.getInfluence(Side::USSR));
+    country.addInfluence(Side::USA, usa - country.getInfluence(Side::USA));
+  }
+}
+
+void randomPlayout(benchmark::State& state, const BenchPosition& position) {
+  const Board board = position.load();
+  std::mt19937_64 rng(3);
+  int64_t steps = 0;
+  for (auto _ : state) {
+    Board game(board);
+    attachRng(game, rng);
+    auto [legal_moves, side, winner] = PhaseMachine::step(game);
+    for (int i = 0; i < MAX_PLAYOUT_STEPS && !winner.has_value() &&
+                    !legal_moves.empty();
+         ++i) {
+      std::uniform_int_distribution<size_t> pick(0, legal_moves.size() - 1);
+      std::tie(legal_moves, side, winner) =
+          PhaseMachine::step(game, legal_moves, pick(rng));
+      ++steps;
+    }
+    benchmark::DoNotOptimize(winner);
+  }
+  state.SetItemsProcessed(steps);
+  state.counters["steps_per_playout"] = benchmark::Counter(
+      static_cast<double>(steps), benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+void registerPhaseMachineBenchmarks() {
+  // 状態ごとに名前を分け、同じ状態の局面を並べて比べられるようにする
+  for (const auto& position : corpusPositions()) {
+    const std::string name = "BM_Step/" + position.state + "/" + position.name;
+    benchmark::RegisterBenchmark(name.c_str(),
+                                 [&position](benchmark::State& state) {
+                                   step(state, position);
+                                 })
+        ->Unit(benchmark::kMicrosecond);
+  }
+  registerPerPosition(
+      "BM_RealignmentApply",
+      [](const BenchPosition& position) {
+        return position.arSide().has_value();
+      },
+      realignmentApply, benchmark::kNanosecond);
+  // 実装済みのカードの局面は4 Opsの合法手生成が1手に数十ミリ秒かかり、
+  // 1回のプレイアウトが計測として長すぎるため、Opsだけのカードの局面に限る
+  registerPerPosition(
+      "BM_RandomPlayout",
+      [](const BenchPosition& position) {
+        return position.cardpool == "ops_only";
+      },
+      randomPlayout, benchmark::kMillisecond);
+}
+
+}  // namespace bench
@@ -0,0 +1,170 @@
+// ファイル: bench/rollout_policy_bench.cpp
+// 役割:
+// 一様ランダムとルールベースのロールアウトポリシーについて、1手の選択時間・プレイアウト1回の時間・対戦時の勝率を計測する。
+// 背景:
+// 重いプレイアウトは1手あたりのコストと引き換えに評価を改善するため、速度と強さを同じ条件で並べて比較する。
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/game_state/card.hpp"
+#include "tsge/players/rollout_policy.hpp"
+
+namespace {
+
+// Opsとイベント陣営をカード番号から決める、イベントを持たないカード。
+// Ops 3以上では影響力配置の合法手生成がプレイアウト時間の大半を占めるため、Opsは1と2に限る。
+class BenchCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  BenchCard(CardEnum id, int ops, Side side)
+      : Card(id, "Bench", ops, side, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+const std::array<std::unique_ptr<Card>, 111>& benchCardpool() {
+  static const auto cardpool = [] {
+    std::array<std::unique_ptr<Card>, 111> pool{};
+    constexpr std::array<Side, 3> SIDES{Side::USSR, Side::USA, Side::NEUTRAL};
+    for (int i = 0; i < 111; ++i) {
+      const auto id = static_cast<CardEnum>(i);
+      const int ops = mcts::scoringRegion(id) ? 0 : 1 + (i % 2);
+      pool[static_cast<size_t>(i)] = std::make_unique<BenchCard>(
+          id, ops, SIDES[static_cast<size_t>(i % 3)]);
+    }
+    return pool;
+  }();
+  return cardpool;
+}
+
+constexpr int MAX_PLAYOUT_STEPS = 5000;
+
+struct PlayoutResult {
+  std::optional<Side> winner;
+  int steps = 0;
+};
+
+// ターン開始からUSSRはussr、USAはusaのポリシーで終局(または手数上限)まで進める。
+PlayoutResult playout(const mcts::RolloutPolicy& ussr,
+                      const mcts::RolloutPolicy& usa, std::mt19937_64& rng) {
+  Board board(benchCardpool());
+  board.getRandomizer().setRng(&rng);
+  board.getDeck().addEarlyWarCards();
+  board.pushState(StateType::TURN_START);
+
+  PlayoutResult result;
+  std::optional<std::shared_ptr<Move>> pending;
+  for (; result.steps < MAX_PLAYOUT_STEPS; ++result.steps) {
+    auto [legal_moves, side, winner] =
+        PhaseMachine::step(board, std::move(pending));
+    if (winner.has_value()) {
+      result.winner = winner;
+      break;
+    }
+    if (legal_moves.empty()) {
+      break;
+    }
+    const auto& policy = side == Side::USA ? usa : ussr;
+    pending = policy.selectMove(board, legal_moves, rng);
+  }
+  return result;
+}
+
+void runPlayout(benchmark::State& state, const mcts::RolloutPolicy& policy) {
+  std::mt19937_64 rng(1);
+  int64_t steps = 0;
+  for (auto _ : state) {
+    const auto result = playout(policy, policy, rng);
+    steps += result.steps;
+    benchmark::DoNotOptimize(result.winner);
+  }
+  state.SetItemsProcessed(steps);
+  state.counters["steps_per_playout"] = benchmark::Counter(
+      static_cast<double>(steps), benchmark::Counter::kAvgIterations);
+}
+
+void BM_RolloutPlayoutUniform(benchmark::State& state) {
+  runPlayout(state, mcts::UniformRolloutPolicy{});
+}
+BENCHMARK(BM_RolloutPlayoutUniform)->Unit(benchmark::kMicrosecond);
+
+void BM_RolloutPlayoutHeuristic(benchmark::State& state) {
+  runPlayout(state, mcts::HeuristicRolloutPolicy{});
+}
+BENCHMARK(BM_RolloutPlayoutHeuristic)->Unit(benchmark::kMicrosecond);
+
+// 1手の選択時間。初手の影響力配置(候補数が最も多い局面の1つ)で測る。
+void BM_HeuristicSelectMove(benchmark::State& state) {
+  Board board(benchCardpool());
+  std::mt19937_64 rng(2);
+  board.getRandomizer().setRng(&rng);
+  board.getDeck().addEarlyWarCards();
+  board.pushState(StateType::TURN_START);
+  const mcts::UniformRolloutPolicy uniform;
+  auto is_place = [](const std::shared_ptr<Move>& move) {
+    return dynamic_cast<const ActionPlaceInfluenceMove*>(move.get()) !=
+           nullptr;
+  };
+  // ヘッドラインを抜けて影響力配置を含む合法手が出るまで一様に進める
+  auto [legal_moves, side, winner] = PhaseMachine::step(board);
+  while (!winner.has_value() && !legal_moves.empty() &&
+         std::none_of(legal_moves.begin(), legal_moves.end(), is_place)) {
+    std::tie(legal_moves, side, winner) =
+        PhaseMachine::step(board, uniform.selectMove(board, legal_moves, rng));
+  }
+  const mcts::HeuristicRolloutPolicy policy;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(policy.selectMove(board, legal_moves, rng));
+  }
+  state.counters["legal_moves"] = static_cast<double>(legal_moves.size());
+}
+BENCHMARK(BM_HeuristicSelectMove);
+
+// 強さの比較: ルールベース側の勝率(引き分けは0.5)を陣営を入れ替えて測る。
+void BM_RolloutStrength(benchmark::State& state) {
+  const mcts::UniformRolloutPolicy uniform;
+  const mcts::HeuristicRolloutPolicy heuristic;
+  const bool heuristic_is_ussr = state.range(0) == 0;
+  const Side heuristic_side = heuristic_is_ussr ? Side::USSR : Side::USA;
+  std::mt19937_64 rng(3);
+  double score = 0.0;
+  int64_t games = 0;
+  for (auto _ : state) {
+    const auto result =
+        heuristic_is_ussr ? playout(heuristic, uniform, rng)
+                          : playout(uniform, heuristic, rng);
+    if (!result.winner.has_value() || *result.winner == Side::NEUTRAL) {
+      score += 0.5;
+    } else if (*result.winner == heuristic_side) {
+      score += 1.0;
+    }
+    ++games;
+  }
+  state.counters["heuristic_win_rate"] =
+      games > 0 ? score / static_cast<double>(games) : 0.0;
+}
+BENCHMARK(BM_RolloutStrength)
+    ->ArgName("heuristic_usa")
+    ->Arg(0)
+    ->Arg(1)
+    ->Iterations(20)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
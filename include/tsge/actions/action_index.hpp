@@ -0,0 +1,95 @@
+// ファイル: include/tsge/actions/action_index.hpp
+// 役割:
+// 全ての種類のMoveを固定長の行動添字空間へ写す正準の対応と、その逆写像、合法手集合のマスク書き込みを定義する。
+// 背景:
+// 推論結果のpolicyは合法手の並びに揃える必要があり、ネットワークが固定長の方策ヘッドを持てなかったため。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "tsge/actions/move.hpp"
+
+// ActionIndex: 行動添字の割り当て(版VERSION)。添字は手番サイドを含まず、逆写像でサイドを与える。
+//
+// 種類ごとの区画(KindOffset順、カードはCardEnumの値、国はCountryEnumの値):
+//   HEADLINE / EVENT / SPACE_RACE / DISCARD        カードごとに1つ
+//   COUP / REALIGNMENT                             カード × 国
+//   PLACE_INFLUENCE / EVENT_PLACE_INFLUENCE /
+//   EVENT_REMOVE_INFLUENCE                         カード × 国(影響力1単位の操作)
+//   PASS                                           1つ
+//
+// 影響力の配置・除去は「1か国に1単位」の手順へ分解して扱う(分解モード)。
+// 複数国・複数単位にまたがる手は、国の昇順で最初の手順の添字を代表として返し、
+// influenceStepsで全手順を列挙できる。
+// RealignmentRequestMoveの継続は REALIGNMENT、打ち切り(対象USSR)は REALIGNMENT の USSR 枠に写る。
+class ActionIndex {
+ public:
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t CARD_COUNT = 111;
+  static constexpr size_t COUNTRY_COUNT = 86;
+  static constexpr size_t CARD_COUNTRY_COUNT = CARD_COUNT * COUNTRY_COUNT;
+
+  enum class Kind : uint8_t {
+    HEADLINE,
+    EVENT,
+    SPACE_RACE,
+    DISCARD,
+    COUP,
+    REALIGNMENT,
+    PLACE_INFLUENCE,
+    EVENT_PLACE_INFLUENCE,
+    EVENT_REMOVE_INFLUENCE,
+    PASS,
+  };
+
+  static constexpr size_t HEADLINE_OFFSET = 0;
+  static constexpr size_t EVENT_OFFSET = HEADLINE_OFFSET + CARD_COUNT;
+  static constexpr size_t SPACE_RACE_OFFSET = EVENT_OFFSET + CARD_COUNT;
+  static constexpr size_t DISCARD_OFFSET = SPACE_RACE_OFFSET + CARD_COUNT;
+  static constexpr size_t COUP_OFFSET = DISCARD_OFFSET + CARD_COUNT;
+  static constexpr size_t REALIGNMENT_OFFSET = COUP_OFFSET + CARD_COUNTRY_COUNT;
+  static constexpr size_t PLACE_INFLUENCE_OFFSET =
+      REALIGNMENT_OFFSET + CARD_COUNTRY_COUNT;
+  static constexpr size_t EVENT_PLACE_INFLUENCE_OFFSET =
+      PLACE_INFLUENCE_OFFSET + CARD_COUNTRY_COUNT;
+  static constexpr size_t EVENT_REMOVE_INFLUENCE_OFFSET =
+      EVENT_PLACE_INFLUENCE_OFFSET + CARD_COUNTRY_COUNT;
+  static constexpr size_t PASS_OFFSET =
+      EVENT_REMOVE_INFLUENCE_OFFSET + CARD_COUNTRY_COUNT;
+  static constexpr size_t SIZE = PASS_OFFSET + 1;
+
+  // 対応する添字が無い手(未知の派生型など)を表す値
+  static constexpr size_t INVALID = SIZE;
+
+  // ビットマスク版のuint64_t語数
+  static constexpr size_t MASK_WORDS = (SIZE + 63) / 64;
+
+  // moveの代表の添字。影響力の手では最初の手順だけを返すため情報を失い、
+  // 最初の手順が同じ別のパターンが同じ値になる。手を区別するにはinfluenceStepsを使う。
+  [[nodiscard]] static size_t moveToIndex(const Move& move);
+
+  // indexの手をside用に作り直す。影響力の区画は対象国に1単位の手になる。範囲外はstd::out_of_range。
+  // イベントの区画は合法手生成と同じく、boardでカードのcanEventを調べてイベントを起こすかを決める。
+  [[nodiscard]] static std::shared_ptr<Move> indexToMove(size_t index,
+                                                         Side side,
+                                                         const Board& board);
+
+  [[nodiscard]] static Kind kindOf(size_t index);
+
+  // moveを分解した手順の添字をoutへ追記する(影響力1単位ごとに1つ、国の昇順)。
+  // 影響力以外の手は moveToIndex の1つだけを追記する。
+  static void influenceSteps(const Move& move, std::vector<size_t>& out);
+
+  // 合法手集合のマスクを書き込む。maskはSIZE要素(uint8)またはMASK_WORDS語(ビット)で、
+  // 呼び出しごとに全体を0で埋め直すため、同じバッファを手番ごとに使い回せる。
+  // 影響力の手は分解後の全手順の添字を立てる(分解モードで最初の1手順として選べる集合)。
+  static void writeLegalMask(
+      std::span<const std::shared_ptr<Move>> legal_moves, uint8_t* mask);
+  static void writeLegalBitmask(
+      std::span<const std::shared_ptr<Move>> legal_moves, uint64_t* mask);
+};
@@ -31,6 +31,14 @@ class DeStalinizationRemoveMove final : public Move {
     return targetCountries_ == other_cast->targetCountries_;
   }
 
+  [[nodiscard]]
+  const std::map<CountryEnum, int>& getTargetCountries() const {
+    return targetCountries_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const std::map<CountryEnum, int> targetCountries_;
 };
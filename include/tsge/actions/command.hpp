@@ -4,9 +4,12 @@
 // 単一の責務点から副作用を管理し、MCTSやPhaseMachineが期待する契約を守るため
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "tsge/enums/cards_enum.hpp"
@@ -15,6 +18,8 @@
 class Board;
 class Move;
 class Card;
+class ByteWriter;
+class ByteReader;
 
 class Command {
  public:
@@ -43,6 +48,15 @@ class Command {
     return side_;
   }
 
+  // Board::serialize用に種類と引数を書く。ラムダを包むCommandは書けないため
+  // std::runtime_errorを投げる。
+  virtual void writeSnapshot(ByteWriter& out) const;
+  // writeSnapshotの出力を読み、カード参照をcardpoolから解決して作り直す。
+  // 壊れていればstd::runtime_error。
+  [[nodiscard]]
+  static std::shared_ptr<Command> readSnapshot(
+      ByteReader& in, const std::array<std::unique_ptr<Card>, 111>& cardpool);
+
  protected:
   const Side side_;
 };
@@ -56,6 +70,7 @@ class PlaceInfluenceCommand final : public Command {
       : Command{side}, card_{card}, targetCountries_{targetCountries} {};
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const std::unique_ptr<Card>& card_;
@@ -69,6 +84,7 @@ class ActionRealigmentCommand final : public Command {
       : Command{side}, card_{card}, targetCountry_{targetCountry} {};
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const std::unique_ptr<Card>& card_;
@@ -82,6 +98,7 @@ class ActionCoupCommand final : public Command {
       : Command{side}, card_{card}, targetCountry_{targetCountry} {};
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const std::unique_ptr<Card>& card_;
@@ -94,6 +111,7 @@ class ActionSpaceRaceCommand final : public Command {
       : Command{side}, card_{card} {};
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const std::unique_ptr<Card>& card_;
@@ -116,6 +134,7 @@ class ChangeDefconCommand final : public Command {
       : Command(Side::NEUTRAL), delta_{delta} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const int delta_;
@@ -127,21 +146,100 @@ class ChangeVpCommand final : public Command {
       : Command{side}, delta_{delta} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const int delta_;
 };
 
+// DefconVpCommand: 適用した時点のDEFCONからsideのVPを
+// base + perDefcon * DEFCONだけ動かす(Duck and Cover、Nuclear Test Ban)。
+class DefconVpCommand final : public Command {
+ public:
+  DefconVpCommand(Side side, int base, int perDefcon)
+      : Command{side}, base_{base}, perDefcon_{perDefcon} {}
+
+  void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
+
+ private:
+  const int base_;
+  const int perDefcon_;
+};
+
+// RequestKind: RequestCommandが合法手をどこから得るか。
+// CLOSUREはラムダで作ったもので、スナップショットに書けない(テストや即席の入力要求用)。
+enum class RequestKind : uint8_t {
+  CLOSURE,
+  REALIGNMENT,
+  ADDITIONAL_OPS_REALIGNMENT,
+  ACTION_FOR_CARD,
+  SPACE_TRACK_DISCARD,
+  DE_STALINIZATION_PLACE,
+  CARD_EVENT,
+};
+
+// RequestDescriptor: 入力要求をラムダの代わりに値で表したもの。
+// 合法手はkindに応じた合法手生成器の関数かCard::requestLegalMovesで作るため、
+// 盤面と一緒に書き出して再開できる。
+struct RequestDescriptor {
+  RequestKind kind = RequestKind::CLOSURE;
+  CardEnum card = CardEnum::DUMMY;
+  // リアライメントの残Ops、De-Stalinizationの配置数、カードイベントごとの数量
+  int value = 0;
+  // 適用済みの追加Ops(AdditionalOpsTypeの値)
+  uint8_t appliedAdditionalOps = 0;
+  // これまでにリアライメントした国
+  std::vector<CountryEnum> history;
+
+  [[nodiscard]]
+  static RequestDescriptor realignment(CardEnum card,
+                                       std::vector<CountryEnum> history,
+                                       int remainingOps,
+                                       uint8_t appliedAdditionalOps) {
+    return {RequestKind::REALIGNMENT, card, remainingOps, appliedAdditionalOps,
+            std::move(history)};
+  }
+  [[nodiscard]]
+  static RequestDescriptor additionalOpsRealignment(
+      CardEnum card, std::vector<CountryEnum> history,
+      uint8_t appliedAdditionalOps) {
+    return {RequestKind::ADDITIONAL_OPS_REALIGNMENT, card, 0,
+            appliedAdditionalOps, std::move(history)};
+  }
+  [[nodiscard]]
+  static RequestDescriptor actionForCard(CardEnum card) {
+    return {RequestKind::ACTION_FOR_CARD, card, 0, 0, {}};
+  }
+  [[nodiscard]]
+  static RequestDescriptor spaceTrackDiscard() {
+    return {RequestKind::SPACE_TRACK_DISCARD, CardEnum::DUMMY, 0, 0, {}};
+  }
+  [[nodiscard]]
+  static RequestDescriptor deStalinizationPlace(CardEnum card, int count) {
+    return {RequestKind::DE_STALINIZATION_PLACE, card, count, 0, {}};
+  }
+  [[nodiscard]]
+  static RequestDescriptor cardEvent(CardEnum card, int value) {
+    return {RequestKind::CARD_EVENT, card, value, 0, {}};
+  }
+
+  bool operator==(const RequestDescriptor&) const = default;
+};
+
 class RequestCommand final : public Command {
  public:
   RequestCommand(Side side,
                  std::function<std::vector<std::shared_ptr<Move>>(const Board&)>
                      legalMoves)
       : Command(side), legalMovesFactory_(std::move(legalMoves)) {}
-
-  // std::function<std::vector<CommandPtr>(const Move&)> resume; いらないかも
+  // CARD_EVENT以外の記述子から作る
+  RequestCommand(Side side, RequestDescriptor descriptor);
+  // カードイベントの入力要求。合法手はcard.requestLegalMoves(board, side, value)。
+  RequestCommand(Side side, const Card& card, int value = 0);
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
   [[nodiscard]]
   bool requiresPlayerInput() const override {
@@ -155,8 +253,14 @@ class RequestCommand final : public Command {
   Side getSide() const {
     return side_;
   }
+  [[nodiscard]]
+  const RequestDescriptor& getDescriptor() const {
+    return descriptor_;
+  }
 
  private:
+  RequestDescriptor descriptor_;
+  const Card* eventCard_ = nullptr;
   std::function<std::vector<std::shared_ptr<Move>>(const Board&)>
       legalMovesFactory_;
 };
@@ -167,6 +271,7 @@ class SetHeadlineCardCommand final : public Command {
       : Command{side}, card_{card} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const CardEnum card_;
@@ -178,6 +283,7 @@ class FinalizeCardPlayCommand final : public Command {
       : Command{side}, card_{card}, removeAfterEvent_{removeAfterEvent} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const CardEnum card_;
@@ -189,6 +295,7 @@ class DiscardCommand final : public Command {
   DiscardCommand(Side side, CardEnum card) : Command{side}, card_{card} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const CardEnum card_;
@@ -200,6 +307,7 @@ class ScoreRegionCommand final : public Command {
       : Command(Side::NEUTRAL), region_{region} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const Region region_;
@@ -210,6 +318,7 @@ class SoutheastAsiaScoringCommand final : public Command {
   SoutheastAsiaScoringCommand() : Command(Side::NEUTRAL) {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 };
 
 class RemoveInfluenceCommand final : public Command {
@@ -221,6 +330,7 @@ class RemoveInfluenceCommand final : public Command {
         targetCountries_{targetCountries} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const Side targetSide_;
@@ -233,6 +343,7 @@ class RemoveAllInfluenceCommand final : public Command {
       : Command{Side::NEUTRAL}, targetSide_{targetSide}, country_{country} {}
 
   void apply(Board& board) const override;
+  void writeSnapshot(ByteWriter& out) const override;
 
  private:
   const Side targetSide_;
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <vector>
@@ -15,6 +16,11 @@ enum class AdditionalOpsType : uint8_t {
   BOTH = CHINA_CARD | VIETNAM_REVOLTS
 };
 
+// combineMoveKey: Moveキーへ値を1つ混ぜ込む(boost::hash_combine相当)。
+[[nodiscard]] inline uint64_t combineMoveKey(uint64_t key, uint64_t value) {
+  return key ^ (value + 0x9e3779b97f4a7c15ULL + (key << 6U) + (key >> 2U));
+}
+
 class Move {
  public:
   Move(CardEnum card, Side side) : card_{card}, side_{side} {}
@@ -39,6 +45,12 @@ class Move {
   [[nodiscard]]
   virtual bool operator==(const Move& other) const = 0;
 
+  // getKey: Moveの同一性を表す64bitキー。operator==で等しいMoveは同じキーを返す。
+  // 探索木の再利用やMove統計の集計でハッシュとして使い、衝突はoperator==で判定する。
+  // 既定実装は型・カード・サイドのみを混ぜる。追加のペイロードを持つ派生型は上書きする。
+  [[nodiscard]]
+  virtual uint64_t getKey() const;
+
  private:
   const CardEnum card_;
   const Side side_;
@@ -68,6 +80,14 @@ class ActionPlaceInfluenceMove final : public Move {
     return targetCountries_ == other_cast->targetCountries_;
   }
 
+  [[nodiscard]]
+  const std::map<CountryEnum, int>& getTargetCountries() const {
+    return targetCountries_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const std::map<CountryEnum, int> targetCountries_;
 };
@@ -96,6 +116,14 @@ class EventPlaceInfluenceMove final : public Move {
     return targetCountries_ == other_cast->targetCountries_;
   }
 
+  [[nodiscard]]
+  const std::map<CountryEnum, int>& getTargetCountries() const {
+    return targetCountries_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const std::map<CountryEnum, int> targetCountries_;
 };
@@ -122,6 +150,14 @@ class ActionCoupMove final : public Move {
     return targetCountry_ == other_cast->targetCountry_;
   }
 
+  [[nodiscard]]
+  CountryEnum getTargetCountry() const {
+    return targetCountry_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const CountryEnum targetCountry_;
 };
@@ -167,6 +203,14 @@ class ActionRealigmentMove final : public Move {
     return targetCountry_ == other_cast->targetCountry_;
   }
 
+  [[nodiscard]]
+  CountryEnum getTargetCountry() const {
+    return targetCountry_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const CountryEnum targetCountry_;
 };
@@ -205,6 +249,14 @@ class RealignmentRequestMove final : public Move {
            appliedAdditionalOps_ == other_cast->appliedAdditionalOps_;
   }
 
+  [[nodiscard]]
+  CountryEnum getTargetCountry() const {
+    return targetCountry_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const CountryEnum targetCountry_;
   const std::vector<CountryEnum> realignmentHistory_;
@@ -312,6 +364,14 @@ class EventRemoveInfluenceMove final : public Move {
     return targetCountries_ == other_cast->targetCountries_;
   }
 
+  [[nodiscard]]
+  const std::map<CountryEnum, int>& getTargetCountries() const {
+    return targetCountries_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const std::map<CountryEnum, int> targetCountries_;
 };
@@ -340,6 +400,14 @@ class EventRemoveAllInfluenceMove final : public Move {
     return targetCountries_ == other_cast->targetCountries_;
   }
 
+  [[nodiscard]]
+  const std::vector<CountryEnum>& getTargetCountries() const {
+    return targetCountries_;
+  }
+
+  [[nodiscard]]
+  uint64_t getKey() const override;
+
  private:
   const std::vector<CountryEnum> targetCountries_;
 };
@@ -0,0 +1,133 @@
+/*
+ * ファイル: include/tsge/capi/tsge_capi.h
+ * 役割:
+ * 対局環境(VectorEnv)を不透明なハンドル越しに操作するC言語のAPIを宣言する。共有ライブラリtsge_capiが実装する。
+ * 背景:
+ * 学習側はC++以外のランタイムで動くため、例外やC++の型を境界に出さず、呼び出し側が確保したバッファへ直接書き込む形で1手あたりの変換コストを無くす。
+ *
+ * スレッド安全性:
+ * - 異なるハンドルは別々のスレッドから同時に使ってよい。
+ * - 1つのハンドルへの呼び出しは呼び出し側で直列化すること。
+ *   ハンドルは内部のワーカースレッドで環境を並列に処理する。
+ * - 引数なしの関数(tsge_abi_versionなど)はどのスレッドからいつ呼んでもよい。
+ * - tsge_last_errorは呼び出したスレッドで最後に失敗した呼び出しのメッセージを返す。
+ *
+ * バッファ:
+ * - 観測・マスク・報酬はすべて呼び出し側が確保したバッファへ直接書き込み、ライブラリ内でのコピーや直列化は行わない。
+ * - 要素数はハンドルの環境数 × tsge_feature_size() / tsge_action_size()。
+ */
+
+#ifndef TSGE_CAPI_TSGE_CAPI_H
+#define TSGE_CAPI_TSGE_CAPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define TSGE_API __declspec(dllexport)
+#else
+#define TSGE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 互換性のない変更のたびに増やす。ヘッダとライブラリの値が違えば使わないこと。 */
+#define TSGE_ABI_VERSION 3
+
+typedef struct tsge_env tsge_env;
+
+typedef enum tsge_status {
+  TSGE_OK = 0,
+  /* NULLポインタ、要素数の不一致、合法でない行動など。状態は変わらない。 */
+  TSGE_INVALID_ARGUMENT = 1,
+  /* 対局エンジン内部の失敗。ハンドルは破棄すること。 */
+  TSGE_RUNTIME_ERROR = 2
+} tsge_status;
+
+/* 環境で使うカードのプール */
+typedef enum tsge_cardpool {
+  /*
+   * イベントを実装済みの32枚(得点カード7枚・China Card・De-Stalinizationなど。一覧は
+   * include/tsge/players/ops_only_cardpool.hppのimplementedCardpool)だけが本物のカード。
+   * 残りはイベントを起こせないOpsだけのカードで、イベントの手は実装済みのカードにしか出ない。
+   * Ops 3以上のカードがあるため、影響力配置の合法手の生成に1手あたり数十ミリ秒かかることがある。
+   */
+  TSGE_CARDPOOL_IMPLEMENTED = 0,
+  /*
+   * 全てのカードが初期戦のOps 0〜2のカードで、イベントの手は選べるが何も起こさない。
+   * 高速だがイベントを学習できない。
+   */
+  TSGE_CARDPOOL_OPS_ONLY = 1
+} tsge_cardpool;
+
+typedef struct tsge_env_config {
+  /* 同時に進める環境の数(1以上)。1なら単一環境として使える。 */
+  size_t num_envs;
+  /* 環境を処理するスレッド数(呼び出し元スレッドを含む、1以上) */
+  size_t threads;
+  /* 1エピソードの手数の上限。超えたら報酬0で打ち切って作り直す。 */
+  size_t max_episode_steps;
+  /* 各環境の種を決める基準の種 */
+  uint64_t seed;
+  /* カードのプール(既定はTSGE_CARDPOOL_IMPLEMENTED) */
+  tsge_cardpool cardpool;
+} tsge_env_config;
+
+TSGE_API uint32_t tsge_abi_version(void);
+/* 1環境あたりの特徴量の要素数 */
+TSGE_API size_t tsge_feature_size(void);
+/* 行動添字の総数(1環境あたりのマスクの要素数) */
+TSGE_API size_t tsge_action_size(void);
+/* このスレッドで最後に失敗した呼び出しのメッセージ。失敗が無ければ空文字列。 */
+TSGE_API const char* tsge_last_error(void);
+
+/* 既定値(環境1つ、スレッド1つ、実装済みのカードのプール)で埋める */
+TSGE_API void tsge_env_config_init(tsge_env_config* config);
+
+/* 環境を作って最初の手番まで進める。成功すれば*out_envにハンドルを書く。 */
+TSGE_API tsge_status tsge_env_create(const tsge_env_config* config,
+                                     tsge_env** out_env);
+/* NULLなら何もしない */
+TSGE_API void tsge_env_destroy(tsge_env* env);
+TSGE_API size_t tsge_env_num_envs(const tsge_env* env);
+
+/* 全環境をやり直す。seedsはnum_envs個。 */
+TSGE_API tsge_status tsge_env_reset(tsge_env* env, const uint64_t* seeds);
+
+/*
+ * 全環境で1手順ずつ進める。actionsはnum_envs個の行動添字で、マスクが1の添字だけが合法。
+ * 影響力の配置・除去は1か国1単位の手順を1つずつ選び、手が決まるまでは盤面を進めない
+ * (その間の報酬は0、doneは0)。途中で手が完成していれば、PASSの添字でそこで確定できる。
+ * rewards_out・dones_outはnum_envs個で、NULLなら書かない。
+ * 合法でない行動があればどの環境も進めずにTSGE_INVALID_ARGUMENTを返す。
+ * 終局した環境は報酬(USSRの勝ちで+1、USAの勝ちで-1)とdoneを記録して自動で作り直す。
+ */
+TSGE_API tsge_status tsge_env_step(tsge_env* env, const int32_t* actions,
+                                   float* rewards_out, uint8_t* dones_out);
+
+/*
+ * 手番側から見た特徴量(num_envs * tsge_feature_size()個)と
+ * 次に選べる手順のマスク(num_envs * tsge_action_size()個)を書く。NULLの出力は書かない。
+ */
+TSGE_API tsge_status tsge_env_observe(tsge_env* env, float* features_out,
+                                      uint8_t* legal_mask_out);
+
+/* stepとobserveを1回の呼び出しで行う。学習ループで境界を越える回数を半分にする。 */
+TSGE_API tsge_status tsge_env_step_observe(tsge_env* env,
+                                           const int32_t* actions,
+                                           float* rewards_out,
+                                           uint8_t* dones_out,
+                                           float* features_out,
+                                           uint8_t* legal_mask_out);
+
+/* 各環境の手番(0: USSR、1: USA)をnum_envs個書く */
+TSGE_API tsge_status tsge_env_sides_to_move(const tsge_env* env,
+                                            int32_t* sides_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TSGE_CAPI_TSGE_CAPI_H */
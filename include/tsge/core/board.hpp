@@ -4,6 +4,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <span>
 #include <variant>
 #include <vector>
 
@@ -28,6 +30,13 @@ class Board {
       hand.reserve(9);
     }
   }
+  // DeckはRandomizerを参照で持つため、コピー先のDeckが自身のrandomizer_を
+  // 参照するよう明示的に定義する(暗黙のコピーでは元Boardを参照し続ける)。
+  Board(const Board& other);
+  Board(Board&& other) noexcept;
+  Board& operator=(const Board&) = delete;
+  Board& operator=(Board&&) = delete;
+  ~Board() = default;
   [[nodiscard]]
   const std::array<std::unique_ptr<Card>, 111>& getCardpool() const {
     return cardpool_;
@@ -45,6 +54,10 @@ class Board {
     return turnTrack_;
   }
   ActionRoundTrack& getActionRoundTrack() { return actionRoundTrack_; }
+  [[nodiscard]]
+  const ActionRoundTrack& getActionRoundTrack() const {
+    return actionRoundTrack_;
+  }
   Randomizer& getRandomizer() { return randomizer_; }
   Deck& getDeck() { return deck_; }
   std::vector<CardEnum>& getPlayerHand(Side side) {
@@ -63,6 +76,10 @@ class Board {
     return defconTrack_;
   }
   [[nodiscard]]
+  const MilopsTrack& getMilopsTrack() const {
+    return milopsTrack_;
+  }
+  [[nodiscard]]
   const Randomizer& getRandomizer() const {
     return randomizer_;
   }
@@ -149,6 +166,22 @@ class Board {
   void drawCardsForPlayers(int ussrDrawCount, int usaDrawCount);
   [[nodiscard]]
   Board copyForMCTS(Side viewerSide) const;
+  // viewerSideから見える情報だけのハッシュ。相手の手札・山札の中身と
+  // 見えないヘッドラインは枚数や有無だけを混ぜるため、copyForMCTSの結果と一致する。
+  [[nodiscard]]
+  uint64_t getObservableHash(Side viewerSide) const;
+
+  // serializeの書き込み先に用意すれば通常の局面は収まる大きさ
+  static constexpr size_t SNAPSHOT_CAPACITY = 2048;
+  // 影響力・各トラック・手札と山札・China Card・VP・ヘッドライン・進行中の効果と
+  // 状態スタック(Commandを含む)をoutへ書き、書いたバイト数を返す。
+  // Randomizerは含まない(乱数は呼び出し側が持つため、復元後にsetRngし直す)。
+  // outが足りなければstd::length_error、ラムダを包むCommandが積まれていれば
+  // std::runtime_error。
+  size_t serialize(std::span<std::byte> out) const;
+  // serializeの出力で盤面を置き換える。書いたBoardと同じcardpoolで作ったBoardに使う。
+  // 壊れていればstd::runtime_errorを投げ、盤面は途中まで書き換わった状態になる。
+  void deserialize(std::span<const std::byte> in);
 
 #ifdef TEST
   void addCardToHand(Side side, CardEnum card) {
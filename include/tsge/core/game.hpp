@@ -1,26 +1,44 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
+#include "tsge/actions/card_effect_legal_move_generator.hpp"
 #include "tsge/core/board.hpp"
 #include "tsge/core/phase_machine.hpp"
 #include "tsge/game_state/card.hpp"
+#include "tsge/players/any_policy.hpp"
 #include "tsge/players/player.hpp"
 #include "tsge/players/policies.hpp"
 
+#ifndef TEST
+#include <random>
+#endif
+
+// Game: 2人のプレイヤーで1局を進める。
+// P1・P2は具体的なポリシー型で、手ごとの呼び出しは仮想関数を介さずに解決される。
+// 実行時にポリシーを選ぶ場合はGame<AnyPolicy>を使う。
+template <DecisionPolicy P1 = TestPolicy, DecisionPolicy P2 = P1>
 class Game {
  public:
 #ifdef TEST
   Game()
-      : Game(Player<TestPolicy>{}, Player<TestPolicy>{}, defaultCardPool()) {}
-  Game(Player<TestPolicy>&& player1, Player<TestPolicy>&& player2)
+    requires std::default_initializable<P1> && std::default_initializable<P2>
+      : Game(Player<P1>{}, Player<P2>{}, defaultCardPool()) {}
+  Game(Player<P1>&& player1, Player<P2>&& player2)
       : Game(std::move(player1), std::move(player2), defaultCardPool()) {}
 #endif
-  Game(Player<TestPolicy>&& player1, Player<TestPolicy>&& player2,
+  Game(Player<P1>&& player1, Player<P2>&& player2,
        const std::array<std::unique_ptr<Card>, 111>& cardpool);
 
   Board& getBoard() { return board_; }
+  Player<P1>& getPlayer1() { return player1_; }
+  Player<P2>& getPlayer2() { return player2_; }
 
   void next();
 
@@ -31,8 +49,78 @@ class Game {
     return pool;
   }
 #endif
+
+  // sideを受け持つプレイヤーに対してvisitを呼ぶ(分岐はP1とP2の2通りのみ)
+  template <typename Visit>
+  decltype(auto) withPlayer(Side side, Visit&& visit) {
+    if ((static_cast<size_t>(side) ^ seat_swapped_) == 0) {
+      return visit(player1_);
+    }
+    return visit(player2_);
+  }
+
   Board board_;
 
-  std::array<Player<TestPolicy>, 2> players_;
+  Player<P1> player1_;
+  Player<P2> player2_;
+  // 1ならplayer1がUSA、player2がUSSRを受け持つ
+  size_t seat_swapped_ = 0;
   static void mayFail(bool success, const std::string& message);
-};
\ No newline at end of file
+};
+
+template <DecisionPolicy P1, DecisionPolicy P2>
+Game<P1, P2>::Game(Player<P1>&& player1, Player<P2>&& player2,
+                   const std::array<std::unique_ptr<Card>, 111>& cardpool)
+    : board_{Board(cardpool)},
+      player1_{std::move(player1)},
+      player2_{std::move(player2)} {
+  CardEffectLegalMoveGenerator::initializeBuiltinGenerators();
+#ifndef TEST
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> firstSecond(0, 1);
+  seat_swapped_ = static_cast<size_t>(firstSecond(gen));
+#endif
+}
+
+template <DecisionPolicy P1, DecisionPolicy P2>
+void Game<P1, P2>::next() {
+  auto result = PhaseMachine::step(board_);
+  while (true) {
+    auto& [legalMoves, waitingForSide, winner] = result;
+    if (legalMoves.empty() && waitingForSide == Side::NEUTRAL) {
+      // スタックが空→ゲーム終了
+      // 勝利者情報が取得可能になった
+      if (winner.has_value()) {
+        // 勝利者が決定している
+        // TODO: 将来的にPlayer::onGameEnd(winner)を呼び出す
+      }
+      break;
+    }
+
+    // 合法手の添字で受け取るため、合法性の確認は範囲の確認だけで済む。
+    // 合法手に無い手を返された場合は選び直させる。
+    std::size_t chosen = legalMoves.size();
+    while (chosen >= legalMoves.size()) {
+      chosen = withPlayer(waitingForSide, [&](auto& player) {
+        return player.decideMoveIndex(board_, legalMoves, waitingForSide);
+      });
+    }
+
+    // 適用直前の盤面で両プレイヤーに手を知らせる(相手の手札の推定などに使う)
+    player1_.observeMove(board_, *legalMoves[chosen]);
+    player2_.observeMove(board_, *legalMoves[chosen]);
+    result = PhaseMachine::step(board_, legalMoves, chosen);
+  }
+}
+
+template <DecisionPolicy P1, DecisionPolicy P2>
+void Game<P1, P2>::mayFail(bool success, const std::string& /*message*/) {
+  if (!success) {
+    throw std::runtime_error("ここは失敗する可能性があるのでlogを出す");
+  }
+}
+
+// よく使う組み合わせはsrc/core/game.cppで実体化する
+extern template class Game<TestPolicy>;
+extern template class Game<AnyPolicy>;
@@ -0,0 +1,142 @@
+// ファイル: include/tsge/core/game_record.hpp
+// 役割:
+// 1局を乱数の種と各判断での合法手の添字(と任意の探索統計)だけで表す棋譜と、その可変長バイナリ形式の読み書き、棋譜から任意の途中局面を組み立て直す再生器を提供する。
+// 背景:
+// 対局を保存・再生する手段が無かったため。盤面そのものではなく判断の列を残し、同じ乱数の流れでPhaseMachine::stepをやり直せば局面は完全に再現できる。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "tsge/actions/move.hpp"
+#include "tsge/core/board.hpp"
+
+// DecisionStats: 1回の判断での探索の統計。valueは手番側から見た評価値で、
+// ファイルには[-1, 1]を16ビットに量子化して書くため約3e-5の誤差が乗る。
+struct DecisionStats {
+  uint32_t visits = 0;
+  float value = 0.0F;
+
+  bool operator==(const DecisionStats&) const = default;
+};
+
+// GameRecord: 1局の棋譜。
+// 盤面はBoard(cardpool)にseedで初期化したstd::mt19937_64を渡し、初期戦カードを山札に入れて
+// TURN_STARTから始めたものとし(playMatch・VectorEnvと同じ)、choicesは各判断での合法手の添字。
+struct GameRecord {
+  static constexpr std::array<char, 4> MAGIC = {'T', 'S', 'G', 'R'};
+  static constexpr uint32_t VERSION = 1;
+
+  uint64_t seed = 0;
+  std::vector<uint32_t> choices;
+  // 空か、choicesと同じ長さ
+  std::vector<DecisionStats> stats;
+  // 勝者。引き分けはSide::NEUTRAL、終局前に打ち切った棋譜はnullopt。
+  std::optional<Side> winner;
+
+  bool operator==(const GameRecord&) const = default;
+
+  // 1局分をoutの末尾へ追記する(長さの前置きは含まない)。statsの長さが合わなければstd::invalid_argument。
+  void encode(std::vector<uint8_t>& out) const;
+  // encodeの出力1局分を読む。壊れていればstd::runtime_error。
+  [[nodiscard]] static GameRecord decode(std::span<const uint8_t> payload);
+};
+
+// GameRecordWriter: 棋譜ファイルへの書き込み。
+// 先頭にMAGICとVERSION、以降は1局ごとに可変長整数の長さとencodeの出力を並べる。
+// 内部のバッファが一杯になるかflush・破棄のときにまとめて書き出す。
+class GameRecordWriter {
+ public:
+  // pathを作り直す。開けなければstd::runtime_error。
+  explicit GameRecordWriter(const std::string& path,
+                            size_t buffer_size = size_t{1} << 20);
+  ~GameRecordWriter();
+  GameRecordWriter(const GameRecordWriter&) = delete;
+  GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+  GameRecordWriter(GameRecordWriter&&) = delete;
+  GameRecordWriter& operator=(GameRecordWriter&&) = delete;
+
+  void write(const GameRecord& record);
+  // 書き出しに失敗すればstd::runtime_error。
+  void flush();
+
+  [[nodiscard]] size_t gamesWritten() const { return games_; }
+
+ private:
+  std::ofstream out_;
+  std::string path_;
+  size_t buffer_size_;
+  std::vector<uint8_t> buffer_;
+  std::vector<uint8_t> payload_;
+  size_t games_ = 0;
+};
+
+// GameRecordReader: 棋譜ファイルを先頭から1局ずつ読む。
+class GameRecordReader {
+ public:
+  // 開けない・形式が違う場合はstd::runtime_error。
+  explicit GameRecordReader(const std::string& path);
+
+  // 次の1局をrecordへ読む。ファイルの終わりならfalse。途中で切れていればstd::runtime_error。
+  bool next(GameRecord& record);
+
+ private:
+  std::vector<uint8_t> data_;
+  size_t offset_ = 0;
+};
+
+// ReplayDriver: 棋譜をPhaseMachine::stepでやり直し、任意の判断の直前の局面を組み立てる。
+// 盤面は内部の乱数を参照するため、コピーもムーブもできない。
+class ReplayDriver {
+ public:
+  // 最初の判断の直前まで進める。
+  ReplayDriver(const std::array<std::unique_ptr<Card>, 111>& cardpool,
+               GameRecord record);
+  ReplayDriver(const ReplayDriver&) = delete;
+  ReplayDriver& operator=(const ReplayDriver&) = delete;
+  ReplayDriver(ReplayDriver&&) = delete;
+  ReplayDriver& operator=(ReplayDriver&&) = delete;
+
+  // 次の判断を適用する。全て適用済みならfalse。
+  // 添字が合法手の範囲外、または終局後に判断が残っていればstd::runtime_error。
+  bool next();
+  // decision番目の判断の直前まで進める(戻る場合は最初からやり直す)。
+  // decisionが判断の数を超えればstd::out_of_range。
+  void seek(size_t decision);
+
+  // 適用済みの判断の数
+  [[nodiscard]] size_t position() const { return position_; }
+  [[nodiscard]] size_t size() const { return record_.choices.size(); }
+  [[nodiscard]] const Board& board() const { return *board_; }
+  [[nodiscard]] const std::vector<std::shared_ptr<Move>>& legalMoves() const {
+    return legal_moves_;
+  }
+  [[nodiscard]] Side sideToMove() const { return side_; }
+  // 終局していればその勝者(引き分けはSide::NEUTRAL)
+  [[nodiscard]] std::optional<Side> winner() const { return winner_; }
+  [[nodiscard]] const GameRecord& record() const { return record_; }
+
+ private:
+  void restart();
+  void absorb(std::tuple<std::vector<std::shared_ptr<Move>>, Side,
+                         std::optional<Side>>&& result);
+
+  const std::array<std::unique_ptr<Card>, 111>& cardpool_;
+  GameRecord record_;
+  std::mt19937_64 rng_;
+  std::optional<Board> board_;
+  std::vector<std::shared_ptr<Move>> legal_moves_;
+  Side side_ = Side::NEUTRAL;
+  std::optional<Side> winner_;
+  size_t position_ = 0;
+};
@@ -0,0 +1,75 @@
+// ファイル: include/tsge/core/perft.hpp
+// 役割:
+// 局面からPhaseMachine::stepで深さdまでの判断の列を全て辿り、到達局面の数を判断の状態・手の種類ごとに数えるperftを提供する。
+// 背景:
+// 合法手生成の変更で手の数が黙って増減しても対局は進んでしまうため、決まった局面と深さでの数を固定値と比べて検出し、同じ走査で生成の速さも測る。
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+
+// 偶然手番(サイコロ・山札のシャッフル)の扱い。
+//   SEEDED     各stepの前に、根からの手の添字の列とseedで決まる種で乱数を初期化する。
+//              同じ局面・深さ・seedなら、辿る順序やスレッド数によらず同じ数になる。
+//   ENUMERATE  サイコロの出目1〜6を全て枝分かれさせる。シャッフルはSEEDEDと同じく種で固定する
+//              (並べ替えの列挙は現実的な数に収まらないため)。
+enum class PerftDice : uint8_t { SEEDED, ENUMERATE };
+
+// 判断の分類の数。StateTypeの各値と、入力要求のCommand(REQUEST)。
+inline constexpr size_t PERFT_DECISION_COUNT = 16;
+inline constexpr size_t PERFT_REQUEST_DECISION = PERFT_DECISION_COUNT - 1;
+// 手の分類の数。ActionIndex::Kindの各値と、添字の無い手(OTHER)。
+inline constexpr size_t PERFT_MOVE_CLASS_COUNT = 11;
+inline constexpr size_t PERFT_OTHER_MOVE_CLASS = PERFT_MOVE_CLASS_COUNT - 1;
+
+// 判断の分類名。ARの判断はAR_USSR/AR_USA、ヘッドラインはHEADLINE_CARD_SELECT_*。
+[[nodiscard]] std::string_view perftDecisionName(size_t decision);
+// 手の分類名(ActionIndex::Kindの列挙子名)
+[[nodiscard]] std::string_view perftMoveClassName(size_t move_class);
+
+// PerftCounts: 部分木の集計。
+struct PerftCounts {
+  // 深さdで到達した局面の数(判断とサイコロの出目の列の数)。深さdちょうどの終局も含む。
+  uint64_t nodes = 0;
+  // 深さdより手前で終局した局面の数
+  uint64_t terminals = 0;
+  // 呼んだPhaseMachine::stepの数(ENUMERATEで出目を決め直した分を含む)
+  uint64_t steps = 0;
+  // 深さd未満の判断の数を分類ごとに
+  std::array<uint64_t, PERFT_DECISION_COUNT> decisions{};
+  // 深さd未満の判断で辿った手の数を手の分類ごとに
+  std::array<uint64_t, PERFT_MOVE_CLASS_COUNT> moves{};
+
+  PerftCounts& operator+=(const PerftCounts& other);
+};
+
+struct PerftConfig {
+  int depth = 1;
+  PerftDice dice = PerftDice::SEEDED;
+  uint64_t seed = 1;
+  // 根の手を単位にワーカーへ分ける
+  size_t threads = 1;
+};
+
+// PerftResult: 全体と根の手ごと(並びはstepが返した合法手の順)の集計。
+struct PerftResult {
+  PerftCounts total;
+  std::vector<PerftCounts> root_moves;
+  std::chrono::nanoseconds elapsed{0};
+
+  [[nodiscard]] double nodesPerSecond() const;
+  [[nodiscard]] double stepsPerSecond() const;
+};
+
+// rootから深さconfig.depthまで数える。rootはstep(answerなし)で判断を返す状態で渡す
+// (局面テキストで読んだ盤面など)。rootは変更しない。
+// 深さ0なら根を1局面として数える。負の深さや0スレッドはstd::invalid_argument。
+[[nodiscard]] PerftResult runPerft(const Board& root,
+                                   const PerftConfig& config);
@@ -1,5 +1,7 @@
+#include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -12,4 +14,11 @@ class PhaseMachine {
                     std::optional<Side>>
   step(Board& board,
        std::optional<std::shared_ptr<Move>>&& answer = std::nullopt);
+
+  // 直前のstepが返した合法手legal_movesのchosen_index番目を回答として1フェーズ進める。
+  // 合法性の確認は範囲の確認だけで済む。範囲外ならstd::out_of_range。
+  static std::tuple<std::vector<std::shared_ptr<Move>>, Side,
+                    std::optional<Side>>
+  step(Board& board, std::span<const std::shared_ptr<Move>> legal_moves,
+       std::size_t chosen_index);
 };
\ No newline at end of file
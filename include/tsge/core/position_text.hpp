@@ -0,0 +1,64 @@
+// ファイル: include/tsge/core/position_text.hpp
+// 役割:
+// 盤面を人が読み書きできる行単位のテキスト(局面テキスト)へ書き出し・読み込む関数と、名前付きの局面を並べたコーパスの読み込みを提供する。
+// 背景:
+// 合法手生成や探索を現実的な局面で計測・検証するには、対局を最初から進めずに特定の局面を用意できる必要があるため。
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+
+// 局面テキストは1行に1項目で、先頭の語がキー、残りが値。#以降は注釈。
+// 列挙はすべて列挙子名(tsge::CARD_NAMESなど)で書き、陣営の組はUSSR・USAの順。
+//
+//   turn 4                     ターン
+//   action_round 3 2           各陣営の済んだAR数
+//   extra_action_round 0 1     追加ARの権利(0/1)
+//   ar_player USSR             現在のARの陣営
+//   defcon 3
+//   vp -2                      USSR側が正
+//   space 2 1                  宇宙開発トラック
+//   space_tried 0 1            このターンの宇宙開発の試行回数
+//   milops 3 0
+//   china USA up               China Cardの持ち主と表(up)/裏(down)
+//   headline DUMMY DUMMY       ヘッドラインに出したカード
+//   influence POLAND 4 0       国ごとの影響力。書かない国は0
+//   hand USSR COMECON NATO     手札(各陣営1行)
+//   deck ...                   山札(並び順どおり)
+//   discard ... / removed ...  捨て札・除外したカード
+//   in_progress ...            解決中のカード効果
+//   effects USSR ...           このターン有効なカード効果(各陣営1行)
+//   state TURN_START           状態スタック。下から順にstateとcommandを並べる
+//   command 0701...            CommandのwriteSnapshotの出力を16進で書いたもの
+//
+// 書かない項目は新しいBoardの値のまま(超大国の欄の影響力もここに含む)。
+// ARとヘッドラインの入力待ちはPhaseMachine::stepが状態を取り除いてから合法手を返すため、
+// 入力待ちの局面はstate AR_USSRのように手前の状態を積んで書く。step直後の盤面を
+// writePositionTextへ渡すと、入力待ちの代わりにAR_USSR_COMPLETEなどが積まれた形になる。
+
+// boardを局面テキストにする。readPositionTextで読むと同じ盤面に戻る(乱数は含まない)。
+// ラムダを包むCommandが積まれていればstd::runtime_error。
+[[nodiscard]] std::string writePositionText(const Board& board);
+
+// 局面テキストでboardを置き換える。boardのcardpoolでCommandのカードを解決する。
+// 書式や値の誤りは行番号付きのstd::runtime_errorで、その場合boardは変わらない。
+void readPositionText(std::string_view text, Board& board);
+
+// CorpusPosition: コーパスの1局面。cardpoolはcardpoolByNameに渡す名前。
+struct CorpusPosition {
+  std::string name;
+  std::string cardpool;
+  std::string text;
+};
+
+// コーパスは「position 名前」の行で局面を区切り、各局面に「cardpool 名前」を1行置く。
+// それ以外の行はその局面の局面テキスト。名前の重複や欠けはstd::runtime_error。
+[[nodiscard]] std::vector<CorpusPosition> parsePositionCorpus(
+    std::string_view contents);
+// pathのコーパスを読む。開けなければstd::runtime_error。
+[[nodiscard]] std::vector<CorpusPosition> loadPositionCorpus(
+    const std::string& path);
@@ -0,0 +1,126 @@
+// ファイル: include/tsge/enums/enum_names.hpp
+// 役割:
+// カード・国・StateType・陣営の列挙子名を文字列との間で相互に変換する。
+// 背景:
+// 局面のテキスト形式や計測ツールの集計は列挙子名をそのまま使うため、列挙の定義と同じ綴りの表を1か所に置く。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "tsge/enums/cards_enum.hpp"
+#include "tsge/enums/game_enums.hpp"
+
+namespace tsge {
+
+// 列挙子の値を添字とする名前の表。列挙を変えたら併せて直す。
+inline constexpr std::array<std::string_view, 111> CARD_NAMES = {
+    "DUMMY", "ASIA_SCORING", "EUROPE_SCORING", "MIDDLE_EAST_SCORING",
+    "DUCK_AND_COVER", "FIVE_YEAR_PLAN", "CHINA_CARD", "SOCIALIST_GOVERNMENTS",
+    "FIDEL", "VIETNAM_REVOLTS", "BLOCKADE", "KOREAN_WAR", "ROMANIAN_ABDICATION",
+    "ARAB_ISRAELI_WAR", "COMECON", "NASSER", "WARSAW_PACT_FORMED",
+    "DE_GAULLE_LEADS_FRANCE", "CAPTURED_NAZI_SCIENTIST", "TRUMAN_DOCTRINE",
+    "OLYMPIC_GAMES", "NATO", "INDEPENDENT_REDS", "MARSHALL_PLAN",
+    "INDO_PAKISTANI_WAR", "CONTAINMENT", "CIA_CREATED",
+    "US_JAPAN_MUTUAL_DEFENSE_PACT", "SUEZ_CRISIS", "EAST_EUROPEAN_UNREST",
+    "DECOLONIZATION", "RED_SCARE_PURGE", "UN_INTERVENTION", "DE_STALINIZATION",
+    "NUCLEAR_TEST_BAN", "FORMOSAN_RESOLUTION", "BRUSH_WAR",
+    "CENTRAL_AMERICA_SCORING", "SOUTHEAST_ASIA_SCORING", "ARMS_RACE",
+    "CUBAN_MISSILE_CRISIS", "NUCLEAR_SUBS", "QUAGMIRE", "SALT_NEGOTIATIONS",
+    "BEAR_TRAP", "SUMMIT", "HOW_I_LEARNED_TO_STOP_WORRYING", "JUNTA",
+    "KITCHEN_DEBATES", "MISSILE_ENVY", "WE_WILL_BURY_YOU", "BREZHNEV_DOCTRINE",
+    "PORTUGUESE_EMPIRE_CRUMBLES", "SOUTH_AFRICAN_UNREST", "ALLENDE",
+    "WILLY_BRANDT", "MUSLIM_REVOLUTION", "ABM_TREATY", "CULTURAL_REVOLUTION",
+    "FLOWER_POWER", "U2_INCIDENT", "OPEC", "LONE_GUNMAN",
+    "COLONIAL_REAR_GUARDS", "PANAMA_CANAL_RETURNED", "CAMP_DAVID_ACCORDS",
+    "PUPPET_GOVERNMENTS", "GRAIN_SALES_TO_SOVIETS", "JOHN_PAUL_II_ELECTED_POPE",
+    "LATIN_AMERICAN_DEATH_SQUADS", "OAS_FOUNDED", "NIXON_PLAYS_THE_CHINA_CARD",
+    "SADAT_EXPELS_SOVIETS", "SHUTTLE_DIPLOMACY", "VOICE_OF_AMERICA",
+    "LIBERATION_THEOLOGY", "USSURI_RIVER_SKIRMISH", "ASK_NOT_WHAT_YOUR_COUNTRY",
+    "ALLIANCE_FOR_PROGRESS", "AFRICA_SCORING", "ONE_SMALL_STEP",
+    "SOUTH_AMERICA_SCORING", "IRANIAN_HOSTAGE_CRISIS", "IRON_LADY",
+    "REAGAN_BOMBS_LIBYA", "STAR_WARS", "NORTH_SEA_OIL", "REFORMER",
+    "MARINE_BARRACKS_BOMBING", "SOVIETS_SHOOT_DOWN_KAL007", "GLASNOST",
+    "ORTEGA_ELECTED_IN_NICARAGUA", "TERRORISM", "IRAN_CONTRA_SCANDAL",
+    "CHERNOBYL", "LATIN_AMERICAN_DEBT_CRISIS", "TEAR_DOWN_THIS_WALL",
+    "AN_EVIL_EMPIRE", "ALDRICH_AMES_REMIX", "PERSHING_II_DEPLOYED", "WARGAMES",
+    "SOLIDARITY", "IRAN_IRAQ_WAR", "DEFECTORS", "CAMBRIDGE_FIVE",
+    "SPECIAL_RELATIONSHIP", "NORAD", "CHE", "OUR_MAN_IN_TEHRAN",
+    "YURI_AND_SAMANTHA", "AWACS_SALE_TO_SAUDIS",
+};
+inline constexpr std::array<std::string_view, 86> COUNTRY_NAMES = {
+    "USSR", "USA", "MEXICO", "CUBA", "GUATEMALA", "HONDURAS", "EL_SALVADOR",
+    "NICARAGUA", "COSTA_RICA", "PANAMA", "HAITI", "DOMINICAN_REPUBLIC",
+    "VENEZUELA", "COLOMBIA", "ECUADOR", "PERU", "BOLIVIA", "PARAGUAY", "CHILE",
+    "URUGUAY", "ARGENTINA", "BRAZIL", "ALGERIA", "TUNISIA", "MOROCCO",
+    "WEST_AFRICAN_STATES", "SAHARA_STATES", "IVORY_COAST", "NIGERIA",
+    "CAMEROON", "ZAIRE", "ANGOLA", "SOUTH_AFRICA", "BOTSWANA", "ZIMBABWE",
+    "MOZAMBIQUE", "KENYA", "ETHIOPIA", "SUDAN", "SOMALIA", "EGYPT", "LIBYA",
+    "ISRAEL", "LEBANON", "SYRIA", "JORDAN", "IRAQ", "IRAN", "SAUDI_ARABIA",
+    "GULF_STATES", "AFGHANISTAN", "PAKISTAN", "INDIA", "BURMA", "THAILAND",
+    "VIETNAM", "LAOS", "MALAYSIA", "INDONESIA", "PHILIPPINES", "JAPAN",
+    "SOUTH_KOREA", "NORTH_KOREA", "TAIWAN", "AUSTRALIA", "POLAND",
+    "EAST_GERMANY", "CZECHOSLOVAKIA", "HUNGARY", "ROMANIA", "BULGARIA",
+    "YUGOSLAVIA", "AUSTRIA", "WEST_GERMANY", "GREECE", "TURKEY", "ITALY",
+    "FRANCE", "SPAIN", "BENELUX", "UNITED_KINGDOM", "CANADA", "NORWAY",
+    "DENMARK", "SWEDEN", "FINLAND",
+};
+inline constexpr std::array<std::string_view, 15> STATE_TYPE_NAMES = {
+    "TURN_START", "HEADLINE_PHASE", "HEADLINE_CARD_SELECT_USSR",
+    "HEADLINE_CARD_SELECT_USA", "HEADLINE_PROCESS_EVENTS", "AR_USSR", "AR_USA",
+    "AR_USSR_COMPLETE", "AR_USA_COMPLETE", "EXTRA_AR_USSR", "EXTRA_AR_USA",
+    "TURN_END", "USSR_WIN_END", "USA_WIN_END", "DRAW_END",
+};
+inline constexpr std::array<std::string_view, 3> SIDE_NAMES = {
+    "USSR", "USA", "NEUTRAL",
+};
+
+namespace detail {
+
+template <typename Enum, size_t N>
+std::optional<Enum> parseName(const std::array<std::string_view, N>& names,
+                              std::string_view name) {
+  for (size_t i = 0; i < N; ++i) {
+    if (names[i] == name) {
+      return static_cast<Enum>(i);
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace detail
+
+[[nodiscard]] inline std::string_view cardName(CardEnum card) {
+  return CARD_NAMES[static_cast<size_t>(card)];
+}
+[[nodiscard]] inline std::string_view countryName(CountryEnum country) {
+  return COUNTRY_NAMES[static_cast<size_t>(country)];
+}
+[[nodiscard]] inline std::string_view stateTypeName(StateType state) {
+  return STATE_TYPE_NAMES[static_cast<size_t>(state)];
+}
+[[nodiscard]] inline std::string_view sideName(Side side) {
+  return SIDE_NAMES[static_cast<size_t>(side)];
+}
+
+// 名前から列挙子を引く。知らない名前ならstd::nullopt。
+[[nodiscard]] inline std::optional<CardEnum> parseCardName(
+    std::string_view name) {
+  return detail::parseName<CardEnum>(CARD_NAMES, name);
+}
+[[nodiscard]] inline std::optional<CountryEnum> parseCountryName(
+    std::string_view name) {
+  return detail::parseName<CountryEnum>(COUNTRY_NAMES, name);
+}
+[[nodiscard]] inline std::optional<StateType> parseStateTypeName(
+    std::string_view name) {
+  return detail::parseName<StateType>(STATE_TYPE_NAMES, name);
+}
+[[nodiscard]] inline std::optional<Side> parseSideName(std::string_view name) {
+  return detail::parseName<Side>(SIDE_NAMES, name);
+}
+
+}  // namespace tsge
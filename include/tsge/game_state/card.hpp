@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,13 @@ class Card {
                                         const Board& board) const = 0;
   [[nodiscard]]
   virtual bool canEvent(const Board& board) const = 0;
+  // eventが積んだRequestDescriptor::cardEventの入力要求に対する合法手。
+  // sideは要求先、valueはイベントが記録した段階や数量。
+  [[nodiscard]]
+  virtual std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& /*board*/, Side /*side*/, int /*value*/) const {
+    return {};
+  }
   [[nodiscard]]
   int getOps() const {
     return ops_;
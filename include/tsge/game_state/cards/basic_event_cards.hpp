@@ -59,6 +59,9 @@ class Comecon final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class Decolonization final : public Card {
@@ -70,6 +73,9 @@ class Decolonization final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class ColonialRearGuards final : public Card {
@@ -81,6 +87,9 @@ class ColonialRearGuards final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class PuppetGovernments final : public Card {
@@ -92,6 +101,9 @@ class PuppetGovernments final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class OASFounded final : public Card {
@@ -103,6 +115,9 @@ class OASFounded final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class LiberationTheology final : public Card {
@@ -114,6 +129,9 @@ class LiberationTheology final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class WarsawPactFormed final : public Card {
@@ -125,6 +143,9 @@ class WarsawPactFormed final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class MarshallPlan final : public Card {
@@ -136,6 +157,9 @@ class MarshallPlan final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class UssuriRiverSkirmish final : public Card {
@@ -147,6 +171,9 @@ class UssuriRiverSkirmish final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class TheReformer final : public Card {
@@ -158,6 +185,9 @@ class TheReformer final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class SpecialRelationship final : public Card {
@@ -169,6 +199,9 @@ class SpecialRelationship final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class SouthAfricanUnrest final : public Card {
@@ -180,6 +213,9 @@ class SouthAfricanUnrest final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class Junta final : public Card {
@@ -191,6 +227,9 @@ class Junta final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class SocialistGovernments final : public Card {
@@ -202,6 +241,9 @@ class SocialistGovernments final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class TheVoiceOfAmerica final : public Card {
@@ -213,6 +255,9 @@ class TheVoiceOfAmerica final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class MarineBarracksBombing final : public Card {
@@ -224,6 +269,9 @@ class MarineBarracksBombing final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class SuezCrisis final : public Card {
@@ -235,6 +283,9 @@ class SuezCrisis final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class EastEuropeanUnrest final : public Card {
@@ -246,6 +297,9 @@ class EastEuropeanUnrest final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class PershingIIDeployed final : public Card {
@@ -257,6 +311,9 @@ class PershingIIDeployed final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
 
 class MuslimRevolution final : public Card {
@@ -268,4 +325,7 @@ class MuslimRevolution final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
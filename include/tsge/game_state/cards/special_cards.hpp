@@ -15,4 +15,7 @@ class DeStainization final : public Card {
   std::vector<CommandPtr> event(Side side, const Board& board) const override;
   [[nodiscard]]
   bool canEvent(const Board& board) const override;
+  [[nodiscard]]
+  std::vector<std::shared_ptr<Move>> requestLegalMoves(
+      const Board& board, Side side, int value) const override;
 };
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "tsge/enums/cards_enum.hpp"
@@ -19,6 +20,19 @@ class Deck {
     discardPile_.reserve(111);
     removedCards_.reserve(111);
   }
+  // Boardのコピー/ムーブ用。山札の内容を引き継ぎ、シャッフルはコピー先のRandomizerで行う。
+  Deck(const Deck& other, Randomizer& randomizer)
+      : randomizer_{randomizer},
+        cardpool_{other.cardpool_},
+        deck_{other.deck_},
+        discardPile_{other.discardPile_},
+        removedCards_{other.removedCards_} {}
+  Deck(Deck&& other, Randomizer& randomizer) noexcept
+      : randomizer_{randomizer},
+        cardpool_{other.cardpool_},
+        deck_{std::move(other.deck_)},
+        discardPile_{std::move(other.discardPile_)},
+        removedCards_{std::move(other.removedCards_)} {}
 
   void reshuffleFromDiscard();
   void addEarlyWarCards() { addCardsByWarPeriod(WarPeriod::EARLY_WAR); }
@@ -49,6 +49,10 @@ class SpaceTrack {
   }
   void spaceTried(Side side) { spaceTried_[static_cast<std::size_t>(side)]++; }
   [[nodiscard]]
+  int getSpaceTried(Side side) const {
+    return spaceTried_[static_cast<std::size_t>(side)];
+  }
+  [[nodiscard]]
   int getRollMax(Side side) const {
     const int space_pos = spaceTrack_[static_cast<std::size_t>(side)];
     // SpaceTrack position 8 has no rollMax (game ends), return 0
@@ -67,6 +71,9 @@ class SpaceTrack {
   }
 
  private:
+  // Board::deserializeがスナップショットから直接書き戻す
+  friend class Board;
+
   std::array<int, 2> spaceTrack_ = {0, 0};
   std::array<int, 2> spaceTried_ = {0, 0};
   static constexpr std::array<std::array<int, 2>, 8> SPACE_VPS = {
@@ -85,6 +92,8 @@ class DefconTrack {
   }
 
  private:
+  friend class Board;
+
   int defcon_ = 5;
 };
 
@@ -105,6 +114,8 @@ class MilopsTrack {
   }
 
  private:
+  friend class Board;
+
   std::array<int, 2> milopsTrack_ = {0, 0};
 };
 
@@ -127,6 +138,8 @@ class TurnTrack {
   }
 
  private:
+  friend class Board;
+
   int turn_ = 1;
   std::array<int, 10> dealedCards_ = {8, 8, 8, 9, 9, 9, 9, 9, 9, 9};
 };
@@ -188,6 +201,8 @@ class ActionRoundTrack {
   }
 
  private:
+  friend class Board;
+
   std::array<int, 2> actionRound_ = {0, 0};
   std::array<int, 10> actionRoundsByTurn_ = {6, 6, 6, 7, 7, 7, 7, 7, 7, 7};
   std::array<bool, 2> extraActionRound_ = {false, false};
@@ -0,0 +1,107 @@
+// ファイル: include/tsge/players/any_policy.hpp
+// 役割:
+// DecisionPolicyを満たす任意のポリシーを型消去して保持し、実行時の設定でポリシーを選べるようにする。
+// 背景:
+// Game<P1, P2>は手ごとの呼び出しを静的に解決するが、コマンドライン引数などで組み合わせを決めたい場面では型を固定できないため。
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tsge/players/player.hpp"
+
+// AnyPolicy: ポリシーをヒープに置き、仮想関数1回で呼び出す。自身もDecisionPolicyを満たす。
+// 大量の対局を回す経路ではGame<P1, P2>に具体的な型を渡し、この間接呼び出しを避ける。
+class AnyPolicy {
+ public:
+  // 自身の型を先に除外し、ムーブ可能かの判定が自分自身へ再帰しないようにする
+  template <typename Policy>
+    requires(!std::is_same_v<std::remove_cvref_t<Policy>, AnyPolicy> &&
+             DecisionPolicy<std::remove_cvref_t<Policy>>)
+  explicit AnyPolicy(Policy&& policy)
+      : model_{std::make_unique<Model<std::remove_cvref_t<Policy>>>(
+            std::forward<Policy>(policy))} {}
+
+  std::shared_ptr<Move> decideMove(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) {
+    if (!model_) {
+      throw std::logic_error("AnyPolicy: moved-from policy");
+    }
+    return model_->decideMove(board, legal_moves, side);
+  }
+
+  // 添字を返すポリシーならその添字を、手を返すポリシーなら合法手中の位置を返す。
+  std::size_t decideMoveIndex(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) {
+    if (!model_) {
+      throw std::logic_error("AnyPolicy: moved-from policy");
+    }
+    return model_->decideMoveIndex(board, legal_moves, side);
+  }
+
+  void observeMove(const Board& board, const Move& move) {
+    if (model_) {
+      model_->observeMove(board, move);
+    }
+  }
+
+  // 保持しているポリシーがPolicy型ならそのポインタ、違えばnullptr。
+  template <typename Policy>
+  [[nodiscard]] Policy* target() {
+    auto* model = dynamic_cast<Model<Policy>*>(model_.get());
+    return model != nullptr ? &model->player.getPolicy() : nullptr;
+  }
+
+ private:
+  struct Concept {
+    Concept() = default;
+    virtual ~Concept() = default;
+    Concept(const Concept&) = delete;
+    Concept& operator=(const Concept&) = delete;
+    Concept(Concept&&) = delete;
+    Concept& operator=(Concept&&) = delete;
+
+    virtual std::shared_ptr<Move> decideMove(
+        const Board& board,
+        const std::vector<std::shared_ptr<Move>>& legal_moves, Side side) = 0;
+    virtual std::size_t decideMoveIndex(
+        const Board& board,
+        const std::vector<std::shared_ptr<Move>>& legal_moves, Side side) = 0;
+    virtual void observeMove(const Board& board, const Move& move) = 0;
+  };
+
+  // 観測の有無や引数の違いはPlayerに吸収させる
+  template <typename Policy>
+  struct Model final : Concept {
+    explicit Model(Policy&& policy) : player{std::move(policy)} {}
+
+    std::shared_ptr<Move> decideMove(
+        const Board& board,
+        const std::vector<std::shared_ptr<Move>>& legal_moves,
+        Side side) override {
+      return player.decideMove(board, legal_moves, side);
+    }
+    std::size_t decideMoveIndex(
+        const Board& board,
+        const std::vector<std::shared_ptr<Move>>& legal_moves,
+        Side side) override {
+      return player.decideMoveIndex(board, legal_moves, side);
+    }
+    void observeMove(const Board& board, const Move& move) override {
+      player.observeMove(board, move);
+    }
+
+    Player<Policy> player;
+  };
+
+  std::unique_ptr<Concept> model_;
+};
+
+static_assert(DecisionPolicy<AnyPolicy>);
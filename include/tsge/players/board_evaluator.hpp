@@ -0,0 +1,106 @@
+// ファイル: include/tsge/players/board_evaluator.hpp
+// 役割:
+// プレイアウトを打ち切った盤面に値を付ける静的評価関数の差し替え口と、手作りの線形評価関数を定義する。
+// 背景:
+// 100手のランダムロールアウトとVPだけの打ち切り評価は遅く荒いため、地域得点やDEFCONなどの特徴量で早めに打ち切る。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <istream>
+#include <string>
+
+#include "tsge/core/board.hpp"
+
+namespace mcts {
+
+// BoardEvaluator: 盤面のside視点の評価値を[-1, 1]で返す。
+// 探索スレッドから同時に呼ぶため、evaluateは状態を変更しない。
+class BoardEvaluator {
+ public:
+  BoardEvaluator() = default;
+  virtual ~BoardEvaluator() = default;
+  BoardEvaluator(const BoardEvaluator&) = delete;
+  BoardEvaluator& operator=(const BoardEvaluator&) = delete;
+  BoardEvaluator(BoardEvaluator&&) = delete;
+  BoardEvaluator& operator=(BoardEvaluator&&) = delete;
+
+  [[nodiscard]]
+  virtual double evaluate(const Board& board, Side side) const = 0;
+};
+
+// VpBoardEvaluator: tanh(VP / 10)。従来のロールアウト打ち切り時の評価。
+class VpBoardEvaluator final : public BoardEvaluator {
+ public:
+  [[nodiscard]] double evaluate(const Board& board, Side side) const override;
+};
+
+// EvaluationFeatures: 評価に使う特徴量。値は全てUSSR視点(USSR有利で正)。
+// refreshで全体を作り直し、影響力が変わった国だけならrefreshCountryで該当地域だけを更新できる。
+struct EvaluationFeatures {
+  // 地域得点を計算する6地域(Board::finalScoringと同じ並び)
+  static constexpr std::array<Region, 6> REGIONS = {
+      Region::EUROPE, Region::ASIA,          Region::MIDDLE_EAST,
+      Region::AFRICA, Region::SOUTH_AMERICA, Region::CENTRAL_AMERICA};
+
+  int vp = 0;
+  // Board::scoreRegionの値。欧州支配(即勝利)のような極端な値は±REGION_SCORE_LIMITに丸める。
+  std::array<int, REGIONS.size()> region_scores{};
+  int battlegrounds = 0;  // 支配しているバトルグラウンド数の差
+  int defcon = 5;
+  // ターン終了時の軍事行動不足によるVP失点の差(USA側の失点 - USSR側の失点)
+  int milops_penalty = 0;
+  int space = 0;     // 宇宙開発トラックの位置の差
+  int turn = 1;
+  int hand_ops = 0;  // 手札のOps合計の差
+  // チャイナカードの所有(USSR: +1, USA: -1)。裏向きなら半分
+  double china_card = 0.0;
+
+  static constexpr int REGION_SCORE_LIMIT = 10;
+
+  void refresh(const Board& board);
+  // countryの影響力だけが変わったときに、それを含む地域の得点とバトルグラウンド数を直す。
+  void refreshCountry(const Board& board, CountryEnum country,
+                      Side previous_control);
+  // VP・トラック・手札などの地図以外の特徴量だけを直す。
+  void refreshScalars(const Board& board);
+};
+
+// 線形評価の重み。合計をscaleで割ってtanhで[-1, 1]へ写す。
+// ターンが進むほど同じ差でも決定的になるため、turn_sharpnessで後半ほど尖らせる。
+struct HeuristicEvaluatorWeights {
+  double vp = 1.0;
+  double region_score = 0.5;
+  double battlegrounds = 0.6;
+  double milops_penalty = 0.5;
+  double space = 0.3;
+  double hand_ops = 0.1;
+  double china_card = 1.0;
+  double scale = 10.0;
+  double turn_sharpness = 0.1;
+
+  // "名前 値"の行を読む。空行と#以降は無視する。未知の名前や数値でない値はstd::runtime_error。
+  static HeuristicEvaluatorWeights parse(std::istream& input);
+  static HeuristicEvaluatorWeights loadFromFile(const std::string& path);
+};
+
+// HeuristicBoardEvaluator: EvaluationFeaturesの線形和による評価関数。
+class HeuristicBoardEvaluator final : public BoardEvaluator {
+ public:
+  explicit HeuristicBoardEvaluator(HeuristicEvaluatorWeights weights = {});
+
+  [[nodiscard]] double evaluate(const Board& board, Side side) const override;
+  // 既に計算済みの特徴量から評価する(差分更新と組み合わせる場合)。
+  [[nodiscard]] double evaluate(const EvaluationFeatures& features,
+                                Side side) const;
+
+  [[nodiscard]] const HeuristicEvaluatorWeights& getWeights() const {
+    return weights_;
+  }
+
+ private:
+  HeuristicEvaluatorWeights weights_;
+};
+
+}  // namespace mcts
@@ -0,0 +1,134 @@
+// ファイル: include/tsge/players/cpu_mlp_engine.hpp
+// 役割:
+// 全結合(残差接続付き可)の小さなネットワークを重みファイルから読み込み、CPUだけでバッチ推論するTsNnMctsInferenceEngine実装を提供する。
+// 背景:
+// 外部ランタイムの無いCPUノードでも自己対戦と評価を回せるよう、量子化重みとAVX2/FMAのGEMMを内蔵する。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "tsge/players/tsnnmcts.hpp"
+
+// CpuMlpWeightType: 重みの格納形式。BFLOAT16は上位16bitだけのfloat、INT8は出力行ごとのスケール付き。
+enum class CpuMlpWeightType : uint8_t {
+  FLOAT32 = 0,
+  BFLOAT16 = 1,
+  INT8 = 2,
+};
+
+enum class CpuMlpActivation : uint8_t {
+  NONE = 0,
+  RELU = 1,
+};
+
+// CpuMlpKernelIsa: GEMMカーネルの実装系統。
+enum class CpuMlpKernelIsa : uint8_t {
+  SCALAR,
+  AVX2_FMA,
+};
+
+// activeCpuMlpKernelIsa: 実行中CPUで利用可能な最速の実装(初回呼び出しで判定しキャッシュ)。
+[[nodiscard]] CpuMlpKernelIsa activeCpuMlpKernelIsa();
+[[nodiscard]] bool isCpuMlpKernelIsaSupported(CpuMlpKernelIsa isa);
+
+// CpuMlpLayer: 全結合1層。y = act(W x + b) (+ x: residualかつ入出力が同じ幅のとき)。
+// 重みは出力行ごとに連続した(outputs × inputs)の行列で、typeに応じた配列だけを使う。
+struct CpuMlpLayer {
+  uint32_t inputs = 0;
+  uint32_t outputs = 0;
+  CpuMlpWeightType type = CpuMlpWeightType::FLOAT32;
+  CpuMlpActivation activation = CpuMlpActivation::NONE;
+  bool residual = false;
+  std::vector<float> weights_f32;
+  std::vector<uint16_t> weights_bf16;
+  std::vector<int8_t> weights_i8;
+  std::vector<float> scales;  // INT8の出力行ごとのスケール
+  std::vector<float> bias;
+
+  // float重みの層を指定形式へ量子化した複製を返す。INT8は行ごとの最大絶対値を127へ写す。
+  [[nodiscard]] CpuMlpLayer quantized(CpuMlpWeightType target) const;
+};
+
+// CpuMlpModel: 胴体の層列と、方策ヘッド・価値ヘッド(出力1、tanh)からなるネットワーク。
+//
+// 重みファイル(リトルエンディアン):
+//   "TSMP" / uint32 version(=1) / uint32 層数(胴体 + 2)
+//   層ごとに uint32 inputs, uint32 outputs, uint8 type, uint8 activation,
+//   uint8 residual, uint8 予約(0), 重み(type形式でoutputs×inputs),
+//   INT8ならfloat scales[outputs], float bias[outputs]
+//   最後の2層が方策ヘッドと価値ヘッド。
+class CpuMlpModel {
+ public:
+  static constexpr uint32_t FILE_VERSION = 1;
+
+  // 層の幅が繋がらない場合はstd::invalid_argument。
+  CpuMlpModel(std::vector<CpuMlpLayer> trunk, CpuMlpLayer policy_head,
+              CpuMlpLayer value_head);
+
+  // 形式が壊れている場合はstd::runtime_error。
+  static CpuMlpModel parse(std::istream& input);
+  static CpuMlpModel loadFromFile(const std::string& path);
+  void save(std::ostream& output) const;
+
+  // forward: batch個の入力(batch × getInputSize()、行優先)を評価する。
+  // policy_logitsはbatch × getPolicySize()、valuesはbatch個を書き込む。
+  void forward(std::span<const float> inputs, size_t batch,
+               std::span<float> policy_logits, std::span<float> values) const;
+  void forward(std::span<const float> inputs, size_t batch,
+               std::span<float> policy_logits, std::span<float> values,
+               CpuMlpKernelIsa isa) const;
+
+  [[nodiscard]] size_t getInputSize() const;
+  [[nodiscard]] size_t getPolicySize() const { return policy_head_.outputs; }
+  [[nodiscard]] const std::vector<CpuMlpLayer>& getTrunk() const {
+    return trunk_;
+  }
+
+ private:
+  std::vector<CpuMlpLayer> trunk_;
+  CpuMlpLayer policy_head_;
+  CpuMlpLayer value_head_;
+};
+
+// 盤面をside視点の入力特徴量へ書き込む関数。outの長さはモデルの入力幅。
+using CpuMlpFeatureFn =
+    std::function<void(const Board& board, Side side, std::span<float> out)>;
+// 手を方策ヘッドの添字へ写す関数。policy_size以上を返した手にはロジット0を使う。
+using CpuMlpMoveIndexFn =
+    std::function<size_t(const Move& move, size_t policy_size)>;
+
+// CpuMlpInferenceEngine: CpuMlpModelで盤面を評価し、方策ロジットをlegal_movesの順へ並べ替えてsoftmaxする。
+// evaluate/evaluateBatchは複数スレッドから同時に呼べる(作業領域はスレッドごと)。
+class CpuMlpInferenceEngine final : public TsNnMctsInferenceEngine {
+ public:
+  // features省略時はFeatureEncoder(入力幅FeatureEncoder::SIZE)を使う。
+  // move_index省略時は方策ヘッドをActionIndexの手順ごとのロジットと見た分解方策の事前確率を使う:
+  // 合法手に現れる手順の集合でsoftmaxした確率を、手のActionIndex::influenceStepsの全手順で掛け合わせる。
+  // 影響力の配置・除去で最初の手順が同じでも、パターンが違えば事前確率も違う。
+  explicit CpuMlpInferenceEngine(std::shared_ptr<const CpuMlpModel> model,
+                                 CpuMlpFeatureFn features = {},
+                                 CpuMlpMoveIndexFn move_index = {});
+
+  [[nodiscard]] TsNnMctsInferenceResult evaluate(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) override;
+
+  [[nodiscard]] std::vector<TsNnMctsInferenceResult> evaluateBatch(
+      std::span<const Board* const> boards,
+      std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+      std::span<const Side> sides) override;
+
+ private:
+  std::shared_ptr<const CpuMlpModel> model_;
+  CpuMlpFeatureFn features_;
+  CpuMlpMoveIndexFn move_index_;
+};
@@ -0,0 +1,120 @@
+// ファイル: include/tsge/players/determinization.hpp
+// 役割:
+// 探索側から見えないカードの集合をビット集合で求め、(相手の手札, 山札の並び)を同時に標本化する。
+// 背景:
+// 捨て札を相手の手札候補に含めるなど決定化の母集団が誤っていたうえ、探索1回に1度しか作れない速度だったため、
+// MCTSの反復ごとに正しい決定化を作れるようにする。
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+
+namespace mcts {
+
+// CardSet: CardEnum(0〜110)を2語のビット集合で表す。
+class CardSet {
+ public:
+  static constexpr size_t CAPACITY = 111;
+
+  void set(CardEnum card) {
+    const auto index = static_cast<size_t>(card);
+    words_[index / 64] |= uint64_t{1} << (index % 64);
+  }
+  void reset(CardEnum card) {
+    const auto index = static_cast<size_t>(card);
+    words_[index / 64] &= ~(uint64_t{1} << (index % 64));
+  }
+  [[nodiscard]] bool test(CardEnum card) const {
+    const auto index = static_cast<size_t>(card);
+    return ((words_[index / 64] >> (index % 64)) & 1U) != 0;
+  }
+  [[nodiscard]] size_t count() const {
+    return static_cast<size_t>(std::popcount(words_[0]) +
+                               std::popcount(words_[1]));
+  }
+  [[nodiscard]] bool empty() const { return (words_[0] | words_[1]) == 0; }
+
+  CardSet& operator|=(const CardSet& other) {
+    words_[0] |= other.words_[0];
+    words_[1] |= other.words_[1];
+    return *this;
+  }
+  // 差集合 (this AND NOT other)
+  CardSet& subtract(const CardSet& other) {
+    words_[0] &= ~other.words_[0];
+    words_[1] &= ~other.words_[1];
+    return *this;
+  }
+  [[nodiscard]] CardSet intersect(const CardSet& other) const {
+    CardSet result;
+    result.words_ = {words_[0] & other.words_[0], words_[1] & other.words_[1]};
+    return result;
+  }
+  bool operator==(const CardSet&) const = default;
+
+  // 立っているビットをCardEnumの昇順でoutへ追加する。
+  void appendTo(std::vector<CardEnum>& out) const {
+    for (size_t word = 0; word < words_.size(); ++word) {
+      uint64_t bits = words_[word];
+      while (bits != 0) {
+        const auto bit = static_cast<size_t>(std::countr_zero(bits));
+        out.push_back(static_cast<CardEnum>(word * 64 + bit));
+        bits &= bits - 1;
+      }
+    }
+  }
+
+ private:
+  std::array<uint64_t, 2> words_{};
+};
+
+// DeterminizationConstraints: 相手の手札に関する既知情報。
+// - opponent_must_hold: 相手が持っていると分かっているカード(見えないカードに含まれるもののみ有効)。
+// - opponent_cannot_hold: 相手の手札には無いと分かっているカード。山札側に配る。
+// - hand_weights: 残りの手札枠を埋めるときの相対的な重み。空なら一様。
+struct DeterminizationConstraints {
+  CardSet opponent_must_hold;
+  CardSet opponent_cannot_hold;
+  std::vector<double> hand_weights;
+};
+
+// DeterminizationSampler: 盤面と視点ごとに母集団を1度だけ求め、sampleを何度でも安く呼べるようにする。
+class DeterminizationSampler {
+ public:
+  DeterminizationSampler(const Board& board, Side viewer,
+                         DeterminizationConstraints constraints = {});
+
+  // computeUnseen: viewerから見えないカードの集合。
+  // 現在の戦期までの全カードから、自分の手札・捨て札・除外カード・中国カード・
+  // 見えているヘッドラインと処理中のイベントを除いたもの。
+  [[nodiscard]]
+  static CardSet computeUnseen(const Board& board, Side viewer);
+
+  // sample: 相手の手札と、残りを無作為に並べた山札を書き出す。
+  void sample(std::mt19937_64& rng, std::vector<CardEnum>& opponent_hand,
+              std::vector<CardEnum>& deck) const;
+
+  // apply: boardの相手の手札と山札を標本で置き換える。
+  void apply(Board& board, std::mt19937_64& rng) const;
+
+  [[nodiscard]] const CardSet& getUnseen() const { return unseen_; }
+  [[nodiscard]] Side getOpponent() const { return opponent_; }
+  [[nodiscard]] size_t getOpponentHandSize() const { return hand_size_; }
+
+ private:
+  Side opponent_;
+  size_t hand_size_;
+  CardSet unseen_;
+  std::vector<CardEnum> required_;   // 必ず手札に入れるカード
+  std::vector<CardEnum> candidates_;  // 残りの手札枠の候補
+  std::vector<CardEnum> deck_only_;   // 山札にしか置けないカード
+  std::vector<double> weights_;       // candidates_と同じ順の重み。空なら一様
+};
+
+}  // namespace mcts
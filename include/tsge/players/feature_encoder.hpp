@@ -0,0 +1,85 @@
+// ファイル: include/tsge/players/feature_encoder.hpp
+// 役割:
+// 盤面を視点プレイヤーから見た固定レイアウトの特徴量(整数値)へ変換し、呼び出し側のfloat/int8バッファへ書き込む。
+// 背景:
+// 学習済み評価器ごとにWorldMap・トラック・手札を個別に走査させず、版付きの1つのレイアウトを共有するため。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "tsge/core/board.hpp"
+#include "tsge/utils/work_stealing_pool.hpp"
+
+// FeatureEncoder: 版VERSIONの特徴量レイアウト。値は全て±127に丸めた整数で、float版とint8版は同じ値を持つ。
+// 書き込みは呼び出し側のバッファだけで行う。encodeとpoolを渡さないencodeBatchはメモリ確保をしない。
+//
+// レイアウト(SIZE要素):
+//   [COUNTRY_OFFSET, TRACK_OFFSET)  国の面。面pの国iは COUNTRY_OFFSET + p * COUNTRY_COUNT + i
+//     OWN_INFLUENCE / OPPONENT_INFLUENCE  影響力
+//     OWN_CONTROL / OPPONENT_CONTROL      支配していれば1
+//     STABILITY                           安定度
+//     BATTLEGROUND                        バトルグラウンドなら1
+//     REGION_FIRST + r                    Region r(0..9)に属していれば1
+//   [TRACK_OFFSET, HAND_OFFSET)     TrackFeatureの順のトラック・手番・チャイナカード
+//   [HAND_OFFSET, SIZE)             視点プレイヤーの手札にCardEnum cがあれば HAND_OFFSET + c が1
+class FeatureEncoder {
+ public:
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t COUNTRY_COUNT = 86;
+  static constexpr size_t REGION_COUNT = 10;
+  static constexpr size_t CARD_COUNT = 111;
+
+  enum CountryPlane : size_t {
+    OWN_INFLUENCE = 0,
+    OPPONENT_INFLUENCE,
+    OWN_CONTROL,
+    OPPONENT_CONTROL,
+    STABILITY,
+    BATTLEGROUND,
+    REGION_FIRST,
+  };
+  static constexpr size_t COUNTRY_PLANES = REGION_FIRST + REGION_COUNT;
+
+  enum TrackFeature : size_t {
+    VP = 0,  // 視点プレイヤーが有利なら正
+    DEFCON,
+    OWN_MILOPS,
+    OPPONENT_MILOPS,
+    OWN_SPACE,
+    OPPONENT_SPACE,
+    TURN,
+    OWN_ACTION_ROUND,
+    OPPONENT_ACTION_ROUND,
+    VIEWER_IS_USSR,
+    VIEWER_TO_MOVE,  // 現在のアクションラウンドの手番が視点プレイヤーなら1
+    OWN_CHINA_CARD,
+    OPPONENT_CHINA_CARD,
+    CHINA_CARD_FACE_UP,
+    OWN_HAND_SIZE,
+    OPPONENT_HAND_SIZE,
+    TRACK_FEATURES,
+  };
+
+  static constexpr size_t COUNTRY_OFFSET = 0;
+  static constexpr size_t TRACK_OFFSET =
+      COUNTRY_OFFSET + (COUNTRY_PLANES * COUNTRY_COUNT);
+  static constexpr size_t HAND_OFFSET = TRACK_OFFSET + TRACK_FEATURES;
+  static constexpr size_t SIZE = HAND_OFFSET + CARD_COUNT;
+
+  // outはSIZE要素以上。viewerはUSSRかUSA。
+  static void encode(const Board& board, Side viewer, float* out);
+  static void encode(const Board& board, Side viewer, int8_t* out);
+
+  // i番目の盤面をout + i * SIZEへ書き込む。poolを渡すと盤面を連続区間に分け、
+  // 先頭の区間を呼び出しスレッドで、残りをpoolのワーカーで処理する。
+  // 区間の投入ごとに仕事を1つ確保し、終わりはpool.wait()で待つので、poolは他の仕事と共有しないこと。
+  static void encodeBatch(std::span<const Board* const> boards,
+                          std::span<const Side> viewers, float* out,
+                          WorkStealingPool* pool = nullptr);
+  static void encodeBatch(std::span<const Board* const> boards,
+                          std::span<const Side> viewers, int8_t* out,
+                          WorkStealingPool* pool = nullptr);
+};
@@ -0,0 +1,68 @@
+// ファイル: include/tsge/players/hand_belief.hpp
+// 役割:
+// 観測した相手の手から相手の手札に対するカードごとの尤度重みを更新し、周辺確率と重み付き決定化の制約を出す。
+// 背景:
+// 一様な決定化ではありそうにない手札の世界にも探索が等しく割かれるため、観測済みの振る舞いで母集団を偏らせる。
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "tsge/actions/move.hpp"
+#include "tsge/core/board.hpp"
+#include "tsge/players/determinization.hpp"
+
+namespace mcts {
+
+// HandBeliefModel: 観測1回ごとに掛ける尤度比。1.0なら情報なしとして扱う。
+struct HandBeliefModel {
+  // Ops利用の手で使われたカードよりOpsが1大きいごとに掛ける(強いカードを温存していない仮定)。
+  double ops_dominance = 0.85;
+  // 相手側のイベントを持つカードを相手がOpsで使ったとき、
+  // 同じOps以上の自陣営・中立カードに追加で掛ける(より良い選択肢が無かった仮定)。
+  double gave_away_event = 0.8;
+  // スコアリングカード以外をヘッドラインにしたとき、スコアリングカードに掛ける。
+  double headline_without_scoring = 0.7;
+  // スコアリングカードを保持している確率の下限倍率(最終ラウンドで出さなかった場合など)。
+  double scoring_floor = 0.05;
+  // ターンが変わったとき、前ターンまでの証拠を残す割合。残りは新しく引いたカードとして一様に戻す。
+  double carry_over = 0.25;
+};
+
+// OpponentHandBelief: viewerから見た相手の手札の信念。
+// 手札の組み合わせ全体ではなくカードごとの独立な重みで近似し、1手あたりO(カード数)で更新する。
+// メンバは固定長配列だけなので、探索スレッドへ安価に値コピーできる。
+class OpponentHandBelief {
+ public:
+  explicit OpponentHandBelief(Side viewer, HandBeliefModel model = {});
+
+  // observe: moveが適用される直前の盤面とその手を渡す。viewer自身の手は無視する。
+  void observe(const Board& board, const Move& move);
+
+  // marginals: 各カードが相手の手札にある確率。見えるカードは0。
+  // 重みw_cに対しp_c = w_c * t / (1 + w_c * t)とし、合計が手札枚数になるtを二分法で求める。
+  [[nodiscard]]
+  std::array<double, CardSet::CAPACITY> marginals(const Board& board) const;
+
+  // toConstraints: DeterminizationSamplerの重み付き標本化に渡す制約。
+  [[nodiscard]] DeterminizationConstraints toConstraints() const;
+
+  [[nodiscard]] double getWeight(CardEnum card) const {
+    return weights_[static_cast<size_t>(card)];
+  }
+  [[nodiscard]] Side getViewer() const { return viewer_; }
+
+ private:
+  void onTurn(int turn);
+  void observeActionRound(const Board& board, CardEnum played);
+  void observeOpsPlay(const Board& board, CardEnum played);
+  void observeHeadline(const Board& board, CardEnum played);
+
+  Side viewer_;
+  HandBeliefModel model_;
+  std::array<float, CardSet::CAPACITY> weights_;
+  int turn_ = 0;
+};
+
+}  // namespace mcts
@@ -0,0 +1,98 @@
+// ファイル: include/tsge/players/inference_cache.hpp
+// 役割:
+// 推論器の前段に置くシャード分割LRUキャッシュ。手番側から見える盤面と合法手列が同じなら推論結果を再利用する。
+// 背景:
+// 手順違いの合流、同じ観測状態に落ちる決定化、部分木再利用後の再探索が同一局面を何度も評価していたため。
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "tsge/players/tsnnmcts.hpp"
+
+// InferenceCacheConfig: キャッシュ容量とロック分割数。
+// 容量はシャードへ均等に割り振り、各シャードは最後に使われてから最も古い項目を追い出す(LRU)。
+struct InferenceCacheConfig {
+  size_t capacity = 1U << 16U;
+  size_t num_shards = 16;
+};
+
+// InferenceCacheStats: 参照回数と追い出し回数の集計。
+struct InferenceCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  size_t size = 0;
+
+  [[nodiscard]] double hitRate() const {
+    const uint64_t lookups = hits + misses;
+    return lookups > 0
+               ? static_cast<double>(hits) / static_cast<double>(lookups)
+               : 0.0;
+  }
+};
+
+// InferenceCacheKey: 手番側の観測ハッシュと合法手列ハッシュの組。
+struct InferenceCacheKey {
+  uint64_t board_hash = 0;
+  uint64_t legal_moves_hash = 0;
+
+  bool operator==(const InferenceCacheKey&) const = default;
+};
+
+// hashLegalMoves: Move::getKeyを順に混ぜる。policyは合法手の並びに対応するため順序も区別する。
+[[nodiscard]]
+uint64_t hashLegalMoves(const std::vector<std::shared_ptr<Move>>& legal_moves);
+
+// CachedInferenceEngine: 任意の推論器を包むデコレータ。複数スレッドから同時に呼べる。
+class CachedInferenceEngine final : public TsNnMctsInferenceEngine {
+ public:
+  CachedInferenceEngine(std::shared_ptr<TsNnMctsInferenceEngine> inner,
+                        InferenceCacheConfig config = {});
+
+  [[nodiscard]]
+  TsNnMctsInferenceResult evaluate(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) override;
+
+  // evaluateBatch: キャッシュに無い葉だけを重複を除いて内側の推論器へまとめて渡す。
+  [[nodiscard]]
+  std::vector<TsNnMctsInferenceResult> evaluateBatch(
+      std::span<const Board* const> boards,
+      std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+      std::span<const Side> sides) override;
+
+  [[nodiscard]] InferenceCacheStats getStats() const;
+  void clear();
+
+ private:
+  struct KeyHash {
+    size_t operator()(const InferenceCacheKey& key) const;
+  };
+  using Entry = std::pair<InferenceCacheKey, TsNnMctsInferenceResult>;
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> entries;  // 先頭が最近使われた項目
+    std::unordered_map<InferenceCacheKey, std::list<Entry>::iterator, KeyHash>
+        index;
+  };
+
+  Shard& shardFor(const InferenceCacheKey& key);
+  std::optional<TsNnMctsInferenceResult> lookup(const InferenceCacheKey& key);
+  void insert(const InferenceCacheKey& key,
+              const TsNnMctsInferenceResult& result);
+
+  std::shared_ptr<TsNnMctsInferenceEngine> inner_;
+  size_t shard_capacity_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
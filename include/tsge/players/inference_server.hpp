@@ -0,0 +1,125 @@
+// ファイル: include/tsge/players/inference_server.hpp
+// 役割:
+// 複数の対局(TsNnMctsController)から届く葉評価要求を集約し、評価スレッドが動的バッチで推論器へ渡す。
+// 背景:
+// 対局ごとのバッチは小さく、CPU推論バックエンドを埋めきれないため、同時進行中の対局をまたいでバッチを作る。
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tsge/players/tsnnmcts.hpp"
+#include "tsge/utils/mpsc_queue.hpp"
+
+// InferenceServerConfig: 評価スレッド数と動的バッチの締め切り条件。
+struct InferenceServerConfig {
+  int num_evaluators = 1;
+  size_t max_batch_size = 64;
+  // 先頭の要求を取り出してからこの時間が経つと、満杯でなくてもバッチを評価する。
+  std::chrono::microseconds batch_timeout{500};
+};
+
+// InferenceServerMetrics: 稼働状況のスナップショット。
+// - batch_fill_rate: 平均バッチサイズ / max_batch_size。
+// - mean/max_queue_latency: 要求の投入から評価開始までの待ち時間。
+// - evaluator_utilization: 評価スレッドが推論器を呼んでいた時間の割合。
+struct InferenceServerMetrics {
+  uint64_t requests = 0;
+  uint64_t batches = 0;
+  double batch_fill_rate = 0.0;
+  std::chrono::microseconds mean_queue_latency{0};
+  std::chrono::microseconds max_queue_latency{0};
+  double evaluator_utilization = 0.0;
+};
+
+// InferenceServer: 要求キューと評価スレッドを所有する推論ブローカー。
+class InferenceServer {
+ public:
+  // errorが空でなければ推論器が投げた例外で、resultは空のまま渡される。
+  using Callback = std::function<void(TsNnMctsInferenceResult&& result,
+                                      std::exception_ptr error)>;
+
+  InferenceServer(std::shared_ptr<TsNnMctsInferenceEngine> backend,
+                  InferenceServerConfig config = {});
+  ~InferenceServer();
+  InferenceServer(const InferenceServer&) = delete;
+  InferenceServer& operator=(const InferenceServer&) = delete;
+  InferenceServer(InferenceServer&&) = delete;
+  InferenceServer& operator=(InferenceServer&&) = delete;
+
+  // submit: 葉評価を非同期に依頼する。完了時に評価スレッド上でon_completeを呼ぶ。
+  // 推論器が例外を投げたら、同じバッチの全要求のon_completeへその例外を渡す。
+  // board/legal_movesはon_completeが呼ばれるまで呼び出し側が生存を保証する。
+  void submit(const Board& board,
+              const std::vector<std::shared_ptr<Move>>& legal_moves, Side side,
+              Callback on_complete);
+
+  [[nodiscard]] InferenceServerMetrics getMetrics() const;
+
+ private:
+  struct Request {
+    const Board* board = nullptr;
+    const std::vector<std::shared_ptr<Move>>* legal_moves = nullptr;
+    Side side = Side::NEUTRAL;
+    Callback on_complete;
+    std::chrono::steady_clock::time_point enqueued_at;
+  };
+
+  void evaluatorLoop();
+  // gatherBatch: キューから最大max_batch_size件を締め切り時間まで集める。
+  void gatherBatch(std::vector<Request>& batch);
+  void waitForArrival(std::chrono::steady_clock::time_point deadline);
+
+  std::shared_ptr<TsNnMctsInferenceEngine> backend_;
+  InferenceServerConfig config_;
+  MpscQueue<Request> queue_;
+  // 未処理要求数。評価スレッドは0の間atomic::waitで眠る。
+  std::atomic<uint64_t> pending_{0};
+  std::atomic<bool> stopping_{false};
+  // MPSCキューの消費者は同時に1スレッドだけにする。
+  std::mutex consumer_mutex_;
+  // バッチ形成中の評価スレッドが締め切りまで眠るための条件変数。
+  // gathering_が立っている間だけsubmitが通知する。
+  std::mutex arrival_mutex_;
+  std::condition_variable arrived_;
+  std::atomic<bool> gathering_{false};
+  std::vector<std::thread> evaluators_;
+
+  std::chrono::steady_clock::time_point started_at_;
+  std::atomic<uint64_t> total_requests_{0};
+  std::atomic<uint64_t> total_batches_{0};
+  std::atomic<int64_t> total_queue_latency_ns_{0};
+  std::atomic<int64_t> max_queue_latency_ns_{0};
+  std::atomic<int64_t> busy_ns_{0};
+};
+
+// InferenceServerClient: InferenceServerを推論器として見せるアダプタ。
+// 各対局のTsNnMctsControllerへ渡すと、evaluateBatchは全要求の完了まで呼び出しスレッドを止める。
+// 推論器が例外を投げた要求があれば、全要求の完了を待ってからその例外を投げ直す。
+class InferenceServerClient final : public TsNnMctsInferenceEngine {
+ public:
+  explicit InferenceServerClient(std::shared_ptr<InferenceServer> server);
+
+  [[nodiscard]]
+  TsNnMctsInferenceResult evaluate(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) override;
+
+  [[nodiscard]]
+  std::vector<TsNnMctsInferenceResult> evaluateBatch(
+      std::span<const Board* const> boards,
+      std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+      std::span<const Side> sides) override;
+
+ private:
+  std::shared_ptr<InferenceServer> server_;
+};
@@ -0,0 +1,101 @@
+// ファイル: include/tsge/players/match_runner.hpp
+// 役割:
+// 陣営ごとに差し替えられるポリシーで1局をPhaseMachineから直接進め、多数の対局をワークスティーリングのスレッドプールで並列に回す。
+// 背景:
+// 自己対戦や強さの比較を回す実行ファイルが無かったため、その中身をライブラリ側に置く。手数上限や1局ごとの計時はGameに無いため、ここで直接進める。
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "tsge/actions/move.hpp"
+#include "tsge/core/board.hpp"
+#include "tsge/core/game_record.hpp"
+
+// MatchPolicy: 対局中の1陣営の指し手を決める。1局ごとに作り直すので対局内の状態を持ってよい。
+class MatchPolicy {
+ public:
+  MatchPolicy() = default;
+  virtual ~MatchPolicy() = default;
+  MatchPolicy(const MatchPolicy&) = delete;
+  MatchPolicy& operator=(const MatchPolicy&) = delete;
+  MatchPolicy(MatchPolicy&&) = delete;
+  MatchPolicy& operator=(MatchPolicy&&) = delete;
+
+  [[nodiscard]] virtual std::shared_ptr<Move> decideMove(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) = 0;
+  // 両陣営の手を適用直前の盤面とともに受け取る(相手の手札の推定などに使う)。
+  virtual void observeMove(const Board& /*board*/, const Move& /*move*/) {}
+};
+
+// 対局の乱数の種から、その対局で使うポリシーを作る。
+using MatchPolicyFactory =
+    std::function<std::unique_ptr<MatchPolicy>(uint64_t seed)>;
+
+// 名前からポリシーを作る。
+//   "random"             一様ランダム
+//   "heuristic"          ルールベースのロールアウトポリシー
+//   "mcts[:iterations]"  MCTSPolicy(1スレッド、既定1000反復)
+// 知らない名前や不正な反復数はstd::invalid_argument。
+[[nodiscard]] MatchPolicyFactory makeMatchPolicy(const std::string& spec);
+
+// MatchResult: 1局の結果。
+struct MatchResult {
+  size_t game_index = 0;
+  uint64_t seed = 0;
+  // 勝者。引き分けはSide::NEUTRAL、手数上限で打ち切った対局はnullopt。
+  std::optional<Side> winner;
+  int final_vp = 0;  // 正ならUSSR優勢
+  int turns = 0;
+  size_t moves = 0;
+  std::chrono::nanoseconds wall_time{0};
+};
+
+struct MatchConfig {
+  size_t games = 1;
+  size_t threads = 1;
+  uint64_t seed = 1;
+  // 1局あたりのPhaseMachine::stepの上限(合法手生成の不具合で終わらない対局を止める)
+  size_t max_steps = 20000;
+  // 添字はSide::USSR=0, Side::USA=1
+  std::array<MatchPolicyFactory, 2> policies;
+};
+
+// MatchSummary: 全対局の集計。
+struct MatchSummary {
+  size_t games = 0;
+  size_t moves = 0;
+  // 添字はSide::USSR=0, Side::USA=1, 引き分け=2, 打ち切り=3
+  std::array<size_t, 4> outcomes{};
+  std::chrono::nanoseconds elapsed{0};
+
+  [[nodiscard]] double gamesPerSecond() const;
+  [[nodiscard]] double movesPerSecond() const;
+};
+
+// game_index番目の対局の種。スレッド数や実行順によらず同じ対局を再現できる。
+[[nodiscard]] uint64_t matchSeed(uint64_t base_seed, size_t game_index);
+
+// ターン開始から終局(または手数上限)まで1局進める。
+// recordを渡すと、ReplayDriverで再生できる棋譜(種・各判断の合法手の添字・勝者)を書き込む。
+[[nodiscard]] MatchResult playMatch(
+    const std::array<std::unique_ptr<Card>, 111>& cardpool,
+    const std::array<MatchPolicyFactory, 2>& policies, uint64_t seed,
+    size_t max_steps = MatchConfig{}.max_steps, GameRecord* record = nullptr);
+
+// config.games局をconfig.threads本のワーカーで並列に指す。
+// on_resultは対局が終わるたびに呼ばれる(呼び出しは直列化されるが、順序は終局順)。
+// ポリシーの未設定や0局・0スレッドはstd::invalid_argument。
+MatchSummary runMatches(
+    const std::array<std::unique_ptr<Card>, 111>& cardpool,
+    const MatchConfig& config,
+    const std::function<void(const MatchResult&)>& on_result = {});
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -12,6 +13,10 @@
 
 #include "tsge/actions/move.hpp"
 #include "tsge/core/board.hpp"
+#include "tsge/players/board_evaluator.hpp"
+#include "tsge/players/determinization.hpp"
+#include "tsge/players/hand_belief.hpp"
+#include "tsge/players/rollout_policy.hpp"
 
 namespace mcts {
 
@@ -28,6 +33,39 @@ struct DeterminizedState {
   size_t determinization_id;  // どの決定化パターンかを識別
 };
 
+// 段階的展開(Progressive Widening)の設定
+// 訪問回数Nのノードでは、並べ替えた候補手の先頭ceil(k * N^alpha)個だけを子として実体化する。
+// 影響力配置のように数千手あるノードで、未訪問の子を総当たりする幅優先化を防ぐ。
+struct ProgressiveWideningConfig {
+  bool enabled = true;
+  double k = 2.0;
+  double alpha = 0.5;
+  // 候補手の並び順を決めるスコア(降順)。未設定なら候補手をランダムに並べる。
+  std::function<double(const Board&, const Move&)> ordering;
+};
+
+// 訪問回数visitsのノードで実体化を許す子の数を返す(1以上total以下)
+[[nodiscard]]
+size_t progressiveWideningLimit(int visits, size_t total,
+                                const ProgressiveWideningConfig& config);
+
+// プレイアウトの設定
+// rollout_depth手までrolloutで進め、終局しなければevaluatorで打ち切って評価する。
+// rollout_depthが0なら葉の盤面をそのまま評価する。
+struct PlayoutConfig {
+  std::shared_ptr<const RolloutPolicy> rollout;  // nullptrなら一様ランダム
+  int rollout_depth = 100;
+  std::shared_ptr<const BoardEvaluator> evaluator;  // nullptrならVP評価
+};
+
+// 探索方式
+enum class SearchMode : uint8_t {
+  // 決定化ごとに独立した木を作り、最後に手ごとの訪問回数を集計する
+  DETERMINIZED_ROOTS,
+  // 探索側の情報集合で1本の木を共有する(SO-ISMCTS)
+  SINGLE_OBSERVER,
+};
+
 // MCTSノード
 class Node {
  public:
@@ -35,6 +73,7 @@ class Node {
        DeterminizedState det_state, Node* parent = nullptr);
 
   // 子ノードを展開
+  // 候補手を並び順どおりに保持するだけで、子の盤面はselectBestChildで必要になった時に作る。
   void expand(const std::vector<std::shared_ptr<Move>>& legal_moves);
 
   // UCB値を計算
@@ -42,7 +81,9 @@ class Node {
   double getUCBValue(double exploration_constant) const;
 
   // 最良の子ノードを選択
-  Node* selectBestChild(double exploration_constant);
+  // 段階的展開の上限に達していなければ次の候補手を実体化して返す。
+  Node* selectBestChild(double exploration_constant,
+                        const ProgressiveWideningConfig& widening);
 
   // バックプロパゲーション
   void backpropagate(double value);
@@ -55,9 +96,15 @@ class Node {
   [[nodiscard]] const std::vector<std::unique_ptr<Node>>& getChildren() const {
     return children_;
   }
+  [[nodiscard]] size_t getCandidateCount() const {
+    return candidate_moves_.size();
+  }
   [[nodiscard]] Move* getLastMove() const {
     return last_move_ ? last_move_.get() : nullptr;
   }
+  [[nodiscard]] const std::shared_ptr<Move>& getLastMoveShared() const {
+    return last_move_;
+  }
   [[nodiscard]] int getVisits() const { return stats_.visits.load(); }
   [[nodiscard]] double getAverageValue() const {
     int value = stats_.visits.load();
@@ -69,10 +116,18 @@ class Node {
   }
 
  private:
+  // 候補手の先頭からlimit番目までで未実体化のものを1つ子にする。
+  // 他スレッドが先に上限まで実体化していればnullptrを返す。
+  Node* materializeNextChild(size_t limit);
+
   Board board_;
   std::shared_ptr<Move> last_move_;
   Node* parent_;
+  std::vector<std::shared_ptr<Move>> candidate_moves_;
+  // children_はexpandで候補手数分reserveし再確保させない。
+  // materialized_までの要素はロックなしで読める。
   std::vector<std::unique_ptr<Node>> children_;
+  std::atomic<size_t> materialized_{0};
   NodeStats stats_;
   Side current_side_;
   DeterminizedState det_state_;
@@ -80,34 +135,84 @@ class Node {
   bool is_expanded_;
 };
 
-// ロールアウトポリシー（ランダムプレイアウト）
-class RolloutPolicy {
+// 情報集合ノード(SO-ISMCTS用)
+// 盤面を持たず、手と統計だけを保持する。反復ごとに決定化し直した盤面で根から辿り、
+// その決定化で合法な子だけを選択候補にする。
+class InformationSetNode {
  public:
-  explicit RolloutPolicy(std::mt19937_64& rng) : rng_(rng) {}
+  InformationSetNode(std::shared_ptr<Move> move, InformationSetNode* parent);
+
+  // 合法手のうち子が無いものがあれば1つを子として追加して返す(expandedをtrueにする)。
+  // 全て子があれば、利用可能回数を分母にしたUCBで選ぶ。
+  // どちらの場合も、合法手に対応する既存の子の利用可能回数を1増やす。
+  InformationSetNode* selectOrExpand(
+      const std::vector<std::shared_ptr<Move>>& legal_moves,
+      double exploration_constant, std::mt19937_64& rng, bool& expanded);
 
-  // ランダムに手を選択
-  std::shared_ptr<Move> selectMove(
-      const std::vector<std::shared_ptr<Move>>& legal_moves);
+  // 根まで訪問回数と価値を積む。valueはroot_side視点で、各ノードでは手を指した側の視点に直す。
+  void backpropagate(double value, Side root_side);
+
+  [[nodiscard]] const std::shared_ptr<Move>& getMove() const { return move_; }
+  [[nodiscard]] int getVisits() const { return visits_.load(); }
+  [[nodiscard]] int getAvailability() const { return availability_.load(); }
+  [[nodiscard]] double getAverageValue() const {
+    const int visits = visits_.load();
+    return visits > 0 ? total_value_.load() / visits : 0.0;
+  }
+  // 子の一覧(探索中に呼ぶ場合は追加と競合しないこと)
+  [[nodiscard]]
+  const std::vector<std::unique_ptr<InformationSetNode>>& getChildren() const {
+    return children_;
+  }
+  // 自身を含む部分木のノード数
+  [[nodiscard]] size_t countNodes() const;
 
  private:
-  std::mt19937_64& rng_;
+  [[nodiscard]] InformationSetNode* findChildLocked(const Move& move) const;
+
+  std::shared_ptr<Move> move_;
+  InformationSetNode* parent_;
+  std::mutex mutex_;  // children_/children_by_key_の排他制御用
+  std::vector<std::unique_ptr<InformationSetNode>> children_;
+  std::unordered_multimap<uint64_t, InformationSetNode*> children_by_key_;
+  std::atomic<int> visits_{0};
+  std::atomic<int> availability_{0};
+  std::atomic<double> total_value_{0.0};
 };
 
 // MCTS実行クラス
 class MCTSExecutor {
  public:
   MCTSExecutor(double exploration_constant = std::sqrt(2.0),
-               int num_threads = 1);
+               int num_threads = 1, ProgressiveWideningConfig widening = {},
+               SearchMode mode = SearchMode::DETERMINIZED_ROOTS,
+               PlayoutConfig playout = {});
 
   // MCTSを実行して最良の手を返す
-  std::shared_ptr<Move> search(const Board& root_board, Side side,
-                               int num_iterations,
-                               std::chrono::milliseconds time_limit);
+  // constraintsは相手の手札の決定化に使う(OpponentHandBelief::toConstraintsなど)。
+  std::shared_ptr<Move> search(
+      const Board& root_board, Side side, int num_iterations,
+      std::chrono::milliseconds time_limit,
+      const DeterminizationConstraints& constraints = {});
+
+  // SO-ISMCTSの木を構築して返す。全スレッドが同じ木を共有する。
+  std::unique_ptr<InformationSetNode> buildInformationSetTree(
+      const Board& root_board, Side side, int num_iterations,
+      std::chrono::milliseconds time_limit,
+      const DeterminizationConstraints& constraints = {});
 
  private:
+  // SO-ISMCTSの1反復(決定化・選択・展開・ロールアウト・逆伝播)
+  void runInformationSetIteration(InformationSetNode* root,
+                                  const Board& root_board,
+                                  const DeterminizationSampler& sampler,
+                                  Side side, std::mt19937_64& rng);
+
   // 決定化パターンを生成
   static std::vector<DeterminizedState> generateDeterminizations(
-      const Board& board, Side side, int max_determinizations = 50);
+      const Board& board, Side side,
+      const DeterminizationConstraints& constraints,
+      int max_determinizations = 50);
 
   // 単一のMCTSスレッドを実行
   void runMCTSThread(Node* root, int iterations_per_thread,
@@ -133,6 +238,9 @@ class MCTSExecutor {
 
   double exploration_constant_;
   int num_threads_;
+  ProgressiveWideningConfig widening_;
+  SearchMode mode_;
+  PlayoutConfig playout_;
   std::vector<std::mt19937_64> thread_rngs_;  // 各スレッド用のRNG
 };
 
@@ -144,14 +252,25 @@ class MCTSPolicy {
   MCTSPolicy(
       int iterations_per_move = 10000,
       std::chrono::milliseconds time_limit = std::chrono::milliseconds(5000),
-      int num_threads = 4);
+      int num_threads = 4,
+      mcts::SearchMode mode = mcts::SearchMode::DETERMINIZED_ROOTS);
 
   std::shared_ptr<Move> decideMove(
       const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
       Side side);
 
+  // observeMove: 適用直前の盤面と実際に指された手を渡し、相手の手札の信念を更新する。
+  // 自分の手は相手側の信念にだけ反映される(observe側で手番を見て無視する)。
+  void observeMove(const Board& board, const Move& move);
+
+  [[nodiscard]] const mcts::OpponentHandBelief& getBelief(Side viewer) const {
+    return beliefs_[static_cast<size_t>(viewer)];
+  }
+
  private:
   mcts::MCTSExecutor executor_;
+  // 手番側ごとの信念(添字はSide::USSR=0, Side::USA=1)
+  std::array<mcts::OpponentHandBelief, 2> beliefs_;
   int iterations_per_move_;
   std::chrono::milliseconds time_limit_;
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+// ファイル: include/tsge/players/mcts_select_kernel.hpp
+// 役割:
+// MCTSの子ノード選択(PUCT/UCB1)をSoA配列上のargmaxとして提供し、実行時のCPU機能判定でAVX2版へ振り分ける。
+// 背景:
+// 影響力配置ノードでは子が数千に達し、子ごとのsqrt/log/除算が選択フェーズの大半を占めるため。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace mcts {
+
+// SelectKernelIsa: 選択カーネルの実装系統。
+enum class SelectKernelIsa : uint8_t {
+  SCALAR,
+  AVX2,
+};
+
+// 逆数テーブルの要素数。これ以上の訪問回数は除算へフォールバックする。
+constexpr int32_t SELECT_KERNEL_TABLE_SIZE = 4096;
+
+// activeSelectKernelIsa: 実行中CPUで利用可能な最速の実装を返す(初回呼び出しで判定しキャッシュ)。
+[[nodiscard]] SelectKernelIsa activeSelectKernelIsa();
+
+// isSelectKernelIsaSupported: 指定実装が実行中CPUで利用可能か。
+[[nodiscard]] bool isSelectKernelIsaSupported(SelectKernelIsa isa);
+
+// reciprocalOnePlus: 1/(1+n)をテーブル参照で返す。
+[[nodiscard]] float reciprocalOnePlus(int32_t visits);
+
+// reciprocalSqrt: 1/sqrt(n)をテーブル参照で返す(n>=1)。
+[[nodiscard]] float reciprocalSqrt(int32_t visits);
+
+// puctArgmax: score = q + exploration_scale * prior / (1+n) が最大の子を返す。
+// - exploration_scale: c_puct * sqrt(parent_visits)を呼び出し側で事前計算して渡す。
+// 同点は先頭側のインデックスを優先する。空配列ではsize()(=0)を返す。
+// isa省略時は実行中CPUの最速実装を使う(子数が少ない場合はスカラー版)。
+[[nodiscard]] std::size_t puctArgmax(std::span<const float> q,
+                                     std::span<const float> prior,
+                                     std::span<const int32_t> visits,
+                                     float exploration_scale);
+[[nodiscard]] std::size_t puctArgmax(std::span<const float> q,
+                                     std::span<const float> prior,
+                                     std::span<const int32_t> visits,
+                                     float exploration_scale,
+                                     SelectKernelIsa isa);
+
+// ucbArgmax: score = mean + exploration_scale / sqrt(n) が最大の子を返す。
+// - exploration_scale: c * sqrt(log(parent_visits + 1))を事前計算して渡す。
+// 未訪問(n==0)の子が存在する場合は先頭の未訪問子を返す(従来のDBL_MAX扱いと同等)。
+[[nodiscard]] std::size_t ucbArgmax(std::span<const float> mean,
+                                    std::span<const int32_t> visits,
+                                    float exploration_scale);
+[[nodiscard]] std::size_t ucbArgmax(std::span<const float> mean,
+                                    std::span<const int32_t> visits,
+                                    float exploration_scale,
+                                    SelectKernelIsa isa);
+
+}  // namespace mcts
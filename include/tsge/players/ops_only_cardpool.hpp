@@ -0,0 +1,37 @@
+// ファイル: include/tsge/players/ops_only_cardpool.hpp
+// 役割:
+// イベントを持たずOpsだけで使うカードを全カード番号に割り当てたカードプールと、実装済みのイベントカードを混ぜたプール、
+// 局面コーパスが名前で選ぶプールを提供する。
+// 背景:
+// カードのイベント実装は一部に限られるため、自己対戦・外部向けの環境・計測ツールは共通してこれらのプールで対局を進める。
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string_view>
+
+#include "tsge/game_state/card.hpp"
+
+// DUMMY以外の全カード番号に、得点カードはOps 0、それ以外はOps 1と2を交互に割り当て、陣営はUSSR・USA・中立の順に巡る。
+// 全カードが初期戦で、イベントは何も起こさないが選ぶことはできる。
+// Ops 3以上は影響力配置の合法手生成が1手に数十ミリ秒かかるため、Opsは1と2に限る。
+// 初回の呼び出しで作ったプールをプログラムの終了まで共有する。
+[[nodiscard]] const std::array<std::unique_ptr<Card>, 111>& opsOnlyCardpool();
+
+// イベントを実装済みの次の32枚だけを本物のカードにしたプール。
+//   得点カード7枚(Asia・Europe・Middle East・Central America・Africa・South America・Southeast Asia)、
+//   China Card、Duck and Cover、Fidel、Nuclear Test Ban、Comecon、Decolonization、Colonial Rear Guards、
+//   Puppet Governments、OAS Founded、Liberation Theology、Warsaw Pact Formed、Marshall Plan、
+//   Ussuri River Skirmish、The Reformer、Special Relationship、South African Unrest、Junta、
+//   Socialist Governments、The Voice of America、Marine Barracks Bombing、Suez Crisis、
+//   East European Unrest、Pershing II Deployed、Muslim Revolution、De-Stalinization
+// 残りはopsOnlyCardpoolと同じOps・陣営・戦争期間のカードだが、canEventがfalseなのでイベントの手は出ず、
+// 相手陣営のカードもOpsとしてだけ使われる。Ops 3以上のカードを含むため、影響力配置の合法手生成が
+// 1手に数十ミリ秒かかることがあり、自己対戦ではopsOnlyCardpoolより遅い。
+[[nodiscard]] const std::array<std::unique_ptr<Card>, 111>& implementedCardpool();
+
+// 局面コーパスのcardpool欄の名前("ops_only"・"implemented")からプールを引く。
+// 知らない名前ならstd::invalid_argument。
+[[nodiscard]] const std::array<std::unique_ptr<Card>, 111>& cardpoolByName(
+    std::string_view name);
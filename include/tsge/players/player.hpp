@@ -1,20 +1,100 @@
 #pragma once
+#include <concepts>
+#include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "tsge/actions/move.hpp"
 #include "tsge/core/board.hpp"
 
 class Move;
 class Board;
 
-template <typename DecisionPolicy>
+// 合法手の中から選んだ手を返すポリシー
+template <typename Policy>
+concept DecidesMove =
+    requires(Policy& policy, const Board& board,
+             const std::vector<std::shared_ptr<Move>>& legal_moves, Side side) {
+      {
+        policy.decideMove(board, legal_moves, side)
+      } -> std::convertible_to<std::shared_ptr<Move>>;
+    };
+
+// 合法手の添字を返すポリシー。Game::nextは手の比較を省いて範囲の確認だけで受理する。
+template <typename Policy>
+concept DecidesMoveIndex =
+    requires(Policy& policy, const Board& board,
+             const std::vector<std::shared_ptr<Move>>& legal_moves, Side side) {
+      {
+        policy.decideMoveIndex(board, legal_moves, side)
+      } -> std::convertible_to<std::size_t>;
+    };
+
+// DecisionPolicy: 盤面・合法手・手番から次の手(または合法手の添字)を返すポリシー。
+// 手の観測(observeMove)は任意で、(board, move)と(move)のどちらの形でもよい。
+template <typename Policy>
+concept DecisionPolicy = std::move_constructible<Policy> &&
+                         (DecidesMove<Policy> || DecidesMoveIndex<Policy>);
+
+template <DecisionPolicy Policy>
 class Player {
  public:
+  Player()
+    requires std::default_initializable<Policy>
+  = default;
+  explicit Player(Policy&& decision_policy)
+      : decision_policy_{std::move(decision_policy)} {}
+
   std::shared_ptr<Move> decideMove(
       const Board& board, const std::vector<std::shared_ptr<Move>>& legalMoves,
       Side side) {
-    return decision_policy_.decideMove(board, legalMoves, side);
+    if constexpr (DecidesMove<Policy>) {
+      return decision_policy_.decideMove(board, legalMoves, side);
+    } else {
+      const std::size_t index =
+          decision_policy_.decideMoveIndex(board, legalMoves, side);
+      return index < legalMoves.size() ? legalMoves[index] : nullptr;
+    }
   }
 
+  // 選んだ手の添字を返す。合法手に無い手を選んだ場合はlegalMoves.size()以上。
+  // 手を返すポリシーでは、まず返された手と同じポインタを探し、無ければoperator==で探す。
+  std::size_t decideMoveIndex(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legalMoves,
+      Side side) {
+    if constexpr (DecidesMoveIndex<Policy>) {
+      return decision_policy_.decideMoveIndex(board, legalMoves, side);
+    } else {
+      const auto move = decision_policy_.decideMove(board, legalMoves, side);
+      if (move == nullptr) {
+        return legalMoves.size();
+      }
+      for (std::size_t i = 0; i < legalMoves.size(); ++i) {
+        if (legalMoves[i] == move) {
+          return i;
+        }
+      }
+      for (std::size_t i = 0; i < legalMoves.size(); ++i) {
+        if (legalMoves[i] && *legalMoves[i] == *move) {
+          return i;
+        }
+      }
+      return legalMoves.size();
+    }
+  }
+
+  // 盤面に適用される直前の手を通知する。観測を持たないポリシーでは何もしない。
+  void observeMove(const Board& board, const Move& move) {
+    if constexpr (requires { decision_policy_.observeMove(board, move); }) {
+      decision_policy_.observeMove(board, move);
+    } else if constexpr (requires { decision_policy_.observeMove(move); }) {
+      decision_policy_.observeMove(move);
+    }
+  }
+
+  Policy& getPolicy() { return decision_policy_; }
+
  private:
-  DecisionPolicy decision_policy_;
-};
\ No newline at end of file
+  Policy decision_policy_;
+};
@@ -0,0 +1,109 @@
+// ファイル: include/tsge/players/rollout_policy.hpp
+// 役割:
+// MCTSのプレイアウトで手を選ぶロールアウトポリシーの差し替え口と、一様ランダム版・ルールベースの重いポリシーを定義する。
+// 背景:
+// 一様ランダムなプレイアウトはDEFCON自滅や明らかな悪手を含むため評価が荒く、少数の安価な規則で質を上げるため。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "tsge/actions/move.hpp"
+#include "tsge/core/board.hpp"
+
+namespace mcts {
+
+// RolloutPolicy: プレイアウト中の1手を選ぶ。
+// 同じインスタンスを複数の探索スレッドから呼ぶため、selectMoveは状態を変更しない。
+class RolloutPolicy {
+ public:
+  RolloutPolicy() = default;
+  virtual ~RolloutPolicy() = default;
+  RolloutPolicy(const RolloutPolicy&) = delete;
+  RolloutPolicy& operator=(const RolloutPolicy&) = delete;
+  RolloutPolicy(RolloutPolicy&&) = delete;
+  RolloutPolicy& operator=(RolloutPolicy&&) = delete;
+
+  // legal_movesが空ならnullptrを返す。boardは手を適用する直前の盤面。
+  [[nodiscard]] virtual std::shared_ptr<Move> selectMove(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      std::mt19937_64& rng) const = 0;
+};
+
+// UniformRolloutPolicy: 合法手から一様に選ぶ(従来のランダムプレイアウト)。
+class UniformRolloutPolicy final : public RolloutPolicy {
+ public:
+  [[nodiscard]] std::shared_ptr<Move> selectMove(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      std::mt19937_64& rng) const override;
+};
+
+// RolloutSummary: 盤面の支配状況の集計。国の走査1回(86か国)で作り、候補手の評価はこれを参照する。
+struct RolloutSummary {
+  static constexpr size_t REGION_COUNT = 9;  // Region::SPECIALを除く
+
+  explicit RolloutSummary(const Board& board);
+
+  // 地域ごと・陣営ごとの支配国数とバトルグラウンド支配数(添字はSide::USSR=0, Side::USA=1)
+  std::array<std::array<int, 2>, REGION_COUNT> controlled{};
+  std::array<std::array<int, 2>, REGION_COUNT> battlegrounds{};
+  int defcon = 5;
+
+  // regionにおけるsideの優勢度。バトルグラウンドの差を国数の差より重く見る。
+  [[nodiscard]] int regionLead(Region region, Side side) const;
+};
+
+// 規則ごとの重み。スコアは大きいほど選ばれやすい。
+struct HeuristicRolloutConfig {
+  // 1手ごとに評価する候補手の数(合法手が多い配置フェーズでも評価時間を一定にする)
+  size_t candidates = 16;
+  // 規則を無視して一様に選ぶ確率(プレイアウトの多様性を残す)
+  double epsilon = 0.1;
+  // 影響力配置で国の支配を得る・相手の支配を崩すときの加点(バトルグラウンドは倍)
+  double gain_control = 2.0;
+  double break_control = 1.0;
+  double battleground_multiplier = 2.0;
+  // 既に支配している国へ上積みする影響力1点ごとの減点
+  double overcontrol_penalty = 0.5;
+  // クーデター: 期待除去量1点ごとの加点と、DEFCON 3でバトルグラウンドを狙う減点
+  double coup_per_influence = 0.6;
+  double defcon_three_penalty = 1.5;
+  // スコアリングカード: 地域の優勢度1点ごとの加点(劣勢なら減点になる)
+  double scoring_per_lead = 0.5;
+  // 相手陣営のイベントを持つカードをOpsで使うときの減点
+  double opponent_event_penalty = 1.0;
+  // 自陣営・中立のイベントを使うときの加点
+  double own_event_bonus = 0.5;
+};
+
+// HeuristicRolloutPolicy: 安価な規則で候補手に点を付け、最高点の手を選ぶ重いプレイアウト。
+// 手番側のバトルグラウンドクーデターでDEFCONが1になる手(自滅)は他に手があれば選ばない。
+class HeuristicRolloutPolicy final : public RolloutPolicy {
+ public:
+  explicit HeuristicRolloutPolicy(HeuristicRolloutConfig config = {});
+
+  [[nodiscard]] std::shared_ptr<Move> selectMove(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      std::mt19937_64& rng) const override;
+
+  // 1手の点数。評価の単体テストとベンチマーク用に公開する。
+  [[nodiscard]] double scoreMove(const Board& board,
+                                 const RolloutSummary& summary,
+                                 const Move& move) const;
+
+  // 自滅手に付ける点数
+  static constexpr double SUICIDE_SCORE = -1.0e9;
+
+ private:
+  HeuristicRolloutConfig config_;
+};
+
+// スコアリングカードが対象とする地域。スコアリングカード以外はnullopt。
+[[nodiscard]] std::optional<Region> scoringRegion(CardEnum card);
+
+}  // namespace mcts
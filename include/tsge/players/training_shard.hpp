@@ -0,0 +1,122 @@
+// ファイル: include/tsge/players/training_shard.hpp
+// 役割:
+// 自己対戦の局面・訪問回数の方策目標・最終結果を固定長レコードとしてmmapしたシャードファイルへ追記し、学習側がそのまま読めるようにする。
+// 背景:
+// 自己対戦の出力に置き場が無かったため、多数の対局スレッドからロック無しで書け、途中で落ちても読めるファイル形式を用意する。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+
+#include "tsge/actions/action_index.hpp"
+#include "tsge/players/feature_encoder.hpp"
+
+// TrainingRecord: シャード内の1局面(2048バイト固定)。
+// 方策目標はActionIndexの添字と確率の疎な組で、確率の大きい順にPOLICY_ENTRIES個まで持つ。
+struct TrainingRecord {
+  static constexpr size_t POLICY_ENTRIES = 64;
+
+  // 書き込み完了の印。他の内容を全て書いた後に最後に1を立てる(シャード内でのみ使う)。
+  uint32_t committed = 0;
+  float value = 0.0F;  // 手番側から見た最終結果 [-1, 1]
+  uint64_t game_seed = 0;
+  uint16_t ply = 0;
+  uint16_t policy_count = 0;
+  uint8_t side = 0;  // Sideの値
+  uint8_t turn = 0;
+  uint8_t action_round = 0;
+  uint8_t reserved = 0;
+  std::array<uint32_t, POLICY_ENTRIES> policy_index{};
+  std::array<float, POLICY_ENTRIES> policy_prob{};
+  std::array<int8_t, FeatureEncoder::SIZE> features{};
+  std::array<uint8_t, 9> padding{};
+
+  // board・sideから特徴量と手番の情報を埋める。
+  void setPosition(const Board& board, Side to_move);
+  // 合法手ごとの確率(訪問回数の比など)を添字ごとに合算し、上位POLICY_ENTRIES個を正規化して持つ。
+  void setPolicy(std::span<const std::shared_ptr<Move>> legal_moves,
+                 std::span<const double> probabilities);
+};
+
+static_assert(sizeof(TrainingRecord) == 2048);
+static_assert(std::is_trivially_copyable_v<TrainingRecord>);
+
+// TrainingShardHeader: シャード先頭の64バイト。以降にcapacity個のレコードが並ぶ。
+struct TrainingShardHeader {
+  static constexpr std::array<char, 4> MAGIC = {'T', 'S', 'T', 'R'};
+  static constexpr uint32_t VERSION = 1;
+
+  std::array<char, 4> magic{};
+  uint32_t version = 0;
+  uint32_t record_size = 0;
+  uint32_t feature_version = 0;
+  uint32_t action_version = 0;
+  uint32_t finalized = 0;  // 1ならrecord_count個が全て書き込み済み
+  uint64_t capacity = 0;
+  uint64_t reserved = 0;  // 追記のために予約された枠の数(capacityを超えうる)
+  uint64_t record_count = 0;
+  std::array<uint8_t, 16> padding{};
+};
+
+static_assert(sizeof(TrainingShardHeader) == 64);
+
+// TrainingShardWriter: capacity個分を事前確保したシャードへの追記。
+// appendは複数スレッドから同時に呼べる(枠の予約はatomicなfetch_addだけ)。
+// finalizeは全てのappendが終わった後に1度呼び、未使用の末尾を切り詰める。
+// finalizeせずに終了したシャードも、書き込み完了の印が付いたレコードだけは読める。
+class TrainingShardWriter {
+ public:
+  // pathを作り直してcapacity個分を確保する。失敗時はstd::runtime_error。
+  TrainingShardWriter(const std::string& path, size_t capacity);
+  ~TrainingShardWriter();
+  TrainingShardWriter(const TrainingShardWriter&) = delete;
+  TrainingShardWriter& operator=(const TrainingShardWriter&) = delete;
+  TrainingShardWriter(TrainingShardWriter&&) = delete;
+  TrainingShardWriter& operator=(TrainingShardWriter&&) = delete;
+
+  // 満杯ならfalse(呼び出し側で次のシャードへ切り替える)。
+  bool append(const TrainingRecord& record);
+  void finalize();
+
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+ private:
+  std::string path_;
+  int fd_ = -1;
+  size_t capacity_ = 0;
+  size_t mapped_size_ = 0;
+  void* mapping_ = nullptr;
+  TrainingShardHeader* header_ = nullptr;
+  TrainingRecord* records_ = nullptr;
+};
+
+// TrainingShardReader: シャードを読み取り専用でmmapし、レコードをコピーせずに見せる。
+class TrainingShardReader {
+ public:
+  // 形式が合わない場合はstd::runtime_error。
+  explicit TrainingShardReader(const std::string& path);
+  ~TrainingShardReader();
+  TrainingShardReader(const TrainingShardReader&) = delete;
+  TrainingShardReader& operator=(const TrainingShardReader&) = delete;
+  TrainingShardReader(TrainingShardReader&&) = delete;
+  TrainingShardReader& operator=(TrainingShardReader&&) = delete;
+
+  [[nodiscard]] bool isFinalized() const { return header_->finalized == 1; }
+  // 枠の並び。finalize前のシャードでは書き込み途中の枠を含むためisCommittedで確かめる。
+  [[nodiscard]] std::span<const TrainingRecord> records() const;
+  [[nodiscard]] bool isCommitted(size_t index) const;
+
+ private:
+  void* mapping_ = nullptr;
+  size_t mapped_size_ = 0;
+  const TrainingShardHeader* header_ = nullptr;
+  const TrainingRecord* records_ = nullptr;
+  size_t count_ = 0;
+};
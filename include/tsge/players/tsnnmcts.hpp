@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <random>
+#include <span>
 #include <vector>
 
 #include "tsge/actions/move.hpp"
@@ -20,7 +23,6 @@ struct TsNnMctsInferenceResult {
 };
 
 // TsNnMctsInferenceEngine: 推論器の抽象インターフェース。
-// TODO: 実際の実装ではバッチ推論・GPU管理などをここに接続する。
 class TsNnMctsInferenceEngine {
  public:
   virtual ~TsNnMctsInferenceEngine() = default;
@@ -34,6 +36,16 @@ class TsNnMctsInferenceEngine {
   virtual TsNnMctsInferenceResult evaluate(
       const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
       Side side) = 0;
+
+  // evaluateBatch: 探索で集めた複数の葉をまとめて評価する。
+  // - boards/legal_moves/sides: 同じ長さで、i番目が1つの葉に対応する。
+  // 返値: 入力と同じ順序の出力。既定実装はevaluateを順に呼ぶだけなので、
+  // バッチ推論できるバックエンドはこれを上書きする。
+  [[nodiscard]]
+  virtual std::vector<TsNnMctsInferenceResult> evaluateBatch(
+      std::span<const Board* const> boards,
+      std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+      std::span<const Side> sides);
 };
 
 // TsNnMctsConfig: 探索パラメータの集約。実数値はTODOで設計書と同期させる想定。
@@ -43,22 +55,63 @@ struct TsNnMctsConfig {
   double dirichlet_alpha = 0.3;  // TODO: 盤面サイズ別に最適値を反映する。
   double dirichlet_epsilon = 0.25;  // TODO: Self-play/対局モードで分岐。
   bool add_dirichlet_noise = true;  // TODO: 実運用モードでフラグを切り替える。
+  bool reuse_tree = true;  // 直前の決定で選んだ手の部分木を次の探索へ引き継ぐ。
+  int batch_size = 8;         // evaluateBatchへ一度に渡す葉の最大数。
+  double virtual_loss = 1.0;  // 評価待ちの経路へ一時的に加える損失。
+  uint64_t seed = 0;          // 盤面遷移とノイズの乱数シード。0なら非決定的。
+};
+
+// TsNnMctsReuseStats: 部分木再利用の集計。
+// - searches: runSearchの呼び出し回数。
+// - reused_roots: 引き継いだ部分木をルートとして使えた回数。
+// - simulations_saved: 再利用したルートが探索開始時点で持っていた訪問回数の累計。
+struct TsNnMctsReuseStats {
+  int64_t searches = 0;
+  int64_t reused_roots = 0;
+  int64_t simulations_saved = 0;
+
+  [[nodiscard]] double hitRate() const {
+    return searches > 0 ? static_cast<double>(reused_roots) /
+                              static_cast<double>(searches)
+                        : 0.0;
+  }
 };
 
 // TsNnMctsNode: 1ノード分の統計を保持。Moveと統計値、子ノードを管理する。
 class TsNnMctsNode {
  public:
-  TsNnMctsNode(std::shared_ptr<Move> move, double prior, TsNnMctsNode* parent);
+  // owner: このノードの統計を誰の視点で持つか。moveがあればmove->getSide()を使い、
+  // ルート(move無し)では手番サイドを渡す。
+  TsNnMctsNode(std::shared_ptr<Move> move, double prior, TsNnMctsNode* parent,
+               Side owner = Side::NEUTRAL);
 
   // expand: 現在ノードの子をpolicyベクトルに基づいて生成。
   void expand(const std::vector<std::shared_ptr<Move>>& legal_moves,
               const std::vector<double>& priors);
 
   // selectChild: PUCTを用いて子ノードを選択。
+  // 子統計のSoA配列をmcts::puctArgmaxへ渡し、対応CPUではAVX2で8子ずつ評価する。
   [[nodiscard]] TsNnMctsNode* selectChild(double c_puct);
 
-  // backup: 葉ノード評価値をバックアップ。
-  void backup(double value, Side root_side);
+  // backup: 葉ノード評価値をルートまでバックアップ。
+  // - value: value_side視点の評価値。各ノードでは自身のowner視点へ符号を揃えて加算する。
+  // TSでは同じサイドが連続して手を選ぶことがあるため、段ごとの単純な符号反転は使わない。
+  void backup(double value, Side value_side);
+
+  // applyVirtualLoss/revertVirtualLoss: 評価待ちの経路(自身からルートまで)に
+  // 訪問1回と損失lossを仮に加え、同じバッチ内の選択を別経路へ散らす。
+  void applyVirtualLoss(double loss);
+  void revertVirtualLoss(double loss);
+
+  // findChild: Moveキーとoperator==で一致する子を返す。無ければnullptr。
+  [[nodiscard]] TsNnMctsNode* findChild(const Move& move) const;
+
+  // releaseChild: 指定した子を木から切り離して新しいルートとして返す。
+  [[nodiscard]] std::unique_ptr<TsNnMctsNode> releaseChild(TsNnMctsNode* child);
+
+  // alignChildren: 子の並びをlegal_movesの順序へ揃える。
+  // 子の集合が合法手と一致しない場合はfalseを返し、木を変更しない。
+  bool alignChildren(const std::vector<std::shared_ptr<Move>>& legal_moves);
 
   // getter群: テストと統計解析用に公開。
   [[nodiscard]] int getVisitCount() const { return visit_count_; }
@@ -74,6 +127,13 @@ class TsNnMctsNode {
   }
   [[nodiscard]] TsNnMctsNode* getParent() const { return parent_; }
   [[nodiscard]] Move* getMove() const { return move_.get(); }
+  [[nodiscard]] const std::shared_ptr<Move>& getMoveShared() const {
+    return move_;
+  }
+  [[nodiscard]] Side getOwner() const { return owner_; }
+  [[nodiscard]] bool isExpanded() const { return !children_.empty(); }
+  // getLegalSignature: 展開時の合法手集合の順序非依存ハッシュ。
+  [[nodiscard]] uint64_t getLegalSignature() const { return legal_signature_; }
 
  private:
   std::shared_ptr<Move> move_;
@@ -81,7 +141,15 @@ class TsNnMctsNode {
   double value_sum_ = 0.0;
   int visit_count_ = 0;
   TsNnMctsNode* parent_;
+  Side owner_;
+  size_t index_in_parent_ = 0;
+  uint64_t legal_signature_ = 0;
   std::vector<std::unique_ptr<TsNnMctsNode>> children_;
+  // 子統計のSoAミラー。backupで子ノードの値と同期し、選択カーネルへ連続配列で渡す。
+  std::vector<float> child_priors_;
+  std::vector<float> child_q_;
+  std::vector<int32_t> child_visits_;
+  std::vector<uint64_t> child_keys_;  // 子MoveのgetKey()。再利用時の照合に使う。
 };
 
 // TsNnMctsController: Zero系MCTSの探索コントローラ。
@@ -90,22 +158,39 @@ class TsNnMctsController {
   TsNnMctsController(std::shared_ptr<TsNnMctsInferenceEngine> inference,
                      TsNnMctsConfig config);
 
-  // runSearch: 探索を実行し、最終的な手を返す。
+  // runSearch: num_simulations回のPUCT探索を行い、訪問回数最大の手を返す。
+  // 葉はbatch_size個ずつ仮想損失付きで集め、evaluateBatchでまとめて評価する。
+  // advanceで引き継いだルートの子が合法手と一致すれば、その統計から探索を続ける。
   std::shared_ptr<Move> runSearch(
       const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
       Side side);
 
+  // advance: 実際に指された手でルートを進める。
+  // 一致する子があればその部分木を新しいルートとして保持し、無ければ木を破棄する。
+  void advance(const Move& played_move);
+
+  // resetTree: 保持している木を破棄する(新しい対局の開始時など)。
+  void resetTree();
+
   // exposeRoot: テスト用にルートノード統計へアクセス。
   [[nodiscard]] const TsNnMctsNode& getRoot() const { return *root_; }
 
+  [[nodiscard]] const TsNnMctsReuseStats& getReuseStats() const {
+    return reuse_stats_;
+  }
+
  private:
   // dirichletノイズをroot priorに付加。
   void injectDirichletNoise(std::vector<double>& priors);
 
-  // TODO: Board遷移を扱うためにPhaseMachine相当のサブシステムと接続する。
+  // runSimulations: ルート盤面のコピーをPhaseMachine::stepで進めながら探索する。
+  void runSimulations(const Board& board, Side side);
+
   std::unique_ptr<TsNnMctsNode> root_;
   std::shared_ptr<TsNnMctsInferenceEngine> inference_;
   TsNnMctsConfig config_;
+  TsNnMctsReuseStats reuse_stats_;
+  std::mt19937_64 rng_;
 };
 
 // TsNnMctsPolicy: Playerラッパー用の決定ポリシー。
@@ -115,10 +200,18 @@ class TsNnMctsPolicy {
                  TsNnMctsConfig config = {});
 
   // decideMove: Playerテンプレートと同等のインターフェース。
+  // 選んだ手で探索木を進め、同じサイドの連続したRequestで部分木を再利用する。
   std::shared_ptr<Move> decideMove(
       const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
       Side side);
 
+  // observeMove: 相手など自分以外が指した手を通知し、探索木を追従させる。
+  void observeMove(const Move& move) { mcts_.advance(move); }
+
+  [[nodiscard]] const TsNnMctsReuseStats& getReuseStats() const {
+    return mcts_.getReuseStats();
+  }
+
  private:
   TsNnMctsController mcts_;
 };
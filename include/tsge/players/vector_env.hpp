@@ -0,0 +1,152 @@
+// ファイル: include/tsge/players/vector_env.hpp
+// 役割:
+// N個の盤面を保持し、行動添字の配列で全環境を1手ずつ同時に進め、特徴量と合法手マスクをまとめて書き出す強化学習向けの環境を提供する。
+// 背景:
+// 学習側は1回の呼び出しで数千環境を進めたいため、環境ごとの呼び出しや終局時の作り直しを呼び出し側に任せず、ここで並列に処理する。
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "tsge/actions/action_index.hpp"
+#include "tsge/core/board.hpp"
+#include "tsge/players/feature_encoder.hpp"
+
+struct VectorEnvConfig {
+  size_t num_envs = 1;
+  // 環境を処理するスレッド数(呼び出し元スレッドを含む)
+  size_t threads = 1;
+  // 1エピソードの手数(盤面を進めた手の数、途中の手順は数えない)の上限。超えたら報酬0で打ち切って作り直す。
+  size_t max_episode_steps = 5000;
+};
+
+// VectorEnv: num_envs個の対局を同時に進める。
+// 行動はActionIndexの手順の添字で、手はActionIndex::influenceStepsの手順を1つずつ選んで組み立てる
+// (分解モード)。影響力の配置・除去は1か国1単位の手順を順不同で選び、選んだ手順の多重集合を
+// 含む合法手が1つに決まった時点で盤面を進める。まだ伸ばせる手があれば手順を記録するだけで
+// 盤面は進まず(報酬0、doneは0)、途中の手順で手が完成しているならPASSの添字でその手に確定できる。
+// 影響力以外の手は1手順なので1回の行動で進む。これで全ての合法手にちょうど1通りの手順列で届く。
+// 観測は手番側から見たFeatureEncoderの特徴量と、次に選べる手順のマスク
+// (途中の手順が無ければActionIndex::writeLegalMaskと同じ)。
+// 終局した環境は報酬とdoneを記録した上で、同じ環境の次のエピソードとして自動で作り直す。
+// 環境ごとのバッファは構築時に確保し、step・observe・resetは自前の確保を行わない
+// (盤面の生成と合法手の列挙はエンジン側で確保する)。
+class VectorEnv {
+ public:
+  // 各環境の種はbase_seedから決めてresetする。num_envs・threadsが0ならstd::invalid_argument。
+  VectorEnv(const std::array<std::unique_ptr<Card>, 111>& cardpool,
+            const VectorEnvConfig& config, uint64_t base_seed = 1);
+  ~VectorEnv();
+  VectorEnv(const VectorEnv&) = delete;
+  VectorEnv& operator=(const VectorEnv&) = delete;
+  VectorEnv(VectorEnv&&) = delete;
+  VectorEnv& operator=(VectorEnv&&) = delete;
+
+  // 全環境を最初の手番まで進める。seedsはnum_envs個で、エピソードの種は(種, 通し番号)から決まる。
+  void reset(std::span<const uint64_t> seeds);
+  // 全環境で1手順ずつ進める。actionsはnum_envs個。
+  // 合法でない行動があればどの環境も進めずにstd::invalid_argumentを投げる。
+  void step(std::span<const int> actions);
+  // features_outへnum_envs * FeatureEncoder::SIZE個、
+  // legal_mask_outへnum_envs * ActionIndex::SIZE個を書き込む。nullptrなら書かない。
+  void observe(float* features_out, uint8_t* legal_mask_out);
+
+  [[nodiscard]] size_t size() const { return envs_.size(); }
+  // 直前のstepでの各環境の報酬(USSRの勝ちで+1、USAの勝ちで-1、引き分け・打ち切りは0)
+  [[nodiscard]] std::span<const float> rewards() const { return rewards_; }
+  // 直前のstepで終局(または打ち切り)した環境は1
+  [[nodiscard]] std::span<const uint8_t> dones() const { return dones_; }
+  [[nodiscard]] Side sideToMove(size_t env) const { return envs_[env].side; }
+  [[nodiscard]] const std::vector<std::shared_ptr<Move>>& legalMoves(
+      size_t env) const {
+    return envs_[env].legal_moves;
+  }
+  [[nodiscard]] const Board& board(size_t env) const {
+    return *envs_[env].board;
+  }
+  // 組み立て中の手で選び済みの手順(昇順)。空なら手の最初の手順を待っている。
+  [[nodiscard]] std::span<const size_t> pendingSteps(size_t env) const {
+    return envs_[env].prefix;
+  }
+  // 環境ごとの完了したエピソード数
+  [[nodiscard]] uint64_t episodes(size_t env) const {
+    return envs_[env].episode;
+  }
+
+ private:
+  struct Env {
+    std::optional<Board> board;
+    std::mt19937_64 rng;
+    std::vector<std::shared_ptr<Move>> legal_moves;
+    Side side = Side::NEUTRAL;
+    uint64_t seed = 0;
+    uint64_t episode = 0;
+    size_t steps = 0;
+    size_t chosen = 0;
+    // 合法手ごとの手順(legal_moves[i]はmove_step_end[i - 1]からmove_step_end[i]まで)
+    std::vector<size_t> move_steps;
+    std::vector<size_t> move_step_end;
+    // 組み立て中の手の手順と、resolveActionで求めた次の手順(applyActionで入れ替える)
+    std::vector<size_t> prefix;
+    std::vector<size_t> next_prefix;
+  };
+
+  using Job = void (VectorEnv::*)(size_t);
+
+  void resetEnv(size_t index);
+  void resolveAction(size_t index);
+  void applyAction(size_t index);
+  void observeEnv(size_t index);
+  static std::span<const size_t> moveSteps(const Env& env, size_t move);
+
+  // 新しいエピソードを始め、最初の手番まで進める
+  void startEpisode(Env& env);
+  // stepの結果を環境へ反映する。終局ならその勝者(引き分けはSide::NEUTRAL)を返す。
+  static std::optional<Side> absorb(
+      Env& env, std::tuple<std::vector<std::shared_ptr<Move>>, Side,
+                           std::optional<Side>>&& result);
+
+  // jobを全環境に適用する。呼び出し元スレッドも処理に加わる。
+  void forEachEnv(Job job);
+  void drain();
+  void workerLoop();
+  void stopWorkers();
+
+  Board template_board_;
+  VectorEnvConfig config_;
+  std::vector<Env> envs_;
+  std::vector<float> rewards_;
+  std::vector<uint8_t> dones_;
+  std::vector<uint8_t> invalid_;
+  std::vector<uint64_t> seeds_;
+
+  // 実行中のジョブの引数
+  std::span<const int> actions_;
+  float* features_out_ = nullptr;
+  uint8_t* legal_mask_out_ = nullptr;
+
+  // 常駐ワーカー。ジョブごとに世代を進めて起こし、環境を小さな区間ずつ取り合う。
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable job_ready_;
+  std::condition_variable job_done_;
+  Job job_ = nullptr;
+  uint64_t generation_ = 0;
+  size_t running_workers_ = 0;
+  bool stopping_ = false;
+  std::atomic<size_t> next_env_{0};
+  std::exception_ptr first_error_;
+};
@@ -0,0 +1,98 @@
+// ファイル: include/tsge/utils/byte_stream.hpp
+// 役割:
+// 呼び出し側が用意したバイト列へ固定長の整数を書き込むByteWriterと、範囲を確かめながら読み出すByteReaderを提供する。
+// 背景:
+// 盤面のスナップショットは1局面あたり1マイクロ秒を大きく下回る速さで読み書きしたいため、確保を伴わない書き込み先と、壊れた入力を例外で弾く読み出しを共通化する。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// ByteWriter: outの先頭から書き進める。溢れればstd::length_error。
+class ByteWriter {
+ public:
+  explicit ByteWriter(std::span<std::byte> out) : out_{out} {}
+
+  void u8(uint8_t value) {
+    if (offset_ >= out_.size()) [[unlikely]] {
+      throw std::length_error("ByteWriter: buffer too small");
+    }
+    out_[offset_++] = static_cast<std::byte>(value);
+  }
+  void i8(int value) {
+    if (value < INT8_MIN || value > INT8_MAX) [[unlikely]] {
+      throw std::out_of_range("ByteWriter: value does not fit in 8 bits");
+    }
+    u8(static_cast<uint8_t>(value));
+  }
+  void i16(int value) {
+    if (value < INT16_MIN || value > INT16_MAX) [[unlikely]] {
+      throw std::out_of_range("ByteWriter: value does not fit in 16 bits");
+    }
+    const auto bits = static_cast<uint16_t>(value);
+    u8(static_cast<uint8_t>(bits));
+    u8(static_cast<uint8_t>(bits >> 8));
+  }
+  // 続くcountバイトをまとめて確保して返す。1バイトずつ書くより速い。
+  std::span<std::byte> take(size_t count) {
+    if (count > out_.size() - offset_) [[unlikely]] {
+      throw std::length_error("ByteWriter: buffer too small");
+    }
+    const auto block = out_.subspan(offset_, count);
+    offset_ += count;
+    return block;
+  }
+
+  [[nodiscard]] size_t offset() const { return offset_; }
+
+ private:
+  std::span<std::byte> out_;
+  size_t offset_ = 0;
+};
+
+// ByteReader: inの先頭から読み進める。足りなければstd::runtime_error。
+class ByteReader {
+ public:
+  explicit ByteReader(std::span<const std::byte> in) : in_{in} {}
+
+  uint8_t u8() {
+    if (offset_ >= in_.size()) [[unlikely]] {
+      throw std::runtime_error("ByteReader: truncated input");
+    }
+    return static_cast<uint8_t>(in_[offset_++]);
+  }
+  int i8() { return static_cast<int8_t>(u8()); }
+  int i16() {
+    const uint8_t low = u8();
+    const uint8_t high = u8();
+    return static_cast<int16_t>(static_cast<uint16_t>(low | (high << 8)));
+  }
+  // 値がlimit未満であることを確かめて読む(列挙型の復元用)
+  uint8_t below(uint8_t limit, const char* what) {
+    const uint8_t value = u8();
+    if (value >= limit) [[unlikely]] {
+      throw std::runtime_error(std::string("ByteReader: invalid ") + what);
+    }
+    return value;
+  }
+  // 続くcountバイトをまとめて読み進めて返す
+  std::span<const std::byte> take(size_t count) {
+    if (count > remaining()) [[unlikely]] {
+      throw std::runtime_error("ByteReader: truncated input");
+    }
+    const auto block = in_.subspan(offset_, count);
+    offset_ += count;
+    return block;
+  }
+
+  [[nodiscard]] size_t offset() const { return offset_; }
+  [[nodiscard]] size_t remaining() const { return in_.size() - offset_; }
+
+ private:
+  std::span<const std::byte> in_;
+  size_t offset_ = 0;
+};
@@ -0,0 +1,56 @@
+// ファイル: include/tsge/utils/mpsc_queue.hpp
+// 役割:
+// 複数スレッドからロックなしでpushでき、単一の消費者がpopする無制限キュー(Vyukov方式)を提供する。
+// 背景:
+// 多数の対局スレッドが推論要求を投げる経路で、投入側がミューテックスで直列化されないようにするため。
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_{new Node{}}, tail_{head_.load()} {}
+  ~MpscQueue() {
+    while (tryPop().has_value()) {
+    }
+    delete tail_;
+  }
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+  MpscQueue(MpscQueue&&) = delete;
+  MpscQueue& operator=(MpscQueue&&) = delete;
+
+  // push: 任意のスレッドから呼べる。待機なしで完了する。
+  void push(T value) {
+    auto* node = new Node{};
+    node->value.emplace(std::move(value));
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // tryPop: 消費者スレッド専用。空、またはpush途中の要素しか無ければnulloptを返す。
+  std::optional<T> tryPop() {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+    std::optional<T> value = std::move(next->value);
+    next->value.reset();
+    delete tail_;
+    tail_ = next;
+    return value;
+  }
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    std::optional<T> value;
+  };
+
+  std::atomic<Node*> head_;  // 生産者が末尾へ追加する位置
+  Node* tail_;               // 消費者が読む位置(番兵ノード)
+};
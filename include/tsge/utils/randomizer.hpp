@@ -1,7 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <random>
+#include <span>
 #include <vector>
 
 class Randomizer {
@@ -16,6 +18,15 @@ class Randomizer {
   // MCTSシミュレーション用
   void setRng(std::mt19937_64* rng) { external_rng_ = rng; }
 
+  // perftで出目を列挙する用。以降のrollDiceはdiceの出目を先頭から順に返し、
+  // 使い切ったら乱数で振る。diceは呼び出し側が保持し、不要になったら空で呼び直す。
+  void forceDice(std::span<const int> dice) {
+    forced_dice_ = dice;
+    dice_rolled_ = 0;
+  }
+  // 直前のforceDice以降にrollDiceを呼んだ回数
+  [[nodiscard]] size_t diceRolled() const { return dice_rolled_; }
+
   int rollDice();
 
   template <typename T>
@@ -27,4 +38,6 @@ class Randomizer {
  private:
   std::mt19937_64 rng_;
   std::mt19937_64* external_rng_ = nullptr;
-};
\ No newline at end of file
+  std::span<const int> forced_dice_;
+  size_t dice_rolled_ = 0;
+};
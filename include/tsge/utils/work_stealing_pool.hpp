@@ -0,0 +1,66 @@
+// ファイル: include/tsge/utils/work_stealing_pool.hpp
+// 役割:
+// ワーカーごとに両端キューを持ち、自分のキューが空になったら他のワーカーの先頭から仕事を盗むスレッドプールを提供する。
+// 背景:
+// 自己対戦の1局は手数も手の重さも大きくばらつくため、静的に割り振ると早く終わったスレッドが遊んでしまう。
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+ public:
+  using Task = std::function<void()>;
+
+  // threads個のワーカーを起動する。0ならstd::invalid_argument。
+  explicit WorkStealingPool(size_t threads);
+  // 残りの仕事を全て実行してからワーカーを止める。
+  ~WorkStealingPool();
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+  WorkStealingPool(WorkStealingPool&&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+  // ワーカー上から呼ぶと自分のキューの末尾へ、外から呼ぶと各キューへ順番に積む。
+  void submit(Task task);
+  // 投入済みの仕事(実行中に追加された仕事を含む)が全て終わるまで待つ。
+  // 仕事が例外を投げていれば、最初の1つをここで投げ直す。
+  void wait();
+
+  [[nodiscard]] size_t threadCount() const { return threads_.size(); }
+  // 他のワーカーから盗んで実行した仕事の数
+  [[nodiscard]] size_t stolenCount() const {
+    return stolen_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  // 自分のキューの末尾、無ければ他のキューの先頭から1つ取る
+  bool tryTake(size_t self, Task& task);
+  void workerLoop(size_t self);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex state_mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable all_done_;
+  std::atomic<size_t> queued_{0};   // キューに積まれて未取得の仕事
+  std::atomic<size_t> pending_{0};  // 投入されて未完了の仕事
+  std::atomic<size_t> next_queue_{0};
+  std::atomic<size_t> stolen_{0};
+  std::exception_ptr first_error_;
+  bool stopping_ = false;
+};
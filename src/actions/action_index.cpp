@@ -0,0 +1,251 @@
+// ファイル: src/actions/action_index.cpp
+// 役割:
+// Moveの型をtypeidで振り分けて行動添字を求め、区画の範囲から手を作り直し、合法手マスクを書き込む。
+// 背景:
+// マスクは探索の各手番で書き直すため、dynamic_castの連鎖や一時配列を使わずに済む形にしている。
+
+#include "tsge/actions/action_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <typeinfo>
+
+#include "tsge/actions/card_specific_moves.hpp"
+#include "tsge/core/board.hpp"
+
+namespace {
+
+using Kind = ActionIndex::Kind;
+
+size_t cardSlot(size_t offset, CardEnum card) {
+  const auto index = static_cast<size_t>(card);
+  return index < ActionIndex::CARD_COUNT ? offset + index
+                                         : ActionIndex::INVALID;
+}
+
+size_t cardCountrySlot(size_t offset, CardEnum card, CountryEnum country) {
+  const auto card_index = static_cast<size_t>(card);
+  const auto country_index = static_cast<size_t>(country);
+  if (card_index >= ActionIndex::CARD_COUNT ||
+      country_index >= ActionIndex::COUNTRY_COUNT) {
+    return ActionIndex::INVALID;
+  }
+  return offset + (card_index * ActionIndex::COUNTRY_COUNT) + country_index;
+}
+
+// 影響力を1単位ずつ扱う手なら、その区画と対象国を返す
+struct InfluenceTargets {
+  size_t offset = ActionIndex::INVALID;
+  const std::map<CountryEnum, int>* amounts = nullptr;
+  const std::vector<CountryEnum>* countries = nullptr;
+};
+
+InfluenceTargets influenceTargets(const Move& move) {
+  const auto& type = typeid(move);
+  if (type == typeid(ActionPlaceInfluenceMove)) {
+    return {ActionIndex::PLACE_INFLUENCE_OFFSET,
+            &static_cast<const ActionPlaceInfluenceMove&>(move)
+                 .getTargetCountries(),
+            nullptr};
+  }
+  if (type == typeid(EventPlaceInfluenceMove)) {
+    return {ActionIndex::EVENT_PLACE_INFLUENCE_OFFSET,
+            &static_cast<const EventPlaceInfluenceMove&>(move)
+                 .getTargetCountries(),
+            nullptr};
+  }
+  if (type == typeid(EventRemoveInfluenceMove)) {
+    return {ActionIndex::EVENT_REMOVE_INFLUENCE_OFFSET,
+            &static_cast<const EventRemoveInfluenceMove&>(move)
+                 .getTargetCountries(),
+            nullptr};
+  }
+  if (type == typeid(DeStalinizationRemoveMove)) {
+    return {ActionIndex::EVENT_REMOVE_INFLUENCE_OFFSET,
+            &static_cast<const DeStalinizationRemoveMove&>(move)
+                 .getTargetCountries(),
+            nullptr};
+  }
+  if (type == typeid(EventRemoveAllInfluenceMove)) {
+    return {ActionIndex::EVENT_REMOVE_INFLUENCE_OFFSET, nullptr,
+            &static_cast<const EventRemoveAllInfluenceMove&>(move)
+                 .getTargetCountries()};
+  }
+  return {};
+}
+
+// 影響力以外の手の添字。影響力の手はINVALIDを返す。
+size_t singleSlot(const Move& move) {
+  const auto& type = typeid(move);
+  const CardEnum card = move.getCard();
+  if (type == typeid(HeadlineCardSelectMove)) {
+    return cardSlot(ActionIndex::HEADLINE_OFFSET, card);
+  }
+  if (type == typeid(ActionEventMove)) {
+    return cardSlot(ActionIndex::EVENT_OFFSET, card);
+  }
+  if (type == typeid(ActionSpaceRaceMove)) {
+    return cardSlot(ActionIndex::SPACE_RACE_OFFSET, card);
+  }
+  if (type == typeid(DiscardMove)) {
+    return cardSlot(ActionIndex::DISCARD_OFFSET, card);
+  }
+  if (type == typeid(PassMove)) {
+    return ActionIndex::PASS_OFFSET;
+  }
+  if (type == typeid(ActionCoupMove)) {
+    return cardCountrySlot(
+        ActionIndex::COUP_OFFSET, card,
+        static_cast<const ActionCoupMove&>(move).getTargetCountry());
+  }
+  if (type == typeid(ActionRealigmentMove)) {
+    return cardCountrySlot(
+        ActionIndex::REALIGNMENT_OFFSET, card,
+        static_cast<const ActionRealigmentMove&>(move).getTargetCountry());
+  }
+  if (type == typeid(RealignmentRequestMove)) {
+    return cardCountrySlot(
+        ActionIndex::REALIGNMENT_OFFSET, card,
+        static_cast<const RealignmentRequestMove&>(move).getTargetCountry());
+  }
+  return ActionIndex::INVALID;
+}
+
+// moveの手順の添字をvisitへ渡す(影響力は1単位ごと)
+template <typename Visit>
+void forEachStep(const Move& move, Visit&& visit) {
+  const auto targets = influenceTargets(move);
+  if (targets.offset == ActionIndex::INVALID) {
+    const size_t index = singleSlot(move);
+    if (index != ActionIndex::INVALID) {
+      visit(index);
+    }
+    return;
+  }
+  if (targets.amounts != nullptr) {
+    for (const auto& [country, amount] : *targets.amounts) {
+      const size_t index =
+          cardCountrySlot(targets.offset, move.getCard(), country);
+      for (int unit = 0; unit < amount && index != ActionIndex::INVALID;
+           ++unit) {
+        visit(index);
+      }
+    }
+    return;
+  }
+  for (const auto country : *targets.countries) {
+    const size_t index =
+        cardCountrySlot(targets.offset, move.getCard(), country);
+    if (index != ActionIndex::INVALID) {
+      visit(index);
+    }
+  }
+}
+
+}  // namespace
+
+size_t ActionIndex::moveToIndex(const Move& move) {
+  const auto targets = influenceTargets(move);
+  if (targets.offset == INVALID) {
+    return singleSlot(move);
+  }
+  if (targets.amounts != nullptr) {
+    for (const auto& [country, amount] : *targets.amounts) {
+      if (amount > 0) {
+        return cardCountrySlot(targets.offset, move.getCard(), country);
+      }
+    }
+    return INVALID;
+  }
+  if (targets.countries->empty()) {
+    return INVALID;
+  }
+  return cardCountrySlot(
+      targets.offset, move.getCard(),
+      *std::min_element(targets.countries->begin(), targets.countries->end()));
+}
+
+ActionIndex::Kind ActionIndex::kindOf(size_t index) {
+  if (index >= SIZE) {
+    throw std::out_of_range("ActionIndex::kindOf: index out of range");
+  }
+  if (index < COUP_OFFSET) {
+    return static_cast<Kind>(index / CARD_COUNT);
+  }
+  if (index < PASS_OFFSET) {
+    return static_cast<Kind>(static_cast<size_t>(Kind::COUP) +
+                             ((index - COUP_OFFSET) / CARD_COUNTRY_COUNT));
+  }
+  return Kind::PASS;
+}
+
+std::shared_ptr<Move> ActionIndex::indexToMove(size_t index, Side side,
+                                               const Board& board) {
+  const Kind kind = kindOf(index);
+  if (kind == Kind::PASS) {
+    return std::make_shared<PassMove>(side);
+  }
+  if (index < COUP_OFFSET) {
+    const auto card = static_cast<CardEnum>(index % CARD_COUNT);
+    switch (kind) {
+      case Kind::HEADLINE:
+        return std::make_shared<HeadlineCardSelectMove>(card, side);
+      case Kind::EVENT: {
+        const auto& pooled = board.getCardpool()[static_cast<size_t>(card)];
+        const bool can_event = pooled != nullptr && pooled->canEvent(board);
+        return std::make_shared<ActionEventMove>(card, side, can_event);
+      }
+      case Kind::SPACE_RACE:
+        return std::make_shared<ActionSpaceRaceMove>(card, side);
+      default:
+        return std::make_shared<DiscardMove>(card, side);
+    }
+  }
+  const size_t slot = (index - COUP_OFFSET) % CARD_COUNTRY_COUNT;
+  const auto card = static_cast<CardEnum>(slot / COUNTRY_COUNT);
+  const auto country = static_cast<CountryEnum>(slot % COUNTRY_COUNT);
+  const std::map<CountryEnum, int> single{{country, 1}};
+  switch (kind) {
+    case Kind::COUP:
+      return std::make_shared<ActionCoupMove>(card, side, country);
+    case Kind::REALIGNMENT:
+      return std::make_shared<ActionRealigmentMove>(card, side, country);
+    case Kind::PLACE_INFLUENCE:
+      return std::make_shared<ActionPlaceInfluenceMove>(card, side, single);
+    case Kind::EVENT_PLACE_INFLUENCE:
+      return std::make_shared<EventPlaceInfluenceMove>(card, side, single);
+    default:
+      return std::make_shared<EventRemoveInfluenceMove>(card, side, single);
+  }
+}
+
+void ActionIndex::influenceSteps(const Move& move, std::vector<size_t>& out) {
+  const auto begin = static_cast<std::ptrdiff_t>(out.size());
+  forEachStep(move, [&out](size_t index) { out.push_back(index); });
+  // 同じカードの区画内では添字の順が国の順と一致する
+  std::sort(out.begin() + begin, out.end());
+}
+
+void ActionIndex::writeLegalMask(
+    std::span<const std::shared_ptr<Move>> legal_moves, uint8_t* mask) {
+  std::memset(mask, 0, SIZE);
+  for (const auto& move : legal_moves) {
+    if (move != nullptr) {
+      forEachStep(*move, [mask](size_t index) { mask[index] = 1; });
+    }
+  }
+}
+
+void ActionIndex::writeLegalBitmask(
+    std::span<const std::shared_ptr<Move>> legal_moves, uint64_t* mask) {
+  std::memset(mask, 0, MASK_WORDS * sizeof(uint64_t));
+  for (const auto& move : legal_moves) {
+    if (move != nullptr) {
+      forEachStep(*move, [mask](size_t index) {
+        mask[index / 64] |= uint64_t{1} << (index % 64);
+      });
+    }
+  }
+}
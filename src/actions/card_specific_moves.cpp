@@ -6,7 +6,6 @@
 
 #include <memory>
 
-#include "tsge/actions/card_effect_legal_move_generator.hpp"
 #include "tsge/actions/command.hpp"
 
 std::vector<CommandPtr> DeStalinizationRemoveMove::toCommand(
@@ -24,19 +23,18 @@ std::vector<CommandPtr> DeStalinizationRemoveMove::toCommand(
   }
 
   // 3. 除去数に応じた配置Requestを発行
-  CardSpecialPlaceInfluenceConfig config;
-  config.totalInfluence = total_removed;
-  config.maxPerCountry = 2;
-  config.allowedRegions = std::nullopt;
-  config.excludeOpponentControlled = true;
-  config.onlyEmptyCountries = false;
-
   commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR, [card_enum = getCard(), config](const Board& board) {
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, Side::USSR,
-                                                    card_enum, config);
-      }));
+      Side::USSR,
+      RequestDescriptor::deStalinizationPlace(getCard(), total_removed)));
 
   return commands;
 }
+
+uint64_t DeStalinizationRemoveMove::getKey() const {
+  uint64_t key = Move::getKey();
+  for (const auto& [country, amount] : targetCountries_) {
+    key = combineMoveKey(key, static_cast<uint64_t>(country));
+    key = combineMoveKey(key, static_cast<uint64_t>(amount));
+  }
+  return key;
+}
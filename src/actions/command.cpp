@@ -5,11 +5,15 @@
 
 #include <algorithm>
 #include <array>
+#include <stdexcept>
 
+#include "tsge/actions/card_effect_legal_move_generator.hpp"
+#include "tsge/actions/game_logic_legal_moves_generator.hpp"
 #include "tsge/core/board.hpp"
 #include "tsge/enums/game_enums.hpp"
 #include "tsge/game_state/card.hpp"
 #include "tsge/game_state/country.hpp"
+#include "tsge/utils/byte_stream.hpp"
 
 namespace {
 
@@ -23,12 +27,174 @@ constexpr std::array<std::pair<CountryEnum, int>, 7>
                                    {CountryEnum::PHILIPPINES, 1},
                                    {CountryEnum::THAILAND, 2}}};
 
+// スナップショット上のCommandの種類。値は書き出した形式の一部なので並べ替えない。
+enum class CommandTag : uint8_t {
+  PLACE_INFLUENCE,
+  REALIGNMENT,
+  COUP,
+  SPACE_RACE,
+  CHANGE_DEFCON,
+  CHANGE_VP,
+  DEFCON_VP,
+  REQUEST,
+  SET_HEADLINE_CARD,
+  FINALIZE_CARD_PLAY,
+  DISCARD,
+  SCORE_REGION,
+  SOUTHEAST_ASIA_SCORING,
+  REMOVE_INFLUENCE,
+  REMOVE_ALL_INFLUENCE,
+  COUNT,
+};
+
+constexpr uint8_t SIDE_COUNT = 3;
+constexpr uint8_t CARD_COUNT = 111;
+constexpr uint8_t COUNTRY_COUNT = 86;
+constexpr uint8_t REGION_COUNT = static_cast<uint8_t>(Region::SPECIAL) + 1;
+constexpr uint8_t REQUEST_KIND_COUNT =
+    static_cast<uint8_t>(RequestKind::CARD_EVENT) + 1;
+
+void writeHeader(ByteWriter& out, CommandTag tag, Side side) {
+  out.u8(static_cast<uint8_t>(tag));
+  out.u8(static_cast<uint8_t>(side));
+}
+
+void writeCountryAmounts(ByteWriter& out,
+                         const std::map<CountryEnum, int>& amounts) {
+  out.u8(static_cast<uint8_t>(amounts.size()));
+  for (const auto& [country, amount] : amounts) {
+    out.u8(static_cast<uint8_t>(country));
+    out.i8(amount);
+  }
+}
+
+Side readSide(ByteReader& in) {
+  return static_cast<Side>(in.below(SIDE_COUNT, "side"));
+}
+
+CardEnum readCard(ByteReader& in) {
+  return static_cast<CardEnum>(in.below(CARD_COUNT, "card"));
+}
+
+CountryEnum readCountry(ByteReader& in) {
+  return static_cast<CountryEnum>(in.below(COUNTRY_COUNT, "country"));
+}
+
+std::map<CountryEnum, int> readCountryAmounts(ByteReader& in) {
+  std::map<CountryEnum, int> amounts;
+  const uint8_t count = in.u8();
+  for (uint8_t i = 0; i < count; ++i) {
+    const CountryEnum country = readCountry(in);
+    amounts[country] = in.i8();
+  }
+  return amounts;
+}
+
+const std::unique_ptr<Card>& lookupCard(
+    CardEnum card_enum,
+    const std::array<std::unique_ptr<Card>, 111>& cardpool) {
+  const auto& card = cardpool[static_cast<size_t>(card_enum)];
+  if (card == nullptr) {
+    throw std::runtime_error("Command snapshot refers to a missing card");
+  }
+  return card;
+}
+
+const std::unique_ptr<Card>& readCardRef(
+    ByteReader& in, const std::array<std::unique_ptr<Card>, 111>& cardpool) {
+  return lookupCard(readCard(in), cardpool);
+}
+
 }  // namespace
 
 std::vector<std::shared_ptr<Move>> Command::legalMoves(const Board&) const {
   return {};
 }
 
+void Command::writeSnapshot(ByteWriter& /*out*/) const {
+  throw std::runtime_error(
+      "Command without a snapshot form (e.g. LambdaCommand) cannot be "
+      "serialized");
+}
+
+CommandPtr Command::readSnapshot(
+    ByteReader& in, const std::array<std::unique_ptr<Card>, 111>& cardpool) {
+  const auto tag = static_cast<CommandTag>(
+      in.below(static_cast<uint8_t>(CommandTag::COUNT), "command"));
+  const Side side = readSide(in);
+  switch (tag) {
+    case CommandTag::PLACE_INFLUENCE: {
+      const auto& card = readCardRef(in, cardpool);
+      return std::make_shared<PlaceInfluenceCommand>(side, card,
+                                                     readCountryAmounts(in));
+    }
+    case CommandTag::REALIGNMENT: {
+      const auto& card = readCardRef(in, cardpool);
+      return std::make_shared<ActionRealigmentCommand>(side, card,
+                                                       readCountry(in));
+    }
+    case CommandTag::COUP: {
+      const auto& card = readCardRef(in, cardpool);
+      return std::make_shared<ActionCoupCommand>(side, card, readCountry(in));
+    }
+    case CommandTag::SPACE_RACE:
+      return std::make_shared<ActionSpaceRaceCommand>(
+          side, readCardRef(in, cardpool));
+    case CommandTag::CHANGE_DEFCON:
+      return std::make_shared<ChangeDefconCommand>(in.i8());
+    case CommandTag::CHANGE_VP:
+      return std::make_shared<ChangeVpCommand>(side, in.i8());
+    case CommandTag::DEFCON_VP: {
+      const int base = in.i8();
+      return std::make_shared<DefconVpCommand>(side, base, in.i8());
+    }
+    case CommandTag::REQUEST: {
+      RequestDescriptor descriptor;
+      descriptor.kind = static_cast<RequestKind>(
+          in.below(REQUEST_KIND_COUNT, "request kind"));
+      if (descriptor.kind == RequestKind::CLOSURE) {
+        throw std::runtime_error("Command snapshot has a closure request");
+      }
+      descriptor.card = readCard(in);
+      descriptor.value = in.i8();
+      descriptor.appliedAdditionalOps = in.u8();
+      const uint8_t count = in.u8();
+      descriptor.history.reserve(count);
+      for (uint8_t i = 0; i < count; ++i) {
+        descriptor.history.push_back(readCountry(in));
+      }
+      if (descriptor.kind == RequestKind::CARD_EVENT) {
+        return std::make_shared<RequestCommand>(
+            side, *lookupCard(descriptor.card, cardpool), descriptor.value);
+      }
+      return std::make_shared<RequestCommand>(side, std::move(descriptor));
+    }
+    case CommandTag::SET_HEADLINE_CARD:
+      return std::make_shared<SetHeadlineCardCommand>(side, readCard(in));
+    case CommandTag::FINALIZE_CARD_PLAY: {
+      const CardEnum card = readCard(in);
+      return std::make_shared<FinalizeCardPlayCommand>(side, card,
+                                                       in.u8() != 0);
+    }
+    case CommandTag::DISCARD:
+      return std::make_shared<DiscardCommand>(side, readCard(in));
+    case CommandTag::SCORE_REGION:
+      return std::make_shared<ScoreRegionCommand>(
+          static_cast<Region>(in.below(REGION_COUNT, "region")));
+    case CommandTag::SOUTHEAST_ASIA_SCORING:
+      return std::make_shared<SoutheastAsiaScoringCommand>();
+    case CommandTag::REMOVE_INFLUENCE:
+      return std::make_shared<RemoveInfluenceCommand>(side,
+                                                      readCountryAmounts(in));
+    case CommandTag::REMOVE_ALL_INFLUENCE:
+      return std::make_shared<RemoveAllInfluenceCommand>(side,
+                                                         readCountry(in));
+    case CommandTag::COUNT:
+      break;
+  }
+  throw std::runtime_error("Command snapshot has an unknown command");
+}
+
 void PlaceInfluenceCommand::apply(Board& board) const {
   for (const auto& target_country : targetCountries_) {
     board.getWorldMap()
@@ -169,11 +335,63 @@ void ChangeVpCommand::apply(Board& board) const {
   }
 }
 
+void DefconVpCommand::apply(Board& board) const {
+  const int defcon = board.getDefconTrack().getDefcon();
+  board.pushState(
+      std::make_shared<ChangeVpCommand>(side_, base_ + (perDefcon_ * defcon)));
+}
+
+RequestCommand::RequestCommand(Side side, RequestDescriptor descriptor)
+    : Command(side), descriptor_(std::move(descriptor)) {
+  if (descriptor_.kind == RequestKind::CLOSURE ||
+      descriptor_.kind == RequestKind::CARD_EVENT) {
+    throw std::invalid_argument(
+        "RequestCommand: closure and card event requests need their source");
+  }
+}
+
+RequestCommand::RequestCommand(Side side, const Card& card, int value)
+    : Command(side),
+      descriptor_(RequestDescriptor::cardEvent(card.getId(), value)),
+      eventCard_(&card) {}
+
 void RequestCommand::apply(Board& board) const {}
 
 std::vector<std::shared_ptr<Move>> RequestCommand::legalMoves(
     const Board& board) const {
-  return legalMovesFactory_(board);
+  const auto applied_ops =
+      static_cast<AdditionalOpsType>(descriptor_.appliedAdditionalOps);
+  switch (descriptor_.kind) {
+    case RequestKind::CLOSURE:
+      return legalMovesFactory_(board);
+    case RequestKind::REALIGNMENT:
+      return GameLogicLegalMovesGenerator::realignmentRequestLegalMoves(
+          board, side_, descriptor_.card, descriptor_.history,
+          descriptor_.value, applied_ops);
+    case RequestKind::ADDITIONAL_OPS_REALIGNMENT:
+      return GameLogicLegalMovesGenerator::additionalOpsRealignmentLegalMoves(
+          board, side_, descriptor_.card, descriptor_.history, applied_ops);
+    case RequestKind::ACTION_FOR_CARD:
+      return GameLogicLegalMovesGenerator::actionLegalMovesForCard(
+          board, side_, descriptor_.card);
+    case RequestKind::SPACE_TRACK_DISCARD:
+      return GameLogicLegalMovesGenerator::spaceTrackDiscardLegalMoves(board,
+                                                                       side_);
+    case RequestKind::DE_STALINIZATION_PLACE: {
+      CardSpecialPlaceInfluenceConfig config;
+      config.totalInfluence = descriptor_.value;
+      config.maxPerCountry = 2;
+      config.allowedRegions = std::nullopt;
+      config.excludeOpponentControlled = true;
+      config.onlyEmptyCountries = false;
+      return CardEffectLegalMoveGenerator::
+          generateCardSpecificPlaceInfluenceMoves(board, side_,
+                                                  descriptor_.card, config);
+    }
+    case RequestKind::CARD_EVENT:
+      return eventCard_->requestLegalMoves(board, side_, descriptor_.value);
+  }
+  return {};
 }
 
 void SetHeadlineCardCommand::apply(Board& board) const {
@@ -244,3 +462,94 @@ void RemoveAllInfluenceCommand::apply(Board& board) const {
   auto& world_map = board.getWorldMap();
   world_map.getCountry(country_).clearInfluence(targetSide_);
 }
+
+void PlaceInfluenceCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::PLACE_INFLUENCE, side_);
+  out.u8(static_cast<uint8_t>(card_->getId()));
+  writeCountryAmounts(out, targetCountries_);
+}
+
+void ActionRealigmentCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::REALIGNMENT, side_);
+  out.u8(static_cast<uint8_t>(card_->getId()));
+  out.u8(static_cast<uint8_t>(targetCountry_));
+}
+
+void ActionCoupCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::COUP, side_);
+  out.u8(static_cast<uint8_t>(card_->getId()));
+  out.u8(static_cast<uint8_t>(targetCountry_));
+}
+
+void ActionSpaceRaceCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::SPACE_RACE, side_);
+  out.u8(static_cast<uint8_t>(card_->getId()));
+}
+
+void ChangeDefconCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::CHANGE_DEFCON, side_);
+  out.i8(delta_);
+}
+
+void ChangeVpCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::CHANGE_VP, side_);
+  out.i8(delta_);
+}
+
+void DefconVpCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::DEFCON_VP, side_);
+  out.i8(base_);
+  out.i8(perDefcon_);
+}
+
+void RequestCommand::writeSnapshot(ByteWriter& out) const {
+  if (descriptor_.kind == RequestKind::CLOSURE) {
+    // ラムダの中身は書けないため、再開できない入力要求として扱う
+    Command::writeSnapshot(out);
+  }
+  writeHeader(out, CommandTag::REQUEST, side_);
+  out.u8(static_cast<uint8_t>(descriptor_.kind));
+  out.u8(static_cast<uint8_t>(descriptor_.card));
+  out.i8(descriptor_.value);
+  out.u8(descriptor_.appliedAdditionalOps);
+  out.u8(static_cast<uint8_t>(descriptor_.history.size()));
+  for (const CountryEnum country : descriptor_.history) {
+    out.u8(static_cast<uint8_t>(country));
+  }
+}
+
+void SetHeadlineCardCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::SET_HEADLINE_CARD, side_);
+  out.u8(static_cast<uint8_t>(card_));
+}
+
+void FinalizeCardPlayCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::FINALIZE_CARD_PLAY, side_);
+  out.u8(static_cast<uint8_t>(card_));
+  out.u8(removeAfterEvent_ ? 1 : 0);
+}
+
+void DiscardCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::DISCARD, side_);
+  out.u8(static_cast<uint8_t>(card_));
+}
+
+void ScoreRegionCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::SCORE_REGION, side_);
+  out.u8(static_cast<uint8_t>(region_));
+}
+
+void SoutheastAsiaScoringCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::SOUTHEAST_ASIA_SCORING, side_);
+}
+
+// 除去系は自身のside_が常にNEUTRALなので、対象陣営をサイドの欄に書く
+void RemoveInfluenceCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::REMOVE_INFLUENCE, targetSide_);
+  writeCountryAmounts(out, targetCountries_);
+}
+
+void RemoveAllInfluenceCommand::writeSnapshot(ByteWriter& out) const {
+  writeHeader(out, CommandTag::REMOVE_ALL_INFLUENCE, targetSide_);
+  out.u8(static_cast<uint8_t>(country_));
+}
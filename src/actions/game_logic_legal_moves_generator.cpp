@@ -45,11 +45,11 @@ struct CountryExtractor<std::pair<const CountryEnum, V>> {
 
 // ヘルパー関数：コンテナ内のすべての国が特定の地域に属するかチェック
 template <Region region, typename Container>
-bool isAllInRegion(const Container& countries, const Board& board) {
+bool isAllInRegion(const Container& countries, const WorldMap& world_map) {
   return std::ranges::all_of(countries, [&](const auto& elem) {
     const auto country =
         CountryExtractor<std::decay_t<decltype(elem)>>::extract(elem);
-    const auto& country_obj = board.getWorldMap().getCountry(country);
+    const auto& country_obj = world_map.getCountry(country);
     return country_obj.hasRegion(region);
   });
 }
@@ -115,7 +115,9 @@ std::vector<CountryEnum> collectOpponentInfluencedCountries(
 
 struct BonusCondition {
   /// 全配置がこの条件(例えば全部アジアにおいてる)を満たしていれば true
-  std::function<bool(const std::map<CountryEnum, int>&)> isSatisfied;
+  /// 条件は関数内のstaticに置くため、盤面は捕捉せず呼び出しごとに受け取る
+  std::function<bool(const std::map<CountryEnum, int>&, const WorldMap&)>
+      isSatisfied;
 };
 
 std::vector<std::pair<int, const BonusCondition*>> computeOpsVariants(
@@ -126,26 +128,26 @@ std::vector<std::pair<int, const BonusCondition*>> computeOpsVariants(
   // NOLINTNEXTLINE(readability-identifier-naming)
   static const BonusCondition asia_only{
       /* すべての国がアジア地域か？ */
-      [&board](const std::map<CountryEnum, int>& placed) {
-        return isAllInRegion<Region::ASIA>(placed, board);
+      [](const std::map<CountryEnum, int>& placed, const WorldMap& world_map) {
+        return isAllInRegion<Region::ASIA>(placed, world_map);
       }};
   // NOLINTNEXTLINE(readability-identifier-naming)
   static const BonusCondition se_asia_only{
-      [&board](const std::map<CountryEnum, int>& placed) {
-        return isAllInRegion<Region::SOUTH_EAST_ASIA>(placed, board);
+      [](const std::map<CountryEnum, int>& placed, const WorldMap& world_map) {
+        return isAllInRegion<Region::SOUTH_EAST_ASIA>(placed, world_map);
       }};
   // NOLINTNEXTLINE(readability-identifier-naming)
   static const BonusCondition not_asia_only{
-      [&board](const std::map<CountryEnum, int>& placed) {
-        return !isAllInRegion<Region::ASIA>(placed, board);
+      [](const std::map<CountryEnum, int>& placed, const WorldMap& world_map) {
+        return !isAllInRegion<Region::ASIA>(placed, world_map);
       }};
   // NOLINTNEXTLINE(readability-identifier-naming)
   static const BonusCondition asia_only_without_se_asia{
-      [&board](const std::map<CountryEnum, int>& placed) {
-        if (!isAllInRegion<Region::ASIA>(placed, board)) {
+      [](const std::map<CountryEnum, int>& placed, const WorldMap& world_map) {
+        if (!isAllInRegion<Region::ASIA>(placed, world_map)) {
           return false;
         }
-        return !isAllInRegion<Region::SOUTH_EAST_ASIA>(placed, board);
+        return !isAllInRegion<Region::SOUTH_EAST_ASIA>(placed, world_map);
       }};
 
   const bool is_china_card = cardId == CardEnum::CHINA_CARD;
@@ -191,7 +193,7 @@ void placeInfluenceDfs(int usedOps, size_t startIdx, WorldMap& tmpWorldMap,
                        const std::vector<CountryEnum>& placeableVec, Side side,
                        const BonusCondition* bonus) {
   if (usedOps == totalOps) {
-    if (bonus == nullptr || bonus->isSatisfied(placed)) {
+    if (bonus == nullptr || bonus->isSatisfied(placed, tmpWorldMap)) {
       out.emplace_back(placed);
     }
     return;
@@ -405,7 +407,7 @@ GameLogicLegalMovesGenerator::additionalOpsRealignmentLegalMoves(
        static_cast<uint8_t>(AdditionalOpsType::CHINA_CARD)) != 0) {
     // 既に中国カードボーナスが適用されている
   } else if (cardEnum == CardEnum::CHINA_CARD && !history.empty() &&
-             isAllInRegion<Region::ASIA>(history, board)) {
+             isAllInRegion<Region::ASIA>(history, board.getWorldMap())) {
     china_card_bonus = true;
   }
 
@@ -417,7 +419,7 @@ GameLogicLegalMovesGenerator::additionalOpsRealignmentLegalMoves(
   } else {
     // TODO: ベトナム蜂起が有効かどうかの判定が必要
     // if (board.isVietnamRevoltsActive() &&
-    // isAllInRegion<Region::SOUTH_EAST_ASIA>(history, board)) {
+    // isAllInRegion<Region::SOUTH_EAST_ASIA>(history, board.getWorldMap())) {
     //   vietnamRevoltsBonus = true;
     // }
   }
@@ -1,10 +1,10 @@
 #include "tsge/actions/move.hpp"
 
 #include <memory>
+#include <typeinfo>
 #include <utility>
 
 #include "tsge/actions/command.hpp"
-#include "tsge/actions/game_logic_legal_moves_generator.hpp"
 #include "tsge/core/board.hpp"
 #include "tsge/enums/game_enums.hpp"
 
@@ -34,8 +34,63 @@ std::vector<CommandPtr> addFinalizeCardPlayCommand(
   return std::move(commands);
 }
 
+uint64_t combineCountryAmounts(uint64_t key,
+                               const std::map<CountryEnum, int>& countries) {
+  for (const auto& [country, amount] : countries) {
+    key = combineMoveKey(key, static_cast<uint64_t>(country));
+    key = combineMoveKey(key, static_cast<uint64_t>(amount));
+  }
+  return key;
+}
+
+uint64_t combineCountries(uint64_t key,
+                          const std::vector<CountryEnum>& countries) {
+  for (const auto country : countries) {
+    key = combineMoveKey(key, static_cast<uint64_t>(country));
+  }
+  return key;
+}
+
 }  // namespace
 
+uint64_t Move::getKey() const {
+  uint64_t key = typeid(*this).hash_code();
+  key = combineMoveKey(key, static_cast<uint64_t>(card_));
+  return combineMoveKey(key, static_cast<uint64_t>(side_));
+}
+
+uint64_t ActionPlaceInfluenceMove::getKey() const {
+  return combineCountryAmounts(Move::getKey(), targetCountries_);
+}
+
+uint64_t EventPlaceInfluenceMove::getKey() const {
+  return combineCountryAmounts(Move::getKey(), targetCountries_);
+}
+
+uint64_t ActionCoupMove::getKey() const {
+  return combineMoveKey(Move::getKey(), static_cast<uint64_t>(targetCountry_));
+}
+
+uint64_t ActionRealigmentMove::getKey() const {
+  return combineMoveKey(Move::getKey(), static_cast<uint64_t>(targetCountry_));
+}
+
+uint64_t RealignmentRequestMove::getKey() const {
+  uint64_t key =
+      combineMoveKey(Move::getKey(), static_cast<uint64_t>(targetCountry_));
+  key = combineCountries(key, realignmentHistory_);
+  key = combineMoveKey(key, static_cast<uint64_t>(remainingOps_));
+  return combineMoveKey(key, static_cast<uint64_t>(appliedAdditionalOps_));
+}
+
+uint64_t EventRemoveInfluenceMove::getKey() const {
+  return combineCountryAmounts(Move::getKey(), targetCountries_);
+}
+
+uint64_t EventRemoveAllInfluenceMove::getKey() const {
+  return combineCountries(Move::getKey(), targetCountries_);
+}
+
 std::vector<CommandPtr> HeadlineCardSelectMove::toCommand(
     const std::unique_ptr<Card>& card, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
@@ -95,25 +150,16 @@ std::vector<CommandPtr> ActionRealigmentMove::toCommand(
   const int remaining_ops = card->getOps() - 1;
   if (remaining_ops > 0) {
     commands.emplace_back(std::make_shared<RequestCommand>(
-        getSide(),
-        [side = getSide(), card_enum = getCard(),
-         history = std::move(initial_history), ops = remaining_ops](
-            const Board& board) -> std::vector<std::shared_ptr<Move>> {
-          return GameLogicLegalMovesGenerator::realignmentRequestLegalMoves(
-              board, side, card_enum, history, ops, AdditionalOpsType::NONE);
-        }));
+        getSide(), RequestDescriptor::realignment(
+                       getCard(), std::move(initial_history), remaining_ops,
+                       static_cast<uint8_t>(AdditionalOpsType::NONE))));
   } else {
     // すべてのOpsを使い切った場合、追加Opsの処理
     // 実際の判定はGameLogicLegalMovesGeneratorで行う
     commands.emplace_back(std::make_shared<RequestCommand>(
-        getSide(),
-        [side = getSide(), card_enum = getCard(),
-         history = std::move(initial_history)](
-            const Board& board) -> std::vector<std::shared_ptr<Move>> {
-          return GameLogicLegalMovesGenerator::
-              additionalOpsRealignmentLegalMoves(
-                  board, side, card_enum, history, AdditionalOpsType::NONE);
-        }));
+        getSide(), RequestDescriptor::additionalOpsRealignment(
+                       getCard(), std::move(initial_history),
+                       static_cast<uint8_t>(AdditionalOpsType::NONE))));
   }
 
   const bool event_triggered =
@@ -143,27 +189,16 @@ std::vector<CommandPtr> RealignmentRequestMove::toCommand(
   if (new_remaining_ops > 0) {
     // まだOpsが残っている場合は、次のRequestを生成
     commands.emplace_back(std::make_shared<RequestCommand>(
-        getSide(),
-        [side = getSide(), card_enum = getCard(),
-         history = std::move(updated_history), ops = new_remaining_ops,
-         applied_ops = appliedAdditionalOps_](
-            const Board& board) -> std::vector<std::shared_ptr<Move>> {
-          return GameLogicLegalMovesGenerator::realignmentRequestLegalMoves(
-              board, side, card_enum, history, ops, applied_ops);
-        }));
+        getSide(), RequestDescriptor::realignment(
+                       getCard(), std::move(updated_history), new_remaining_ops,
+                       static_cast<uint8_t>(appliedAdditionalOps_))));
   } else {
     // すべてのOpsを使い切った場合、追加Opsの処理
     // 実際の判定はGameLogicLegalMovesGeneratorで行う
     commands.emplace_back(std::make_shared<RequestCommand>(
-        getSide(),
-        [side = getSide(), card_enum = getCard(),
-         history = std::move(updated_history),
-         applied_ops = appliedAdditionalOps_](
-            const Board& board) -> std::vector<std::shared_ptr<Move>> {
-          return GameLogicLegalMovesGenerator::
-              additionalOpsRealignmentLegalMoves(board, side, card_enum,
-                                                 history, applied_ops);
-        }));
+        getSide(), RequestDescriptor::additionalOpsRealignment(
+                       getCard(), std::move(updated_history),
+                       static_cast<uint8_t>(appliedAdditionalOps_))));
   }
 
   return commands;
@@ -191,12 +226,7 @@ std::vector<CommandPtr> ActionEventMove::toCommand(
   if (card_side == getOpponentSide(player_side)) {
     // Add a RequestCommand for the player to choose Place/Realign/Coup action
     commands.emplace_back(std::make_shared<RequestCommand>(
-        player_side,
-        [card_enum = getCard(), side = player_side](
-            const Board& board) -> std::vector<std::shared_ptr<Move>> {
-          return GameLogicLegalMovesGenerator::actionLegalMovesForCard(
-              board, side, card_enum);
-        }));
+        player_side, RequestDescriptor::actionForCard(getCard())));
   }
 
   return addFinalizeCardPlayCommand(std::move(commands), getSide(), getCard(),
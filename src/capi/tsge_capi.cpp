@@ -0,0 +1,184 @@
+// ファイル: src/capi/tsge_capi.cpp
+// 役割:
+// C言語のAPIをVectorEnvの呼び出しへ変換し、例外を状態コードとスレッドごとのエラーメッセージに置き換える。
+// 背景:
+// 例外がCの境界を越えると呼び出し側のランタイムごと異常終了するため、全ての入口で捕まえて返す。
+
+#include "tsge/capi/tsge_capi.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "tsge/actions/action_index.hpp"
+#include "tsge/players/feature_encoder.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+#include "tsge/players/vector_env.hpp"
+
+// 行動の配列をコピーせずにVectorEnv::stepへ渡すため
+static_assert(std::is_same_v<int32_t, int>);
+
+struct tsge_env {
+  tsge_env(const std::array<std::unique_ptr<Card>, 111>& cardpool,
+           const VectorEnvConfig& config, uint64_t seed)
+      : env(cardpool, config, seed) {}
+
+  VectorEnv env;
+};
+
+namespace {
+
+thread_local std::string last_error;
+
+// fnを実行し、例外を状態コードへ変換する
+template <typename Fn>
+tsge_status guard(Fn&& fn) noexcept {
+  try {
+    fn();
+    last_error.clear();
+    return TSGE_OK;
+  } catch (const std::invalid_argument& error) {
+    last_error = error.what();
+    return TSGE_INVALID_ARGUMENT;
+  } catch (const std::out_of_range& error) {
+    last_error = error.what();
+    return TSGE_INVALID_ARGUMENT;
+  } catch (const std::exception& error) {
+    last_error = error.what();
+    return TSGE_RUNTIME_ERROR;
+  } catch (...) {
+    last_error = "unknown error";
+    return TSGE_RUNTIME_ERROR;
+  }
+}
+
+void requireNonNull(const void* pointer, const char* name) {
+  if (pointer == nullptr) {
+    throw std::invalid_argument(std::string(name) + " must not be NULL");
+  }
+}
+
+void copyOutcome(const VectorEnv& env, float* rewards_out,
+                 uint8_t* dones_out) {
+  if (rewards_out != nullptr) {
+    const auto rewards = env.rewards();
+    std::copy(rewards.begin(), rewards.end(), rewards_out);
+  }
+  if (dones_out != nullptr) {
+    const auto dones = env.dones();
+    std::copy(dones.begin(), dones.end(), dones_out);
+  }
+}
+
+const std::array<std::unique_ptr<Card>, 111>& cardpoolOf(
+    tsge_cardpool cardpool) {
+  switch (cardpool) {
+    case TSGE_CARDPOOL_IMPLEMENTED:
+      return implementedCardpool();
+    case TSGE_CARDPOOL_OPS_ONLY:
+      return opsOnlyCardpool();
+  }
+  throw std::invalid_argument("unknown cardpool " +
+                              std::to_string(static_cast<int>(cardpool)));
+}
+
+}  // namespace
+
+extern "C" {
+
+uint32_t tsge_abi_version(void) { return TSGE_ABI_VERSION; }
+
+size_t tsge_feature_size(void) { return FeatureEncoder::SIZE; }
+
+size_t tsge_action_size(void) { return ActionIndex::SIZE; }
+
+const char* tsge_last_error(void) { return last_error.c_str(); }
+
+void tsge_env_config_init(tsge_env_config* config) {
+  if (config == nullptr) {
+    return;
+  }
+  const VectorEnvConfig defaults;
+  config->num_envs = defaults.num_envs;
+  config->threads = defaults.threads;
+  config->max_episode_steps = defaults.max_episode_steps;
+  config->seed = 1;
+  config->cardpool = TSGE_CARDPOOL_IMPLEMENTED;
+}
+
+tsge_status tsge_env_create(const tsge_env_config* config,
+                            tsge_env** out_env) {
+  return guard([&] {
+    requireNonNull(config, "config");
+    requireNonNull(out_env, "out_env");
+    *out_env = new tsge_env(
+        cardpoolOf(config->cardpool),
+        {.num_envs = config->num_envs,
+         .threads = config->threads,
+         .max_episode_steps = config->max_episode_steps},
+        config->seed);
+  });
+}
+
+void tsge_env_destroy(tsge_env* env) { delete env; }
+
+size_t tsge_env_num_envs(const tsge_env* env) {
+  return env != nullptr ? env->env.size() : 0;
+}
+
+tsge_status tsge_env_reset(tsge_env* env, const uint64_t* seeds) {
+  return guard([&] {
+    requireNonNull(env, "env");
+    requireNonNull(seeds, "seeds");
+    env->env.reset(std::span(seeds, env->env.size()));
+  });
+}
+
+tsge_status tsge_env_step(tsge_env* env, const int32_t* actions,
+                          float* rewards_out, uint8_t* dones_out) {
+  return guard([&] {
+    requireNonNull(env, "env");
+    requireNonNull(actions, "actions");
+    env->env.step(std::span(actions, env->env.size()));
+    copyOutcome(env->env, rewards_out, dones_out);
+  });
+}
+
+tsge_status tsge_env_observe(tsge_env* env, float* features_out,
+                             uint8_t* legal_mask_out) {
+  return guard([&] {
+    requireNonNull(env, "env");
+    env->env.observe(features_out, legal_mask_out);
+  });
+}
+
+tsge_status tsge_env_step_observe(tsge_env* env, const int32_t* actions,
+                                  float* rewards_out, uint8_t* dones_out,
+                                  float* features_out,
+                                  uint8_t* legal_mask_out) {
+  return guard([&] {
+    requireNonNull(env, "env");
+    requireNonNull(actions, "actions");
+    env->env.step(std::span(actions, env->env.size()));
+    copyOutcome(env->env, rewards_out, dones_out);
+    env->env.observe(features_out, legal_mask_out);
+  });
+}
+
+tsge_status tsge_env_sides_to_move(const tsge_env* env, int32_t* sides_out) {
+  return guard([&] {
+    requireNonNull(env, "env");
+    requireNonNull(sides_out, "sides_out");
+    for (size_t i = 0; i < env->env.size(); ++i) {
+      sides_out[i] = static_cast<int32_t>(env->env.sideToMove(i));
+    }
+  });
+}
+
+}  // extern "C"
@@ -3,7 +3,12 @@
 // 特に最終得点は勝敗を左右するため、ここで一貫したアルゴリズムを提供する。
 #include "tsge/core/board.hpp"
 
+#include <algorithm>
 #include <ranges>
+#include <stdexcept>
+#include <typeinfo>
+
+#include "tsge/utils/byte_stream.hpp"
 
 namespace {
 
@@ -35,6 +40,22 @@ constexpr std::array<Region, 6> GLOBAL_SCORING_REGIONS = {
   return REGION_SCORE_PROFILES[static_cast<std::size_t>(region)];
 }
 
+// hashCombine: boost::hash_combine相当の64bit混合。
+[[nodiscard]] uint64_t hashCombine(uint64_t seed, uint64_t value) {
+  return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U));
+}
+
+// 並び順に意味のないカード列は整列してから混ぜ、同じ集合を同じハッシュにする。
+[[nodiscard]] uint64_t hashCardMultiset(uint64_t seed,
+                                        std::vector<CardEnum> cards) {
+  std::ranges::sort(cards);
+  seed = hashCombine(seed, cards.size());
+  for (const auto card : cards) {
+    seed = hashCombine(seed, static_cast<uint64_t>(card));
+  }
+  return seed;
+}
+
 }  // namespace
 
 void Board::giveChinaCardTo(Side newOwner, bool faceUp) {
@@ -223,6 +244,111 @@ bool Board::isHeadlineCardVisible(Side viewer, Side target) const {
   return spaceTrack_.effectEnabled(viewer, 4);
 }
 
+Board::Board(const Board& other)
+    : cardpool_{other.cardpool_},
+      states_{other.states_},
+      worldMap_{other.worldMap_},
+      spaceTrack_{other.spaceTrack_},
+      defconTrack_{other.defconTrack_},
+      milopsTrack_{other.milopsTrack_},
+      turnTrack_{other.turnTrack_},
+      actionRoundTrack_{other.actionRoundTrack_},
+      randomizer_{other.randomizer_},
+      deck_{other.deck_, randomizer_},
+      playerHands_{other.playerHands_},
+      headlineCards_{other.headlineCards_},
+      cardEffectsInProgress_{other.cardEffectsInProgress_},
+      cardsEffectsInThisTurn_{other.cardsEffectsInThisTurn_},
+      vp_{other.vp_},
+      currentArPlayer_{other.currentArPlayer_},
+      chinaCard_{other.chinaCard_} {}
+
+Board::Board(Board&& other) noexcept
+    : cardpool_{other.cardpool_},
+      states_{std::move(other.states_)},
+      worldMap_{std::move(other.worldMap_)},
+      spaceTrack_{std::move(other.spaceTrack_)},
+      defconTrack_{std::move(other.defconTrack_)},
+      milopsTrack_{std::move(other.milopsTrack_)},
+      turnTrack_{std::move(other.turnTrack_)},
+      actionRoundTrack_{std::move(other.actionRoundTrack_)},
+      randomizer_{std::move(other.randomizer_)},
+      deck_{std::move(other.deck_), randomizer_},
+      playerHands_{std::move(other.playerHands_)},
+      headlineCards_{other.headlineCards_},
+      cardEffectsInProgress_{std::move(other.cardEffectsInProgress_)},
+      cardsEffectsInThisTurn_{std::move(other.cardsEffectsInThisTurn_)},
+      vp_{other.vp_},
+      currentArPlayer_{other.currentArPlayer_},
+      chinaCard_{other.chinaCard_} {}
+
+uint64_t Board::getObservableHash(Side viewerSide) const {
+  const Side opponent_side = getOpponentSide(viewerSide);
+  uint64_t hash = hashCombine(0, static_cast<uint64_t>(viewerSide));
+
+  // 状態スタック: StateTypeは値、コマンドは型だけを混ぜる。
+  // コマンドが持つ選択肢の違いは合法手側のハッシュで区別される前提。
+  hash = hashCombine(hash, states_.size());
+  for (const auto& state : states_) {
+    if (const auto* type = std::get_if<StateType>(&state)) {
+      hash = hashCombine(hash, static_cast<uint64_t>(*type));
+    } else {
+      const auto& command = std::get<CommandPtr>(state);
+      hash = hashCombine(hash, command != nullptr
+                                   ? typeid(*command).hash_code()
+                                   : 0);
+    }
+  }
+
+  for (size_t i = 0; i < worldMap_.getCountriesCount(); ++i) {
+    const auto& country = worldMap_.getCountry(static_cast<CountryEnum>(i));
+    hash = hashCombine(hash,
+                       static_cast<uint64_t>(country.getInfluence(Side::USSR)));
+    hash = hashCombine(hash,
+                       static_cast<uint64_t>(country.getInfluence(Side::USA)));
+  }
+
+  for (const auto side : {Side::USSR, Side::USA}) {
+    hash = hashCombine(
+        hash, static_cast<uint64_t>(spaceTrack_.getSpaceTrackPosition(side)));
+    hash = hashCombine(hash,
+                       static_cast<uint64_t>(spaceTrack_.getSpaceTried(side)));
+    hash = hashCombine(hash,
+                       static_cast<uint64_t>(milopsTrack_.getMilops(side)));
+    hash = hashCombine(
+        hash, static_cast<uint64_t>(actionRoundTrack_.getActionRound(side)));
+    hash = hashCombine(hash, static_cast<uint64_t>(
+                                 actionRoundTrack_.hasExtraActionRound(side)));
+    hash = hashCardMultiset(hash,
+                            cardsEffectsInThisTurn_[static_cast<size_t>(side)]);
+  }
+  hash = hashCombine(hash, static_cast<uint64_t>(defconTrack_.getDefcon()));
+  hash = hashCombine(hash, static_cast<uint64_t>(turnTrack_.getTurn()));
+  hash = hashCombine(hash, static_cast<uint64_t>(vp_));
+  hash = hashCombine(hash, static_cast<uint64_t>(currentArPlayer_));
+  hash = hashCombine(hash, static_cast<uint64_t>(chinaCard_.owner));
+  hash = hashCombine(hash, static_cast<uint64_t>(chinaCard_.faceUp));
+
+  // 手札: 自分は中身、相手は枚数のみ。山札も枚数のみ。
+  hash = hashCardMultiset(hash, playerHands_[static_cast<size_t>(viewerSide)]);
+  hash = hashCombine(hash,
+                     playerHands_[static_cast<size_t>(opponent_side)].size());
+  hash = hashCombine(hash, deck_.getDeck().size());
+  hash = hashCardMultiset(hash, deck_.getDiscardPile());
+  hash = hashCardMultiset(hash, deck_.getRemovedCards());
+
+  hash = hashCombine(hash, static_cast<uint64_t>(getHeadlineCard(viewerSide)));
+  const CardEnum opponent_headline =
+      isHeadlineCardVisible(viewerSide, opponent_side)
+          ? getHeadlineCard(opponent_side)
+          : CardEnum::DUMMY;
+  hash = hashCombine(hash, static_cast<uint64_t>(opponent_headline));
+  for (const auto card : cardEffectsInProgress_) {
+    hash = hashCombine(hash, static_cast<uint64_t>(card));
+  }
+  return hash;
+}
+
 Board Board::copyForMCTS(Side viewerSide) const {
   // shared_ptrに変更したことで、完全なコピーコンストラクタが使用可能
   Board copy = *this;
@@ -254,3 +380,199 @@ Board Board::copyForMCTS(Side viewerSide) const {
 
   return copy;
 }
+
+namespace {
+
+// スナップショットの先頭。形式を変えたらSNAPSHOT_VERSIONを上げる。
+constexpr std::array<uint8_t, 4> SNAPSHOT_MAGIC = {'T', 'S', 'B', 'S'};
+constexpr uint8_t SNAPSHOT_VERSION = 1;
+constexpr uint8_t STATE_TAG_TYPE = 0;
+constexpr uint8_t STATE_TAG_COMMAND = 1;
+constexpr uint8_t SNAPSHOT_CARD_COUNT = 111;
+constexpr uint8_t SNAPSHOT_STATE_TYPE_COUNT =
+    static_cast<uint8_t>(StateType::DRAW_END) + 1;
+
+void writeCount(ByteWriter& out, size_t count) {
+  if (count > UINT8_MAX) {
+    throw std::length_error("Board::serialize: list too long");
+  }
+  out.u8(static_cast<uint8_t>(count));
+}
+
+template <typename Cards>
+void writeCards(ByteWriter& out, const Cards& cards) {
+  writeCount(out, cards.size());
+  std::byte* cursor = out.take(cards.size()).data();
+  for (const CardEnum card : cards) {
+    *cursor++ = static_cast<std::byte>(card);
+  }
+}
+
+CardEnum checkedCard(std::byte value) {
+  if (static_cast<uint8_t>(value) >= SNAPSHOT_CARD_COUNT) [[unlikely]] {
+    throw std::runtime_error("ByteReader: invalid card");
+  }
+  return static_cast<CardEnum>(value);
+}
+
+void readCards(ByteReader& in, std::vector<CardEnum>& cards) {
+  const auto block = in.take(in.u8());
+  cards.resize(block.size());
+  for (size_t i = 0; i < block.size(); ++i) {
+    cards[i] = checkedCard(block[i]);
+  }
+}
+
+Side readSnapshotSide(ByteReader& in) {
+  return static_cast<Side>(in.below(3, "side"));
+}
+
+}  // namespace
+
+size_t Board::serialize(std::span<std::byte> out) const {
+  ByteWriter writer(out);
+  for (const uint8_t byte : SNAPSHOT_MAGIC) {
+    writer.u8(byte);
+  }
+  writer.u8(SNAPSHOT_VERSION);
+
+  for (size_t side = 0; side < 2; ++side) {
+    writer.u8(static_cast<uint8_t>(spaceTrack_.spaceTrack_[side]));
+    writer.u8(static_cast<uint8_t>(spaceTrack_.spaceTried_[side]));
+    writer.u8(static_cast<uint8_t>(milopsTrack_.milopsTrack_[side]));
+    writer.u8(static_cast<uint8_t>(actionRoundTrack_.actionRound_[side]));
+    writer.u8(actionRoundTrack_.extraActionRound_[side] ? 1 : 0);
+  }
+  writer.u8(static_cast<uint8_t>(defconTrack_.defcon_));
+  writer.u8(static_cast<uint8_t>(turnTrack_.turn_));
+  writer.i16(vp_);
+  writer.u8(static_cast<uint8_t>(currentArPlayer_));
+  writer.u8(static_cast<uint8_t>(chinaCard_.owner));
+  writer.u8(chinaCard_.faceUp ? 1 : 0);
+  for (const CardEnum card : headlineCards_) {
+    writer.u8(static_cast<uint8_t>(card));
+  }
+
+  // 超大国の欄は初期値999を持つため、影響力は16bitで書く。
+  // 国の数だけ1バイトずつ書くと遅いので、まとめて確保した領域へ詰める。
+  std::byte* cursor = writer.take(worldMap_.getCountriesCount() * 4).data();
+  for (size_t i = 0; i < worldMap_.getCountriesCount(); ++i) {
+    const auto& country = worldMap_.getCountry(static_cast<CountryEnum>(i));
+    for (const Side side : {Side::USSR, Side::USA}) {
+      const int influence = country.getInfluence(side);
+      if (influence < 0 || influence > INT16_MAX) [[unlikely]] {
+        throw std::out_of_range("Board::serialize: influence out of range");
+      }
+      *cursor++ = static_cast<std::byte>(influence);
+      *cursor++ = static_cast<std::byte>(influence >> 8);
+    }
+  }
+
+  for (const auto& hand : playerHands_) {
+    writeCards(writer, hand);
+  }
+  writeCards(writer, deck_.getDeck());
+  writeCards(writer, deck_.getDiscardPile());
+  writeCards(writer, deck_.getRemovedCards());
+  writeCards(writer, cardEffectsInProgress_);
+  for (const auto& effects : cardsEffectsInThisTurn_) {
+    writeCards(writer, effects);
+  }
+
+  writeCount(writer, states_.size());
+  for (const auto& state : states_) {
+    if (const auto* type = std::get_if<StateType>(&state)) {
+      writer.u8(STATE_TAG_TYPE);
+      writer.u8(static_cast<uint8_t>(*type));
+    } else {
+      const auto& command = std::get<CommandPtr>(state);
+      if (command == nullptr) {
+        throw std::runtime_error("Board::serialize: null command on stack");
+      }
+      writer.u8(STATE_TAG_COMMAND);
+      command->writeSnapshot(writer);
+    }
+  }
+  return writer.offset();
+}
+
+void Board::deserialize(std::span<const std::byte> in) {
+  ByteReader reader(in);
+  for (const uint8_t byte : SNAPSHOT_MAGIC) {
+    if (reader.u8() != byte) {
+      throw std::runtime_error("Board::deserialize: not a board snapshot");
+    }
+  }
+  if (reader.u8() != SNAPSHOT_VERSION) {
+    throw std::runtime_error("Board::deserialize: unsupported version");
+  }
+
+  for (size_t side = 0; side < 2; ++side) {
+    spaceTrack_.spaceTrack_[side] = reader.below(9, "space track");
+    spaceTrack_.spaceTried_[side] = reader.u8();
+    milopsTrack_.milopsTrack_[side] = reader.below(6, "milops");
+    actionRoundTrack_.actionRound_[side] = reader.u8();
+    actionRoundTrack_.extraActionRound_[side] = reader.u8() != 0;
+  }
+  defconTrack_.defcon_ = reader.below(6, "defcon");
+  turnTrack_.turn_ = reader.below(11, "turn");
+  if (defconTrack_.defcon_ == 0 || turnTrack_.turn_ == 0) {
+    throw std::runtime_error("Board::deserialize: invalid track value");
+  }
+  vp_ = reader.i16();
+  currentArPlayer_ = readSnapshotSide(reader);
+  chinaCard_.owner = readSnapshotSide(reader);
+  chinaCard_.faceUp = reader.u8() != 0;
+  for (auto& card : headlineCards_) {
+    card = static_cast<CardEnum>(reader.below(SNAPSHOT_CARD_COUNT, "card"));
+  }
+
+  const auto influence_block =
+      reader.take(worldMap_.getCountriesCount() * 4);
+  for (size_t i = 0; i < worldMap_.getCountriesCount(); ++i) {
+    auto& country = worldMap_.getCountry(static_cast<CountryEnum>(i));
+    for (const Side side : {Side::USSR, Side::USA}) {
+      const size_t at = (i * 4) + (static_cast<size_t>(side) * 2);
+      const int influence =
+          static_cast<uint8_t>(influence_block[at]) |
+          (static_cast<uint8_t>(influence_block[at + 1]) << 8);
+      if (influence > INT16_MAX) [[unlikely]] {
+        throw std::runtime_error("Board::deserialize: negative influence");
+      }
+      country.clearInfluence(side);
+      country.addInfluence(side, influence);
+    }
+  }
+
+  for (auto& hand : playerHands_) {
+    readCards(reader, hand);
+  }
+  readCards(reader, deck_.getDeck());
+  readCards(reader, deck_.getDiscardPile());
+  readCards(reader, deck_.getRemovedCards());
+  cardEffectsInProgress_.clear();
+  for (const std::byte card : reader.take(reader.u8())) {
+    cardEffectsInProgress_.insert(checkedCard(card));
+  }
+  for (auto& effects : cardsEffectsInThisTurn_) {
+    readCards(reader, effects);
+  }
+
+  const uint8_t state_count = reader.u8();
+  states_.clear();
+  states_.reserve(state_count);
+  for (uint8_t i = 0; i < state_count; ++i) {
+    const uint8_t tag = reader.u8();
+    if (tag == STATE_TAG_TYPE) {
+      states_.emplace_back(static_cast<StateType>(
+          reader.below(SNAPSHOT_STATE_TYPE_COUNT, "state")));
+    } else if (tag == STATE_TAG_COMMAND) {
+      states_.emplace_back(Command::readSnapshot(reader, cardpool_));
+    } else {
+      throw std::runtime_error("Board::deserialize: unknown state entry");
+    }
+  }
+  if (reader.remaining() != 0) {
+    throw std::runtime_error("Board::deserialize: trailing bytes");
+  }
+}
@@ -0,0 +1,311 @@
+// ファイル: src/core/game_record.cpp
+// 役割:
+// 棋譜の可変長整数による符号化・復号、バッファ付きのファイル書き込みと読み込み、PhaseMachine::stepによる再生を実装する。
+// 背景:
+// 合法手の添字はほぼ1バイトに収まり、探索統計は直前の判断との差分をジグザグ符号化すると小さな値になるため、固定長より数倍小さく書ける。
+
+#include "tsge/core/game_record.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "tsge/core/phase_machine.hpp"
+
+namespace {
+
+// 勝者の符号はSideの値(引き分けはSide::NEUTRAL)で、MatchSummary::outcomesと同じ並び。
+constexpr uint8_t OUTCOME_UNFINISHED = 3;
+constexpr uint8_t FLAG_STATS = 1;
+constexpr float VALUE_SCALE = 32767.0F;
+constexpr size_t FILE_HEADER_SIZE = 8;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putFixed(std::vector<uint8_t>& out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+int64_t quantize(float value) {
+  return std::lround(std::clamp(value, -1.0F, 1.0F) * VALUE_SCALE);
+}
+
+// 範囲を確かめながら先頭から読み進める
+class ByteCursor {
+ public:
+  explicit ByteCursor(std::span<const uint8_t> bytes) : bytes_{bytes} {}
+
+  uint64_t varint() {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = take();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw std::runtime_error("GameRecord: varint too long");
+  }
+
+  uint64_t fixed(size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+      value |= static_cast<uint64_t>(take()) << (8 * i);
+    }
+    return value;
+  }
+
+  uint8_t take() {
+    if (offset_ >= bytes_.size()) {
+      throw std::runtime_error("GameRecord: truncated record");
+    }
+    return bytes_[offset_++];
+  }
+
+  [[nodiscard]] size_t remaining() const { return bytes_.size() - offset_; }
+  [[nodiscard]] size_t offset() const { return offset_; }
+
+ private:
+  std::span<const uint8_t> bytes_;
+  size_t offset_ = 0;
+};
+
+}  // namespace
+
+void GameRecord::encode(std::vector<uint8_t>& out) const {
+  if (!stats.empty() && stats.size() != choices.size()) {
+    throw std::invalid_argument(
+        "GameRecord::encode: stats must be empty or match choices");
+  }
+  putFixed(out, seed, 8);
+  out.push_back(winner.has_value() ? static_cast<uint8_t>(*winner)
+                                   : OUTCOME_UNFINISHED);
+  out.push_back(stats.empty() ? 0 : FLAG_STATS);
+  putVarint(out, choices.size());
+  for (const uint32_t choice : choices) {
+    putVarint(out, choice);
+  }
+  int64_t previous_visits = 0;
+  int64_t previous_value = 0;
+  for (const auto& decision : stats) {
+    const auto visits = static_cast<int64_t>(decision.visits);
+    const int64_t value = quantize(decision.value);
+    putVarint(out, zigzag(visits - previous_visits));
+    putVarint(out, zigzag(value - previous_value));
+    previous_visits = visits;
+    previous_value = value;
+  }
+}
+
+GameRecord GameRecord::decode(std::span<const uint8_t> payload) {
+  ByteCursor cursor(payload);
+  GameRecord record;
+  record.seed = cursor.fixed(8);
+  const uint8_t outcome = cursor.take();
+  if (outcome < OUTCOME_UNFINISHED) {
+    record.winner = static_cast<Side>(outcome);
+  } else if (outcome != OUTCOME_UNFINISHED) {
+    throw std::runtime_error("GameRecord: unknown outcome");
+  }
+  const uint8_t flags = cursor.take();
+  if ((flags & ~FLAG_STATS) != 0) {
+    throw std::runtime_error("GameRecord: unknown flags");
+  }
+  const uint64_t count = cursor.varint();
+  // 1判断につき少なくとも1バイトあるはずなので、壊れた長さで巨大な確保をしない
+  if (count > cursor.remaining()) {
+    throw std::runtime_error("GameRecord: truncated record");
+  }
+  record.choices.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    const uint64_t choice = cursor.varint();
+    if (choice > std::numeric_limits<uint32_t>::max()) {
+      throw std::runtime_error("GameRecord: choice out of range");
+    }
+    record.choices.push_back(static_cast<uint32_t>(choice));
+  }
+  if ((flags & FLAG_STATS) != 0) {
+    record.stats.reserve(count);
+    int64_t visits = 0;
+    int64_t value = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+      visits += unzigzag(cursor.varint());
+      value += unzigzag(cursor.varint());
+      if (visits < 0 || visits > std::numeric_limits<uint32_t>::max() ||
+          std::abs(value) > static_cast<int64_t>(VALUE_SCALE)) {
+        throw std::runtime_error("GameRecord: stats out of range");
+      }
+      record.stats.push_back({static_cast<uint32_t>(visits),
+                              static_cast<float>(value) / VALUE_SCALE});
+    }
+  }
+  if (cursor.remaining() != 0) {
+    throw std::runtime_error("GameRecord: trailing bytes in record");
+  }
+  return record;
+}
+
+GameRecordWriter::GameRecordWriter(const std::string& path,
+                                   size_t buffer_size)
+    : out_(path, std::ios::binary | std::ios::trunc),
+      path_{path},
+      buffer_size_{std::max<size_t>(buffer_size, 64)} {
+  if (!out_) {
+    throw std::runtime_error("GameRecordWriter: cannot open " + path);
+  }
+  buffer_.reserve(buffer_size_);
+  buffer_.insert(buffer_.end(), GameRecord::MAGIC.begin(),
+                 GameRecord::MAGIC.end());
+  putFixed(buffer_, GameRecord::VERSION, 4);
+}
+
+GameRecordWriter::~GameRecordWriter() {
+  try {
+    flush();
+  } catch (const std::exception&) {
+    // デストラクタからは投げられないため、確実に書きたい場合は先にflushを呼ぶ
+  }
+}
+
+void GameRecordWriter::write(const GameRecord& record) {
+  payload_.clear();
+  record.encode(payload_);
+  putVarint(buffer_, payload_.size());
+  buffer_.insert(buffer_.end(), payload_.begin(), payload_.end());
+  ++games_;
+  if (buffer_.size() >= buffer_size_) {
+    flush();
+  }
+}
+
+void GameRecordWriter::flush() {
+  if (!buffer_.empty()) {
+    out_.write(reinterpret_cast<const char*>(buffer_.data()),
+               static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+  out_.flush();
+  if (!out_) {
+    throw std::runtime_error("GameRecordWriter: failed to write " + path_);
+  }
+}
+
+GameRecordReader::GameRecordReader(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("GameRecordReader: cannot open " + path);
+  }
+  data_.assign(std::istreambuf_iterator<char>(in),
+               std::istreambuf_iterator<char>());
+  if (data_.size() < FILE_HEADER_SIZE ||
+      !std::equal(GameRecord::MAGIC.begin(), GameRecord::MAGIC.end(),
+                  data_.begin())) {
+    throw std::runtime_error("GameRecordReader: not a game record file: " +
+                             path);
+  }
+  ByteCursor header{std::span(data_).subspan(4, 4)};
+  if (header.fixed(4) != GameRecord::VERSION) {
+    throw std::runtime_error("GameRecordReader: unsupported version: " +
+                             path);
+  }
+  offset_ = FILE_HEADER_SIZE;
+}
+
+bool GameRecordReader::next(GameRecord& record) {
+  if (offset_ >= data_.size()) {
+    return false;
+  }
+  ByteCursor cursor{std::span(data_).subspan(offset_)};
+  const uint64_t size = cursor.varint();
+  if (size > cursor.remaining()) {
+    throw std::runtime_error("GameRecordReader: truncated record");
+  }
+  const size_t begin = offset_ + cursor.offset();
+  record = GameRecord::decode(std::span(data_).subspan(begin, size));
+  offset_ = begin + size;
+  return true;
+}
+
+ReplayDriver::ReplayDriver(
+    const std::array<std::unique_ptr<Card>, 111>& cardpool, GameRecord record)
+    : cardpool_{cardpool}, record_{std::move(record)} {
+  restart();
+}
+
+void ReplayDriver::restart() {
+  rng_.seed(record_.seed);
+  board_.emplace(cardpool_);
+  board_->getRandomizer().setRng(&rng_);
+  board_->getDeck().addEarlyWarCards();
+  board_->pushState(StateType::TURN_START);
+  position_ = 0;
+  winner_.reset();
+  absorb(PhaseMachine::step(*board_));
+}
+
+bool ReplayDriver::next() {
+  if (position_ >= record_.choices.size()) {
+    return false;
+  }
+  if (legal_moves_.empty()) {
+    throw std::runtime_error("ReplayDriver: decisions remain after game end");
+  }
+  const uint32_t chosen = record_.choices[position_];
+  if (chosen >= legal_moves_.size()) {
+    throw std::runtime_error("ReplayDriver: choice " + std::to_string(chosen) +
+                             " out of range at decision " +
+                             std::to_string(position_));
+  }
+  // stepの結果で合法手を置き換えるため、適用する手の列は先に取り出しておく
+  const auto legal_moves = std::move(legal_moves_);
+  absorb(PhaseMachine::step(*board_, legal_moves, chosen));
+  ++position_;
+  return true;
+}
+
+void ReplayDriver::seek(size_t decision) {
+  if (decision > record_.choices.size()) {
+    throw std::out_of_range("ReplayDriver::seek: decision " +
+                            std::to_string(decision) + " beyond " +
+                            std::to_string(record_.choices.size()));
+  }
+  if (decision < position_) {
+    restart();
+  }
+  while (position_ < decision) {
+    next();
+  }
+}
+
+void ReplayDriver::absorb(
+    std::tuple<std::vector<std::shared_ptr<Move>>, Side, std::optional<Side>>&&
+        result) {
+  auto& [legal_moves, side, winner] = result;
+  legal_moves_ = std::move(legal_moves);
+  side_ = side;
+  if (winner.has_value()) {
+    winner_ = winner;
+    legal_moves_.clear();
+    side_ = Side::NEUTRAL;
+  }
+}
@@ -0,0 +1,240 @@
+// ファイル: src/core/perft.cpp
+// 役割:
+// 盤面の複製とPhaseMachine::stepで判断の木を深さ優先に辿り、判断・手・到達局面を数える。根の手ごとの部分木をスレッドプールで並列に数える。
+// 背景:
+// 偶然手番の種は根からの添字の列だけで決めるため、辿る順序やスレッド数を変えても数は変わらず、固定値との比較に使える。
+
+#include "tsge/core/perft.hpp"
+
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <variant>
+
+#include "tsge/actions/action_index.hpp"
+#include "tsge/actions/command.hpp"
+#include "tsge/actions/move.hpp"
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/enums/enum_names.hpp"
+#include "tsge/utils/work_stealing_pool.hpp"
+
+namespace {
+
+using LegalMoves = std::vector<std::shared_ptr<Move>>;
+
+// ActionIndex::Kindの並び。最後がOTHER
+constexpr std::array<std::string_view, PERFT_MOVE_CLASS_COUNT>
+    MOVE_CLASS_NAMES = {
+        "HEADLINE",
+        "EVENT",
+        "SPACE_RACE",
+        "DISCARD",
+        "COUP",
+        "REALIGNMENT",
+        "PLACE_INFLUENCE",
+        "EVENT_PLACE_INFLUENCE",
+        "EVENT_REMOVE_INFLUENCE",
+        "PASS",
+        "OTHER",
+};
+
+// step直後の盤面から、いま返された判断の分類を決める
+size_t decisionOf(Board& board, Side side) {
+  const auto& states = board.getStates();
+  if (!states.empty()) {
+    if (const auto* command = std::get_if<CommandPtr>(&states.back())) {
+      if (*command != nullptr && (*command)->requiresPlayerInput()) {
+        return PERFT_REQUEST_DECISION;
+      }
+    } else {
+      // ARの判断ではhandleActionRoundが完了の状態を積んでから合法手を返す
+      switch (std::get<StateType>(states.back())) {
+        case StateType::AR_USSR_COMPLETE:
+          return static_cast<size_t>(StateType::AR_USSR);
+        case StateType::AR_USA_COMPLETE:
+          return static_cast<size_t>(StateType::AR_USA);
+        default:
+          break;
+      }
+    }
+  }
+  return static_cast<size_t>(side == Side::USSR
+                                 ? StateType::HEADLINE_CARD_SELECT_USSR
+                                 : StateType::HEADLINE_CARD_SELECT_USA);
+}
+
+size_t moveClassOf(const Move& move) {
+  const size_t index = ActionIndex::moveToIndex(move);
+  if (index == ActionIndex::INVALID) {
+    return PERFT_OTHER_MOVE_CLASS;
+  }
+  return static_cast<size_t>(ActionIndex::kindOf(index));
+}
+
+// Walker: 1スレッド分の走査。乱数と出目の列を持ち、部分木の数をcountsへ足す。
+class Walker {
+ public:
+  explicit Walker(const PerftConfig& config) : config_{config} {}
+
+  // parentでmovesのindex番目を選んで進め、残りdepthの部分木を数える
+  void advance(const Board& parent, const LegalMoves& moves, size_t index,
+               int depth, uint64_t key) {
+    std::vector<int> forced;
+    advanceWithDice(parent, moves, index, depth, key, forced);
+  }
+
+  // step直後のboard(合法手moves、残りdepth)から下を数える
+  void visit(Board& board, const LegalMoves& moves, Side side, bool finished,
+             int depth, uint64_t key) {
+    if (depth == 0) {
+      ++counts_.nodes;
+      return;
+    }
+    if (finished) {
+      ++counts_.terminals;
+      return;
+    }
+    ++counts_.decisions[decisionOf(board, side)];
+    for (const auto& move : moves) {
+      ++counts_.moves[moveClassOf(*move)];
+    }
+    if (depth == 1 && config_.dice == PerftDice::SEEDED) {
+      // 最後の手は1手につき1局面にしかならないため、stepせずに数える
+      counts_.nodes += moves.size();
+      return;
+    }
+    for (size_t i = 0; i < moves.size(); ++i) {
+      advance(board, moves, i, depth - 1, combineMoveKey(key, i));
+    }
+  }
+
+  [[nodiscard]] const PerftCounts& counts() const { return counts_; }
+
+ private:
+  // forcedを出目の先頭として進める。forcedより多くサイコロを振ったら、
+  // 次の出目を1〜6に決めて進め直す。
+  void advanceWithDice(const Board& parent, const LegalMoves& moves,
+                       size_t index, int depth, uint64_t key,
+                       std::vector<int>& forced) {
+    Board child(parent);
+    auto& randomizer = child.getRandomizer();
+    randomizer.setRng(&rng_);
+    rng_.seed(key);
+    randomizer.forceDice(forced);
+    auto [next_moves, side, winner] = PhaseMachine::step(child, moves, index);
+    ++counts_.steps;
+    const size_t rolled = randomizer.diceRolled();
+    randomizer.forceDice({});
+
+    if (config_.dice == PerftDice::ENUMERATE && rolled > forced.size()) {
+      for (int die = 1; die <= 6; ++die) {
+        forced.push_back(die);
+        advanceWithDice(parent, moves, index, depth, key, forced);
+        forced.pop_back();
+      }
+      return;
+    }
+    visit(child, next_moves, side,
+          winner.has_value() || next_moves.empty(), depth, key);
+  }
+
+  const PerftConfig& config_;
+  std::mt19937_64 rng_;
+  PerftCounts counts_;
+};
+
+double perSecond(uint64_t count, std::chrono::nanoseconds elapsed) {
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+}  // namespace
+
+std::string_view perftDecisionName(size_t decision) {
+  if (decision == PERFT_REQUEST_DECISION) {
+    return "REQUEST";
+  }
+  return tsge::stateTypeName(static_cast<StateType>(decision));
+}
+
+std::string_view perftMoveClassName(size_t move_class) {
+  return MOVE_CLASS_NAMES.at(move_class);
+}
+
+PerftCounts& PerftCounts::operator+=(const PerftCounts& other) {
+  nodes += other.nodes;
+  terminals += other.terminals;
+  steps += other.steps;
+  for (size_t i = 0; i < decisions.size(); ++i) {
+    decisions[i] += other.decisions[i];
+  }
+  for (size_t i = 0; i < moves.size(); ++i) {
+    moves[i] += other.moves[i];
+  }
+  return *this;
+}
+
+double PerftResult::nodesPerSecond() const {
+  return perSecond(total.nodes, elapsed);
+}
+
+double PerftResult::stepsPerSecond() const {
+  return perSecond(total.steps, elapsed);
+}
+
+PerftResult runPerft(const Board& root, const PerftConfig& config) {
+  if (config.depth < 0) {
+    throw std::invalid_argument("runPerft: depth must not be negative");
+  }
+  if (config.threads == 0) {
+    throw std::invalid_argument("runPerft: threads must be positive");
+  }
+  const auto start = std::chrono::steady_clock::now();
+  PerftResult result;
+
+  // 根のstepの偶然手番は、出目を列挙する場合もseedで決める
+  Board board(root);
+  std::mt19937_64 rng(config.seed);
+  board.getRandomizer().setRng(&rng);
+  LegalMoves moves;
+  Side side = Side::NEUTRAL;
+  std::optional<Side> winner;
+  std::tie(moves, side, winner) = PhaseMachine::step(board);
+  result.total.steps = 1;
+
+  if (config.depth == 0) {
+    result.total.nodes = 1;
+  } else if (winner.has_value() || moves.empty()) {
+    result.total.terminals = 1;
+  } else {
+    result.total.decisions[decisionOf(board, side)] = 1;
+    for (const auto& move : moves) {
+      ++result.total.moves[moveClassOf(*move)];
+    }
+    result.root_moves.resize(moves.size());
+    if (config.depth == 1 && config.dice == PerftDice::SEEDED) {
+      for (auto& counts : result.root_moves) {
+        counts.nodes = 1;
+      }
+    } else {
+      WorkStealingPool pool(config.threads);
+      for (size_t i = 0; i < moves.size(); ++i) {
+        pool.submit([&, i] {
+          Walker walker(config);
+          walker.advance(board, moves, i, config.depth - 1,
+                         combineMoveKey(config.seed, i));
+          result.root_moves[i] = walker.counts();
+        });
+      }
+      pool.wait();
+    }
+    for (const auto& counts : result.root_moves) {
+      result.total += counts;
+    }
+  }
+
+  result.elapsed = std::chrono::steady_clock::now() - start;
+  return result;
+}
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <ranges>
+#include <stdexcept>
 #include <variant>
 
 #include "tsge/actions/command.hpp"
@@ -331,10 +332,7 @@ MaybeStepOutput handleState(Board& board, StateStack& states, StateType state) {
           return;
         }
         states.emplace_back(std::make_shared<RequestCommand>(
-            side, [side](const Board& next_board) {
-              return GameLogicLegalMovesGenerator::spaceTrackDiscardLegalMoves(
-                  next_board, side);
-            }));
+            side, RequestDescriptor::spaceTrackDiscard()));
       };
       enqueue_space_track_discard(Side::USSR);
       enqueue_space_track_discard(Side::USA);
@@ -412,3 +410,14 @@ PhaseMachine::step(Board& board,
 
   return makeTerminalResult(Side::NEUTRAL);
 }
+
+std::tuple<std::vector<std::shared_ptr<Move>>, Side, std::optional<Side>>
+PhaseMachine::step(Board& board,
+                   std::span<const std::shared_ptr<Move>> legal_moves,
+                   std::size_t chosen_index) {
+  if (chosen_index >= legal_moves.size()) {
+    throw std::out_of_range("PhaseMachine::step: chosen index out of range");
+  }
+  return step(board, std::optional<std::shared_ptr<Move>>{
+                         legal_moves[chosen_index]});
+}
@@ -0,0 +1,514 @@
+// ファイル: src/core/position_text.cpp
+// 役割:
+// 局面テキストの書き出しと、行ごとの検証をしながら作業用のBoardへ組み立てる読み込み、コーパスの分割を実装する。
+// 背景:
+// 各トラックは範囲で丸める操作しか公開していないため、作業用のBoardで値を作ってから読み戻して確かめ、
+// 最後にスナップショットで呼び出し側のBoardへ移すことで、途中で失敗しても盤面を壊さない。
+
+#include "tsge/core/position_text.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#include "tsge/actions/command.hpp"
+#include "tsge/enums/enum_names.hpp"
+#include "tsge/utils/byte_stream.hpp"
+
+namespace {
+
+constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+constexpr size_t COMMAND_CAPACITY = 256;
+
+bool isSuperpower(CountryEnum country) {
+  return country == CountryEnum::USSR || country == CountryEnum::USA;
+}
+
+// 書き出し
+
+void appendCards(std::string& out, std::string_view key,
+                 const auto& cards) {
+  out += key;
+  for (const CardEnum card : cards) {
+    out += ' ';
+    out += tsge::cardName(card);
+  }
+  out += '\n';
+}
+
+void appendPair(std::string& out, std::string_view key, int ussr, int usa) {
+  out += key;
+  out += ' ' + std::to_string(ussr) + ' ' + std::to_string(usa) + '\n';
+}
+
+std::string commandHex(const Command& command) {
+  std::array<std::byte, COMMAND_CAPACITY> buffer{};
+  ByteWriter writer(buffer);
+  command.writeSnapshot(writer);
+  std::string hex;
+  hex.reserve(writer.offset() * 2);
+  for (size_t i = 0; i < writer.offset(); ++i) {
+    const auto value = static_cast<uint8_t>(buffer[i]);
+    hex += HEX_DIGITS[value >> 4];
+    hex += HEX_DIGITS[value & 0x0F];
+  }
+  return hex;
+}
+
+// 読み込み
+
+class LineParser {
+ public:
+  LineParser(size_t line_number, std::vector<std::string_view> tokens)
+      : line_number_{line_number}, tokens_{std::move(tokens)} {}
+
+  [[noreturn]] void fail(const std::string& message) const {
+    throw std::runtime_error("position line " + std::to_string(line_number_) +
+                             ": " + message);
+  }
+
+  [[nodiscard]] std::string_view key() const { return tokens_.front(); }
+  // キーを除いた値の数
+  [[nodiscard]] size_t size() const { return tokens_.size() - 1; }
+
+  void expectSize(size_t count) const {
+    if (size() != count) {
+      fail(std::string(key()) + " takes " + std::to_string(count) +
+           " values");
+    }
+  }
+
+  [[nodiscard]] std::string_view token(size_t index) const {
+    if (index >= size()) {
+      fail(std::string(key()) + " is missing a value");
+    }
+    return tokens_[index + 1];
+  }
+
+  [[nodiscard]] int integer(size_t index, int min, int max) const {
+    const std::string_view text = token(index);
+    int value = 0;
+    const auto [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size()) {
+      fail("not an integer: " + std::string(text));
+    }
+    if (value < min || value > max) {
+      fail(std::string(key()) + " out of range: " + std::string(text));
+    }
+    return value;
+  }
+
+  template <typename Enum>
+  [[nodiscard]] Enum name(size_t index,
+                          std::optional<Enum> (*parse)(std::string_view),
+                          const char* what) const {
+    const auto value = parse(token(index));
+    if (!value.has_value()) {
+      fail(std::string("unknown ") + what + ": " + std::string(token(index)));
+    }
+    return *value;
+  }
+
+  [[nodiscard]] Side side(size_t index) const {
+    const Side value = name(index, &tsge::parseSideName, "side");
+    if (value == Side::NEUTRAL) {
+      fail("side must be USSR or USA");
+    }
+    return value;
+  }
+
+  [[nodiscard]] std::vector<CardEnum> cards(size_t first) const {
+    std::vector<CardEnum> cards;
+    cards.reserve(size() > first ? size() - first : 0);
+    for (size_t i = first; i < size(); ++i) {
+      cards.push_back(name(i, &tsge::parseCardName, "card"));
+    }
+    return cards;
+  }
+
+ private:
+  size_t line_number_;
+  std::vector<std::string_view> tokens_;
+};
+
+std::vector<std::string_view> tokenize(std::string_view line) {
+  line = line.substr(0, line.find('#'));
+  std::vector<std::string_view> tokens;
+  size_t begin = 0;
+  while (begin < line.size()) {
+    begin = line.find_first_not_of(" \t\r", begin);
+    if (begin == std::string_view::npos) {
+      break;
+    }
+    const size_t end = std::min(line.find_first_of(" \t\r", begin),
+                                line.size());
+    tokens.push_back(line.substr(begin, end - begin));
+    begin = end;
+  }
+  return tokens;
+}
+
+// textを行に分け、空でない行ごとにvisit(行番号, 語の列)を呼ぶ
+template <typename Visitor>
+void forEachLine(std::string_view text, Visitor&& visit) {
+  size_t line_number = 0;
+  size_t begin = 0;
+  while (begin <= text.size()) {
+    const size_t end = std::min(text.find('\n', begin), text.size());
+    ++line_number;
+    auto tokens = tokenize(text.substr(begin, end - begin));
+    if (!tokens.empty()) {
+      visit(line_number, std::move(tokens));
+    }
+    begin = end + 1;
+  }
+}
+
+int hexValue(char digit) {
+  const size_t value = HEX_DIGITS.find(digit);
+  return value == std::string_view::npos ? -1 : static_cast<int>(value);
+}
+
+CommandPtr parseCommand(const LineParser& line, const Board& board) {
+  line.expectSize(1);
+  const std::string_view hex = line.token(0);
+  if (hex.size() % 2 != 0 || hex.size() / 2 > COMMAND_CAPACITY) {
+    line.fail("malformed command");
+  }
+  std::array<std::byte, COMMAND_CAPACITY> buffer{};
+  for (size_t i = 0; i < hex.size() / 2; ++i) {
+    const int high = hexValue(hex[i * 2]);
+    const int low = hexValue(hex[(i * 2) + 1]);
+    if (high < 0 || low < 0) {
+      line.fail("malformed command");
+    }
+    buffer[i] = static_cast<std::byte>((high << 4) | low);
+  }
+  ByteReader reader{std::span(buffer).first(hex.size() / 2)};
+  CommandPtr command;
+  try {
+    command = Command::readSnapshot(reader, board.getCardpool());
+  } catch (const std::runtime_error& error) {
+    line.fail(error.what());
+  }
+  if (reader.remaining() != 0) {
+    line.fail("trailing bytes in command");
+  }
+  return command;
+}
+
+// 丸めのある操作で値を作ったあと、読み戻して一致を確かめる
+void expectEqual(const LineParser& line, int actual, int expected) {
+  if (actual != expected) {
+    line.fail(std::string(line.key()) + " " + std::to_string(expected) +
+              " is not reachable");
+  }
+}
+
+void applyLine(const LineParser& line, Board& board) {
+  const std::string_view key = line.key();
+  if (key == "turn") {
+    line.expectSize(1);
+    const int turn = line.integer(0, 1, 10);
+    while (board.getTurnTrack().getTurn() < turn) {
+      board.getTurnTrack().nextTurn();
+    }
+  } else if (key == "action_round") {
+    line.expectSize(2);
+    auto& track = board.getActionRoundTrack();
+    const int turn = board.getTurnTrack().getTurn();
+    for (const Side side : {Side::USSR, Side::USA}) {
+      const int rounds = line.integer(static_cast<size_t>(side), 0, 8);
+      for (int i = 0; i < rounds; ++i) {
+        track.advanceActionRound(side, turn);
+      }
+      expectEqual(line, track.getActionRound(side), rounds);
+    }
+  } else if (key == "extra_action_round") {
+    line.expectSize(2);
+    auto& track = board.getActionRoundTrack();
+    for (const Side side : {Side::USSR, Side::USA}) {
+      if (line.integer(static_cast<size_t>(side), 0, 1) == 1) {
+        track.setExtraActionRound(side);
+      } else {
+        track.clearExtraActionRound(side);
+      }
+    }
+  } else if (key == "ar_player") {
+    line.expectSize(1);
+    // ARが始まる前はNEUTRAL
+    board.setCurrentArPlayer(line.name(0, &tsge::parseSideName, "side"));
+  } else if (key == "defcon") {
+    line.expectSize(1);
+    board.getDefconTrack().setDefcon(line.integer(0, 1, 5));
+  } else if (key == "vp") {
+    line.expectSize(1);
+    board.changeVp(line.integer(0, INT16_MIN, INT16_MAX));
+  } else if (key == "space") {
+    line.expectSize(2);
+    for (const Side side : {Side::USSR, Side::USA}) {
+      board.getSpaceTrack().advanceSpaceTrack(
+          side, line.integer(static_cast<size_t>(side), 0, 8));
+    }
+  } else if (key == "space_tried") {
+    line.expectSize(2);
+    for (const Side side : {Side::USSR, Side::USA}) {
+      const int tried = line.integer(static_cast<size_t>(side), 0, 2);
+      for (int i = 0; i < tried; ++i) {
+        board.getSpaceTrack().spaceTried(side);
+      }
+    }
+  } else if (key == "milops") {
+    line.expectSize(2);
+    for (const Side side : {Side::USSR, Side::USA}) {
+      board.getMilopsTrack().advanceMilopsTrack(
+          side, line.integer(static_cast<size_t>(side), 0, 5));
+    }
+  } else if (key == "china") {
+    line.expectSize(2);
+    const std::string_view face = line.token(1);
+    if (face != "up" && face != "down") {
+      line.fail("china face must be up or down");
+    }
+    board.giveChinaCardTo(line.side(0), face == "up");
+  } else if (key == "headline") {
+    line.expectSize(2);
+    for (const Side side : {Side::USSR, Side::USA}) {
+      board.setHeadlineCard(side,
+                            line.name(static_cast<size_t>(side),
+                                      &tsge::parseCardName, "card"));
+    }
+  } else if (key == "influence") {
+    line.expectSize(3);
+    auto& country = board.getWorldMap().getCountry(
+        line.name(0, &tsge::parseCountryName, "country"));
+    for (const Side side : {Side::USSR, Side::USA}) {
+      country.clearInfluence(side);
+      country.addInfluence(
+          side, line.integer(static_cast<size_t>(side) + 1, 0, INT16_MAX));
+    }
+  } else if (key == "hand") {
+    board.getPlayerHand(line.side(0)) = line.cards(1);
+  } else if (key == "deck") {
+    board.getDeck().getDeck() = line.cards(0);
+  } else if (key == "discard") {
+    board.getDeck().getDiscardPile() = line.cards(0);
+  } else if (key == "removed") {
+    board.getDeck().getRemovedCards() = line.cards(0);
+  } else if (key == "in_progress") {
+    for (const CardEnum card : line.cards(0)) {
+      board.addCardEffectInProgress(card);
+    }
+  } else if (key == "effects") {
+    const Side side = line.side(0);
+    for (const CardEnum card : line.cards(1)) {
+      board.addCardEffectInThisTurn(side, card);
+    }
+  } else if (key == "state") {
+    line.expectSize(1);
+    board.pushState(line.name(0, &tsge::parseStateTypeName, "state"));
+  } else if (key == "command") {
+    board.pushState(parseCommand(line, board));
+  } else {
+    line.fail("unknown key: " + std::string(key));
+  }
+}
+
+// 同じキーを2度書けるのは陣営や国ごとの項目と状態スタックだけ
+std::string uniqueKey(const LineParser& line) {
+  const std::string_view key = line.key();
+  if (key == "state" || key == "command") {
+    return {};
+  }
+  if ((key == "hand" || key == "effects" || key == "influence") &&
+      line.size() > 0) {
+    return std::string(key) + ' ' + std::string(line.token(0));
+  }
+  return std::string(key);
+}
+
+}  // namespace
+
+std::string writePositionText(const Board& board) {
+  std::string out;
+  out.reserve(2048);
+  out += "turn " + std::to_string(board.getTurnTrack().getTurn()) + '\n';
+  const auto& rounds = board.getActionRoundTrack();
+  appendPair(out, "action_round", rounds.getActionRound(Side::USSR),
+             rounds.getActionRound(Side::USA));
+  appendPair(out, "extra_action_round",
+             rounds.hasExtraActionRound(Side::USSR) ? 1 : 0,
+             rounds.hasExtraActionRound(Side::USA) ? 1 : 0);
+  out += "ar_player ";
+  out += tsge::sideName(board.getCurrentArPlayer());
+  out += '\n';
+  out += "defcon " + std::to_string(board.getDefconTrack().getDefcon()) + '\n';
+  out += "vp " + std::to_string(board.getVp()) + '\n';
+  const auto& space = board.getSpaceTrack();
+  appendPair(out, "space", space.getSpaceTrackPosition(Side::USSR),
+             space.getSpaceTrackPosition(Side::USA));
+  appendPair(out, "space_tried", space.getSpaceTried(Side::USSR),
+             space.getSpaceTried(Side::USA));
+  appendPair(out, "milops", board.getMilopsTrack().getMilops(Side::USSR),
+             board.getMilopsTrack().getMilops(Side::USA));
+  out += "china ";
+  out += tsge::sideName(board.getChinaCardOwner());
+  out += board.isChinaCardFaceUp() ? " up\n" : " down\n";
+  out += "headline ";
+  out += tsge::cardName(board.getHeadlineCard(Side::USSR));
+  out += ' ';
+  out += tsge::cardName(board.getHeadlineCard(Side::USA));
+  out += '\n';
+
+  // 超大国の欄は新しいBoardの初期値と同じなら書かない
+  const WorldMap initial_map;
+  const auto& world_map = board.getWorldMap();
+  for (size_t i = 0; i < world_map.getCountriesCount(); ++i) {
+    const auto id = static_cast<CountryEnum>(i);
+    const auto& country = world_map.getCountry(id);
+    const int ussr = country.getInfluence(Side::USSR);
+    const int usa = country.getInfluence(Side::USA);
+    const auto& initial = initial_map.getCountry(id);
+    const bool unchanged =
+        isSuperpower(id) ? ussr == initial.getInfluence(Side::USSR) &&
+                               usa == initial.getInfluence(Side::USA)
+                         : ussr == 0 && usa == 0;
+    if (!unchanged) {
+      out += "influence ";
+      out += tsge::countryName(id);
+      appendPair(out, "", ussr, usa);
+    }
+  }
+
+  for (const Side side : {Side::USSR, Side::USA}) {
+    appendCards(out, std::string("hand ") + std::string(tsge::sideName(side)),
+                board.getPlayerHand(side));
+  }
+  appendCards(out, "deck", board.getDeck().getDeck());
+  appendCards(out, "discard", board.getDeck().getDiscardPile());
+  appendCards(out, "removed", board.getDeck().getRemovedCards());
+  appendCards(out, "in_progress", board.getCardEffectsInProgress());
+  for (const Side side : {Side::USSR, Side::USA}) {
+    appendCards(out,
+                std::string("effects ") + std::string(tsge::sideName(side)),
+                board.getCardsEffectsInThisTurn(side));
+  }
+
+  // getStatesは非constのみのため、読むだけの目的でconstを外す
+  for (const auto& state : const_cast<Board&>(board).getStates()) {
+    if (const auto* type = std::get_if<StateType>(&state)) {
+      out += "state ";
+      out += tsge::stateTypeName(*type);
+    } else {
+      const auto& command = std::get<CommandPtr>(state);
+      if (command == nullptr) {
+        throw std::runtime_error("writePositionText: null command on stack");
+      }
+      out += "command " + commandHex(*command);
+    }
+    out += '\n';
+  }
+  return out;
+}
+
+void readPositionText(std::string_view text, Board& board) {
+  Board scratch(board.getCardpool());
+  // 書かない国の影響力は0。超大国の欄だけは初期値を残す。
+  auto& world_map = scratch.getWorldMap();
+  for (size_t i = 0; i < world_map.getCountriesCount(); ++i) {
+    const auto id = static_cast<CountryEnum>(i);
+    if (!isSuperpower(id)) {
+      world_map.getCountry(id).clearInfluence(Side::USSR);
+      world_map.getCountry(id).clearInfluence(Side::USA);
+    }
+  }
+
+  std::set<std::string> seen;
+  forEachLine(text, [&](size_t line_number,
+                        std::vector<std::string_view> tokens) {
+    const LineParser line(line_number, std::move(tokens));
+    const std::string unique = uniqueKey(line);
+    if (!unique.empty() && !seen.insert(unique).second) {
+      line.fail("duplicate " + unique);
+    }
+    // action_roundの上限はターンで決まるため、turnより後に書かせる
+    if (line.key() == "turn" && seen.contains("action_round")) {
+      line.fail("turn must precede action_round");
+    }
+    applyLine(line, scratch);
+  });
+
+  std::array<std::byte, Board::SNAPSHOT_CAPACITY> bytes{};
+  const size_t size = scratch.serialize(bytes);
+  board.deserialize(std::span(bytes).first(size));
+}
+
+std::vector<CorpusPosition> parsePositionCorpus(std::string_view contents) {
+  std::vector<CorpusPosition> positions;
+  std::set<std::string, std::less<>> names;
+  size_t line_number = 0;
+  size_t begin = 0;
+  const auto fail = [&](const std::string& message) {
+    throw std::runtime_error("corpus line " + std::to_string(line_number) +
+                             ": " + message);
+  };
+  while (begin <= contents.size()) {
+    const size_t end = std::min(contents.find('\n', begin), contents.size());
+    const std::string_view line = contents.substr(begin, end - begin);
+    ++line_number;
+    begin = end + 1;
+    const auto tokens = tokenize(line);
+    if (!tokens.empty() && tokens.front() == "position") {
+      if (tokens.size() != 2) {
+        fail("position takes a name");
+      }
+      if (!names.emplace(tokens[1]).second) {
+        fail("duplicate position " + std::string(tokens[1]));
+      }
+      positions.push_back({std::string(tokens[1]), {}, {}});
+      continue;
+    }
+    if (positions.empty()) {
+      if (!tokens.empty()) {
+        fail("expected position");
+      }
+      continue;
+    }
+    auto& position = positions.back();
+    if (!tokens.empty() && tokens.front() == "cardpool") {
+      if (tokens.size() != 2 || !position.cardpool.empty()) {
+        fail("position " + position.name + " needs exactly one cardpool");
+      }
+      position.cardpool = tokens[1];
+      continue;
+    }
+    position.text.append(line);
+    position.text += '\n';
+  }
+  for (const auto& position : positions) {
+    if (position.cardpool.empty()) {
+      throw std::runtime_error("corpus: position " + position.name +
+                               " has no cardpool");
+    }
+  }
+  return positions;
+}
+
+std::vector<CorpusPosition> loadPositionCorpus(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("loadPositionCorpus: cannot open " + path);
+  }
+  const std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+  return parsePositionCorpus(contents);
+}
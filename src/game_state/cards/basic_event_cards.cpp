@@ -15,11 +15,8 @@ std::vector<CommandPtr> DuckAndCover::event(Side side,
                                             const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
   commands.push_back(std::make_shared<ChangeDefconCommand>(-1));
-  commands.push_back(std::make_shared<LambdaCommand>([](Board& board) {
-    int current_defcon = board.getDefconTrack().getDefcon();
-    int vp_change = (5 - current_defcon);
-    board.pushState(std::make_shared<ChangeVpCommand>(Side::USA, vp_change));
-  }));
+  // 下げた後のDEFCONから、USAが5 - DEFCONのVPを得る
+  commands.push_back(std::make_shared<DefconVpCommand>(Side::USA, 5, -1));
   return commands;
 }
 
@@ -57,11 +54,8 @@ bool Fidel::canEvent(const Board& board) const {
 std::vector<CommandPtr> NuclearTestBan::event(Side side,
                                               const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.push_back(std::make_shared<LambdaCommand>([side](Board& board) {
-    int current_defcon = board.getDefconTrack().getDefcon();
-    int vp_change = (current_defcon - 2);
-    board.pushState(std::make_shared<ChangeVpCommand>(side, vp_change));
-  }));
+  // DEFCONを上げる前に、DEFCON - 2のVPを得る
+  commands.push_back(std::make_shared<DefconVpCommand>(side, -2, 1));
   commands.push_back(std::make_shared<ChangeDefconCommand>(2));
   return commands;
 }
@@ -74,21 +68,7 @@ bool NuclearTestBan::canEvent(const Board& board) const {
 std::vector<CommandPtr> Comecon::event(Side side,
                                        const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum = getId(), side = Side::USSR](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 4;
-        config.maxPerCountry = 1;
-        config.allowedRegions = std::vector<Region>{Region::EAST_EUROPE};
-        config.excludeOpponentControlled = true;  // 非US支配国のみ
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -96,25 +76,24 @@ bool Comecon::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> Comecon::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 4;
+  config.maxPerCountry = 1;
+  config.allowedRegions = std::vector<Region>{Region::EAST_EUROPE};
+  config.excludeOpponentControlled = true;  // 非US支配国のみ
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> Decolonization::event(Side side,
                                               const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum = getId(), side = Side::USSR](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 4;
-        config.maxPerCountry = 1;
-        config.allowedRegions =
-            std::vector<Region>{Region::AFRICA, Region::SOUTH_EAST_ASIA};
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -122,25 +101,25 @@ bool Decolonization::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> Decolonization::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 4;
+  config.maxPerCountry = 1;
+  config.allowedRegions =
+      std::vector<Region>{Region::AFRICA, Region::SOUTH_EAST_ASIA};
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> ColonialRearGuards::event(
     Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum = getId(), side = Side::USA](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 4;
-        config.maxPerCountry = 1;
-        config.allowedRegions =
-            std::vector<Region>{Region::AFRICA, Region::SOUTH_EAST_ASIA};
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USA, *this));
   return commands;
 }
 
@@ -148,24 +127,25 @@ bool ColonialRearGuards::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> ColonialRearGuards::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 4;
+  config.maxPerCountry = 1;
+  config.allowedRegions =
+      std::vector<Region>{Region::AFRICA, Region::SOUTH_EAST_ASIA};
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> PuppetGovernments::event(Side side,
                                                  const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum = getId(), side = Side::USA](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 3;
-        config.maxPerCountry = 1;
-        config.allowedRegions = std::nullopt;  // 全地域OK
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = true;  // 影響力のない国のみ
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USA, *this));
   return commands;
 }
 
@@ -173,25 +153,24 @@ bool PuppetGovernments::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> PuppetGovernments::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 3;
+  config.maxPerCountry = 1;
+  config.allowedRegions = std::nullopt;  // 全地域OK
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = true;  // 影響力のない国のみ
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> OASFounded::event(Side side,
                                           const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum = getId(), side = Side::USA](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 2;
-        config.maxPerCountry = 0;  // 無制限
-        config.allowedRegions =
-            std::vector<Region>{Region::CENTRAL_AMERICA, Region::SOUTH_AMERICA};
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USA, *this));
   return commands;
 }
 
@@ -199,24 +178,25 @@ bool OASFounded::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> OASFounded::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 2;
+  config.maxPerCountry = 0;  // 無制限
+  config.allowedRegions =
+      std::vector<Region>{Region::CENTRAL_AMERICA, Region::SOUTH_AMERICA};
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> LiberationTheology::event(
     Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum = getId(), side = Side::USSR](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 3;
-        config.maxPerCountry = 2;
-        config.allowedRegions = std::vector<Region>{Region::CENTRAL_AMERICA};
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -224,51 +204,25 @@ bool LiberationTheology::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> LiberationTheology::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 3;
+  config.maxPerCountry = 2;
+  config.allowedRegions = std::vector<Region>{Region::CENTRAL_AMERICA};
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> WarsawPactFormed::event(Side side,
                                                 const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
   // Warsaw Pact Formedは2つの選択肢: 除去 or 配置
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum = getId(), side = Side::USSR](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        std::vector<std::shared_ptr<Move>> moves;
-
-        // 選択肢1: 東欧4カ国から米影響力全除去
-        // 東欧の国リストを作成
-        std::vector<CountryEnum> east_europe_countries;
-        const auto& world_map = board.getWorldMap();
-        for (size_t i = static_cast<size_t>(CountryEnum::USA) + 1;
-             i < world_map.getCountriesCount(); ++i) {
-          auto country_enum = static_cast<CountryEnum>(i);
-          if (world_map.getCountry(country_enum)
-                  .hasRegion(Region::EAST_EUROPE)) {
-            east_europe_countries.push_back(country_enum);
-          }
-        }
-        auto remove_moves = CardEffectLegalMoveGenerator::
-            generateSelectCountriesRemoveAllInfluenceMoves(
-                board, card_enum, Side::USSR, Side::USA, east_europe_countries,
-                4);
-        moves.insert(moves.end(), std::make_move_iterator(remove_moves.begin()),
-                     std::make_move_iterator(remove_moves.end()));
-
-        // 選択肢2: 東欧に露影響力5配置（1国最大2）
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 5;
-        config.maxPerCountry = 2;
-        config.allowedRegions = std::vector<Region>{Region::EAST_EUROPE};
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = false;
-
-        auto place_moves = CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-        moves.insert(moves.end(), std::make_move_iterator(place_moves.begin()),
-                     std::make_move_iterator(place_moves.end()));
-
-        return moves;
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -276,24 +230,48 @@ bool WarsawPactFormed::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> WarsawPactFormed::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  std::vector<std::shared_ptr<Move>> moves;
+
+  // 選択肢1: 東欧4カ国から米影響力全除去
+  // 東欧の国リストを作成
+  std::vector<CountryEnum> east_europe_countries;
+  const auto& world_map = board.getWorldMap();
+  for (size_t i = static_cast<size_t>(CountryEnum::USA) + 1;
+       i < world_map.getCountriesCount(); ++i) {
+    auto country_enum = static_cast<CountryEnum>(i);
+    if (world_map.getCountry(country_enum).hasRegion(Region::EAST_EUROPE)) {
+      east_europe_countries.push_back(country_enum);
+    }
+  }
+  auto remove_moves = CardEffectLegalMoveGenerator::
+      generateSelectCountriesRemoveAllInfluenceMoves(
+          board, card_enum, Side::USSR, Side::USA, east_europe_countries, 4);
+  moves.insert(moves.end(), std::make_move_iterator(remove_moves.begin()),
+               std::make_move_iterator(remove_moves.end()));
+
+  // 選択肢2: 東欧に露影響力5配置（1国最大2）
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 5;
+  config.maxPerCountry = 2;
+  config.allowedRegions = std::vector<Region>{Region::EAST_EUROPE};
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = false;
+
+  auto place_moves = CardEffectLegalMoveGenerator::
+      generateCardSpecificPlaceInfluenceMoves(board, side, card_enum, config);
+  moves.insert(moves.end(), std::make_move_iterator(place_moves.begin()),
+               std::make_move_iterator(place_moves.end()));
+
+  return moves;
+}
+
 std::vector<CommandPtr> MarshallPlan::event(Side side,
                                             const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum = getId(), side = Side::USA](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 7;
-        config.maxPerCountry = 1;
-        config.allowedRegions = std::vector<Region>{Region::WEST_EUROPE};
-        config.excludeOpponentControlled = true;  // 非USSR支配国のみ
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USA, *this));
   return commands;
 }
 
@@ -301,25 +279,25 @@ bool MarshallPlan::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> MarshallPlan::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 7;
+  config.maxPerCountry = 1;
+  config.allowedRegions = std::vector<Region>{Region::WEST_EUROPE};
+  config.excludeOpponentControlled = true;  // 非USSR支配国のみ
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> UssuriRiverSkirmish::event(
     Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
   // Ussuri River Skirmishは条件分岐があるが、今回は配置の部分のみ実装
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum = getId(), side = Side::USA](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 4;
-        config.maxPerCountry = 2;
-        config.allowedRegions = std::vector<Region>{Region::ASIA};
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USA, *this));
   return commands;
 }
 
@@ -327,25 +305,25 @@ bool UssuriRiverSkirmish::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> UssuriRiverSkirmish::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 4;
+  config.maxPerCountry = 2;
+  config.allowedRegions = std::vector<Region>{Region::ASIA};
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> TheReformer::event(Side side,
                                            const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
   // The Reformerは条件によって配置数が変わるが、今回は4個の場合のみ実装
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum = getId(), side = Side::USSR](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        CardSpecialPlaceInfluenceConfig config;
-        config.totalInfluence = 4;  // 条件により6個の場合もある
-        config.maxPerCountry = 2;
-        config.allowedRegions = std::vector<Region>{Region::EUROPE};
-        config.excludeOpponentControlled = false;
-        config.onlyEmptyCountries = false;
-
-        return CardEffectLegalMoveGenerator::
-            generateCardSpecificPlaceInfluenceMoves(board, side, card_enum,
-                                                    config);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -353,55 +331,24 @@ bool TheReformer::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> TheReformer::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  CardSpecialPlaceInfluenceConfig config;
+  config.totalInfluence = 4;  // 条件により6個の場合もある
+  config.maxPerCountry = 2;
+  config.allowedRegions = std::vector<Region>{Region::EUROPE};
+  config.excludeOpponentControlled = false;
+  config.onlyEmptyCountries = false;
+
+  return CardEffectLegalMoveGenerator::generateCardSpecificPlaceInfluenceMoves(
+      board, side, card_enum, config);
+}
+
 std::vector<CommandPtr> SpecialRelationship::event(Side side,
                                                    const Board& board) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum = getId(), side = Side::USA](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        std::vector<std::shared_ptr<Move>> moves;
-
-        // UK支配をチェック
-        bool uk_controlled = board.getWorldMap()
-                                 .getCountry(CountryEnum::UNITED_KINGDOM)
-                                 .getControlSide() == Side::USA;
-
-        if (!uk_controlled) {
-          return moves;  // UK支配でない場合は空のmovesを返す
-        }
-
-        // NATO有効かチェック
-        bool nato_active =
-            board.getCardEffectsInProgress().contains(CardEnum::NATO);
-
-        if (nato_active) {
-          // NATO有効時: 西欧地域の各国に+2
-          const auto& western_europe_countries =
-              board.getWorldMap().countriesInRegion(Region::WEST_EUROPE);
-          moves.reserve(western_europe_countries.size());
-
-          for (const auto& country : western_europe_countries) {
-            moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-                card_enum, side,
-                std::map<CountryEnum, int>{{country.getId(), 2}}));
-          }
-        } else {
-          // NATO無効時: UK隣接国に+1
-          const auto& united_kingdom =
-              board.getWorldMap().getCountry(CountryEnum::UNITED_KINGDOM);
-          const auto uk_adjacent = united_kingdom.getAdjacentCountries();
-          moves.reserve(uk_adjacent.size());
-
-          for (const auto& country_enum : uk_adjacent) {
-            moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-                card_enum, side,
-                std::map<CountryEnum, int>{{country_enum, 1}}));
-          }
-        }
-
-        return moves;
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USA, *this));
 
   // VP+2はNATO有効時のみプッシュ
   bool nato_active = board.getCardEffectsInProgress().contains(CardEnum::NATO);
@@ -416,42 +363,53 @@ bool SpecialRelationship::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> SpecialRelationship::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  std::vector<std::shared_ptr<Move>> moves;
+
+  // UK支配をチェック
+  bool uk_controlled = board.getWorldMap()
+                           .getCountry(CountryEnum::UNITED_KINGDOM)
+                           .getControlSide() == Side::USA;
+
+  if (!uk_controlled) {
+    return moves;  // UK支配でない場合は空のmovesを返す
+  }
+
+  // NATO有効かチェック
+  bool nato_active = board.getCardEffectsInProgress().contains(CardEnum::NATO);
+
+  if (nato_active) {
+    // NATO有効時: 西欧地域の各国に+2
+    const auto& western_europe_countries =
+        board.getWorldMap().countriesInRegion(Region::WEST_EUROPE);
+    moves.reserve(western_europe_countries.size());
+
+    for (const auto& country : western_europe_countries) {
+      moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+          card_enum, side, std::map<CountryEnum, int>{{country.getId(), 2}}));
+    }
+  } else {
+    // NATO無効時: UK隣接国に+1
+    const auto& united_kingdom =
+        board.getWorldMap().getCountry(CountryEnum::UNITED_KINGDOM);
+    const auto uk_adjacent = united_kingdom.getAdjacentCountries();
+    moves.reserve(uk_adjacent.size());
+
+    for (const auto& country_enum : uk_adjacent) {
+      moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+          card_enum, side, std::map<CountryEnum, int>{{country_enum, 1}}));
+    }
+  }
+
+  return moves;
+}
+
 std::vector<CommandPtr> SouthAfricanUnrest::event(
     Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum = getId(), side = Side::USSR](
-          const Board& /*board*/) -> std::vector<std::shared_ptr<Move>> {
-        std::vector<std::shared_ptr<Move>> moves;
-        moves.reserve(4);
-
-        // 1. South Africa に +2
-        moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-            card_enum, side,
-            std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 2}}));
-
-        // 2. South Africa +1, Angola +1, Botswana +1
-        moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-            card_enum, side,
-            std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 1},
-                                       {CountryEnum::ANGOLA, 1},
-                                       {CountryEnum::BOTSWANA, 1}}));
-
-        // 3. South Africa +1, Angola +2
-        moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-            card_enum, side,
-            std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 1},
-                                       {CountryEnum::ANGOLA, 2}}));
-
-        // 4. South Africa +1, Botswana +2
-        moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-            card_enum, side,
-            std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 1},
-                                       {CountryEnum::BOTSWANA, 2}}));
-
-        return moves;
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -459,39 +417,42 @@ bool SouthAfricanUnrest::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> SouthAfricanUnrest::requestLegalMoves(
+    const Board& /*board*/, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  std::vector<std::shared_ptr<Move>> moves;
+  moves.reserve(4);
+
+  // 1. South Africa に +2
+  moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+      card_enum, side,
+      std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 2}}));
+
+  // 2. South Africa +1, Angola +1, Botswana +1
+  moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+      card_enum, side,
+      std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 1},
+                                 {CountryEnum::ANGOLA, 1},
+                                 {CountryEnum::BOTSWANA, 1}}));
+
+  // 3. South Africa +1, Angola +2
+  moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+      card_enum, side,
+      std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 1},
+                                 {CountryEnum::ANGOLA, 2}}));
+
+  // 4. South Africa +1, Botswana +2
+  moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+      card_enum, side,
+      std::map<CountryEnum, int>{{CountryEnum::SOUTH_AFRICA, 1},
+                                 {CountryEnum::BOTSWANA, 2}}));
+
+  return moves;
+}
+
 std::vector<CommandPtr> Junta::event(Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      side,
-      [card_enum = getId(),
-       side](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        std::vector<std::shared_ptr<Move>> moves;
-
-        // 中南米地域の全国を列挙
-        const auto& central_america_countries =
-            board.getWorldMap().countriesInRegion(Region::CENTRAL_AMERICA);
-        const auto& south_america_countries =
-            board.getWorldMap().countriesInRegion(Region::SOUTH_AMERICA);
-
-        moves.reserve(central_america_countries.size() +
-                      south_america_countries.size());
-
-        // 中米の各国に2影響力を配置するEventPlaceInfluenceMoveを生成
-        for (const auto& country : central_america_countries) {
-          moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-              card_enum, side,
-              std::map<CountryEnum, int>{{country.getId(), 2}}));
-        }
-
-        // 南米の各国に2影響力を配置するEventPlaceInfluenceMoveを生成
-        for (const auto& country : south_america_countries) {
-          moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
-              card_enum, side,
-              std::map<CountryEnum, int>{{country.getId(), 2}}));
-        }
-
-        return moves;
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(side, *this));
   return commands;
 }
 
@@ -499,17 +460,39 @@ bool Junta::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> Junta::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  std::vector<std::shared_ptr<Move>> moves;
+
+  // 中南米地域の全国を列挙
+  const auto& central_america_countries =
+      board.getWorldMap().countriesInRegion(Region::CENTRAL_AMERICA);
+  const auto& south_america_countries =
+      board.getWorldMap().countriesInRegion(Region::SOUTH_AMERICA);
+
+  moves.reserve(central_america_countries.size() +
+                south_america_countries.size());
+
+  // 中米の各国に2影響力を配置するEventPlaceInfluenceMoveを生成
+  for (const auto& country : central_america_countries) {
+    moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+        card_enum, side, std::map<CountryEnum, int>{{country.getId(), 2}}));
+  }
+
+  // 南米の各国に2影響力を配置するEventPlaceInfluenceMoveを生成
+  for (const auto& country : south_america_countries) {
+    moves.emplace_back(std::make_shared<EventPlaceInfluenceMove>(
+        card_enum, side, std::map<CountryEnum, int>{{country.getId(), 2}}));
+  }
+
+  return moves;
+}
+
 std::vector<CommandPtr> SocialistGovernments::event(
     Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum =
-           getId()](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
-            board, card_enum, Side::USSR, Side::USA, 3, 2,
-            std::vector<Region>{Region::WEST_EUROPE}, std::nullopt);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -517,21 +500,18 @@ bool SocialistGovernments::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> SocialistGovernments::requestLegalMoves(
+    const Board& board, Side /*side*/, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
+      board, card_enum, Side::USSR, Side::USA, 3, 2,
+      std::vector<Region>{Region::WEST_EUROPE}, std::nullopt);
+}
+
 std::vector<CommandPtr> TheVoiceOfAmerica::event(Side side,
                                                  const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum =
-           getId()](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        // 欧州以外の全地域
-        std::vector<Region> non_europe_regions = {
-            Region::ASIA, Region::MIDDLE_EAST, Region::AFRICA,
-            Region::CENTRAL_AMERICA, Region::SOUTH_AMERICA};
-        return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
-            board, card_enum, Side::USA, Side::USSR, 4, 2, non_europe_regions,
-            std::nullopt);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USA, *this));
   return commands;
 }
 
@@ -539,6 +519,18 @@ bool TheVoiceOfAmerica::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> TheVoiceOfAmerica::requestLegalMoves(
+    const Board& board, Side /*side*/, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  // 欧州以外の全地域
+  std::vector<Region> non_europe_regions = {
+      Region::ASIA, Region::MIDDLE_EAST, Region::AFRICA,
+      Region::CENTRAL_AMERICA, Region::SOUTH_AMERICA};
+  return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
+      board, card_enum, Side::USA, Side::USSR, 4, 2, non_europe_regions,
+      std::nullopt);
+}
+
 std::vector<CommandPtr> MarineBarracksBombing::event(
     Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
@@ -546,14 +538,7 @@ std::vector<CommandPtr> MarineBarracksBombing::event(
   commands.push_back(std::make_shared<RemoveAllInfluenceCommand>(
       Side::USA, CountryEnum::LEBANON));
   // 中東から米影響力2除去
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum =
-           getId()](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
-            board, card_enum, Side::USSR, Side::USA, 2, 2,
-            std::vector<Region>{Region::MIDDLE_EAST}, std::nullopt);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -561,20 +546,18 @@ bool MarineBarracksBombing::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> MarineBarracksBombing::requestLegalMoves(
+    const Board& board, Side /*side*/, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
+      board, card_enum, Side::USSR, Side::USA, 2, 2,
+      std::vector<Region>{Region::MIDDLE_EAST}, std::nullopt);
+}
+
 std::vector<CommandPtr> SuezCrisis::event(Side side,
                                           const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum =
-           getId()](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        std::vector<CountryEnum> candidates = {CountryEnum::FRANCE,
-                                               CountryEnum::UNITED_KINGDOM,
-                                               CountryEnum::ISRAEL};
-        return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
-            board, card_enum, Side::USSR, Side::USA, 4, 2, std::nullopt,
-            candidates);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -582,20 +565,23 @@ bool SuezCrisis::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> SuezCrisis::requestLegalMoves(
+    const Board& board, Side /*side*/, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  std::vector<CountryEnum> candidates = {CountryEnum::FRANCE,
+                                         CountryEnum::UNITED_KINGDOM,
+                                         CountryEnum::ISRAEL};
+  return CardEffectLegalMoveGenerator::generateRemoveInfluenceMoves(
+      board, card_enum, Side::USSR, Side::USA, 4, 2, std::nullopt, candidates);
+}
+
 std::vector<CommandPtr> EastEuropeanUnrest::event(Side side,
                                                   const Board& board) const {
   std::vector<CommandPtr> commands;
   // 現在の時期を取得 (ターン7以下はEarly/Mid War)
   int remove_amount = (board.getTurnTrack().getTurn() <= 7) ? 1 : 2;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USA,
-      [card_enum = getId(), remove_amount](
-          const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        return CardEffectLegalMoveGenerator::
-            generateSelectCountriesRemoveInfluenceMoves(
-                board, card_enum, Side::USA, Side::USSR, Region::EAST_EUROPE, 3,
-                remove_amount);
-      }));
+  commands.emplace_back(
+      std::make_shared<RequestCommand>(Side::USA, *this, remove_amount));
   return commands;
 }
 
@@ -603,21 +589,22 @@ bool EastEuropeanUnrest::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> EastEuropeanUnrest::requestLegalMoves(
+    const Board& board, Side /*side*/, int remove_amount) const {
+  const CardEnum card_enum = getId();
+  return CardEffectLegalMoveGenerator::
+      generateSelectCountriesRemoveInfluenceMoves(
+          board, card_enum, Side::USA, Side::USSR, Region::EAST_EUROPE, 3,
+          remove_amount);
+}
+
 std::vector<CommandPtr> PershingIIDeployed::event(
     Side side, const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
   // USSRが1VPを獲得
   commands.push_back(std::make_shared<ChangeVpCommand>(Side::USSR, 1));
   // 西欧3カ国から米国影響力を各1除去
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum =
-           getId()](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        return CardEffectLegalMoveGenerator::
-            generateSelectCountriesRemoveInfluenceMoves(
-                board, card_enum, Side::USSR, Side::USA, Region::WEST_EUROPE, 3,
-                1);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
@@ -625,24 +612,33 @@ bool PershingIIDeployed::canEvent(const Board& /*board*/) const {
   return true;
 }
 
+std::vector<std::shared_ptr<Move>> PershingIIDeployed::requestLegalMoves(
+    const Board& board, Side /*side*/, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  return CardEffectLegalMoveGenerator::
+      generateSelectCountriesRemoveInfluenceMoves(
+          board, card_enum, Side::USSR, Side::USA, Region::WEST_EUROPE, 3, 1);
+}
+
 std::vector<CommandPtr> MuslimRevolution::event(Side side,
                                                 const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR,
-      [card_enum =
-           getId()](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        std::vector<CountryEnum> candidates = {
-            CountryEnum::SUDAN, CountryEnum::IRAN,  CountryEnum::IRAQ,
-            CountryEnum::EGYPT, CountryEnum::LIBYA, CountryEnum::SAUDI_ARABIA,
-            CountryEnum::SYRIA, CountryEnum::JORDAN};
-        return CardEffectLegalMoveGenerator::
-            generateSelectCountriesRemoveAllInfluenceMoves(
-                board, card_enum, Side::USSR, Side::USA, candidates, 2);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
 bool MuslimRevolution::canEvent(const Board& /*board*/) const {
   return true;
 }
+
+std::vector<std::shared_ptr<Move>> MuslimRevolution::requestLegalMoves(
+    const Board& board, Side /*side*/, int /*value*/) const {
+  const CardEnum card_enum = getId();
+  std::vector<CountryEnum> candidates = {
+      CountryEnum::SUDAN, CountryEnum::IRAN,  CountryEnum::IRAQ,
+      CountryEnum::EGYPT, CountryEnum::LIBYA, CountryEnum::SAUDI_ARABIA,
+      CountryEnum::SYRIA, CountryEnum::JORDAN};
+  return CardEffectLegalMoveGenerator::
+      generateSelectCountriesRemoveAllInfluenceMoves(
+          board, card_enum, Side::USSR, Side::USA, candidates, 2);
+}
@@ -64,14 +64,16 @@ std::vector<CommandPtr> DeStainization::event(Side side,
                                               const Board& /*board*/) const {
   std::vector<CommandPtr> commands;
   // De-Stalinization: USSR影響力を1-4除去し、除去した数だけ配置
-  commands.emplace_back(std::make_shared<RequestCommand>(
-      Side::USSR, [](const Board& board) -> std::vector<std::shared_ptr<Move>> {
-        return CardEffectLegalMoveGenerator::generate(
-            CardEnum::DE_STALINIZATION, board, Side::USSR);
-      }));
+  commands.emplace_back(std::make_shared<RequestCommand>(Side::USSR, *this));
   return commands;
 }
 
 bool DeStainization::canEvent(const Board& /*board*/) const {
   return true;
 }
+
+std::vector<std::shared_ptr<Move>> DeStainization::requestLegalMoves(
+    const Board& board, Side side, int /*value*/) const {
+  return CardEffectLegalMoveGenerator::generate(CardEnum::DE_STALINIZATION,
+                                                board, side);
+}
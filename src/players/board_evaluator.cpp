@@ -0,0 +1,186 @@
+// ファイル: src/players/board_evaluator.cpp
+// 役割:
+// VPだけの評価関数と、地域得点・バトルグラウンド・軍事行動などの線形評価関数、重みファイルの読み込みを実装する。
+// 背景:
+// 打ち切り評価は葉ごとに呼ばれるため、特徴量の計算は地図の走査1回と地域ごとのscoreRegionに限る。
+
+#include "tsge/players/board_evaluator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "tsge/game_state/card.hpp"
+
+namespace mcts {
+
+namespace {
+
+constexpr size_t COUNTRY_COUNT = 86;
+
+[[nodiscard]] int controlSign(Side side) {
+  if (side == Side::USSR) {
+    return 1;
+  }
+  return side == Side::USA ? -1 : 0;
+}
+
+[[nodiscard]] int regionScore(const Board& board, Region region) {
+  return std::clamp(board.scoreRegion(region, false),
+                    -EvaluationFeatures::REGION_SCORE_LIMIT,
+                    EvaluationFeatures::REGION_SCORE_LIMIT);
+}
+
+[[nodiscard]] int handOps(const Board& board, Side side) {
+  int total = 0;
+  for (const auto card : board.getPlayerHand(side)) {
+    if (const auto& entry = board.getCardpool()[static_cast<size_t>(card)]) {
+      total += entry->getOps();
+    }
+  }
+  return total;
+}
+
+// 評価値をside視点へ直す
+[[nodiscard]] double forSide(double ussr_value, Side side) {
+  return side == Side::USA ? -ussr_value : ussr_value;
+}
+
+}  // namespace
+
+double VpBoardEvaluator::evaluate(const Board& board, Side side) const {
+  return forSide(std::tanh(board.getVp() / 10.0), side);
+}
+
+void EvaluationFeatures::refresh(const Board& board) {
+  battlegrounds = 0;
+  const auto& world_map = board.getWorldMap();
+  for (size_t i = 0; i < COUNTRY_COUNT; ++i) {
+    const auto& country = world_map.getCountry(static_cast<CountryEnum>(i));
+    if (country.isBattleground()) {
+      battlegrounds += controlSign(country.getControlSide());
+    }
+  }
+  for (size_t i = 0; i < REGIONS.size(); ++i) {
+    region_scores[i] = regionScore(board, REGIONS[i]);
+  }
+  refreshScalars(board);
+}
+
+void EvaluationFeatures::refreshCountry(const Board& board,
+                                        CountryEnum country_enum,
+                                        Side previous_control) {
+  const auto& country = board.getWorldMap().getCountry(country_enum);
+  if (country.isBattleground()) {
+    battlegrounds += controlSign(country.getControlSide()) -
+                     controlSign(previous_control);
+  }
+  for (size_t i = 0; i < REGIONS.size(); ++i) {
+    if (country.hasRegion(REGIONS[i])) {
+      region_scores[i] = regionScore(board, REGIONS[i]);
+    }
+  }
+}
+
+void EvaluationFeatures::refreshScalars(const Board& board) {
+  vp = board.getVp();
+  defcon = board.getDefconTrack().getDefcon();
+  const auto& milops = board.getMilopsTrack();
+  milops_penalty = std::max(0, defcon - milops.getMilops(Side::USA)) -
+                   std::max(0, defcon - milops.getMilops(Side::USSR));
+  const auto& space_track = board.getSpaceTrack();
+  space = space_track.getSpaceTrackPosition(Side::USSR) -
+          space_track.getSpaceTrackPosition(Side::USA);
+  turn = board.getTurnTrack().getTurn();
+  hand_ops = handOps(board, Side::USSR) - handOps(board, Side::USA);
+  china_card = controlSign(board.getChinaCardOwner()) *
+               (board.isChinaCardFaceUp() ? 1.0 : 0.5);
+}
+
+HeuristicEvaluatorWeights HeuristicEvaluatorWeights::parse(
+    std::istream& input) {
+  HeuristicEvaluatorWeights weights;
+  const std::array<std::pair<std::string_view, double*>, 9> fields = {{
+      {"vp", &weights.vp},
+      {"region_score", &weights.region_score},
+      {"battlegrounds", &weights.battlegrounds},
+      {"milops_penalty", &weights.milops_penalty},
+      {"space", &weights.space},
+      {"hand_ops", &weights.hand_ops},
+      {"china_card", &weights.china_card},
+      {"scale", &weights.scale},
+      {"turn_sharpness", &weights.turn_sharpness},
+  }};
+
+  std::string line;
+  int line_number = 0;
+  while (std::getline(input, line)) {
+    ++line_number;
+    line = line.substr(0, line.find('#'));
+    std::istringstream tokens(line);
+    std::string name;
+    if (!(tokens >> name)) {
+      continue;
+    }
+    const auto* field = std::find_if(
+        fields.begin(), fields.end(),
+        [&name](const auto& entry) { return entry.first == name; });
+    double value = 0.0;
+    std::string rest;
+    if (field == fields.end() || !(tokens >> value) || (tokens >> rest)) {
+      throw std::runtime_error("invalid evaluator weight at line " +
+                               std::to_string(line_number) + ": " + line);
+    }
+    *field->second = value;
+  }
+  if (weights.scale <= 0.0) {
+    throw std::runtime_error("evaluator weight 'scale' must be positive");
+  }
+  return weights;
+}
+
+HeuristicEvaluatorWeights HeuristicEvaluatorWeights::loadFromFile(
+    const std::string& path) {
+  std::ifstream input(path);
+  if (!input) {
+    throw std::runtime_error("cannot open evaluator weights: " + path);
+  }
+  return parse(input);
+}
+
+HeuristicBoardEvaluator::HeuristicBoardEvaluator(
+    HeuristicEvaluatorWeights weights)
+    : weights_(weights) {
+  if (weights_.scale <= 0.0) {
+    throw std::invalid_argument("HeuristicBoardEvaluator requires scale > 0");
+  }
+}
+
+double HeuristicBoardEvaluator::evaluate(const Board& board, Side side) const {
+  EvaluationFeatures features;
+  features.refresh(board);
+  return evaluate(features, side);
+}
+
+double HeuristicBoardEvaluator::evaluate(const EvaluationFeatures& features,
+                                         Side side) const {
+  int region_total = 0;
+  for (const auto score : features.region_scores) {
+    region_total += score;
+  }
+  const double sum = (weights_.vp * features.vp) +
+                     (weights_.region_score * region_total) +
+                     (weights_.battlegrounds * features.battlegrounds) +
+                     (weights_.milops_penalty * features.milops_penalty) +
+                     (weights_.space * features.space) +
+                     (weights_.hand_ops * features.hand_ops) +
+                     (weights_.china_card * features.china_card);
+  const double sharpness =
+      1.0 + (weights_.turn_sharpness * std::max(0, features.turn - 1));
+  return forSide(std::tanh(sum * sharpness / weights_.scale), side);
+}
+
+}  // namespace mcts
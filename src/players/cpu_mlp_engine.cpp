@@ -0,0 +1,688 @@
+// ファイル: src/players/cpu_mlp_engine.cpp
+// 役割:
+// 重みファイルの読み書き、量子化、入力方向にブロック化したGEMM(スカラー版とAVX2/FMA版)、合法手へのsoftmaxを実装する。
+// 背景:
+// 推論は自己対戦の大半の時間を占めるため、重み行を入力ブロックごとにL1へ載せたまま複数の盤面で使い回す。
+
+#include "tsge/players/cpu_mlp_engine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "tsge/actions/action_index.hpp"
+#include "tsge/players/feature_encoder.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TSGE_CPU_MLP_X86 1
+#endif
+
+namespace {
+
+// 入力方向のブロック幅。重み2行と入力4行の断片(合わせて約6KB)をL1に保つ。
+constexpr size_t K_BLOCK = 256;
+// 1回のマイクロカーネルで扱う盤面数と出力数
+constexpr size_t BATCH_BLOCK = 4;
+constexpr size_t OUTPUT_BLOCK = 2;
+
+constexpr std::array<char, 4> FILE_MAGIC = {'T', 'S', 'M', 'P'};
+// 壊れたファイルで巨大な確保をしないための層の幅の上限
+constexpr uint32_t MAX_LAYER_WIDTH = 1U << 16;
+
+template <CpuMlpWeightType TYPE>
+float scalarWeight(const CpuMlpLayer& layer, size_t offset) {
+  if constexpr (TYPE == CpuMlpWeightType::FLOAT32) {
+    return layer.weights_f32[offset];
+  } else if constexpr (TYPE == CpuMlpWeightType::BFLOAT16) {
+    return std::bit_cast<float>(
+        static_cast<uint32_t>(layer.weights_bf16[offset]) << 16);
+  } else {
+    return static_cast<float>(layer.weights_i8[offset]);
+  }
+}
+
+template <CpuMlpWeightType TYPE>
+float rowScale(const CpuMlpLayer& layer, size_t row) {
+  if constexpr (TYPE == CpuMlpWeightType::INT8) {
+    return layer.scales[row];
+  } else {
+    return 1.0F;
+  }
+}
+
+// y[b][o] += Σk x[b][k] W[o][k] (kは[k_begin, k_end))
+template <CpuMlpWeightType TYPE>
+void accumulateScalar(const CpuMlpLayer& layer, const float* x, size_t batch,
+                      float* y, size_t k_begin, size_t k_end) {
+  const size_t inputs = layer.inputs;
+  const size_t outputs = layer.outputs;
+  std::array<float, K_BLOCK> row{};
+  for (size_t o = 0; o < outputs; ++o) {
+    for (size_t k = k_begin; k < k_end; ++k) {
+      row[k - k_begin] = scalarWeight<TYPE>(layer, (o * inputs) + k);
+    }
+    const float scale = rowScale<TYPE>(layer, o);
+    for (size_t b = 0; b < batch; ++b) {
+      const float* x_row = x + (b * inputs);
+      float sum = 0.0F;
+      for (size_t k = k_begin; k < k_end; ++k) {
+        sum += x_row[k] * row[k - k_begin];
+      }
+      y[(b * outputs) + o] += sum * scale;
+    }
+  }
+}
+
+#ifdef TSGE_CPU_MLP_X86
+
+template <CpuMlpWeightType TYPE>
+__attribute__((target("avx2,fma"))) __m256 loadWeights(
+    const CpuMlpLayer& layer, size_t offset) {
+  if constexpr (TYPE == CpuMlpWeightType::FLOAT32) {
+    return _mm256_loadu_ps(layer.weights_f32.data() + offset);
+  } else if constexpr (TYPE == CpuMlpWeightType::BFLOAT16) {
+    const __m128i raw = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(layer.weights_bf16.data() + offset));
+    return _mm256_castsi256_ps(
+        _mm256_slli_epi32(_mm256_cvtepu16_epi32(raw), 16));
+  } else {
+    const __m128i raw = _mm_loadl_epi64(
+        reinterpret_cast<const __m128i*>(layer.weights_i8.data() + offset));
+    return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(raw));
+  }
+}
+
+__attribute__((target("avx2,fma"))) float horizontalSum(__m256 value) {
+  const __m128 low = _mm256_castps256_ps128(value);
+  const __m128 high = _mm256_extractf128_ps(value, 1);
+  __m128 sum = _mm_add_ps(low, high);
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+  return _mm_cvtss_f32(sum);
+}
+
+// ROWS個の盤面 × COLS個の出力を8要素ずつFMAで積み上げる。端数の入力はスカラーで足す。
+template <CpuMlpWeightType TYPE, size_t ROWS, size_t COLS>
+__attribute__((target("avx2,fma"))) void microKernelAvx2(
+    const CpuMlpLayer& layer, const float* x, float* y, size_t out_row,
+    size_t k_begin, size_t k_end) {
+  const size_t inputs = layer.inputs;
+  const size_t outputs = layer.outputs;
+  // std::arrayの要素型にすると__m256の属性が落ちて警告になるため配列で持つ
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  __m256 acc[ROWS][COLS];
+  for (auto& row : acc) {
+    for (auto& value : row) {
+      value = _mm256_setzero_ps();
+    }
+  }
+  size_t k = k_begin;
+  for (; k + 8 <= k_end; k += 8) {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+    __m256 weights[COLS];
+    for (size_t c = 0; c < COLS; ++c) {
+      weights[c] = loadWeights<TYPE>(layer, ((out_row + c) * inputs) + k);
+    }
+    for (size_t r = 0; r < ROWS; ++r) {
+      const __m256 input = _mm256_loadu_ps(x + (r * inputs) + k);
+      for (size_t c = 0; c < COLS; ++c) {
+        acc[r][c] = _mm256_fmadd_ps(input, weights[c], acc[r][c]);
+      }
+    }
+  }
+  for (size_t r = 0; r < ROWS; ++r) {
+    for (size_t c = 0; c < COLS; ++c) {
+      const size_t row_offset = (out_row + c) * inputs;
+      float sum = horizontalSum(acc[r][c]);
+      for (size_t tail = k; tail < k_end; ++tail) {
+        sum += x[(r * inputs) + tail] *
+               scalarWeight<TYPE>(layer, row_offset + tail);
+      }
+      y[(r * outputs) + out_row + c] +=
+          sum * rowScale<TYPE>(layer, out_row + c);
+    }
+  }
+}
+
+template <CpuMlpWeightType TYPE, size_t COLS>
+__attribute__((target("avx2,fma"))) void dispatchRows(
+    size_t rows, const CpuMlpLayer& layer, const float* x, float* y,
+    size_t out_row, size_t k_begin, size_t k_end) {
+  switch (rows) {
+    case 4:
+      microKernelAvx2<TYPE, 4, COLS>(layer, x, y, out_row, k_begin, k_end);
+      break;
+    case 3:
+      microKernelAvx2<TYPE, 3, COLS>(layer, x, y, out_row, k_begin, k_end);
+      break;
+    case 2:
+      microKernelAvx2<TYPE, 2, COLS>(layer, x, y, out_row, k_begin, k_end);
+      break;
+    default:
+      microKernelAvx2<TYPE, 1, COLS>(layer, x, y, out_row, k_begin, k_end);
+      break;
+  }
+}
+
+// 出力2行の重み断片を読み込んだまま、全ての盤面を4つずつ流す。
+template <CpuMlpWeightType TYPE>
+__attribute__((target("avx2,fma"))) void accumulateAvx2(
+    const CpuMlpLayer& layer, const float* x, size_t batch, float* y,
+    size_t k_begin, size_t k_end) {
+  const size_t inputs = layer.inputs;
+  const size_t outputs = layer.outputs;
+  for (size_t o = 0; o < outputs; o += OUTPUT_BLOCK) {
+    const size_t cols = std::min(OUTPUT_BLOCK, outputs - o);
+    for (size_t b = 0; b < batch; b += BATCH_BLOCK) {
+      const size_t rows = std::min(BATCH_BLOCK, batch - b);
+      const float* x_block = x + (b * inputs);
+      float* y_block = y + (b * outputs);
+      if (cols == OUTPUT_BLOCK) {
+        dispatchRows<TYPE, OUTPUT_BLOCK>(rows, layer, x_block, y_block, o,
+                                         k_begin, k_end);
+      } else {
+        dispatchRows<TYPE, 1>(rows, layer, x_block, y_block, o, k_begin,
+                              k_end);
+      }
+    }
+  }
+}
+
+#endif  // TSGE_CPU_MLP_X86
+
+template <CpuMlpWeightType TYPE>
+void accumulate(const CpuMlpLayer& layer, const float* x, size_t batch,
+                float* y, CpuMlpKernelIsa isa) {
+  for (size_t k_begin = 0; k_begin < layer.inputs; k_begin += K_BLOCK) {
+    const size_t k_end = std::min<size_t>(layer.inputs, k_begin + K_BLOCK);
+#ifdef TSGE_CPU_MLP_X86
+    if (isa == CpuMlpKernelIsa::AVX2_FMA) {
+      accumulateAvx2<TYPE>(layer, x, batch, y, k_begin, k_end);
+      continue;
+    }
+#endif
+    accumulateScalar<TYPE>(layer, x, batch, y, k_begin, k_end);
+  }
+}
+
+// y = act(W x + b) (+ x)。yはbatch × outputs。
+void denseForward(const CpuMlpLayer& layer, const float* x, size_t batch,
+                  float* y, CpuMlpKernelIsa isa) {
+  const size_t outputs = layer.outputs;
+  for (size_t b = 0; b < batch; ++b) {
+    std::copy(layer.bias.begin(), layer.bias.end(), y + (b * outputs));
+  }
+  switch (layer.type) {
+    case CpuMlpWeightType::FLOAT32:
+      accumulate<CpuMlpWeightType::FLOAT32>(layer, x, batch, y, isa);
+      break;
+    case CpuMlpWeightType::BFLOAT16:
+      accumulate<CpuMlpWeightType::BFLOAT16>(layer, x, batch, y, isa);
+      break;
+    case CpuMlpWeightType::INT8:
+      accumulate<CpuMlpWeightType::INT8>(layer, x, batch, y, isa);
+      break;
+  }
+  const size_t total = batch * outputs;
+  if (layer.activation == CpuMlpActivation::RELU) {
+    for (size_t i = 0; i < total; ++i) {
+      y[i] = std::max(y[i], 0.0F);
+    }
+  }
+  if (layer.residual) {
+    for (size_t i = 0; i < total; ++i) {
+      y[i] += x[i];
+    }
+  }
+}
+
+void validateLayer(const CpuMlpLayer& layer, const char* name) {
+  const std::string prefix = std::string("CpuMlpModel ") + name + ": ";
+  if (layer.inputs == 0 || layer.outputs == 0) {
+    throw std::invalid_argument(prefix + "layer width must be positive");
+  }
+  const size_t count = static_cast<size_t>(layer.inputs) * layer.outputs;
+  size_t stored = 0;
+  switch (layer.type) {
+    case CpuMlpWeightType::FLOAT32:
+      stored = layer.weights_f32.size();
+      break;
+    case CpuMlpWeightType::BFLOAT16:
+      stored = layer.weights_bf16.size();
+      break;
+    case CpuMlpWeightType::INT8:
+      stored = layer.weights_i8.size();
+      if (layer.scales.size() != layer.outputs) {
+        throw std::invalid_argument(prefix + "int8 layer needs one scale/row");
+      }
+      break;
+    default:
+      throw std::invalid_argument(prefix + "unknown weight type");
+  }
+  if (stored != count || layer.bias.size() != layer.outputs) {
+    throw std::invalid_argument(prefix + "weight or bias size mismatch");
+  }
+  if (layer.activation != CpuMlpActivation::NONE &&
+      layer.activation != CpuMlpActivation::RELU) {
+    throw std::invalid_argument(prefix + "unknown activation");
+  }
+  if (layer.residual && layer.inputs != layer.outputs) {
+    throw std::invalid_argument(prefix + "residual layer must be square");
+  }
+}
+
+template <typename T>
+void readValues(std::istream& input, T* data, size_t count) {
+  input.read(reinterpret_cast<char*>(data),
+             static_cast<std::streamsize>(count * sizeof(T)));
+  if (!input) {
+    throw std::runtime_error("CpuMlpModel: truncated weight file");
+  }
+}
+
+template <typename T>
+T readValue(std::istream& input) {
+  T value{};
+  readValues(input, &value, 1);
+  return value;
+}
+
+template <typename T>
+void writeValues(std::ostream& output, const T* data, size_t count) {
+  output.write(reinterpret_cast<const char*>(data),
+               static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T>
+void writeValue(std::ostream& output, T value) {
+  writeValues(output, &value, 1);
+}
+
+CpuMlpLayer readLayer(std::istream& input) {
+  CpuMlpLayer layer;
+  layer.inputs = readValue<uint32_t>(input);
+  layer.outputs = readValue<uint32_t>(input);
+  if (layer.inputs == 0 || layer.outputs == 0 ||
+      layer.inputs > MAX_LAYER_WIDTH || layer.outputs > MAX_LAYER_WIDTH) {
+    throw std::runtime_error("CpuMlpModel: invalid layer width");
+  }
+  const auto type = readValue<uint8_t>(input);
+  const auto activation = readValue<uint8_t>(input);
+  const auto residual = readValue<uint8_t>(input);
+  readValue<uint8_t>(input);  // 予約
+  if (type > static_cast<uint8_t>(CpuMlpWeightType::INT8) ||
+      activation > static_cast<uint8_t>(CpuMlpActivation::RELU) ||
+      residual > 1) {
+    throw std::runtime_error("CpuMlpModel: invalid layer header");
+  }
+  layer.type = static_cast<CpuMlpWeightType>(type);
+  layer.activation = static_cast<CpuMlpActivation>(activation);
+  layer.residual = residual != 0;
+
+  const size_t count = static_cast<size_t>(layer.inputs) * layer.outputs;
+  switch (layer.type) {
+    case CpuMlpWeightType::FLOAT32:
+      layer.weights_f32.resize(count);
+      readValues(input, layer.weights_f32.data(), count);
+      break;
+    case CpuMlpWeightType::BFLOAT16:
+      layer.weights_bf16.resize(count);
+      readValues(input, layer.weights_bf16.data(), count);
+      break;
+    case CpuMlpWeightType::INT8:
+      layer.weights_i8.resize(count);
+      readValues(input, layer.weights_i8.data(), count);
+      layer.scales.resize(layer.outputs);
+      readValues(input, layer.scales.data(), layer.outputs);
+      break;
+  }
+  layer.bias.resize(layer.outputs);
+  readValues(input, layer.bias.data(), layer.outputs);
+  return layer;
+}
+
+void writeLayer(std::ostream& output, const CpuMlpLayer& layer) {
+  writeValue(output, layer.inputs);
+  writeValue(output, layer.outputs);
+  writeValue(output, static_cast<uint8_t>(layer.type));
+  writeValue(output, static_cast<uint8_t>(layer.activation));
+  writeValue(output, static_cast<uint8_t>(layer.residual ? 1 : 0));
+  writeValue(output, static_cast<uint8_t>(0));
+  switch (layer.type) {
+    case CpuMlpWeightType::FLOAT32:
+      writeValues(output, layer.weights_f32.data(), layer.weights_f32.size());
+      break;
+    case CpuMlpWeightType::BFLOAT16:
+      writeValues(output, layer.weights_bf16.data(),
+                  layer.weights_bf16.size());
+      break;
+    case CpuMlpWeightType::INT8:
+      writeValues(output, layer.weights_i8.data(), layer.weights_i8.size());
+      writeValues(output, layer.scales.data(), layer.scales.size());
+      break;
+  }
+  writeValues(output, layer.bias.data(), layer.bias.size());
+}
+
+// 最近接偶数丸めでfloatの上位16bitを取り出す
+uint16_t toBfloat16(float value) {
+  const auto bits = std::bit_cast<uint32_t>(value);
+  const uint32_t rounding = 0x7FFFU + ((bits >> 16) & 1U);
+  return static_cast<uint16_t>((bits + rounding) >> 16);
+}
+
+CpuMlpKernelIsa detectIsa() {
+#ifdef TSGE_CPU_MLP_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return CpuMlpKernelIsa::AVX2_FMA;
+  }
+#endif
+  return CpuMlpKernelIsa::SCALAR;
+}
+
+// 分解方策での事前確率のlogをscoresへ書く(合法手をまたいだ正規化は呼び出し側)。
+// 合法手に現れる手順の集合の上でsoftmaxを取って手順ごとの確率とし、
+// 手の値を手順の確率のlogの和とする。手順が方策ヘッドに無い手はロジット0の1手順と同じ扱い。
+void factorizedScores(std::span<const float> logits,
+                      const std::vector<std::shared_ptr<Move>>& moves,
+                      std::vector<double>& scores) {
+  thread_local std::vector<size_t> steps;
+  thread_local std::vector<size_t> step_end;
+  thread_local std::vector<uint8_t> seen;
+  steps.clear();
+  step_end.clear();
+  for (const auto& move : moves) {
+    if (move != nullptr) {
+      ActionIndex::influenceSteps(*move, steps);
+    }
+    step_end.push_back(steps.size());
+  }
+
+  double max_logit = -std::numeric_limits<double>::infinity();
+  for (const size_t step : steps) {
+    if (step < logits.size()) {
+      max_logit = std::max(max_logit, static_cast<double>(logits[step]));
+    }
+  }
+  double log_total = 0.0;
+  if (std::isfinite(max_logit)) {
+    seen.assign(logits.size(), 0);
+    double total = 0.0;
+    for (const size_t step : steps) {
+      if (step < logits.size() && seen[step] == 0) {
+        seen[step] = 1;
+        total += std::exp(logits[step] - max_logit);
+      }
+    }
+    log_total = max_logit + std::log(total);
+  }
+
+  scores.resize(moves.size());
+  size_t begin = 0;
+  for (size_t m = 0; m < moves.size(); ++m) {
+    double score = 0.0;
+    bool mapped = false;
+    for (size_t k = begin; k < step_end[m]; ++k) {
+      if (steps[k] < logits.size()) {
+        score += logits[steps[k]] - log_total;
+        mapped = true;
+      }
+    }
+    scores[m] = mapped ? score : -log_total;
+    begin = step_end[m];
+  }
+}
+
+}  // namespace
+
+CpuMlpKernelIsa activeCpuMlpKernelIsa() {
+  static const CpuMlpKernelIsa isa = detectIsa();
+  return isa;
+}
+
+bool isCpuMlpKernelIsaSupported(CpuMlpKernelIsa isa) {
+  if (isa == CpuMlpKernelIsa::SCALAR) {
+    return true;
+  }
+  return activeCpuMlpKernelIsa() == CpuMlpKernelIsa::AVX2_FMA;
+}
+
+CpuMlpLayer CpuMlpLayer::quantized(CpuMlpWeightType target) const {
+  if (type != CpuMlpWeightType::FLOAT32) {
+    throw std::invalid_argument("CpuMlpLayer::quantized requires float32");
+  }
+  CpuMlpLayer result = *this;
+  result.type = target;
+  if (target == CpuMlpWeightType::FLOAT32) {
+    return result;
+  }
+  result.weights_f32.clear();
+  if (target == CpuMlpWeightType::BFLOAT16) {
+    result.weights_bf16.reserve(weights_f32.size());
+    for (const float weight : weights_f32) {
+      result.weights_bf16.push_back(toBfloat16(weight));
+    }
+    return result;
+  }
+  result.weights_i8.resize(weights_f32.size());
+  result.scales.resize(outputs);
+  for (size_t o = 0; o < outputs; ++o) {
+    const auto row = std::span(weights_f32).subspan(o * inputs, inputs);
+    float max_abs = 0.0F;
+    for (const float weight : row) {
+      max_abs = std::max(max_abs, std::abs(weight));
+    }
+    const float scale = max_abs > 0.0F ? max_abs / 127.0F : 1.0F;
+    result.scales[o] = scale;
+    for (size_t i = 0; i < inputs; ++i) {
+      const float level = std::clamp(std::round(row[i] / scale), -127.0F,
+                                     127.0F);
+      result.weights_i8[(o * inputs) + i] = static_cast<int8_t>(level);
+    }
+  }
+  return result;
+}
+
+CpuMlpModel::CpuMlpModel(std::vector<CpuMlpLayer> trunk,
+                         CpuMlpLayer policy_head, CpuMlpLayer value_head)
+    : trunk_(std::move(trunk)),
+      policy_head_(std::move(policy_head)),
+      value_head_(std::move(value_head)) {
+  for (size_t i = 0; i < trunk_.size(); ++i) {
+    validateLayer(trunk_[i], "trunk");
+    if (i > 0 && trunk_[i].inputs != trunk_[i - 1].outputs) {
+      throw std::invalid_argument("CpuMlpModel: trunk widths do not chain");
+    }
+  }
+  validateLayer(policy_head_, "policy head");
+  validateLayer(value_head_, "value head");
+  const uint32_t features =
+      trunk_.empty() ? policy_head_.inputs : trunk_.back().outputs;
+  if (policy_head_.inputs != features || value_head_.inputs != features) {
+    throw std::invalid_argument("CpuMlpModel: heads do not match the trunk");
+  }
+  if (value_head_.outputs != 1) {
+    throw std::invalid_argument("CpuMlpModel: value head must have 1 output");
+  }
+}
+
+CpuMlpModel CpuMlpModel::parse(std::istream& input) {
+  std::array<char, 4> magic{};
+  readValues(input, magic.data(), magic.size());
+  if (magic != FILE_MAGIC) {
+    throw std::runtime_error("CpuMlpModel: not a TSMP weight file");
+  }
+  if (readValue<uint32_t>(input) != FILE_VERSION) {
+    throw std::runtime_error("CpuMlpModel: unsupported weight file version");
+  }
+  const auto layer_count = readValue<uint32_t>(input);
+  if (layer_count < 2 || layer_count > 1024) {
+    throw std::runtime_error("CpuMlpModel: invalid layer count");
+  }
+  std::vector<CpuMlpLayer> layers;
+  layers.reserve(layer_count);
+  for (uint32_t i = 0; i < layer_count; ++i) {
+    layers.push_back(readLayer(input));
+  }
+  CpuMlpLayer value_head = std::move(layers.back());
+  layers.pop_back();
+  CpuMlpLayer policy_head = std::move(layers.back());
+  layers.pop_back();
+  try {
+    return {std::move(layers), std::move(policy_head), std::move(value_head)};
+  } catch (const std::invalid_argument& error) {
+    throw std::runtime_error(error.what());
+  }
+}
+
+CpuMlpModel CpuMlpModel::loadFromFile(const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input) {
+    throw std::runtime_error("cannot open CPU MLP weights: " + path);
+  }
+  return parse(input);
+}
+
+void CpuMlpModel::save(std::ostream& output) const {
+  writeValues(output, FILE_MAGIC.data(), FILE_MAGIC.size());
+  writeValue(output, FILE_VERSION);
+  writeValue(output, static_cast<uint32_t>(trunk_.size() + 2));
+  for (const auto& layer : trunk_) {
+    writeLayer(output, layer);
+  }
+  writeLayer(output, policy_head_);
+  writeLayer(output, value_head_);
+}
+
+size_t CpuMlpModel::getInputSize() const {
+  return trunk_.empty() ? policy_head_.inputs : trunk_.front().inputs;
+}
+
+void CpuMlpModel::forward(std::span<const float> inputs, size_t batch,
+                          std::span<float> policy_logits,
+                          std::span<float> values) const {
+  forward(inputs, batch, policy_logits, values, activeCpuMlpKernelIsa());
+}
+
+void CpuMlpModel::forward(std::span<const float> inputs, size_t batch,
+                          std::span<float> policy_logits,
+                          std::span<float> values, CpuMlpKernelIsa isa) const {
+  if (inputs.size() < batch * getInputSize() ||
+      policy_logits.size() < batch * getPolicySize() || values.size() < batch) {
+    throw std::invalid_argument("CpuMlpModel::forward: buffer too small");
+  }
+  if (!isCpuMlpKernelIsaSupported(isa)) {
+    isa = CpuMlpKernelIsa::SCALAR;
+  }
+  // 胴体の中間出力は呼び出しスレッドごとの2面バッファを交互に使う
+  thread_local std::vector<float> front;
+  thread_local std::vector<float> back;
+  const float* current = inputs.data();
+  for (const auto& layer : trunk_) {
+    back.resize(batch * layer.outputs);
+    denseForward(layer, current, batch, back.data(), isa);
+    std::swap(front, back);
+    current = front.data();
+  }
+  denseForward(policy_head_, current, batch, policy_logits.data(), isa);
+  denseForward(value_head_, current, batch, values.data(), isa);
+  for (size_t b = 0; b < batch; ++b) {
+    values[b] = std::tanh(values[b]);
+  }
+}
+
+CpuMlpInferenceEngine::CpuMlpInferenceEngine(
+    std::shared_ptr<const CpuMlpModel> model, CpuMlpFeatureFn features,
+    CpuMlpMoveIndexFn move_index)
+    : model_(std::move(model)),
+      features_(std::move(features)),
+      move_index_(std::move(move_index)) {
+  if (model_ == nullptr) {
+    throw std::invalid_argument("CpuMlpInferenceEngine requires a model");
+  }
+  if (!features_) {
+    if (model_->getInputSize() != FeatureEncoder::SIZE) {
+      throw std::invalid_argument(
+          "CpuMlpInferenceEngine: model input does not match FeatureEncoder");
+    }
+    features_ = [](const Board& board, Side side, std::span<float> out) {
+      FeatureEncoder::encode(board, side, out.data());
+    };
+  }
+}
+
+TsNnMctsInferenceResult CpuMlpInferenceEngine::evaluate(
+    const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+    Side side) {
+  const std::array<const Board*, 1> boards{&board};
+  const std::array<const std::vector<std::shared_ptr<Move>>*, 1> moves{
+      &legal_moves};
+  const std::array<Side, 1> sides{side};
+  auto results = evaluateBatch(boards, moves, sides);
+  return std::move(results.front());
+}
+
+std::vector<TsNnMctsInferenceResult> CpuMlpInferenceEngine::evaluateBatch(
+    std::span<const Board* const> boards,
+    std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+    std::span<const Side> sides) {
+  if (legal_moves.size() != boards.size() || sides.size() != boards.size()) {
+    throw std::invalid_argument(
+        "CpuMlpInferenceEngine::evaluateBatch: size mismatch");
+  }
+  const size_t batch = boards.size();
+  const size_t input_size = model_->getInputSize();
+  const size_t policy_size = model_->getPolicySize();
+  thread_local std::vector<float> inputs;
+  thread_local std::vector<float> logits;
+  thread_local std::vector<float> values;
+  inputs.assign(batch * input_size, 0.0F);
+  logits.resize(batch * policy_size);
+  values.resize(batch);
+  for (size_t i = 0; i < batch; ++i) {
+    features_(*boards[i], sides[i],
+              std::span(inputs).subspan(i * input_size, input_size));
+  }
+  model_->forward(inputs, batch, logits, values);
+
+  std::vector<TsNnMctsInferenceResult> results(batch);
+  for (size_t i = 0; i < batch; ++i) {
+    const auto& moves = *legal_moves[i];
+    auto& policy = results[i].policy;
+    policy.resize(moves.size());
+    if (move_index_) {
+      for (size_t m = 0; m < moves.size(); ++m) {
+        const size_t index = moves[m] != nullptr
+                                 ? move_index_(*moves[m], policy_size)
+                                 : SIZE_MAX;
+        policy[m] =
+            index < policy_size ? logits[(i * policy_size) + index] : 0.0;
+      }
+    } else {
+      factorizedScores(
+          std::span<const float>(logits).subspan(i * policy_size, policy_size),
+          moves, policy);
+    }
+    double max_logit = -std::numeric_limits<double>::infinity();
+    for (const double score : policy) {
+      max_logit = std::max(max_logit, score);
+    }
+    double total = 0.0;
+    for (auto& probability : policy) {
+      probability = std::exp(probability - max_logit);
+      total += probability;
+    }
+    for (auto& probability : policy) {
+      probability /= total;
+    }
+    results[i].value = values[i];
+  }
+  return results;
+}
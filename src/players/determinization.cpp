@@ -0,0 +1,186 @@
+// ファイル: src/players/determinization.cpp
+// 役割:
+// 見えないカード集合の計算と、制約付きの(相手の手札, 山札)同時標本化を実装する。
+// 背景:
+// 標本化はMCTSの反復ごとに呼ばれるため、母集団の計算はコンストラクタへ寄せ、sampleはヒープ確保を避ける。
+
+#include "tsge/players/determinization.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tsge/game_state/card.hpp"
+
+namespace mcts {
+
+namespace {
+
+// turnの時点で山札に投入済みの戦期か。Mid Warはターン3終了時、Late Warはターン7終了時に加わる。
+[[nodiscard]] bool isWarPeriodInPlay(WarPeriod period, int turn) {
+  switch (period) {
+    case WarPeriod::EARLY_WAR:
+      return true;
+    case WarPeriod::MID_WAR:
+      return turn >= 4;
+    case WarPeriod::LATE_WAR:
+      return turn >= 8;
+    case WarPeriod::DUMMY:
+      return false;
+  }
+  return false;
+}
+
+// Fisher-Yates用の添字生成器。乱数1語から2つの添字を作る。範囲は高々111なので、
+// 32bitずつの乗算シフト(Lemire方式)による偏りは無視できる。
+class IndexSource {
+ public:
+  explicit IndexSource(std::mt19937_64& rng) : rng_(rng) {}
+
+  // [0, range)の一様な添字
+  size_t next(size_t range) {
+    if (!has_spare_) {
+      const uint64_t word = rng_();
+      spare_ = static_cast<uint32_t>(word >> 32U);
+      has_spare_ = true;
+      return scale(static_cast<uint32_t>(word), range);
+    }
+    has_spare_ = false;
+    return scale(spare_, range);
+  }
+
+ private:
+  static size_t scale(uint32_t value, size_t range) {
+    return static_cast<size_t>((static_cast<uint64_t>(value) * range) >> 32U);
+  }
+
+  std::mt19937_64& rng_;
+  uint32_t spare_ = 0;
+  bool has_spare_ = false;
+};
+
+}  // namespace
+
+CardSet DeterminizationSampler::computeUnseen(const Board& board, Side viewer) {
+  const int turn = board.getTurnTrack().getTurn();
+  const auto& cardpool = board.getCardpool();
+
+  CardSet unseen;
+  for (size_t i = 1; i < cardpool.size(); ++i) {
+    if (cardpool[i] && isWarPeriodInPlay(cardpool[i]->getWarPeriod(), turn)) {
+      unseen.set(static_cast<CardEnum>(i));
+    }
+  }
+
+  CardSet seen;
+  seen.set(CardEnum::DUMMY);
+  seen.set(CardEnum::CHINA_CARD);
+  for (const auto card : board.getPlayerHand(viewer)) {
+    seen.set(card);
+  }
+  for (const auto card : board.getDeck().getDiscardPile()) {
+    seen.set(card);
+  }
+  for (const auto card : board.getDeck().getRemovedCards()) {
+    seen.set(card);
+  }
+  for (const auto card : board.getCardEffectsInProgress()) {
+    seen.set(card);
+  }
+  seen.set(board.getHeadlineCard(viewer));
+  const Side opponent = getOpponentSide(viewer);
+  if (board.isHeadlineCardVisible(viewer, opponent)) {
+    seen.set(board.getHeadlineCard(opponent));
+  }
+  return unseen.subtract(seen);
+}
+
+DeterminizationSampler::DeterminizationSampler(
+    const Board& board, Side viewer, DeterminizationConstraints constraints)
+    : opponent_(getOpponentSide(viewer)),
+      hand_size_(board.getPlayerHand(opponent_).size()),
+      unseen_(computeUnseen(board, viewer)) {
+  CardSet required = unseen_.intersect(constraints.opponent_must_hold);
+  CardSet deck_only = unseen_.intersect(constraints.opponent_cannot_hold);
+  deck_only.subtract(required);
+  CardSet candidates = unseen_;
+  candidates.subtract(required).subtract(deck_only);
+
+  required.appendTo(required_);
+  deck_only.appendTo(deck_only_);
+  candidates.appendTo(candidates_);
+  // 手札枠より多く必須カードがある場合、溢れた分は山札へ回す。
+  if (required_.size() > hand_size_) {
+    deck_only_.insert(deck_only_.end(), required_.begin() + hand_size_,
+                      required_.end());
+    required_.resize(hand_size_);
+  }
+
+  const auto& weights = constraints.hand_weights;
+  const bool uniform = std::all_of(weights.begin(), weights.end(),
+                                   [](double weight) { return weight == 1.0; });
+  if (!uniform) {
+    weights_.reserve(candidates_.size());
+    for (const auto card : candidates_) {
+      const auto index = static_cast<size_t>(card);
+      weights_.push_back(index < weights.size() ? std::max(weights[index], 0.0)
+                                                : 1.0);
+    }
+  }
+}
+
+void DeterminizationSampler::sample(std::mt19937_64& rng,
+                                    std::vector<CardEnum>& opponent_hand,
+                                    std::vector<CardEnum>& deck) const {
+  std::array<CardEnum, CardSet::CAPACITY> pool{};
+  const size_t pool_size = candidates_.size();
+  std::copy(candidates_.begin(), candidates_.end(), pool.begin());
+
+  opponent_hand.assign(required_.begin(), required_.end());
+  const size_t need = std::min(hand_size_ - required_.size(), pool_size);
+
+  // 選んだカードをpoolの先頭へ寄せる(部分Fisher-Yates)。
+  IndexSource indices(rng);
+  if (weights_.empty()) {
+    for (size_t i = 0; i < need; ++i) {
+      std::swap(pool[i], pool[i + indices.next(pool_size - i)]);
+    }
+  } else {
+    std::array<double, CardSet::CAPACITY> weights{};
+    std::copy(weights_.begin(), weights_.end(), weights.begin());
+    double total = 0.0;
+    for (size_t i = 0; i < pool_size; ++i) {
+      total += weights[i];
+    }
+    for (size_t i = 0; i < need; ++i) {
+      size_t pick = i;
+      if (total > 0.0) {
+        std::uniform_real_distribution<double> dist(0.0, total);
+        double target = dist(rng);
+        for (pick = i; pick + 1 < pool_size; ++pick) {
+          target -= weights[pick];
+          if (target < 0.0) {
+            break;
+          }
+        }
+      }
+      total -= weights[pick];
+      std::swap(pool[i], pool[pick]);
+      std::swap(weights[i], weights[pick]);
+    }
+  }
+  opponent_hand.insert(opponent_hand.end(), pool.begin(),
+                       pool.begin() + static_cast<std::ptrdiff_t>(need));
+
+  deck.assign(pool.begin() + static_cast<std::ptrdiff_t>(need),
+              pool.begin() + static_cast<std::ptrdiff_t>(pool_size));
+  deck.insert(deck.end(), deck_only_.begin(), deck_only_.end());
+  for (size_t i = deck.size(); i > 1; --i) {
+    std::swap(deck[i - 1], deck[indices.next(i)]);
+  }
+}
+
+void DeterminizationSampler::apply(Board& board, std::mt19937_64& rng) const {
+  sample(rng, board.getPlayerHand(opponent_), board.getDeck().getDeck());
+}
+
+}  // namespace mcts
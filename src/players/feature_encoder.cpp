@@ -0,0 +1,165 @@
+// ファイル: src/players/feature_encoder.cpp
+// 役割:
+// 特徴量レイアウトへの書き込みをfloat/int8共通のテンプレートで実装し、バッチ版を区間ごとに呼び出し側のスレッドプールへ分ける。
+// 背景:
+// 地図は国ごとに1度だけ読み、面ごとの書き込みは事前にゼロ埋めした連続領域へ散らすだけにする。
+
+#include "tsge/players/feature_encoder.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// 超大国の番兵(影響力999など)もint8に収まるよう、float版も同じく±127へ丸める
+template <typename T>
+T toFeature(int value) {
+  return static_cast<T>(std::clamp(value, -127, 127));
+}
+
+void checkViewer(Side viewer) {
+  if (viewer != Side::USSR && viewer != Side::USA) {
+    throw std::invalid_argument("FeatureEncoder: viewer must be USSR or USA");
+  }
+}
+
+template <typename T>
+void encodeBoard(const Board& board, Side viewer, T* out) {
+  using Encoder = FeatureEncoder;
+  const Side opponent = getOpponentSide(viewer);
+  std::fill(out, out + Encoder::SIZE, T{});
+
+  T* planes = out + Encoder::COUNTRY_OFFSET;
+  const auto plane = [planes](size_t index, size_t country) -> T& {
+    return planes[(index * Encoder::COUNTRY_COUNT) + country];
+  };
+  const auto& world_map = board.getWorldMap();
+  const size_t countries =
+      std::min(Encoder::COUNTRY_COUNT, world_map.getCountriesCount());
+  for (size_t i = 0; i < countries; ++i) {
+    const auto& country = world_map.getCountry(static_cast<CountryEnum>(i));
+    const Side control = country.getControlSide();
+    plane(Encoder::OWN_INFLUENCE, i) =
+        toFeature<T>(country.getInfluence(viewer));
+    plane(Encoder::OPPONENT_INFLUENCE, i) =
+        toFeature<T>(country.getInfluence(opponent));
+    plane(Encoder::OWN_CONTROL, i) = toFeature<T>(control == viewer ? 1 : 0);
+    plane(Encoder::OPPONENT_CONTROL, i) =
+        toFeature<T>(control == opponent ? 1 : 0);
+    plane(Encoder::STABILITY, i) = toFeature<T>(country.getStability());
+    plane(Encoder::BATTLEGROUND, i) =
+        toFeature<T>(country.isBattleground() ? 1 : 0);
+    for (const Region region : country.getRegions()) {
+      const auto index = static_cast<size_t>(region);
+      if (index < Encoder::REGION_COUNT) {
+        plane(Encoder::REGION_FIRST + index, i) = toFeature<T>(1);
+      }
+    }
+  }
+
+  T* tracks = out + Encoder::TRACK_OFFSET;
+  const auto& milops = board.getMilopsTrack();
+  const auto& space = board.getSpaceTrack();
+  const auto& action_rounds = board.getActionRoundTrack();
+  const Side china_owner = board.getChinaCardOwner();
+  const int vp = viewer == Side::USSR ? board.getVp() : -board.getVp();
+  tracks[Encoder::VP] = toFeature<T>(vp);
+  tracks[Encoder::DEFCON] = toFeature<T>(board.getDefconTrack().getDefcon());
+  tracks[Encoder::OWN_MILOPS] = toFeature<T>(milops.getMilops(viewer));
+  tracks[Encoder::OPPONENT_MILOPS] = toFeature<T>(milops.getMilops(opponent));
+  tracks[Encoder::OWN_SPACE] =
+      toFeature<T>(space.getSpaceTrackPosition(viewer));
+  tracks[Encoder::OPPONENT_SPACE] =
+      toFeature<T>(space.getSpaceTrackPosition(opponent));
+  tracks[Encoder::TURN] = toFeature<T>(board.getTurnTrack().getTurn());
+  tracks[Encoder::OWN_ACTION_ROUND] =
+      toFeature<T>(action_rounds.getActionRound(viewer));
+  tracks[Encoder::OPPONENT_ACTION_ROUND] =
+      toFeature<T>(action_rounds.getActionRound(opponent));
+  tracks[Encoder::VIEWER_IS_USSR] = toFeature<T>(viewer == Side::USSR ? 1 : 0);
+  tracks[Encoder::VIEWER_TO_MOVE] =
+      toFeature<T>(board.getCurrentArPlayer() == viewer ? 1 : 0);
+  tracks[Encoder::OWN_CHINA_CARD] = toFeature<T>(china_owner == viewer ? 1 : 0);
+  tracks[Encoder::OPPONENT_CHINA_CARD] =
+      toFeature<T>(china_owner == opponent ? 1 : 0);
+  tracks[Encoder::CHINA_CARD_FACE_UP] =
+      toFeature<T>(board.isChinaCardFaceUp() ? 1 : 0);
+  tracks[Encoder::OWN_HAND_SIZE] =
+      toFeature<T>(static_cast<int>(board.getPlayerHand(viewer).size()));
+  tracks[Encoder::OPPONENT_HAND_SIZE] =
+      toFeature<T>(static_cast<int>(board.getPlayerHand(opponent).size()));
+
+  T* hand = out + Encoder::HAND_OFFSET;
+  for (const CardEnum card : board.getPlayerHand(viewer)) {
+    const auto index = static_cast<size_t>(card);
+    if (index < Encoder::CARD_COUNT) {
+      hand[index] = toFeature<T>(1);
+    }
+  }
+}
+
+template <typename T>
+void encodeRange(std::span<const Board* const> boards,
+                 std::span<const Side> viewers, T* out, size_t begin,
+                 size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    encodeBoard(*boards[i], viewers[i], out + (i * FeatureEncoder::SIZE));
+  }
+}
+
+template <typename T>
+void encodeBoards(std::span<const Board* const> boards,
+                  std::span<const Side> viewers, T* out,
+                  WorkStealingPool* pool) {
+  if (viewers.size() != boards.size()) {
+    throw std::invalid_argument("FeatureEncoder::encodeBatch: size mismatch");
+  }
+  // 作業スレッド内で例外を投げないよう、視点は先に全て検査する
+  for (const Side viewer : viewers) {
+    checkViewer(viewer);
+  }
+  const size_t count = boards.size();
+  const size_t parts =
+      pool == nullptr
+          ? 1
+          : std::clamp<size_t>(pool->threadCount() + 1, 1,
+                               std::max<size_t>(count, 1));
+  if (parts == 1) {
+    encodeRange(boards, viewers, out, 0, count);
+    return;
+  }
+  const size_t chunk = (count + parts - 1) / parts;
+  // 先頭の区間は呼び出しスレッドで処理する
+  for (size_t begin = chunk; begin < count; begin += chunk) {
+    const size_t end = std::min(count, begin + chunk);
+    pool->submit([boards, viewers, out, begin, end] {
+      encodeRange(boards, viewers, out, begin, end);
+    });
+  }
+  encodeRange(boards, viewers, out, 0, std::min(count, chunk));
+  pool->wait();
+}
+
+}  // namespace
+
+void FeatureEncoder::encode(const Board& board, Side viewer, float* out) {
+  checkViewer(viewer);
+  encodeBoard(board, viewer, out);
+}
+
+void FeatureEncoder::encode(const Board& board, Side viewer, int8_t* out) {
+  checkViewer(viewer);
+  encodeBoard(board, viewer, out);
+}
+
+void FeatureEncoder::encodeBatch(std::span<const Board* const> boards,
+                                 std::span<const Side> viewers, float* out,
+                                 WorkStealingPool* pool) {
+  encodeBoards(boards, viewers, out, pool);
+}
+
+void FeatureEncoder::encodeBatch(std::span<const Board* const> boards,
+                                 std::span<const Side> viewers, int8_t* out,
+                                 WorkStealingPool* pool) {
+  encodeBoards(boards, viewers, out, pool);
+}
@@ -0,0 +1,199 @@
+// ファイル: src/players/hand_belief.cpp
+// 役割:
+// OpponentHandBeliefの観測ごとの尤度更新と、周辺確率の計算を実装する。
+// 背景:
+// 観測1回あたりカード数に比例する時間で済ませ、対局中に毎手更新しても探索時間を削らないため。
+
+#include "tsge/players/hand_belief.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tsge/game_state/card.hpp"
+
+namespace mcts {
+
+namespace {
+
+[[nodiscard]] const Card* findCard(const Board& board, CardEnum card) {
+  if (card == CardEnum::DUMMY) {
+    return nullptr;
+  }
+  return board.getCardpool()[static_cast<size_t>(card)].get();
+}
+
+[[nodiscard]] bool isScoringCard(const Card& card) {
+  return card.getOps() == 0;
+}
+
+[[nodiscard]] bool isOpsMove(const Move& move) {
+  return dynamic_cast<const ActionPlaceInfluenceMove*>(&move) != nullptr ||
+         dynamic_cast<const ActionCoupMove*>(&move) != nullptr ||
+         dynamic_cast<const ActionRealigmentMove*>(&move) != nullptr ||
+         dynamic_cast<const ActionSpaceRaceMove*>(&move) != nullptr;
+}
+
+}  // namespace
+
+OpponentHandBelief::OpponentHandBelief(Side viewer, HandBeliefModel model)
+    : viewer_(viewer), model_(model) {
+  weights_.fill(1.0F);
+}
+
+void OpponentHandBelief::observe(const Board& board, const Move& move) {
+  if (move.getSide() != getOpponentSide(viewer_)) {
+    return;
+  }
+  onTurn(board.getTurnTrack().getTurn());
+
+  const CardEnum played = move.getCard();
+  if (findCard(board, played) == nullptr) {
+    return;
+  }
+  if (dynamic_cast<const HeadlineCardSelectMove*>(&move) != nullptr) {
+    observeHeadline(board, played);
+  } else if (isOpsMove(move)) {
+    observeOpsPlay(board, played);
+    observeActionRound(board, played);
+  } else if (dynamic_cast<const ActionEventMove*>(&move) != nullptr) {
+    observeActionRound(board, played);
+  }
+}
+
+// onTurn: 新しいターンでは手札の大半が引き直されるため、証拠を一部だけ残して一様へ戻す。
+void OpponentHandBelief::onTurn(int turn) {
+  if (turn == turn_) {
+    return;
+  }
+  if (turn_ != 0) {
+    const auto keep = static_cast<float>(model_.carry_over);
+    for (auto& weight : weights_) {
+      weight = 1.0F + (weight - 1.0F) * keep;
+    }
+  }
+  turn_ = turn;
+}
+
+// observeActionRound: スコアリングカードは手番内に必ず出すため、
+// 残りr回のアクションラウンドのうち今回出さなかったことから保持確率を(r-1)/r倍する。
+void OpponentHandBelief::observeActionRound(const Board& board,
+                                            CardEnum played) {
+  const Card* played_card = findCard(board, played);
+  if (played_card == nullptr || isScoringCard(*played_card)) {
+    return;
+  }
+  const Side opponent = getOpponentSide(viewer_);
+  const auto& track = board.getActionRoundTrack();
+  const int defined =
+      track.getDefinedActionRounds(board.getTurnTrack().getTurn());
+  const int remaining = std::max(1, defined - track.getActionRound(opponent));
+  const double factor =
+      std::max(model_.scoring_floor, static_cast<double>(remaining - 1) /
+                                         static_cast<double>(remaining));
+
+  const auto& cardpool = board.getCardpool();
+  for (size_t i = 1; i < cardpool.size(); ++i) {
+    if (cardpool[i] && isScoringCard(*cardpool[i])) {
+      weights_[i] = static_cast<float>(weights_[i] * factor);
+    }
+  }
+}
+
+void OpponentHandBelief::observeOpsPlay(const Board& board, CardEnum played) {
+  const Card* played_card = findCard(board, played);
+  const int played_ops = played_card->getOps();
+  const bool gave_away = played_card->getSide() == viewer_;
+
+  // Ops差ごとの倍率は高々4段なので先に求めておく。
+  std::array<float, 5> dominance{};
+  for (size_t diff = 0; diff < dominance.size(); ++diff) {
+    dominance[diff] = static_cast<float>(
+        std::pow(model_.ops_dominance, static_cast<double>(diff)));
+  }
+
+  const auto& cardpool = board.getCardpool();
+  for (size_t i = 1; i < cardpool.size(); ++i) {
+    const Card* card = cardpool[i].get();
+    if (card == nullptr || isScoringCard(*card)) {
+      continue;
+    }
+    const int ops = card->getOps();
+    if (ops > played_ops) {
+      const auto diff = std::min<size_t>(static_cast<size_t>(ops - played_ops),
+                                         dominance.size() - 1);
+      weights_[i] *= dominance[diff];
+    }
+    if (gave_away && ops >= played_ops && card->getSide() != viewer_) {
+      weights_[i] *= static_cast<float>(model_.gave_away_event);
+    }
+  }
+}
+
+void OpponentHandBelief::observeHeadline(const Board& board, CardEnum played) {
+  const Card* played_card = findCard(board, played);
+  if (isScoringCard(*played_card)) {
+    return;
+  }
+  const auto factor = static_cast<float>(model_.headline_without_scoring);
+  const auto& cardpool = board.getCardpool();
+  for (size_t i = 1; i < cardpool.size(); ++i) {
+    if (cardpool[i] && isScoringCard(*cardpool[i])) {
+      weights_[i] *= factor;
+    }
+  }
+}
+
+std::array<double, CardSet::CAPACITY> OpponentHandBelief::marginals(
+    const Board& board) const {
+  std::array<double, CardSet::CAPACITY> result{};
+  const CardSet unseen = DeterminizationSampler::computeUnseen(board, viewer_);
+  const auto hand_size = static_cast<double>(
+      board.getPlayerHand(getOpponentSide(viewer_)).size());
+  if (hand_size <= 0.0 || unseen.empty()) {
+    return result;
+  }
+  if (hand_size >= static_cast<double>(unseen.count())) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = unseen.test(static_cast<CardEnum>(i)) ? 1.0 : 0.0;
+    }
+    return result;
+  }
+
+  // sum_c w_c t / (1 + w_c t) はtについて単調増加なので、対数軸の二分法で手札枚数に合わせる。
+  auto expected = [&](double scale) {
+    double sum = 0.0;
+    for (size_t i = 0; i < weights_.size(); ++i) {
+      if (unseen.test(static_cast<CardEnum>(i))) {
+        const double odds = weights_[i] * scale;
+        sum += odds / (1.0 + odds);
+      }
+    }
+    return sum;
+  };
+  double low = -30.0;
+  double high = 30.0;
+  for (int iteration = 0; iteration < 60; ++iteration) {
+    const double mid = 0.5 * (low + high);
+    if (expected(std::exp(mid)) < hand_size) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  const double scale = std::exp(0.5 * (low + high));
+  for (size_t i = 0; i < result.size(); ++i) {
+    if (unseen.test(static_cast<CardEnum>(i))) {
+      const double odds = weights_[i] * scale;
+      result[i] = odds / (1.0 + odds);
+    }
+  }
+  return result;
+}
+
+DeterminizationConstraints OpponentHandBelief::toConstraints() const {
+  DeterminizationConstraints constraints;
+  constraints.hand_weights.assign(weights_.begin(), weights_.end());
+  return constraints;
+}
+
+}  // namespace mcts
@@ -0,0 +1,163 @@
+// ファイル: src/players/inference_cache.cpp
+// 役割:
+// CachedInferenceEngineのシャード選択、LRU更新、キャッシュミスのまとめ評価を実装する。
+// 背景:
+// ロックをシャード単位に分け、推論器の呼び出し中はどのロックも持たないことで探索スレッド同士の待ちを減らすため。
+
+#include "tsge/players/inference_cache.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+uint64_t hashLegalMoves(const std::vector<std::shared_ptr<Move>>& legal_moves) {
+  uint64_t hash = combineMoveKey(0, legal_moves.size());
+  for (const auto& move : legal_moves) {
+    hash = combineMoveKey(hash, move != nullptr ? move->getKey() : 0);
+  }
+  return hash;
+}
+
+size_t CachedInferenceEngine::KeyHash::operator()(
+    const InferenceCacheKey& key) const {
+  return static_cast<size_t>(
+      combineMoveKey(key.board_hash, key.legal_moves_hash));
+}
+
+CachedInferenceEngine::CachedInferenceEngine(
+    std::shared_ptr<TsNnMctsInferenceEngine> inner,
+    InferenceCacheConfig config)
+    : inner_(std::move(inner)) {
+  if (inner_ == nullptr) {
+    throw std::invalid_argument("CachedInferenceEngine requires an engine");
+  }
+  const size_t num_shards = std::max<size_t>(1, config.num_shards);
+  shard_capacity_ = std::max<size_t>(1, config.capacity / num_shards);
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
+CachedInferenceEngine::Shard& CachedInferenceEngine::shardFor(
+    const InferenceCacheKey& key) {
+  // 下位ビットはunordered_mapのバケット選択に使われるため、上位ビットでシャードを選ぶ。
+  const uint64_t mixed = combineMoveKey(key.board_hash, key.legal_moves_hash);
+  return *shards_[static_cast<size_t>(mixed >> 32U) % shards_.size()];
+}
+
+std::optional<TsNnMctsInferenceResult> CachedInferenceEngine::lookup(
+    const InferenceCacheKey& key) {
+  auto& shard = shardFor(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  const auto found = shard.index.find(key);
+  if (found == shard.index.end()) {
+    return std::nullopt;
+  }
+  shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+  return found->second->second;
+}
+
+void CachedInferenceEngine::insert(const InferenceCacheKey& key,
+                                   const TsNnMctsInferenceResult& result) {
+  auto& shard = shardFor(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  // 別スレッドが先に同じ局面を登録していれば、それを最新扱いにするだけでよい。
+  if (const auto found = shard.index.find(key); found != shard.index.end()) {
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    return;
+  }
+  shard.entries.emplace_front(key, result);
+  shard.index.emplace(key, shard.entries.begin());
+  if (shard.entries.size() > shard_capacity_) {
+    shard.index.erase(shard.entries.back().first);
+    shard.entries.pop_back();
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+TsNnMctsInferenceResult CachedInferenceEngine::evaluate(
+    const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+    Side side) {
+  const InferenceCacheKey key{board.getObservableHash(side),
+                              hashLegalMoves(legal_moves)};
+  if (auto cached = lookup(key)) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return std::move(*cached);
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  auto result = inner_->evaluate(board, legal_moves, side);
+  insert(key, result);
+  return result;
+}
+
+std::vector<TsNnMctsInferenceResult> CachedInferenceEngine::evaluateBatch(
+    std::span<const Board* const> boards,
+    std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+    std::span<const Side> sides) {
+  std::vector<TsNnMctsInferenceResult> results(boards.size());
+  std::vector<InferenceCacheKey> miss_keys;
+  std::vector<const Board*> miss_boards;
+  std::vector<const std::vector<std::shared_ptr<Move>>*> miss_moves;
+  std::vector<Side> miss_sides;
+  // 各入力が何番目のミスの結果を使うか。キャッシュ済みなら空。
+  std::vector<std::optional<size_t>> miss_slot(boards.size());
+  std::unordered_map<InferenceCacheKey, size_t, KeyHash> batch_slots;
+
+  for (size_t i = 0; i < boards.size(); ++i) {
+    const InferenceCacheKey key{boards[i]->getObservableHash(sides[i]),
+                                hashLegalMoves(*legal_moves[i])};
+    if (auto cached = lookup(key)) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      results[i] = std::move(*cached);
+      continue;
+    }
+    // 同じバッチ内の重複は1回だけ評価する。
+    const auto [slot, inserted] = batch_slots.emplace(key, miss_keys.size());
+    if (inserted) {
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      miss_keys.push_back(key);
+      miss_boards.push_back(boards[i]);
+      miss_moves.push_back(legal_moves[i]);
+      miss_sides.push_back(sides[i]);
+    } else {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    miss_slot[i] = slot->second;
+  }
+
+  if (miss_keys.empty()) {
+    return results;
+  }
+  auto evaluated = inner_->evaluateBatch(miss_boards, miss_moves, miss_sides);
+  evaluated.resize(miss_keys.size());
+  for (size_t i = 0; i < miss_keys.size(); ++i) {
+    insert(miss_keys[i], evaluated[i]);
+  }
+  for (size_t i = 0; i < boards.size(); ++i) {
+    if (miss_slot[i].has_value()) {
+      results[i] = evaluated[*miss_slot[i]];
+    }
+  }
+  return results;
+}
+
+InferenceCacheStats CachedInferenceEngine::getStats() const {
+  InferenceCacheStats stats;
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  stats.evictions = evictions_.load(std::memory_order_relaxed);
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    stats.size += shard->entries.size();
+  }
+  return stats;
+}
+
+void CachedInferenceEngine::clear() {
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->entries.clear();
+    shard->index.clear();
+  }
+}
@@ -0,0 +1,274 @@
+// ファイル: src/players/inference_server.cpp
+// 役割:
+// InferenceServerの評価スレッドと、対局側から同期的に使うクライアントアダプタを実装する。
+// 背景:
+// 対局スレッドは結果が揃うまで待つだけにし、バッチ形成と推論器呼び出しを評価スレッドへ集約するため。
+
+#include "tsge/players/inference_server.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+void updateMax(std::atomic<int64_t>& target, int64_t value) {
+  int64_t current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+         !target.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+InferenceServer::InferenceServer(
+    std::shared_ptr<TsNnMctsInferenceEngine> backend,
+    InferenceServerConfig config)
+    : backend_(std::move(backend)),
+      config_(config),
+      started_at_(std::chrono::steady_clock::now()) {
+  if (backend_ == nullptr) {
+    throw std::invalid_argument("InferenceServer requires a backend");
+  }
+  config_.num_evaluators = std::max(1, config_.num_evaluators);
+  config_.max_batch_size = std::max<size_t>(1, config_.max_batch_size);
+
+  evaluators_.reserve(static_cast<size_t>(config_.num_evaluators));
+  for (int i = 0; i < config_.num_evaluators; ++i) {
+    evaluators_.emplace_back([this] { evaluatorLoop(); });
+  }
+}
+
+// ~InferenceServer: 残っている要求を評価し終えてから評価スレッドを止める。
+InferenceServer::~InferenceServer() {
+  stopping_.store(true, std::memory_order_release);
+  // 眠っている評価スレッドを起こすため、要求数に番兵の1を加える。
+  pending_.fetch_add(1, std::memory_order_release);
+  pending_.notify_all();
+  {
+    const std::lock_guard<std::mutex> lock(arrival_mutex_);
+    arrived_.notify_all();
+  }
+  for (auto& thread : evaluators_) {
+    thread.join();
+  }
+}
+
+void InferenceServer::submit(
+    const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+    Side side, Callback on_complete) {
+  total_requests_.fetch_add(1, std::memory_order_relaxed);
+  // 先に要求数を増やし、取り出し側のfetch_subが0を下回らないようにする。
+  // waitForArrivalとの取り決めのため、こことgathering_の読み出しは逐次一貫にする。
+  const uint64_t before = pending_.fetch_add(1);
+  queue_.push(Request{&board, &legal_moves, side, std::move(on_complete),
+                      std::chrono::steady_clock::now()});
+  if (before == 0) {
+    pending_.notify_one();
+  }
+  // 締め切りまで眠っているバッチ形成中の評価スレッドを起こす
+  if (gathering_.load()) {
+    const std::lock_guard<std::mutex> lock(arrival_mutex_);
+    arrived_.notify_one();
+  }
+}
+
+// waitForArrival: 新しい要求か停止が来るまで、deadlineを上限に眠る。
+// gathering_を立ててから要求数を確かめるため、submitが要求数を増やした後に
+// gathering_を読めば必ず通知が届く。
+void InferenceServer::waitForArrival(
+    std::chrono::steady_clock::time_point deadline) {
+  std::unique_lock<std::mutex> lock(arrival_mutex_);
+  gathering_.store(true);
+  arrived_.wait_until(lock, deadline, [this] {
+    return pending_.load() > 0 || stopping_.load();
+  });
+  gathering_.store(false);
+}
+
+void InferenceServer::gatherBatch(std::vector<Request>& batch) {
+  std::lock_guard<std::mutex> lock(consumer_mutex_);
+
+  std::chrono::steady_clock::time_point deadline{};
+  while (batch.size() < config_.max_batch_size) {
+    if (auto request = queue_.tryPop()) {
+      pending_.fetch_sub(1, std::memory_order_acq_rel);
+      if (batch.empty()) {
+        deadline = std::chrono::steady_clock::now() + config_.batch_timeout;
+      }
+      batch.push_back(std::move(*request));
+      continue;
+    }
+    // 停止中は待たずに手元の分だけ評価する。
+    if (stopping_.load(std::memory_order_acquire)) {
+      break;
+    }
+    if (!batch.empty() && std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+    if (pending_.load(std::memory_order_acquire) > 0) {
+      // pushの途中(要求数は増えたがリンク前)。すぐに繋がるので譲って待つ。
+      std::this_thread::yield();
+      continue;
+    }
+    if (batch.empty()) {
+      break;
+    }
+    // 締め切り前で次の要求を待っている。回り続けずに眠る。
+    waitForArrival(deadline);
+  }
+}
+
+void InferenceServer::evaluatorLoop() {
+  std::vector<Request> batch;
+  batch.reserve(config_.max_batch_size);
+  std::vector<const Board*> boards;
+  std::vector<const std::vector<std::shared_ptr<Move>>*> legal_moves;
+  std::vector<Side> sides;
+
+  while (true) {
+    const uint64_t pending = pending_.load(std::memory_order_acquire);
+    if (pending == 0) {
+      pending_.wait(0, std::memory_order_acquire);
+      continue;
+    }
+
+    batch.clear();
+    gatherBatch(batch);
+    if (batch.empty()) {
+      if (stopping_.load(std::memory_order_acquire)) {
+        return;
+      }
+      std::this_thread::yield();
+      continue;
+    }
+
+    const auto evaluate_start = std::chrono::steady_clock::now();
+    boards.clear();
+    legal_moves.clear();
+    sides.clear();
+    for (const auto& request : batch) {
+      const int64_t latency_ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              evaluate_start - request.enqueued_at)
+              .count();
+      total_queue_latency_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+      updateMax(max_queue_latency_ns_, latency_ns);
+      boards.push_back(request.board);
+      legal_moves.push_back(request.legal_moves);
+      sides.push_back(request.side);
+    }
+
+    // 推論器の例外は評価スレッドを止めずに、待っている要求の側へ渡す
+    std::vector<TsNnMctsInferenceResult> results;
+    std::exception_ptr error;
+    try {
+      results = backend_->evaluateBatch(boards, legal_moves, sides);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    busy_ns_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - evaluate_start)
+                           .count(),
+                       std::memory_order_relaxed);
+    total_batches_.fetch_add(1, std::memory_order_relaxed);
+
+    results.resize(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+      batch[i].on_complete(std::move(results[i]), error);
+    }
+  }
+}
+
+InferenceServerMetrics InferenceServer::getMetrics() const {
+  InferenceServerMetrics metrics;
+  metrics.requests = total_requests_.load(std::memory_order_relaxed);
+  metrics.batches = total_batches_.load(std::memory_order_relaxed);
+  if (metrics.batches > 0) {
+    metrics.batch_fill_rate =
+        static_cast<double>(metrics.requests) /
+        (static_cast<double>(metrics.batches) *
+         static_cast<double>(config_.max_batch_size));
+  }
+  if (metrics.requests > 0) {
+    metrics.mean_queue_latency = std::chrono::duration_cast<
+        std::chrono::microseconds>(std::chrono::nanoseconds(
+        total_queue_latency_ns_.load(std::memory_order_relaxed) /
+        static_cast<int64_t>(metrics.requests)));
+  }
+  metrics.max_queue_latency =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::nanoseconds(
+              max_queue_latency_ns_.load(std::memory_order_relaxed)));
+
+  const auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - started_at_)
+                           .count();
+  if (wall_ns > 0) {
+    metrics.evaluator_utilization =
+        static_cast<double>(busy_ns_.load(std::memory_order_relaxed)) /
+        (static_cast<double>(wall_ns) *
+         static_cast<double>(config_.num_evaluators));
+  }
+  return metrics;
+}
+
+InferenceServerClient::InferenceServerClient(
+    std::shared_ptr<InferenceServer> server)
+    : server_(std::move(server)) {
+  if (server_ == nullptr) {
+    throw std::invalid_argument("InferenceServerClient requires a server");
+  }
+}
+
+TsNnMctsInferenceResult InferenceServerClient::evaluate(
+    const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+    Side side) {
+  const Board* boards[] = {&board};
+  const std::vector<std::shared_ptr<Move>>* moves[] = {&legal_moves};
+  const Side sides[] = {side};
+  auto results = evaluateBatch(boards, moves, sides);
+  return std::move(results.front());
+}
+
+// evaluateBatch: 全要求を投入し、最後の結果が届くまで条件変数で待つ。
+// 完了の状態はコールバックと共有して持つ。待ち側が戻った後に評価スレッドが
+// 通知しても、共有された状態は最後のコールバックが終わるまで生きている。
+std::vector<TsNnMctsInferenceResult> InferenceServerClient::evaluateBatch(
+    std::span<const Board* const> boards,
+    std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+    std::span<const Side> sides) {
+  struct Completion {
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining;
+    std::vector<TsNnMctsInferenceResult> results;
+    std::exception_ptr error;
+  };
+  auto completion = std::make_shared<Completion>();
+  completion->remaining = boards.size();
+  completion->results.resize(boards.size());
+  for (size_t i = 0; i < boards.size(); ++i) {
+    server_->submit(*boards[i], *legal_moves[i], sides[i],
+                    [completion, i](TsNnMctsInferenceResult&& out,
+                                    std::exception_ptr error) {
+                      std::lock_guard<std::mutex> lock(completion->mutex);
+                      completion->results[i] = std::move(out);
+                      if (error != nullptr && completion->error == nullptr) {
+                        completion->error = std::move(error);
+                      }
+                      if (--completion->remaining == 0) {
+                        completion->done.notify_one();
+                      }
+                    });
+  }
+  std::unique_lock<std::mutex> lock(completion->mutex);
+  completion->done.wait(lock, [&] { return completion->remaining == 0; });
+  if (completion->error != nullptr) {
+    std::rethrow_exception(completion->error);
+  }
+  return std::move(completion->results);
+}
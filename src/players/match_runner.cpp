@@ -0,0 +1,226 @@
+// ファイル: src/players/match_runner.cpp
+// 役割:
+// ロールアウトポリシーとMCTSPolicyをMatchPolicyへ包むアダプタ、1局の進行、プールへの対局の投入と集計を実装する。
+// 背景:
+// 対局の種は通し番号から決めるため、スレッド数を変えても同じ局が再現でき、速度だけを比べられる。
+
+#include "tsge/players/match_runner.hpp"
+
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/players/mcts_policy.hpp"
+#include "tsge/players/rollout_policy.hpp"
+#include "tsge/utils/work_stealing_pool.hpp"
+
+namespace {
+
+constexpr int DEFAULT_MCTS_ITERATIONS = 1000;
+
+// ロールアウトポリシーを対局用の乱数と組にする
+class RolloutMatchPolicy final : public MatchPolicy {
+ public:
+  RolloutMatchPolicy(std::shared_ptr<const mcts::RolloutPolicy> rollout,
+                     uint64_t seed)
+      : rollout_{std::move(rollout)}, rng_{seed} {}
+
+  std::shared_ptr<Move> decideMove(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side /*side*/) override {
+    return rollout_->selectMove(board, legal_moves, rng_);
+  }
+
+ private:
+  std::shared_ptr<const mcts::RolloutPolicy> rollout_;
+  std::mt19937_64 rng_;
+};
+
+class MCTSMatchPolicy final : public MatchPolicy {
+ public:
+  explicit MCTSMatchPolicy(int iterations)
+      // 並列化は対局単位で行うため、探索自体は1スレッドにする
+      : policy_{iterations, std::chrono::milliseconds(60000), 1} {}
+
+  std::shared_ptr<Move> decideMove(
+      const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) override {
+    return policy_.decideMove(board, legal_moves, side);
+  }
+
+  void observeMove(const Board& board, const Move& move) override {
+    policy_.observeMove(board, move);
+  }
+
+ private:
+  MCTSPolicy policy_;
+};
+
+[[nodiscard]] double perSecond(size_t count, std::chrono::nanoseconds time) {
+  const double seconds = std::chrono::duration<double>(time).count();
+  return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+// 棋譜に書く添字。同じポインタを優先し、無ければoperator==で探す。
+uint32_t legalMoveIndex(const std::vector<std::shared_ptr<Move>>& legal_moves,
+                        const Move& move) {
+  for (size_t i = 0; i < legal_moves.size(); ++i) {
+    if (legal_moves[i].get() == &move) {
+      return static_cast<uint32_t>(i);
+    }
+  }
+  for (size_t i = 0; i < legal_moves.size(); ++i) {
+    if (*legal_moves[i] == move) {
+      return static_cast<uint32_t>(i);
+    }
+  }
+  throw std::runtime_error("match policy returned a move that is not legal");
+}
+
+}  // namespace
+
+MatchPolicyFactory makeMatchPolicy(const std::string& spec) {
+  if (spec == "random") {
+    auto rollout = std::make_shared<const mcts::UniformRolloutPolicy>();
+    return [rollout](uint64_t seed) {
+      return std::make_unique<RolloutMatchPolicy>(rollout, seed);
+    };
+  }
+  if (spec == "heuristic") {
+    auto rollout = std::make_shared<const mcts::HeuristicRolloutPolicy>();
+    return [rollout](uint64_t seed) {
+      return std::make_unique<RolloutMatchPolicy>(rollout, seed);
+    };
+  }
+  if (spec == "mcts" || spec.starts_with("mcts:")) {
+    int iterations = DEFAULT_MCTS_ITERATIONS;
+    if (spec.size() > 5) {
+      const std::string count = spec.substr(5);
+      size_t parsed = 0;
+      try {
+        iterations = std::stoi(count, &parsed);
+      } catch (const std::exception&) {
+        parsed = 0;
+      }
+      if (parsed != count.size() || iterations <= 0) {
+        throw std::invalid_argument("invalid MCTS iterations: " + spec);
+      }
+    }
+    return [iterations](uint64_t /*seed*/) {
+      return std::make_unique<MCTSMatchPolicy>(iterations);
+    };
+  }
+  throw std::invalid_argument("unknown match policy: " + spec);
+}
+
+double MatchSummary::gamesPerSecond() const {
+  return perSecond(games, elapsed);
+}
+
+double MatchSummary::movesPerSecond() const {
+  return perSecond(moves, elapsed);
+}
+
+uint64_t matchSeed(uint64_t base_seed, size_t game_index) {
+  // splitmix64で通し番号を攪拌し、隣り合う対局の乱数列が似ないようにする
+  uint64_t value = base_seed + ((game_index + 1) * 0x9E3779B97F4A7C15ULL);
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+MatchResult playMatch(const std::array<std::unique_ptr<Card>, 111>& cardpool,
+                      const std::array<MatchPolicyFactory, 2>& policies,
+                      uint64_t seed, size_t max_steps, GameRecord* record) {
+  const auto start = std::chrono::steady_clock::now();
+  MatchResult result;
+  result.seed = seed;
+
+  if (record != nullptr) {
+    *record = GameRecord{};
+    record->seed = seed;
+  }
+
+  std::mt19937_64 rng(seed);
+  Board board(cardpool);
+  board.getRandomizer().setRng(&rng);
+  board.getDeck().addEarlyWarCards();
+  board.pushState(StateType::TURN_START);
+
+  const std::array<std::unique_ptr<MatchPolicy>, 2> players{
+      policies[0](seed ^ 0x55555555ULL), policies[1](seed ^ 0xAAAAAAAAULL)};
+
+  std::optional<std::shared_ptr<Move>> pending;
+  for (size_t step = 0; step < max_steps; ++step) {
+    auto [legal_moves, side, winner] =
+        PhaseMachine::step(board, std::move(pending));
+    if (winner.has_value()) {
+      result.winner = winner;
+      break;
+    }
+    if (legal_moves.empty()) {
+      break;
+    }
+    auto& player = players[side == Side::USA ? 1 : 0];
+    auto move = player->decideMove(board, legal_moves, side);
+    if (move == nullptr) {
+      throw std::runtime_error("match policy returned no move");
+    }
+    for (const auto& observer : players) {
+      observer->observeMove(board, *move);
+    }
+    if (record != nullptr) {
+      record->choices.push_back(legalMoveIndex(legal_moves, *move));
+    }
+    pending = std::move(move);
+    ++result.moves;
+  }
+
+  if (record != nullptr) {
+    record->winner = result.winner;
+  }
+  result.final_vp = board.getVp();
+  result.turns = board.getTurnTrack().getTurn();
+  result.wall_time = std::chrono::steady_clock::now() - start;
+  return result;
+}
+
+MatchSummary runMatches(
+    const std::array<std::unique_ptr<Card>, 111>& cardpool,
+    const MatchConfig& config,
+    const std::function<void(const MatchResult&)>& on_result) {
+  if (config.games == 0 || config.threads == 0) {
+    throw std::invalid_argument("runMatches requires games > 0, threads > 0");
+  }
+  if (!config.policies[0] || !config.policies[1]) {
+    throw std::invalid_argument("runMatches requires a policy for each side");
+  }
+
+  MatchSummary summary;
+  std::mutex result_mutex;
+  const auto start = std::chrono::steady_clock::now();
+  {
+    WorkStealingPool pool(config.threads);
+    for (size_t game = 0; game < config.games; ++game) {
+      pool.submit([&, game] {
+        auto result = playMatch(cardpool, config.policies,
+                                matchSeed(config.seed, game), config.max_steps);
+        result.game_index = game;
+        const std::lock_guard lock(result_mutex);
+        ++summary.games;
+        summary.moves += result.moves;
+        ++summary.outcomes[result.winner.has_value()
+                               ? static_cast<size_t>(*result.winner)
+                               : 3];
+        if (on_result) {
+          on_result(result);
+        }
+      });
+    }
+    pool.wait();
+  }
+  summary.elapsed = std::chrono::steady_clock::now() - start;
+  return summary;
+}
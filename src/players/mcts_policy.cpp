@@ -1,10 +1,14 @@
 #include "tsge/players/mcts_policy.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <numeric>
+#include <tuple>
 
 #include "tsge/core/phase_machine.hpp"
+#include "tsge/players/determinization.hpp"
+#include "tsge/players/mcts_select_kernel.hpp"
 
 namespace mcts {
 
@@ -36,29 +40,43 @@ void Node::expand(const std::vector<std::shared_ptr<Move>>& legal_moves) {
     return;
   }
 
-  children_.reserve(legal_moves.size());
+  candidate_moves_ = legal_moves;
+  children_.reserve(candidate_moves_.size());
 
-  for (const auto& move : legal_moves) {
-    // 各子ノード用にボードをコピー
-    Board child_board = board_.copyForMCTS(current_side_);
+  is_expanded_ = true;
+}
 
-    // 相手の手札を決定化状態に設定
-    Side opponent = getOpponentSide(current_side_);
-    auto& opponent_hand = child_board.getPlayerHand(opponent);
-    opponent_hand.clear();
-    for (CardEnum card : det_state_.opponent_hand) {
-      opponent_hand.push_back(card);
-    }
+Node* Node::materializeNextChild(size_t limit) {
+  std::lock_guard<std::mutex> lock(stats_.expansion_mutex);
+
+  const size_t index = materialized_.load(std::memory_order_relaxed);
+  if (index >= limit || index >= candidate_moves_.size()) {
+    return nullptr;
+  }
+  const auto& move = candidate_moves_[index];
 
-    // Moveを適用
-    auto [next_legal_moves, next_side, winner] =
-        PhaseMachine::step(child_board, move);
+  // 子ノード用にボードをコピー
+  Board child_board = board_.copyForMCTS(current_side_);
 
-    children_.emplace_back(std::make_unique<Node>(std::move(child_board), move,
-                                                  next_side, det_state_, this));
+  // 相手の手札を決定化状態に設定
+  Side opponent = getOpponentSide(current_side_);
+  auto& opponent_hand = child_board.getPlayerHand(opponent);
+  opponent_hand.clear();
+  for (CardEnum card : det_state_.opponent_hand) {
+    opponent_hand.push_back(card);
   }
 
-  is_expanded_ = true;
+  // Moveを適用
+  auto [next_legal_moves, next_side, winner] =
+      PhaseMachine::step(child_board, move);
+
+  Node* child = children_
+                    .emplace_back(std::make_unique<Node>(
+                        std::move(child_board), move, next_side, det_state_,
+                        this))
+                    .get();
+  materialized_.store(index + 1, std::memory_order_release);
+  return child;
 }
 
 double Node::getUCBValue(double exploration_constant) const {
@@ -77,19 +95,53 @@ double Node::getUCBValue(double exploration_constant) const {
   return average_value + exploration_term;
 }
 
-Node* Node::selectBestChild(double exploration_constant) {
-  Node* best_child = nullptr;
-  double best_value = -std::numeric_limits<double>::max();
+Node* Node::selectBestChild(double exploration_constant,
+                            const ProgressiveWideningConfig& widening) {
+  const size_t total = candidate_moves_.size();
+  if (total == 0) {
+    return nullptr;
+  }
 
-  for (const auto& child : children_) {
-    double ucb_value = child->getUCBValue(exploration_constant);
-    if (ucb_value > best_value) {
-      best_value = ucb_value;
-      best_child = child.get();
+  // 上限まで実体化していなければ、新しい(未訪問の)子を優先して返す。
+  // 未訪問の子を最優先する従来のUCB挙動と同じ順序を、候補手の並び順で辿る。
+  const int parent_visits = stats_.visits.load();
+  const size_t limit =
+      widening.enabled
+          ? progressiveWideningLimit(parent_visits, total, widening)
+          : total;
+  if (materialized_.load(std::memory_order_acquire) < limit) {
+    if (Node* child = materializeNextChild(limit)) {
+      return child;
     }
   }
+  const size_t count = materialized_.load(std::memory_order_acquire);
+  if (count == 0) {
+    return nullptr;
+  }
 
-  return best_child;
+  // 子統計はatomicで個別に保持されているため、スレッドローカルの連続配列へ
+  // スナップショットしてから選択カーネルに渡す。log/sqrtは親で1回だけ計算する。
+  thread_local std::vector<float> means;
+  thread_local std::vector<int32_t> visits;
+  means.resize(count);
+  visits.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto& child_stats = children_[i]->stats_;
+    const int child_visits = child_stats.visits.load();
+    visits[i] = child_visits;
+    means[i] = child_visits > 0
+                   ? static_cast<float>(child_stats.total_value.load() /
+                                        child_visits)
+                   : 0.0F;
+  }
+
+  const auto exploration_scale = static_cast<float>(
+      exploration_constant * std::sqrt(std::log(parent_visits + 1)));
+  const size_t best_index = ucbArgmax(means, visits, exploration_scale);
+  if (best_index >= count) {
+    return nullptr;
+  }
+  return children_[best_index].get();
 }
 
 void Node::backpropagate(double value) {
@@ -101,23 +153,130 @@ void Node::backpropagate(double value) {
   }
 }
 
-// RolloutPolicy implementation
-std::shared_ptr<Move> RolloutPolicy::selectMove(
-    const std::vector<std::shared_ptr<Move>>& legal_moves) {
-  if (legal_moves.empty()) {
-    return nullptr;
+size_t progressiveWideningLimit(int visits, size_t total,
+                                const ProgressiveWideningConfig& config) {
+  if (total == 0) {
+    return 0;
+  }
+  const double allowed =
+      std::ceil(config.k * std::pow(std::max(visits, 1), config.alpha));
+  if (!std::isfinite(allowed) || allowed >= static_cast<double>(total)) {
+    return total;
   }
+  return std::max<size_t>(1, static_cast<size_t>(allowed));
+}
 
-  std::uniform_int_distribution<size_t> dist(0, legal_moves.size() - 1);
-  size_t selected_index = dist(rng_);
+// InformationSetNode implementation
+InformationSetNode::InformationSetNode(std::shared_ptr<Move> move,
+                                       InformationSetNode* parent)
+    : move_(std::move(move)), parent_(parent) {}
+
+InformationSetNode* InformationSetNode::findChildLocked(
+    const Move& move) const {
+  const auto [first, last] = children_by_key_.equal_range(move.getKey());
+  for (auto it = first; it != last; ++it) {
+    if (*it->second->move_ == move) {
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
+InformationSetNode* InformationSetNode::selectOrExpand(
+    const std::vector<std::shared_ptr<Move>>& legal_moves,
+    double exploration_constant, std::mt19937_64& rng, bool& expanded) {
+  expanded = false;
+  std::lock_guard<std::mutex> lock(mutex_);
 
-  return legal_moves[selected_index];
+  thread_local std::vector<InformationSetNode*> available;
+  thread_local std::vector<const std::shared_ptr<Move>*> untried;
+  available.clear();
+  untried.clear();
+  for (const auto& move : legal_moves) {
+    if (InformationSetNode* child = findChildLocked(*move)) {
+      // 同じ手が重複して並んでいても利用可能回数は1回分だけ数える。
+      if (std::find(available.begin(), available.end(), child) ==
+          available.end()) {
+        available.push_back(child);
+      }
+    } else {
+      untried.push_back(&move);
+    }
+  }
+  for (auto* child : available) {
+    child->availability_.fetch_add(1);
+  }
+
+  if (!untried.empty()) {
+    std::uniform_int_distribution<size_t> dist(0, untried.size() - 1);
+    const auto& move = *untried[dist(rng)];
+    auto* child = children_
+                      .emplace_back(
+                          std::make_unique<InformationSetNode>(move, this))
+                      .get();
+    children_by_key_.emplace(move->getKey(), child);
+    child->availability_.fetch_add(1);
+    expanded = true;
+    return child;
+  }
+
+  // 親の訪問回数の代わりに、その子を選べた回数を探索項の分母に使う。
+  InformationSetNode* best = nullptr;
+  double best_score = -std::numeric_limits<double>::infinity();
+  for (auto* child : available) {
+    const int child_visits = child->visits_.load();
+    double score = std::numeric_limits<double>::max();
+    if (child_visits > 0) {
+      score = child->total_value_.load() / child_visits +
+              exploration_constant *
+                  std::sqrt(std::log(child->availability_.load()) /
+                            child_visits);
+    }
+    if (score > best_score) {
+      best_score = score;
+      best = child;
+    }
+  }
+  return best;
+}
+
+void InformationSetNode::backpropagate(double value, Side root_side) {
+  for (InformationSetNode* node = this; node != nullptr;
+       node = node->parent_) {
+    node->visits_.fetch_add(1);
+    if (node->move_ != nullptr) {
+      const Side mover = node->move_->getSide();
+      node->total_value_.fetch_add(
+          mover == getOpponentSide(root_side) ? -value : value);
+    }
+  }
+}
+
+size_t InformationSetNode::countNodes() const {
+  size_t count = 1;
+  for (const auto& child : children_) {
+    count += child->countNodes();
+  }
+  return count;
 }
 
 // MCTSExecutor implementation
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-MCTSExecutor::MCTSExecutor(double exploration_constant, int num_threads)
-    : exploration_constant_(exploration_constant), num_threads_(num_threads) {
+MCTSExecutor::MCTSExecutor(double exploration_constant, int num_threads,
+                           ProgressiveWideningConfig widening, SearchMode mode,
+                           PlayoutConfig playout)
+    : exploration_constant_(exploration_constant),
+      num_threads_(num_threads),
+      widening_(std::move(widening)),
+      mode_(mode),
+      playout_(std::move(playout)) {
+  if (!playout_.rollout) {
+    playout_.rollout = std::make_shared<UniformRolloutPolicy>();
+  }
+  if (!playout_.evaluator) {
+    playout_.evaluator = std::make_shared<VpBoardEvaluator>();
+  }
+  playout_.rollout_depth = std::max(playout_.rollout_depth, 0);
   // 各スレッド用のRNGを初期化
   thread_rngs_.reserve(num_threads);
   // NOLINTNEXTLINE(readability-identifier-length)
@@ -129,9 +288,26 @@ MCTSExecutor::MCTSExecutor(double exploration_constant, int num_threads)
 
 std::shared_ptr<Move> MCTSExecutor::search(
     const Board& root_board, Side side, int num_iterations,
-    std::chrono::milliseconds time_limit) {
+    std::chrono::milliseconds time_limit,
+    const DeterminizationConstraints& constraints) {
+  if (mode_ == SearchMode::SINGLE_OBSERVER) {
+    auto root = buildInformationSetTree(root_board, side, num_iterations,
+                                        time_limit, constraints);
+    // 最も訪問回数の多い手を選択（Robust Child）
+    std::shared_ptr<Move> best_move;
+    int max_visits = -1;
+    for (const auto& child : root->getChildren()) {
+      if (child->getVisits() > max_visits) {
+        max_visits = child->getVisits();
+        best_move = child->getMove();
+      }
+    }
+    return best_move;
+  }
+
   // 決定化パターンを生成
-  auto determinizations = generateDeterminizations(root_board, side);
+  auto determinizations =
+      generateDeterminizations(root_board, side, constraints);
 
   if (determinizations.empty()) {
     return nullptr;
@@ -182,110 +358,105 @@ std::shared_ptr<Move> MCTSExecutor::search(
   return selectBestMove(root_nodes);
 }
 
-std::vector<DeterminizedState> MCTSExecutor::generateDeterminizations(
-    const Board& board, Side side, int max_determinizations) {
-  // 返却すべき決定化パターンのリスト
-  std::vector<DeterminizedState> determinizations;
+std::unique_ptr<InformationSetNode> MCTSExecutor::buildInformationSetTree(
+    const Board& root_board, Side side, int num_iterations,
+    std::chrono::milliseconds time_limit,
+    const DeterminizationConstraints& constraints) {
+  auto root = std::make_unique<InformationSetNode>(nullptr, nullptr);
+  const DeterminizationSampler sampler(root_board, side, constraints);
 
-  Side opponent = getOpponentSide(side);
-  const auto& my_hand = board.getPlayerHand(side);
-  // opponent_handには基本Dummyカードのみ
-  const auto& opponent_hand = board.getPlayerHand(opponent);
-  // TODO:
-  // Deckは不可視！有効なカードから逆算する必要あり(というかDeckという名前は不適切で、available_cardsとかにすべき)
-  // なぜなら不可視カードはデッキ+相手の手札のためデッキそのものではない。相手の手札を決定したあとデッキを決定化する必要がある
-  // ただしデッキは決定化せず乱数に任せる方法もある
-  const auto& deck = board.getDeck().getDeck();
-  const auto& discard = board.getDeck().getDiscardPile();
-
-  size_t opponent_hand_size = opponent_hand.size();
-
-  // TODO: 決定化のアルゴリズム
-  // 相手の手札をランダムに決定化する、その後ランダムで選ばれたをused_cardsに登録する。また相手の手札が決定化されたしたのでデッキも決定化される。
-  // 次の決定化では、used_cardsに登録されたカードは選ばれないようにする。
-  // 例えばused_cardsに登録された無いカードがあと3枚で、決定化しなければならないカードが4枚あった場合、used_cardsに登録されたカードを1枚ランダムに外して決定化する。
-  // used_cardsがすべてのカードを含む場合、used_cardsをクリアして再度決定化を行う。これをmax_determinizationsまで繰り返す
-
-  // 使用可能なカードプールを作成
-  std::vector<CardEnum> available_cards;
-  available_cards.reserve(deck.size() + discard.size());
-
-  // デッキから自分の手札を除外
-  for (CardEnum card : deck) {
-    if (std::find(my_hand.begin(), my_hand.end(), card) == my_hand.end()) {
-      available_cards.push_back(card);
-    }
+  // Tree Parallelization: 全スレッドが1本の木を共有する
+  std::atomic<bool> should_stop(false);
+  std::vector<std::thread> threads;
+  const int iterations_per_thread = std::max(1, num_iterations / num_threads_);
+  const auto start_time = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < num_threads_; ++i) {
+    threads.emplace_back([this, &root, &root_board, &sampler, side,
+                          iterations_per_thread, time_limit, start_time,
+                          &should_stop, i]() {
+      auto& rng = thread_rngs_[static_cast<size_t>(i)];
+      for (int j = 0; j < iterations_per_thread; ++j) {
+        if (should_stop.load()) {
+          break;
+        }
+        if (std::chrono::steady_clock::now() - start_time > time_limit) {
+          should_stop.store(true);
+          break;
+        }
+        runInformationSetIteration(root.get(), root_board, sampler, side, rng);
+      }
+    });
   }
 
-  // 捨て札から自分の手札を除外
-  for (CardEnum card : discard) {
-    if (std::find(my_hand.begin(), my_hand.end(), card) == my_hand.end()) {
-      available_cards.push_back(card);
-    }
+  for (auto& thread : threads) {
+    thread.join();
   }
+  return root;
+}
 
-  if (available_cards.size() < opponent_hand_size) {
-    // 使用可能なカードが足りない場合は現在の状態をそのまま使用
-    DeterminizedState det;
-    det.opponent_hand =
-        std::vector<CardEnum>(opponent_hand.begin(), opponent_hand.end());
-    det.determinization_id = 0;
-    determinizations.push_back(det);
-    return determinizations;
-  }
-
-  // 脅威となるカードを優先的に配分
-  std::vector<CardEnum> threat_cards;
-  std::vector<CardEnum> normal_cards;
-
-  for (CardEnum card : available_cards) {
-    // スコアリングカードや高Opsカードを脅威として扱う
-    const auto& card_obj = board.getCardpool()[static_cast<size_t>(card)];
-    if (card_obj && (card_obj->getOps() == 0 || card_obj->getOps() >= 3)) {
-      threat_cards.push_back(card);
-    } else {
-      normal_cards.push_back(card);
+void MCTSExecutor::runInformationSetIteration(
+    InformationSetNode* root, const Board& root_board,
+    const DeterminizationSampler& sampler, Side side, std::mt19937_64& rng) {
+  Board board = root_board.copyForMCTS(side);
+  sampler.apply(board, rng);
+  board.getRandomizer().setRng(&rng);
+
+  auto winnerValue = [side](Side winner) {
+    if (winner == side) {
+      return 1.0;
+    }
+    return winner == getOpponentSide(side) ? -1.0 : 0.0;
+  };
+
+  // Selection / Expansion: この決定化で合法な子だけを辿り、未試行の手に出会ったら1つ展開する
+  InformationSetNode* node = root;
+  auto [legal_moves, next_side, winner] = PhaseMachine::step(board);
+  while (!winner.has_value() && !legal_moves.empty()) {
+    bool expanded = false;
+    InformationSetNode* child = node->selectOrExpand(
+        legal_moves, exploration_constant_, rng, expanded);
+    if (child == nullptr) {
+      break;
+    }
+    node = child;
+    std::tie(legal_moves, next_side, winner) =
+        PhaseMachine::step(board, child->getMove());
+    if (expanded) {
+      break;
     }
   }
 
-  // 決定化パターンを生成
+  // Simulation
+  const double value = winner.has_value()
+                           ? winnerValue(*winner)
+                           : simulate(std::move(board), side);
+
+  // Backpropagation
+  node->backpropagate(value, side);
+}
+
+std::vector<DeterminizedState> MCTSExecutor::generateDeterminizations(
+    const Board& board, Side side,
+    const DeterminizationConstraints& constraints, int max_determinizations) {
+  std::vector<DeterminizedState> determinizations;
+
+  // 見えないカード(現在の戦期の全カードから公開情報を除いたもの)を相手の手札と山札に分ける
+  const DeterminizationSampler sampler(board, side, constraints);
+  // 相手の手札が空なら決定化しても全て同じになる
+  const int count =
+      sampler.getOpponentHandSize() == 0 ? 1 : max_determinizations;
+
   // NOLINTNEXTLINE(readability-identifier-length)
   std::random_device rd;
   std::mt19937_64 rng(rd());
-
-  for (int i = 0;
-       i < max_determinizations &&
-       i < static_cast<int>(available_cards.size() / opponent_hand_size);
-       ++i) {
+  std::vector<CardEnum> deck;
+  determinizations.reserve(static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
     DeterminizedState det;
-    det.determinization_id = i;
-
-    // 使用済みカードを記録
-    std::vector<bool> used(available_cards.size(), false);
-
-    // 脅威カードを均等に配分
-    size_t threat_per_det = std::min(
-        threat_cards.size() / max_determinizations + 1, opponent_hand_size);
-    size_t added_count = 0;
-
-    for (size_t j = 0; j < threat_per_det && added_count < opponent_hand_size;
-         ++j) {
-      size_t threat_index = (i * threat_per_det + j) % threat_cards.size();
-      if (threat_index < threat_cards.size()) {
-        det.opponent_hand.push_back(threat_cards[threat_index]);
-        added_count++;
-      }
-    }
-
-    // 残りを通常カードで埋める
-    std::shuffle(normal_cards.begin(), normal_cards.end(), rng);
-    for (size_t j = 0;
-         j < normal_cards.size() && added_count < opponent_hand_size; ++j) {
-      det.opponent_hand.push_back(normal_cards[j]);
-      added_count++;
-    }
-
-    determinizations.push_back(det);
+    det.determinization_id = static_cast<size_t>(i);
+    sampler.sample(rng, det.opponent_hand, deck);
+    determinizations.push_back(std::move(det));
   }
 
   return determinizations;
@@ -339,7 +510,7 @@ Node* MCTSExecutor::select(Node* start_node) const {
   Node* current = start_node;
   while (current != nullptr && !current->isTerminal() &&
          current->isExpanded()) {
-    current = current->selectBestChild(exploration_constant_);
+    current = current->selectBestChild(exploration_constant_, widening_);
   }
   return current;
 }
@@ -357,19 +528,35 @@ Node* MCTSExecutor::expand(Node* node) {
     return node;
   }
 
-  node->expand(legal_moves);
-
-  // ランダムに子ノードを選択して返す
-  const auto& children = node->getChildren();
-  if (!children.empty()) {
+  // 段階的展開では候補手の先頭から子になるため、ここで並び順を決める。
+  if (widening_.ordering) {
+    std::vector<std::pair<double, size_t>> scored;
+    scored.reserve(legal_moves.size());
+    for (size_t i = 0; i < legal_moves.size(); ++i) {
+      scored.emplace_back(widening_.ordering(node->getBoard(), *legal_moves[i]),
+                          i);
+    }
+    std::stable_sort(
+        scored.begin(), scored.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+    std::vector<std::shared_ptr<Move>> ordered;
+    ordered.reserve(legal_moves.size());
+    for (const auto& [score, index] : scored) {
+      ordered.push_back(legal_moves[index]);
+    }
+    legal_moves = std::move(ordered);
+  } else {
     size_t thread_id =
         std::hash<std::thread::id>{}(std::this_thread::get_id()) %
         thread_rngs_.size();
-    std::uniform_int_distribution<size_t> dist(0, children.size() - 1);
-    return children[dist(thread_rngs_[thread_id])].get();
+    std::shuffle(legal_moves.begin(), legal_moves.end(),
+                 thread_rngs_[thread_id]);
   }
 
-  return node;
+  node->expand(legal_moves);
+
+  Node* child = node->selectBestChild(exploration_constant_, widening_);
+  return child != nullptr ? child : node;
 }
 
 double MCTSExecutor::simulate(Board board, Side maximizing_side) {
@@ -377,14 +564,9 @@ double MCTSExecutor::simulate(Board board, Side maximizing_side) {
                      thread_rngs_.size();
   auto& rng = thread_rngs_[thread_id];
 
-  RolloutPolicy rollout_policy(rng);
-
-  // シミュレーション深さ制限
-  const int max_depth = 100;
-  int depth = 0;
-
+  // rollout_depth手まで進め、終局しなければ評価関数で打ち切る
   std::optional<std::shared_ptr<Move>> pending;
-  while (depth <= max_depth) {
+  for (int depth = 0;; ++depth) {
     auto [legal_moves, next_side, winner] =
         PhaseMachine::step(board, std::move(pending));
 
@@ -400,25 +582,14 @@ double MCTSExecutor::simulate(Board board, Side maximizing_side) {
       }
     }
 
-    if (legal_moves.empty()) {
+    if (legal_moves.empty() || depth >= playout_.rollout_depth) {
       break;
     }
 
-    // ランダムに手を選択
-    pending = rollout_policy.selectMove(legal_moves);
-
-    depth++;
+    pending = playout_.rollout->selectMove(board, legal_moves, rng);
   }
 
-  // 深さ制限に達した場合はVPで評価
-  // NOLINTNEXTLINE(readability-identifier-length)
-  int vp = board.getVp();
-  if (maximizing_side == Side::USSR) {
-    return std::tanh(vp / 10.0);  // [-1, 1]に正規化
-    // NOLINTNEXTLINE(readability-else-after-return)
-  } else {
-    return std::tanh(-vp / 10.0);
-  }
+  return playout_.evaluator->evaluate(board, maximizing_side);
 }
 
 std::shared_ptr<Move> MCTSExecutor::selectBestMove(
@@ -427,80 +598,65 @@ std::shared_ptr<Move> MCTSExecutor::selectBestMove(
     return nullptr;
   }
 
-  // 各Moveの統計を集計
-  std::unordered_map<std::string, std::pair<int, double>> move_stats;
+  // 決定化ごとのルートに同じ手が別インスタンスで並ぶため、Moveキーで集計する。
+  // キーが衝突した場合はoperator==で別の手として扱う。
+  struct MoveVisits {
+    std::shared_ptr<Move> move;
+    int visits = 0;
+  };
+  std::unordered_map<uint64_t, std::vector<MoveVisits>> move_stats;
 
   for (const auto& root : roots) {
     for (const auto& child : root->getChildren()) {
-      if (child->getLastMove() != nullptr) {
-        // Moveを文字列化して識別（簡易的な実装）
-        std::string move_key =
-            std::to_string(static_cast<int>(child->getLastMove()->getCard()));
-
-        if (auto* place_move = dynamic_cast<const ActionPlaceInfluenceMove*>(
-                child->getLastMove())) {
-          move_key += "_place";
-        } else if (auto* coup_move = dynamic_cast<const ActionCoupMove*>(
-                       child->getLastMove())) {
-          move_key += "_coup";
-        }
-        // 他の型も同様に処理
-
-        move_stats[move_key].first += child->getVisits();
-        move_stats[move_key].second +=
-            child->getAverageValue() * child->getVisits();
+      const auto& move = child->getLastMoveShared();
+      if (move == nullptr) {
+        continue;
       }
+      auto& bucket = move_stats[move->getKey()];
+      auto entry = std::find_if(
+          bucket.begin(), bucket.end(),
+          [&move](const MoveVisits& stat) { return *stat.move == *move; });
+      if (entry == bucket.end()) {
+        bucket.push_back({move, 0});
+        entry = std::prev(bucket.end());
+      }
+      entry->visits += child->getVisits();
     }
   }
 
   // 最も訪問回数の多い手を選択（Robust Child）
-  std::string best_move_key;
-  int max_visits = 0;
-
-  for (const auto& [key, stats] : move_stats) {
-    if (stats.first > max_visits) {
-      max_visits = stats.first;
-      best_move_key = key;
-    }
-  }
-
-  // 該当するMoveを見つけて返す
-  for (const auto& root : roots) {
-    for (const auto& child : root->getChildren()) {
-      if (child->getLastMove() != nullptr) {
-        std::string move_key =
-            std::to_string(static_cast<int>(child->getLastMove()->getCard()));
-
-        if (auto* place_move = dynamic_cast<const ActionPlaceInfluenceMove*>(
-                child->getLastMove())) {
-          move_key += "_place";
-          if (move_key == best_move_key) {
-            return std::make_shared<ActionPlaceInfluenceMove>(*place_move);
-          }
-        } else if (auto* coup_move = dynamic_cast<const ActionCoupMove*>(
-                       child->getLastMove())) {
-          move_key += "_coup";
-          if (move_key == best_move_key) {
-            return std::make_shared<ActionCoupMove>(*coup_move);
-          }
-        }
-        // 他の型も同様に処理
+  std::shared_ptr<Move> best_move;
+  int max_visits = -1;
+  for (const auto& [key, bucket] : move_stats) {
+    for (const auto& stat : bucket) {
+      if (stat.visits > max_visits) {
+        max_visits = stat.visits;
+        best_move = stat.move;
       }
     }
   }
 
-  return nullptr;
+  return best_move;
 }
 
 }  // namespace mcts
 
 // MCTSPolicy implementation
 MCTSPolicy::MCTSPolicy(int iterations_per_move,
-                       std::chrono::milliseconds time_limit, int num_threads)
-    : executor_(std::sqrt(2.0), num_threads),
+                       std::chrono::milliseconds time_limit, int num_threads,
+                       mcts::SearchMode mode)
+    : executor_(std::sqrt(2.0), num_threads, {}, mode),
+      beliefs_{mcts::OpponentHandBelief(Side::USSR),
+               mcts::OpponentHandBelief(Side::USA)},
       iterations_per_move_(iterations_per_move),
       time_limit_(time_limit) {}
 
+void MCTSPolicy::observeMove(const Board& board, const Move& move) {
+  for (auto& belief : beliefs_) {
+    belief.observe(board, move);
+  }
+}
+
 std::shared_ptr<Move> MCTSPolicy::decideMove(
     const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
     Side side) {
@@ -514,8 +670,12 @@ std::shared_ptr<Move> MCTSPolicy::decideMove(
   }
 
   // MCTSを実行
-  auto best_move =
-      executor_.search(board, side, iterations_per_move_, time_limit_);
+  const auto constraints =
+      side == Side::NEUTRAL
+          ? mcts::DeterminizationConstraints{}
+          : beliefs_[static_cast<size_t>(side)].toConstraints();
+  auto best_move = executor_.search(board, side, iterations_per_move_,
+                                    time_limit_, constraints);
 
   // MCTSが失敗した場合は最初の合法手を返す
   if (!best_move && !legal_moves.empty()) {
@@ -0,0 +1,304 @@
+// ファイル: src/players/mcts_select_kernel.cpp
+// 役割:
+// PUCT/UCB1のargmaxカーネルをスカラー版とAVX2版で実装し、実行時に振り分ける。
+// 背景:
+// -march=nativeを前提にできない配布バイナリでも、対応CPUでは8子同時評価を使えるようにするため。
+
+#include "tsge/players/mcts_select_kernel.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TSGE_SELECT_KERNEL_X86 1
+#endif
+
+namespace mcts {
+
+namespace {
+
+struct ReciprocalTables {
+  // inv_one_plus[n] = 1/(1+n), inv_sqrt[n] = 1/sqrt(n) (inv_sqrt[0]は未使用)
+  std::array<float, SELECT_KERNEL_TABLE_SIZE> inv_one_plus{};
+  std::array<float, SELECT_KERNEL_TABLE_SIZE> inv_sqrt{};
+
+  ReciprocalTables() {
+    for (int32_t n = 0; n < SELECT_KERNEL_TABLE_SIZE; ++n) {
+      inv_one_plus[n] = 1.0F / (1.0F + static_cast<float>(n));
+      inv_sqrt[n] = n == 0 ? 0.0F : 1.0F / std::sqrt(static_cast<float>(n));
+    }
+  }
+};
+
+// 子数がこれ未満ならAVX2の準備コストが上回るため自動選択ではスカラー版を使う。
+constexpr std::size_t SIMD_MIN_CHILDREN = 16;
+
+SelectKernelIsa isaForSize(std::size_t size) {
+  return size < SIMD_MIN_CHILDREN ? SelectKernelIsa::SCALAR
+                                  : activeSelectKernelIsa();
+}
+
+const ReciprocalTables& tables() {
+  static const ReciprocalTables instance;
+  return instance;
+}
+
+std::size_t puctArgmaxScalar(const float* q, const float* prior,
+                             const int32_t* visits, std::size_t size,
+                             float scale, std::size_t begin,
+                             std::size_t best_index, float best_score) {
+  for (std::size_t i = begin; i < size; ++i) {
+    const float score = q[i] + scale * prior[i] * reciprocalOnePlus(visits[i]);
+    if (score > best_score) {
+      best_score = score;
+      best_index = i;
+    }
+  }
+  return best_index;
+}
+
+std::size_t ucbArgmaxScalar(const float* mean, const int32_t* visits,
+                            std::size_t size, float scale, std::size_t begin,
+                            std::size_t best_index, float best_score) {
+  for (std::size_t i = begin; i < size; ++i) {
+    const float score = mean[i] + scale * reciprocalSqrt(visits[i]);
+    if (score > best_score) {
+      best_score = score;
+      best_index = i;
+    }
+  }
+  return best_index;
+}
+
+std::size_t firstUnvisitedScalar(const int32_t* visits, std::size_t size,
+                                 std::size_t begin) {
+  for (std::size_t i = begin; i < size; ++i) {
+    if (visits[i] <= 0) {
+      return i;
+    }
+  }
+  return size;
+}
+
+#ifdef TSGE_SELECT_KERNEL_X86
+
+// 8レーン分の(score, index)から最大score・最小indexを取り出す。
+__attribute__((target("avx2"))) void reduceLanes(__m256 best_scores,
+                                                 __m256i best_indices,
+                                                 float& out_score,
+                                                 std::size_t& out_index) {
+  alignas(32) std::array<float, 8> scores{};
+  alignas(32) std::array<int32_t, 8> indices{};
+  _mm256_store_ps(scores.data(), best_scores);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(indices.data()), best_indices);
+  for (std::size_t lane = 0; lane < 8; ++lane) {
+    // 一度も更新されていないレーン(-inf)はスカラー版と同様に候補にしない。
+    if (!(scores[lane] > -std::numeric_limits<float>::infinity())) {
+      continue;
+    }
+    const auto index = static_cast<std::size_t>(indices[lane]);
+    if (scores[lane] > out_score ||
+        (scores[lane] == out_score && index < out_index)) {
+      out_score = scores[lane];
+      out_index = index;
+    }
+  }
+}
+
+// テーブル範囲内はgather、範囲外は除算で逆数を求める。
+__attribute__((target("avx2"))) __m256 lookupReciprocal(
+    const float* table, __m256i counts, __m256 fallback) {
+  const __m256i limit = _mm256_set1_epi32(SELECT_KERNEL_TABLE_SIZE);
+  const __m256i in_table = _mm256_cmpgt_epi32(limit, counts);
+  const __m256i clamped =
+      _mm256_min_epi32(counts, _mm256_set1_epi32(SELECT_KERNEL_TABLE_SIZE - 1));
+  const __m256 gathered = _mm256_i32gather_ps(table, clamped, 4);
+  return _mm256_blendv_ps(fallback, gathered, _mm256_castsi256_ps(in_table));
+}
+
+__attribute__((target("avx2"))) std::size_t puctArgmaxAvx2(
+    const float* q, const float* prior, const int32_t* visits,
+    std::size_t size, float scale) {
+  const float* table = tables().inv_one_plus.data();
+  const __m256 one = _mm256_set1_ps(1.0F);
+  const __m256 scale_vec = _mm256_set1_ps(scale);
+  __m256 best_scores = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+  __m256i best_indices = _mm256_set1_epi32(0);
+  __m256i lane_indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i stride = _mm256_set1_epi32(8);
+
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m256i counts =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visits + i));
+    const __m256 fallback =
+        _mm256_div_ps(one, _mm256_add_ps(one, _mm256_cvtepi32_ps(counts)));
+    const __m256 recip = lookupReciprocal(table, counts, fallback);
+    const __m256 weighted =
+        _mm256_mul_ps(scale_vec, _mm256_loadu_ps(prior + i));
+    const __m256 scores =
+        _mm256_add_ps(_mm256_loadu_ps(q + i), _mm256_mul_ps(weighted, recip));
+    const __m256 better = _mm256_cmp_ps(scores, best_scores, _CMP_GT_OQ);
+    best_scores = _mm256_blendv_ps(best_scores, scores, better);
+    best_indices = _mm256_castps_si256(
+        _mm256_blendv_ps(_mm256_castsi256_ps(best_indices),
+                         _mm256_castsi256_ps(lane_indices), better));
+    lane_indices = _mm256_add_epi32(lane_indices, stride);
+  }
+
+  float best_score = -std::numeric_limits<float>::infinity();
+  std::size_t best_index = size;
+  if (i > 0) {
+    reduceLanes(best_scores, best_indices, best_score, best_index);
+  }
+  return puctArgmaxScalar(q, prior, visits, size, scale, i, best_index,
+                          best_score);
+}
+
+__attribute__((target("avx2"))) std::size_t firstUnvisitedAvx2(
+    const int32_t* visits, std::size_t size) {
+  const __m256i one = _mm256_set1_epi32(1);
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m256i counts =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visits + i));
+    const int mask = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpgt_epi32(one, counts)));
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  }
+  return firstUnvisitedScalar(visits, size, i);
+}
+
+__attribute__((target("avx2"))) std::size_t ucbArgmaxAvx2(
+    const float* mean, const int32_t* visits, std::size_t size, float scale) {
+  const float* table = tables().inv_sqrt.data();
+  const __m256 scale_vec = _mm256_set1_ps(scale);
+  __m256 best_scores = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+  __m256i best_indices = _mm256_set1_epi32(0);
+  __m256i lane_indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i stride = _mm256_set1_epi32(8);
+
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m256i counts =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visits + i));
+    const __m256 fallback = _mm256_div_ps(
+        _mm256_set1_ps(1.0F), _mm256_sqrt_ps(_mm256_cvtepi32_ps(counts)));
+    const __m256 recip = lookupReciprocal(table, counts, fallback);
+    const __m256 scores = _mm256_add_ps(_mm256_loadu_ps(mean + i),
+                                        _mm256_mul_ps(scale_vec, recip));
+    const __m256 better = _mm256_cmp_ps(scores, best_scores, _CMP_GT_OQ);
+    best_scores = _mm256_blendv_ps(best_scores, scores, better);
+    best_indices = _mm256_castps_si256(
+        _mm256_blendv_ps(_mm256_castsi256_ps(best_indices),
+                         _mm256_castsi256_ps(lane_indices), better));
+    lane_indices = _mm256_add_epi32(lane_indices, stride);
+  }
+
+  float best_score = -std::numeric_limits<float>::infinity();
+  std::size_t best_index = size;
+  if (i > 0) {
+    reduceLanes(best_scores, best_indices, best_score, best_index);
+  }
+  return ucbArgmaxScalar(mean, visits, size, scale, i, best_index, best_score);
+}
+
+#endif  // TSGE_SELECT_KERNEL_X86
+
+SelectKernelIsa detectIsa() {
+#ifdef TSGE_SELECT_KERNEL_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SelectKernelIsa::AVX2;
+  }
+#endif
+  return SelectKernelIsa::SCALAR;
+}
+
+}  // namespace
+
+SelectKernelIsa activeSelectKernelIsa() {
+  static const SelectKernelIsa isa = detectIsa();
+  return isa;
+}
+
+bool isSelectKernelIsaSupported(SelectKernelIsa isa) {
+  if (isa == SelectKernelIsa::SCALAR) {
+    return true;
+  }
+  return activeSelectKernelIsa() == SelectKernelIsa::AVX2;
+}
+
+float reciprocalOnePlus(int32_t visits) {
+  if (visits >= 0 && visits < SELECT_KERNEL_TABLE_SIZE) [[likely]] {
+    return tables().inv_one_plus[visits];
+  }
+  return 1.0F / (1.0F + static_cast<float>(visits));
+}
+
+float reciprocalSqrt(int32_t visits) {
+  if (visits >= 0 && visits < SELECT_KERNEL_TABLE_SIZE) [[likely]] {
+    return tables().inv_sqrt[visits];
+  }
+  return 1.0F / std::sqrt(static_cast<float>(visits));
+}
+
+std::size_t puctArgmax(std::span<const float> q, std::span<const float> prior,
+                       std::span<const int32_t> visits,
+                       float exploration_scale) {
+  return puctArgmax(q, prior, visits, exploration_scale, isaForSize(q.size()));
+}
+
+std::size_t puctArgmax(std::span<const float> q, std::span<const float> prior,
+                       std::span<const int32_t> visits, float exploration_scale,
+                       SelectKernelIsa isa) {
+  const std::size_t size = q.size();
+  if (size == 0) {
+    return 0;
+  }
+#ifdef TSGE_SELECT_KERNEL_X86
+  if (isa == SelectKernelIsa::AVX2 && isSelectKernelIsaSupported(isa)) {
+    return puctArgmaxAvx2(q.data(), prior.data(), visits.data(), size,
+                          exploration_scale);
+  }
+#endif
+  return puctArgmaxScalar(q.data(), prior.data(), visits.data(), size,
+                          exploration_scale, 0, size,
+                          -std::numeric_limits<float>::infinity());
+}
+
+std::size_t ucbArgmax(std::span<const float> mean,
+                      std::span<const int32_t> visits,
+                      float exploration_scale) {
+  return ucbArgmax(mean, visits, exploration_scale, isaForSize(mean.size()));
+}
+
+std::size_t ucbArgmax(std::span<const float> mean,
+                      std::span<const int32_t> visits, float exploration_scale,
+                      SelectKernelIsa isa) {
+  const std::size_t size = mean.size();
+  if (size == 0) {
+    return 0;
+  }
+#ifdef TSGE_SELECT_KERNEL_X86
+  if (isa == SelectKernelIsa::AVX2 && isSelectKernelIsaSupported(isa)) {
+    const std::size_t unvisited = firstUnvisitedAvx2(visits.data(), size);
+    if (unvisited < size) {
+      return unvisited;
+    }
+    return ucbArgmaxAvx2(mean.data(), visits.data(), size, exploration_scale);
+  }
+#endif
+  const std::size_t unvisited = firstUnvisitedScalar(visits.data(), size, 0);
+  if (unvisited < size) {
+    return unvisited;
+  }
+  return ucbArgmaxScalar(mean.data(), visits.data(), size, exploration_scale, 0,
+                         size, -std::numeric_limits<float>::infinity());
+}
+
+}  // namespace mcts
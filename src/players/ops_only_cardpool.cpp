@@ -0,0 +1,102 @@
+// ファイル: src/players/ops_only_cardpool.cpp
+// 役割:
+// Opsだけのカードを定義し、全カード番号分のプールと、その一部を実装済みのイベントカードで置き換えたプールを1度だけ組み立てる。
+// 背景:
+// 実行ファイルやライブラリごとに同じ定義を複製すると、Opsの割り当てがずれて結果を比べられなくなるため。
+
+#include "tsge/players/ops_only_cardpool.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tsge/actions/card_effect_legal_move_generator.hpp"
+#include "tsge/game_state/cards.hpp"
+#include "tsge/players/rollout_policy.hpp"
+
+namespace {
+
+// can_eventがfalseなら、何も起こさないイベントの手を合法手に出さない
+class OpsOnlyCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  OpsOnlyCard(CardEnum id, int ops, Side side, bool can_event)
+      : Card(id, "OpsOnly", ops, side, WarPeriod::EARLY_WAR, false),
+        can_event_{can_event} {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return can_event_;
+  }
+
+ private:
+  bool can_event_;
+};
+
+std::array<std::unique_ptr<Card>, 111> makeOpsOnlyCards(bool can_event) {
+  std::array<std::unique_ptr<Card>, 111> pool{};
+  constexpr std::array<Side, 3> SIDES{Side::USSR, Side::USA, Side::NEUTRAL};
+  // DUMMYはヘッドライン未選択や隠した札を表す番兵なので、カードを置かず山札にも入れない
+  for (int i = 1; i < 111; ++i) {
+    const auto id = static_cast<CardEnum>(i);
+    const int ops = mcts::scoringRegion(id) ? 0 : 1 + (i % 2);
+    pool[static_cast<size_t>(i)] = std::make_unique<OpsOnlyCard>(
+        id, ops, SIDES[static_cast<size_t>(i % 3)], can_event);
+  }
+  return pool;
+}
+
+// 各カードを自身のカード番号の位置へ置き換える
+template <typename... Cards>
+void placeCards(std::array<std::unique_ptr<Card>, 111>& pool) {
+  std::array<std::unique_ptr<Card>, sizeof...(Cards)> cards{
+      std::make_unique<Cards>()...};
+  for (auto& card : cards) {
+    pool[static_cast<size_t>(card->getId())] = std::move(card);
+  }
+}
+
+}  // namespace
+
+const std::array<std::unique_ptr<Card>, 111>& opsOnlyCardpool() {
+  static const auto cardpool = makeOpsOnlyCards(true);
+  return cardpool;
+}
+
+const std::array<std::unique_ptr<Card>, 111>& implementedCardpool() {
+  static const auto cardpool = [] {
+    // 実装済みのイベントだけを選べるよう、残りのカードはイベントを起こせない
+    auto pool = makeOpsOnlyCards(false);
+    placeCards<AsiaScoring, EuropeScoring, MiddleEastScoring,
+               CentralAmericaScoring, AfricaScoring, SouthAmericaScoring,
+               SoutheastAsiaScoring, DuckAndCover, ChinaCard, Fidel,
+               NuclearTestBan, Comecon, Decolonization, ColonialRearGuards,
+               PuppetGovernments, OASFounded, LiberationTheology,
+               WarsawPactFormed, MarshallPlan, UssuriRiverSkirmish,
+               TheReformer, SpecialRelationship, SouthAfricanUnrest, Junta,
+               SocialistGovernments, TheVoiceOfAmerica, MarineBarracksBombing,
+               SuezCrisis, EastEuropeanUnrest, PershingIIDeployed,
+               MuslimRevolution, DeStainization>(pool);
+    // De-Stalinizationの合法手生成器はGameの構築時に登録されるため、
+    // Gameを介さずPhaseMachineで進める利用者のためにここでも登録する
+    CardEffectLegalMoveGenerator::initializeBuiltinGenerators();
+    return pool;
+  }();
+  return cardpool;
+}
+
+const std::array<std::unique_ptr<Card>, 111>& cardpoolByName(
+    std::string_view name) {
+  if (name == "ops_only") {
+    return opsOnlyCardpool();
+  }
+  if (name == "implemented") {
+    return implementedCardpool();
+  }
+  throw std::invalid_argument("unknown cardpool: " + std::string(name));
+}
@@ -0,0 +1,230 @@
+// ファイル: src/players/rollout_policy.cpp
+// 役割:
+// 一様ランダム版とルールベース版のロールアウトポリシー、および盤面の支配状況の集計を実装する。
+// 背景:
+// プレイアウト1手の評価を数マイクロ秒に収めるため、盤面の走査は1手につき1回に限り、候補手の数も固定する。
+
+#include "tsge/players/rollout_policy.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "tsge/game_state/card.hpp"
+
+namespace mcts {
+
+namespace {
+
+constexpr size_t COUNTRY_COUNT = 86;
+
+[[nodiscard]] size_t sideIndex(Side side) {
+  return static_cast<size_t>(side);
+}
+
+[[nodiscard]] Side controlAfter(const Country& country, Side side, int added) {
+  const int own = country.getInfluence(side) + added;
+  const int other = country.getInfluence(getOpponentSide(side));
+  if (own - other >= country.getStability()) {
+    return side;
+  }
+  if (other - own >= country.getStability()) {
+    return getOpponentSide(side);
+  }
+  return Side::NEUTRAL;
+}
+
+}  // namespace
+
+std::optional<Region> scoringRegion(CardEnum card) {
+  switch (card) {
+    case CardEnum::ASIA_SCORING:
+      return Region::ASIA;
+    case CardEnum::EUROPE_SCORING:
+      return Region::EUROPE;
+    case CardEnum::MIDDLE_EAST_SCORING:
+      return Region::MIDDLE_EAST;
+    case CardEnum::CENTRAL_AMERICA_SCORING:
+      return Region::CENTRAL_AMERICA;
+    case CardEnum::SOUTHEAST_ASIA_SCORING:
+      return Region::SOUTH_EAST_ASIA;
+    case CardEnum::AFRICA_SCORING:
+      return Region::AFRICA;
+    case CardEnum::SOUTH_AMERICA_SCORING:
+      return Region::SOUTH_AMERICA;
+    default:
+      return std::nullopt;
+  }
+}
+
+RolloutSummary::RolloutSummary(const Board& board)
+    : defcon(board.getDefconTrack().getDefcon()) {
+  const auto& world_map = board.getWorldMap();
+  for (size_t i = 0; i < COUNTRY_COUNT; ++i) {
+    const auto& country = world_map.getCountry(static_cast<CountryEnum>(i));
+    const Side control = country.getControlSide();
+    if (control == Side::NEUTRAL) {
+      continue;
+    }
+    for (const auto region : country.getRegions()) {
+      const auto index = static_cast<size_t>(region);
+      if (index >= REGION_COUNT) {
+        continue;
+      }
+      ++controlled[index][sideIndex(control)];
+      if (country.isBattleground()) {
+        ++battlegrounds[index][sideIndex(control)];
+      }
+    }
+  }
+}
+
+int RolloutSummary::regionLead(Region region, Side side) const {
+  const auto index = static_cast<size_t>(region);
+  if (index >= REGION_COUNT || side == Side::NEUTRAL) {
+    return 0;
+  }
+  const size_t own = sideIndex(side);
+  const size_t other = sideIndex(getOpponentSide(side));
+  return 2 * (battlegrounds[index][own] - battlegrounds[index][other]) +
+         (controlled[index][own] - controlled[index][other]);
+}
+
+std::shared_ptr<Move> UniformRolloutPolicy::selectMove(
+    const Board& /*board*/,
+    const std::vector<std::shared_ptr<Move>>& legal_moves,
+    std::mt19937_64& rng) const {
+  if (legal_moves.empty()) {
+    return nullptr;
+  }
+  std::uniform_int_distribution<size_t> dist(0, legal_moves.size() - 1);
+  return legal_moves[dist(rng)];
+}
+
+HeuristicRolloutPolicy::HeuristicRolloutPolicy(HeuristicRolloutConfig config)
+    : config_(config) {
+  config_.candidates = std::max<size_t>(config_.candidates, 1);
+}
+
+std::shared_ptr<Move> HeuristicRolloutPolicy::selectMove(
+    const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
+    std::mt19937_64& rng) const {
+  if (legal_moves.empty()) {
+    return nullptr;
+  }
+  if (legal_moves.size() == 1) {
+    return legal_moves.front();
+  }
+  std::uniform_int_distribution<size_t> index_dist(0, legal_moves.size() - 1);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  if (unit(rng) < config_.epsilon) {
+    return legal_moves[index_dist(rng)];
+  }
+
+  const RolloutSummary summary(board);
+  // 合法手が候補数以下なら全て、それ以上なら無作為に候補数だけ評価する。
+  const bool exhaustive = legal_moves.size() <= config_.candidates;
+  const size_t count = exhaustive ? legal_moves.size() : config_.candidates;
+  size_t best = 0;
+  double best_score = -std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < count; ++i) {
+    const size_t index = exhaustive ? i : index_dist(rng);
+    const double score = scoreMove(board, summary, *legal_moves[index]);
+    if (score > best_score) {
+      best_score = score;
+      best = index;
+    }
+  }
+
+  // 引いた候補が全て自滅手なら、自滅でない手を探し直す。
+  if (best_score <= SUICIDE_SCORE && !exhaustive) {
+    for (size_t i = 0; i < legal_moves.size(); ++i) {
+      if (scoreMove(board, summary, *legal_moves[i]) > SUICIDE_SCORE) {
+        return legal_moves[i];
+      }
+    }
+  }
+  return legal_moves[best];
+}
+
+double HeuristicRolloutPolicy::scoreMove(const Board& board,
+                                         const RolloutSummary& summary,
+                                         const Move& move) const {
+  const Side side = move.getSide();
+  if (side == Side::NEUTRAL) {
+    return 0.0;
+  }
+  const Side opponent = getOpponentSide(side);
+  const CardEnum card_enum = move.getCard();
+  const Card* card =
+      card_enum == CardEnum::DUMMY
+          ? nullptr
+          : board.getCardpool()[static_cast<size_t>(card_enum)].get();
+  const int ops = card != nullptr ? card->getOps() : 0;
+  const bool opponent_event = card != nullptr && card->getSide() == opponent;
+  const auto& world_map = board.getWorldMap();
+
+  if (const auto* place =
+          dynamic_cast<const ActionPlaceInfluenceMove*>(&move)) {
+    double score = opponent_event ? -config_.opponent_event_penalty : 0.0;
+    for (const auto& [country_enum, amount] : place->getTargetCountries()) {
+      const auto& country = world_map.getCountry(country_enum);
+      const double weight =
+          country.isBattleground() ? config_.battleground_multiplier : 1.0;
+      const Side before = country.getControlSide();
+      const Side after = controlAfter(country, side, amount);
+      if (before == side) {
+        score -= config_.overcontrol_penalty * amount;
+      } else if (after == side) {
+        score += config_.gain_control * weight;
+      } else if (before == opponent && after != opponent) {
+        score += config_.break_control * weight;
+      }
+    }
+    return score;
+  }
+
+  if (const auto* coup = dynamic_cast<const ActionCoupMove*>(&move)) {
+    const auto& country = world_map.getCountry(coup->getTargetCountry());
+    if (country.isBattleground() && summary.defcon <= 2) {
+      return SUICIDE_SCORE;
+    }
+    // 期待除去量は Ops + 3.5 - 2 * 安定度(ダイスの期待値)。相手の影響力を上限とする。
+    const double expected = std::clamp(
+        ops + 3.5 - (2.0 * country.getStability()), 0.0,
+        static_cast<double>(country.getInfluence(opponent)));
+    double score = config_.coup_per_influence * expected;
+    if (country.isBattleground()) {
+      score *= config_.battleground_multiplier;
+      if (summary.defcon == 3) {
+        score -= config_.defcon_three_penalty;
+      }
+    }
+    return score - (opponent_event ? config_.opponent_event_penalty : 0.0);
+  }
+
+  if (const auto* realign =
+          dynamic_cast<const ActionRealigmentMove*>(&move)) {
+    const auto& country = world_map.getCountry(realign->getTargetCountry());
+    const double score = country.getInfluence(opponent) > 0 ? 0.3 : -1.0;
+    return score - (opponent_event ? config_.opponent_event_penalty : 0.0);
+  }
+
+  if (dynamic_cast<const ActionSpaceRaceMove*>(&move) != nullptr) {
+    // 相手のイベントを起こさずに捨てられる
+    return opponent_event ? config_.opponent_event_penalty : 0.0;
+  }
+
+  const bool is_event = dynamic_cast<const ActionEventMove*>(&move) != nullptr;
+  const bool is_headline =
+      dynamic_cast<const HeadlineCardSelectMove*>(&move) != nullptr;
+  if (is_event || is_headline) {
+    if (const auto region = scoringRegion(card_enum)) {
+      return config_.scoring_per_lead * summary.regionLead(*region, side);
+    }
+    return opponent_event ? -config_.opponent_event_penalty
+                          : config_.own_event_bonus;
+  }
+  return 0.0;
+}
+
+}  // namespace mcts
@@ -0,0 +1,247 @@
+// ファイル: src/players/training_shard.cpp
+// 役割:
+// シャードファイルの事前確保・mmap・ロック無し追記・切り詰めによる確定と、読み取り専用mmapでの検証を実装する。
+// 背景:
+// 追記はfetch_addで枠を取ってから内容を書き、最後に完了印をreleaseで立てるため、途中で落ちた枠は読み手が読み飛ばせる。
+
+#include "tsge/players/training_shard.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t HEADER_SIZE = sizeof(TrainingShardHeader);
+constexpr size_t RECORD_SIZE = sizeof(TrainingRecord);
+
+[[noreturn]] void throwSystemError(const std::string& what,
+                                   const std::string& path) {
+  throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+void TrainingRecord::setPosition(const Board& board, Side to_move) {
+  FeatureEncoder::encode(board, to_move, features.data());
+  side = static_cast<uint8_t>(to_move);
+  turn = static_cast<uint8_t>(board.getTurnTrack().getTurn());
+  action_round =
+      static_cast<uint8_t>(board.getActionRoundTrack().getActionRound(to_move));
+}
+
+void TrainingRecord::setPolicy(
+    std::span<const std::shared_ptr<Move>> legal_moves,
+    std::span<const double> probabilities) {
+  if (legal_moves.size() != probabilities.size()) {
+    throw std::invalid_argument("TrainingRecord::setPolicy: size mismatch");
+  }
+  std::vector<std::pair<size_t, double>> entries;
+  entries.reserve(legal_moves.size());
+  for (size_t i = 0; i < legal_moves.size(); ++i) {
+    if (legal_moves[i] == nullptr || probabilities[i] <= 0.0) {
+      continue;
+    }
+    const size_t index = ActionIndex::moveToIndex(*legal_moves[i]);
+    if (index != ActionIndex::INVALID) {
+      entries.emplace_back(index, probabilities[i]);
+    }
+  }
+  // 影響力の分解などで同じ添字に写る手の確率を合算する
+  std::sort(entries.begin(), entries.end());
+  size_t merged = 0;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (merged > 0 && entries[merged - 1].first == entries[i].first) {
+      entries[merged - 1].second += entries[i].second;
+    } else {
+      entries[merged++] = entries[i];
+    }
+  }
+  entries.resize(merged);
+
+  const size_t kept = std::min(entries.size(), POLICY_ENTRIES);
+  std::partial_sort(
+      entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(kept),
+      entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second ||
+               (lhs.second == rhs.second && lhs.first < rhs.first);
+      });
+  double total = 0.0;
+  for (size_t i = 0; i < kept; ++i) {
+    total += entries[i].second;
+  }
+  policy_count = static_cast<uint16_t>(kept);
+  policy_index.fill(0);
+  policy_prob.fill(0.0F);
+  for (size_t i = 0; i < kept; ++i) {
+    policy_index[i] = static_cast<uint32_t>(entries[i].first);
+    policy_prob[i] = static_cast<float>(entries[i].second / total);
+  }
+}
+
+TrainingShardWriter::TrainingShardWriter(const std::string& path,
+                                         size_t capacity)
+    : path_(path), capacity_(capacity) {
+  if (capacity_ == 0) {
+    throw std::invalid_argument("TrainingShardWriter requires capacity > 0");
+  }
+  fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) {
+    throwSystemError("cannot create training shard", path_);
+  }
+  mapped_size_ = HEADER_SIZE + (capacity_ * RECORD_SIZE);
+  if (::ftruncate(fd_, static_cast<off_t>(mapped_size_)) != 0) {
+    ::close(fd_);
+    throwSystemError("cannot allocate training shard", path_);
+  }
+  mapping_ = ::mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    fd_, 0);
+  if (mapping_ == MAP_FAILED) {
+    ::close(fd_);
+    throwSystemError("cannot map training shard", path_);
+  }
+  header_ = static_cast<TrainingShardHeader*>(mapping_);
+  records_ = reinterpret_cast<TrainingRecord*>(static_cast<char*>(mapping_) +
+                                               HEADER_SIZE);
+  header_->magic = TrainingShardHeader::MAGIC;
+  header_->version = TrainingShardHeader::VERSION;
+  header_->record_size = RECORD_SIZE;
+  header_->feature_version = FeatureEncoder::VERSION;
+  header_->action_version = ActionIndex::VERSION;
+  header_->capacity = capacity_;
+}
+
+TrainingShardWriter::~TrainingShardWriter() {
+  try {
+    finalize();
+  } catch (...) {  // NOLINT(bugprone-empty-catch)
+    // デストラクタからは投げない。未確定のシャードも完了印で読める。
+  }
+}
+
+bool TrainingShardWriter::append(const TrainingRecord& record) {
+  const uint64_t slot = std::atomic_ref<uint64_t>(header_->reserved)
+                            .fetch_add(1, std::memory_order_relaxed);
+  if (slot >= capacity_) {
+    return false;
+  }
+  TrainingRecord& target = records_[slot];
+  // 完了印以外を先に書き、印は最後にreleaseで立てる
+  constexpr size_t BODY_OFFSET = sizeof(TrainingRecord::committed);
+  std::memcpy(reinterpret_cast<char*>(&target) + BODY_OFFSET,
+              reinterpret_cast<const char*>(&record) + BODY_OFFSET,
+              RECORD_SIZE - BODY_OFFSET);
+  std::atomic_ref<uint32_t>(target.committed)
+      .store(1, std::memory_order_release);
+  return true;
+}
+
+void TrainingShardWriter::finalize() {
+  if (mapping_ == nullptr) {
+    return;
+  }
+  const size_t count = size();
+  // 本体を永続化してから確定の印を書くため、落ちても確定済みなのに中身が無い状態にならない
+  if (::msync(mapping_, mapped_size_, MS_SYNC) != 0) {
+    throwSystemError("cannot sync training shard", path_);
+  }
+  header_->record_count = count;
+  header_->finalized = 1;
+  if (::msync(mapping_, HEADER_SIZE, MS_SYNC) != 0) {
+    throwSystemError("cannot sync training shard header", path_);
+  }
+  ::munmap(mapping_, mapped_size_);
+  mapping_ = nullptr;
+  header_ = nullptr;
+  records_ = nullptr;
+  const auto used = static_cast<off_t>(HEADER_SIZE + (count * RECORD_SIZE));
+  const bool truncated = ::ftruncate(fd_, used) == 0 && ::fsync(fd_) == 0;
+  ::close(fd_);
+  fd_ = -1;
+  if (!truncated) {
+    throwSystemError("cannot truncate training shard", path_);
+  }
+}
+
+size_t TrainingShardWriter::size() const {
+  if (header_ == nullptr) {
+    return 0;
+  }
+  const uint64_t reserved = std::atomic_ref<uint64_t>(header_->reserved)
+                                .load(std::memory_order_relaxed);
+  return static_cast<size_t>(std::min<uint64_t>(reserved, capacity_));
+}
+
+TrainingShardReader::TrainingShardReader(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throwSystemError("cannot open training shard", path);
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    throwSystemError("cannot stat training shard", path);
+  }
+  mapped_size_ = static_cast<size_t>(status.st_size);
+  if (mapped_size_ < HEADER_SIZE) {
+    ::close(fd);
+    throw std::runtime_error("training shard is too small: " + path);
+  }
+  mapping_ = ::mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throwSystemError("cannot map training shard", path);
+  }
+  header_ = static_cast<const TrainingShardHeader*>(mapping_);
+  records_ = reinterpret_cast<const TrainingRecord*>(
+      static_cast<const char*>(mapping_) + HEADER_SIZE);
+
+  const size_t slots = (mapped_size_ - HEADER_SIZE) / RECORD_SIZE;
+  std::string error;
+  if (header_->magic != TrainingShardHeader::MAGIC) {
+    error = "not a training shard";
+  } else if (header_->version != TrainingShardHeader::VERSION ||
+             header_->record_size != RECORD_SIZE) {
+    error = "unsupported training shard version";
+  } else if (header_->finalized == 1) {
+    if (header_->record_count > slots) {
+      error = "truncated training shard";
+    }
+    count_ = static_cast<size_t>(header_->record_count);
+  } else {
+    const uint64_t reserved = __atomic_load_n(&header_->reserved,
+                                              __ATOMIC_RELAXED);
+    count_ = static_cast<size_t>(
+        std::min<uint64_t>({reserved, header_->capacity, slots}));
+  }
+  if (!error.empty()) {
+    ::munmap(mapping_, mapped_size_);
+    mapping_ = nullptr;
+    throw std::runtime_error(error + ": " + path);
+  }
+}
+
+TrainingShardReader::~TrainingShardReader() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapped_size_);
+  }
+}
+
+std::span<const TrainingRecord> TrainingShardReader::records() const {
+  return {records_, count_};
+}
+
+bool TrainingShardReader::isCommitted(size_t index) const {
+  return index < count_ &&
+         __atomic_load_n(&records_[index].committed, __ATOMIC_ACQUIRE) == 1;
+}
@@ -1,29 +1,74 @@
 // ファイル: src/players/tsnnmcts.cpp
 // 役割:
-// TsNnMcts骨組みのロジックを実装し、推論器とプレイヤーの橋渡しを担当する。
+// TsNnMctsの探索ロジックを実装し、推論器とプレイヤーの橋渡しを担当する。
 // 背景:
-// 盤面遷移の完全実装前にMCTSの制御フローを確立しておき、後続で段階的に拡張するため。
+// PhaseMachineで盤面を進めるPUCT探索と推論器のバッチ評価を1か所で制御するため。
 
 #include "tsge/players/tsnnmcts.hpp"
 
 #include <algorithm>
 #include <cmath>
-#include <limits>
 #include <numeric>
+#include <optional>
 #include <random>
 #include <stdexcept>
+#include <unordered_map>
+
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/players/mcts_select_kernel.hpp"
+
+namespace {
+
+// 合法手集合の順序非依存ハッシュ。確率的な遷移で子の前提が崩れていないかの照合に使う。
+uint64_t legalMovesSignature(const std::vector<std::shared_ptr<Move>>& moves) {
+  uint64_t signature = combineMoveKey(0, moves.size());
+  for (const auto& move : moves) {
+    signature += combineMoveKey(0, move->getKey());
+  }
+  return signature;
+}
+
+// owner視点へ評価値の符号を揃える。NEUTRALは視点を持たないためそのまま扱う。
+double valueForOwner(double value, Side value_side, Side owner) {
+  if (owner == Side::NEUTRAL || value_side == Side::NEUTRAL ||
+      owner == value_side) {
+    return value;
+  }
+  return -value;
+}
+
+}  // namespace
+
+// evaluateBatch: 既定では1件ずつevaluateへ委譲する。
+std::vector<TsNnMctsInferenceResult> TsNnMctsInferenceEngine::evaluateBatch(
+    std::span<const Board* const> boards,
+    std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+    std::span<const Side> sides) {
+  std::vector<TsNnMctsInferenceResult> results;
+  results.reserve(boards.size());
+  for (size_t i = 0; i < boards.size(); ++i) {
+    results.push_back(evaluate(*boards[i], *legal_moves[i], sides[i]));
+  }
+  return results;
+}
 
 // TsNnMctsNode::TsNnMctsNode: Moveとpriorを束ね、親ノード参照を保持。
 TsNnMctsNode::TsNnMctsNode(std::shared_ptr<Move> move, double prior,
-                           TsNnMctsNode* parent)
-    : move_(std::move(move)), prior_(prior), parent_(parent) {
-  // TODO: 将来的にはゲーム固有のMove IDで去重管理を行う。
-}
+                           TsNnMctsNode* parent, Side owner)
+    : move_(std::move(move)),
+      prior_(prior),
+      parent_(parent),
+      owner_(move_ != nullptr ? move_->getSide() : owner) {}
 
 // expand: policyベクトルと合法手に基づき子ノードを生成。
 void TsNnMctsNode::expand(const std::vector<std::shared_ptr<Move>>& legal_moves,
                           const std::vector<double>& priors) {
   children_.clear();
+  child_priors_.clear();
+  child_q_.clear();
+  child_visits_.clear();
+  child_keys_.clear();
+  legal_signature_ = legalMovesSignature(legal_moves);
 
   if (legal_moves.empty()) {
     return;
@@ -43,62 +88,179 @@ void TsNnMctsNode::expand(const std::vector<std::shared_ptr<Move>>& legal_moves,
     sum = 1.0;
   }
 
+  children_.reserve(legal_moves.size());
+  child_priors_.reserve(legal_moves.size());
+  child_q_.assign(legal_moves.size(), 0.0F);
+  child_visits_.assign(legal_moves.size(), 0);
+  child_keys_.reserve(legal_moves.size());
   for (size_t i = 0; i < legal_moves.size(); ++i) {
     double prior = normalized[i] / sum;
-    children_.push_back(
+    auto& child = children_.emplace_back(
         std::make_unique<TsNnMctsNode>(legal_moves[i], prior, this));
+    child->index_in_parent_ = i;
+    child_priors_.push_back(static_cast<float>(prior));
+    child_keys_.push_back(legal_moves[i]->getKey());
   }
 }
 
-// selectChild: シンプルなPUCT式で子を選択。
+// selectChild: PUCT式 q + c * prior * sqrt(N) / (1 + n) で子を選択。
+// sqrt(N)は親ごとに1回だけ計算し、1/(1+n)は選択カーネル側のテーブルで引く。
 TsNnMctsNode* TsNnMctsNode::selectChild(double c_puct) {
   if (children_.empty()) {
     return nullptr;
   }
 
-  double parent_visit = std::max(1, visit_count_);
-  TsNnMctsNode* best_child = nullptr;
-  double best_score = -std::numeric_limits<double>::infinity();
-
-  for (auto& child : children_) {
-    double q_value = 0.0;
-    if (child->visit_count_ > 0) {
-      q_value = child->value_sum_ / static_cast<double>(child->visit_count_);
-    }
-    double u_value = c_puct * child->prior_ *
-                     std::sqrt(static_cast<double>(parent_visit)) /
-                     (1.0 + static_cast<double>(child->visit_count_));
-    double puct = q_value + u_value;
-    if (puct > best_score) {
-      best_score = puct;
-      best_child = child.get();
-    }
+  const double parent_visit = std::max(1, visit_count_);
+  const auto exploration_scale =
+      static_cast<float>(c_puct * std::sqrt(parent_visit));
+  const size_t best_index = mcts::puctArgmax(child_q_, child_priors_,
+                                             child_visits_, exploration_scale);
+  if (best_index >= children_.size()) {
+    return nullptr;
   }
-
-  return best_child;
+  return children_[best_index].get();
 }
 
 // backup: 葉評価値を親まで伝播。
-void TsNnMctsNode::backup(double value, Side /*root_side*/) {
+void TsNnMctsNode::backup(double value, Side value_side) {
   TsNnMctsNode* node = this;
-  double propagated = value;
 
   while (node != nullptr) {
     node->visit_count_ += 1;
-    node->value_sum_ += propagated;
-
-    // TODO: サイド切り替えを明示的に格納し、反転規則を柔軟化する。
-    propagated = -propagated;
+    node->value_sum_ += valueForOwner(value, value_side, node->owner_);
+    if (node->parent_ != nullptr) {
+      // 親のSoAミラーを更新し、次回のselectChildで連続配列を読めるようにする。
+      auto& parent = *node->parent_;
+      parent.child_visits_[node->index_in_parent_] = node->visit_count_;
+      parent.child_q_[node->index_in_parent_] = static_cast<float>(
+          node->value_sum_ / static_cast<double>(node->visit_count_));
+    }
     node = node->parent_;
   }
 }
 
+// applyVirtualLoss: 経路上の各ノードを「1回訪問して負けた」ように見せる。
+void TsNnMctsNode::applyVirtualLoss(double loss) {
+  for (TsNnMctsNode* node = this; node != nullptr; node = node->parent_) {
+    node->visit_count_ += 1;
+    node->value_sum_ -= loss;
+    if (node->parent_ != nullptr) {
+      auto& parent = *node->parent_;
+      parent.child_visits_[node->index_in_parent_] = node->visit_count_;
+      parent.child_q_[node->index_in_parent_] = static_cast<float>(
+          node->value_sum_ / static_cast<double>(node->visit_count_));
+    }
+  }
+}
+
+// revertVirtualLoss: applyVirtualLossで加えた訪問と損失を取り除く。
+void TsNnMctsNode::revertVirtualLoss(double loss) {
+  for (TsNnMctsNode* node = this; node != nullptr; node = node->parent_) {
+    node->visit_count_ -= 1;
+    node->value_sum_ += loss;
+    if (node->parent_ != nullptr) {
+      auto& parent = *node->parent_;
+      parent.child_visits_[node->index_in_parent_] = node->visit_count_;
+      parent.child_q_[node->index_in_parent_] =
+          node->visit_count_ > 0
+              ? static_cast<float>(node->value_sum_ /
+                                   static_cast<double>(node->visit_count_))
+              : 0.0F;
+    }
+  }
+}
+
+// findChild: キーで候補を絞り、operator==で衝突を除外して一致する子を返す。
+TsNnMctsNode* TsNnMctsNode::findChild(const Move& move) const {
+  const uint64_t key = move.getKey();
+  for (size_t i = 0; i < children_.size(); ++i) {
+    if (child_keys_[i] == key && children_[i]->move_ != nullptr &&
+        *children_[i]->move_ == move) {
+      return children_[i].get();
+    }
+  }
+  return nullptr;
+}
+
+// releaseChild: 子の所有権を取り出し、親参照を切って新ルートとする。
+std::unique_ptr<TsNnMctsNode> TsNnMctsNode::releaseChild(TsNnMctsNode* child) {
+  if (child == nullptr || child->parent_ != this) {
+    return nullptr;
+  }
+  std::unique_ptr<TsNnMctsNode> released =
+      std::move(children_[child->index_in_parent_]);
+  released->parent_ = nullptr;
+  released->index_in_parent_ = 0;
+  return released;
+}
+
+// alignChildren: 合法手の順に子とSoAミラーを並べ替える。
+// 子のMoveは合法手側のインスタンスへ差し替え、以降の返却値を呼び出し側の手と揃える。
+bool TsNnMctsNode::alignChildren(
+    const std::vector<std::shared_ptr<Move>>& legal_moves) {
+  if (children_.size() != legal_moves.size()) {
+    return false;
+  }
+
+  std::unordered_multimap<uint64_t, size_t> index_by_key;
+  index_by_key.reserve(child_keys_.size());
+  for (size_t i = 0; i < child_keys_.size(); ++i) {
+    index_by_key.emplace(child_keys_[i], i);
+  }
+
+  std::vector<size_t> order;
+  order.reserve(legal_moves.size());
+  for (const auto& move : legal_moves) {
+    auto [first, last] = index_by_key.equal_range(move->getKey());
+    auto found = last;
+    for (auto it = first; it != last; ++it) {
+      if (*children_[it->second]->move_ == *move) {
+        found = it;
+        break;
+      }
+    }
+    if (found == last) {
+      return false;
+    }
+    order.push_back(found->second);
+    index_by_key.erase(found);
+  }
+
+  std::vector<std::unique_ptr<TsNnMctsNode>> children;
+  std::vector<float> priors;
+  std::vector<float> q_values;
+  std::vector<int32_t> visits;
+  std::vector<uint64_t> keys;
+  children.reserve(order.size());
+  priors.reserve(order.size());
+  q_values.reserve(order.size());
+  visits.reserve(order.size());
+  keys.reserve(order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    const size_t from = order[i];
+    auto& child = children.emplace_back(std::move(children_[from]));
+    child->index_in_parent_ = i;
+    child->move_ = legal_moves[i];
+    priors.push_back(child_priors_[from]);
+    q_values.push_back(child_q_[from]);
+    visits.push_back(child_visits_[from]);
+    keys.push_back(child_keys_[from]);
+  }
+  children_ = std::move(children);
+  child_priors_ = std::move(priors);
+  child_q_ = std::move(q_values);
+  child_visits_ = std::move(visits);
+  child_keys_ = std::move(keys);
+  return true;
+}
+
 // TsNnMctsController::TsNnMctsController: 推論器と設定を受け取って初期化。
 TsNnMctsController::TsNnMctsController(
     std::shared_ptr<TsNnMctsInferenceEngine> inference, TsNnMctsConfig config)
     : root_(std::make_unique<TsNnMctsNode>(nullptr, 1.0, nullptr)),
       inference_(std::move(inference)),
-      config_(config) {
+      config_(config),
+      rng_(config.seed != 0 ? config.seed : std::random_device{}()) {
   if (inference_ == nullptr) {
     throw std::invalid_argument(
         "TsNnMctsController requires a valid inference engine");
@@ -111,14 +273,12 @@ void TsNnMctsController::injectDirichletNoise(std::vector<double>& priors) {
     return;
   }
 
-  std::random_device rd;
-  std::mt19937 gen(rd());
   std::gamma_distribution<double> gamma(config_.dirichlet_alpha, 1.0);
 
   std::vector<double> noise(priors.size(), 0.0);
   double noise_sum = 0.0;
   for (double& n : noise) {
-    n = gamma(gen);
+    n = gamma(rng_);
     noise_sum += n;
   }
 
@@ -133,7 +293,7 @@ void TsNnMctsController::injectDirichletNoise(std::vector<double>& priors) {
   }
 }
 
-// runSearch: Skeleton実装では推論結果を用いて単純に手を選択。
+// runSearch: ルートを用意してnum_simulations回探索し、訪問回数最大の手を返す。
 std::shared_ptr<Move> TsNnMctsController::runSearch(
     const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
     Side side) {
@@ -141,43 +301,185 @@ std::shared_ptr<Move> TsNnMctsController::runSearch(
     return nullptr;
   }
 
-  // ルートノードをリセット。
-  root_ = std::make_unique<TsNnMctsNode>(nullptr, 1.0, nullptr);
+  // advanceで引き継いだルートが展開済みで、子が今回の合法手と一致すれば再利用する。
+  // 未展開のルートは別局面の統計である可能性を排除できないため破棄する。
+  reuse_stats_.searches += 1;
+  const bool reused = config_.reuse_tree && root_->isExpanded() &&
+                      root_->alignChildren(legal_moves);
+  if (reused) {
+    reuse_stats_.reused_roots += 1;
+    reuse_stats_.simulations_saved += root_->getVisitCount();
+  } else {
+    root_ = std::make_unique<TsNnMctsNode>(nullptr, 1.0, nullptr, side);
 
-  TsNnMctsInferenceResult inference_output =
-      inference_->evaluate(board, legal_moves, side);
+    TsNnMctsInferenceResult inference_output =
+        inference_->evaluate(board, legal_moves, side);
 
-  std::vector<double> priors = inference_output.policy;
-  if (priors.size() != legal_moves.size()) {
-    priors.assign(legal_moves.size(),
-                  1.0 / static_cast<double>(legal_moves.size()));
-  }
+    std::vector<double> priors = inference_output.policy;
+    if (priors.size() != legal_moves.size()) {
+      priors.assign(legal_moves.size(),
+                    1.0 / static_cast<double>(legal_moves.size()));
+    }
 
-  injectDirichletNoise(priors);
-  root_->expand(legal_moves, priors);
+    injectDirichletNoise(priors);
+    root_->expand(legal_moves, priors);
+    root_->backup(inference_output.value, side);
+  }
 
-  // TODO:
-  // PhaseMachineによる盤面遷移を組み込み、num_simulations回の探索を実行する。
-  // 現状は推論器のprior最大値を返却するのみ。
+  runSimulations(board, side);
 
+  // 訪問回数最大の子を選ぶ(Robust Child)。同数ならpriorの大きい方を優先し、
+  // num_simulations=0の場合は推論器のprior最大値を返す。
   size_t best_index = 0;
-  double best_prior = -1.0;
-  auto& children = root_->getMutableChildren();
-  for (size_t i = 0; i < children.size(); ++i) {
-    auto* child = children[i].get();
-    double child_prior = child->getPrior();
-    if (child_prior > best_prior) {
-      best_prior = child_prior;
+  const auto& children = root_->getChildren();
+  for (size_t i = 1; i < children.size(); ++i) {
+    const auto& best = children[best_index];
+    const auto& candidate = children[i];
+    if (candidate->getVisitCount() > best->getVisitCount() ||
+        (candidate->getVisitCount() == best->getVisitCount() &&
+         candidate->getPrior() > best->getPrior())) {
       best_index = i;
     }
-    // 初期構造では直接バックアップして統計を保存する。
-    child->backup(inference_output.value, side);
   }
 
   // TODO: root visit数に基づく温度付きサンプリングを導入する。
   return legal_moves[best_index];
 }
 
+// runSimulations: 選択→遷移→(バッチ)評価→展開→バックアップを繰り返す。
+void TsNnMctsController::runSimulations(const Board& board, Side side) {
+  struct PendingLeaf {
+    TsNnMctsNode* node;
+    Board board;
+    std::vector<std::shared_ptr<Move>> legal_moves;
+    Side side;
+    bool expand;
+  };
+
+  const size_t batch_size =
+      static_cast<size_t>(std::max(1, config_.batch_size));
+  int completed = 0;
+  std::vector<PendingLeaf> batch;
+  batch.reserve(batch_size);
+  // 葉からバッチ内の位置への対応と、同じ葉を再選択したシミュレーションの位置
+  std::unordered_map<TsNnMctsNode*, size_t> in_batch;
+  std::vector<size_t> duplicates;
+
+  while (completed < config_.num_simulations) {
+    batch.clear();
+    in_batch.clear();
+    duplicates.clear();
+
+    while (batch.size() < batch_size &&
+           completed + static_cast<int>(batch.size() + duplicates.size()) <
+               config_.num_simulations) {
+      Board sim_board = board;
+      sim_board.getRandomizer().setRng(&rng_);
+
+      TsNnMctsNode* node = root_.get();
+      std::vector<std::shared_ptr<Move>> legal_moves;
+      Side to_move = side;
+      std::optional<Side> winner;
+      bool expand = true;
+
+      while (node->isExpanded()) {
+        TsNnMctsNode* child = node->selectChild(config_.c_puct);
+        auto [next_moves, next_side, next_winner] = PhaseMachine::step(
+            sim_board, std::optional<std::shared_ptr<Move>>{
+                           child->getMoveShared()});
+        node = child;
+        if (next_winner.has_value() || next_moves.empty()) {
+          winner = next_winner.value_or(Side::NEUTRAL);
+          break;
+        }
+        legal_moves = std::move(next_moves);
+        to_move = next_side;
+        // 乱数を含む遷移で展開時と合法手が変わった場合は、この経路の子を使えない。
+        // 葉として評価だけ行い、既存の子は変更しない。
+        if (node->isExpanded() &&
+            node->getLegalSignature() != legalMovesSignature(legal_moves)) {
+          expand = false;
+          break;
+        }
+      }
+
+      if (winner.has_value()) {
+        const double terminal_value = *winner == Side::NEUTRAL ? 0.0 : 1.0;
+        node->backup(terminal_value, *winner);
+        completed += 1;
+        continue;
+      }
+
+      const auto [slot, inserted] = in_batch.try_emplace(node, batch.size());
+      if (!inserted) {
+        // 同じ葉が同一バッチで再選択された(仮想損失でも散らせない小さな木)。
+        // 仮想損失を重ねて選択を続け、評価後にその葉の値でバックアップする。
+        node->applyVirtualLoss(config_.virtual_loss);
+        duplicates.push_back(slot->second);
+        continue;
+      }
+
+      node->applyVirtualLoss(config_.virtual_loss);
+      batch.push_back({node, std::move(sim_board), std::move(legal_moves),
+                       to_move, expand});
+    }
+
+    if (batch.empty()) {
+      continue;
+    }
+
+    std::vector<const Board*> boards;
+    std::vector<const std::vector<std::shared_ptr<Move>>*> batch_moves;
+    std::vector<Side> sides;
+    boards.reserve(batch.size());
+    batch_moves.reserve(batch.size());
+    sides.reserve(batch.size());
+    for (const auto& leaf : batch) {
+      boards.push_back(&leaf.board);
+      batch_moves.push_back(&leaf.legal_moves);
+      sides.push_back(leaf.side);
+    }
+
+    const auto results = inference_->evaluateBatch(boards, batch_moves, sides);
+    for (size_t i = 0; i < batch.size(); ++i) {
+      auto& leaf = batch[i];
+      const double value = i < results.size() ? results[i].value : 0.0;
+      if (leaf.expand) {
+        const std::vector<double> empty_policy;
+        leaf.node->expand(leaf.legal_moves, i < results.size()
+                                                ? results[i].policy
+                                                : empty_policy);
+      }
+      leaf.node->revertVirtualLoss(config_.virtual_loss);
+      leaf.node->backup(value, leaf.side);
+      completed += 1;
+    }
+    for (const size_t i : duplicates) {
+      const auto& leaf = batch[i];
+      const double value = i < results.size() ? results[i].value : 0.0;
+      leaf.node->revertVirtualLoss(config_.virtual_loss);
+      leaf.node->backup(value, leaf.side);
+      completed += 1;
+    }
+  }
+}
+
+// advance: 指された手に対応する子を新ルートとして残し、兄弟の部分木は解放する。
+void TsNnMctsController::advance(const Move& played_move) {
+  TsNnMctsNode* child =
+      config_.reuse_tree ? root_->findChild(played_move) : nullptr;
+  if (child == nullptr) {
+    resetTree();
+    return;
+  }
+  root_ = root_->releaseChild(child);
+}
+
+// resetTree: ルートを空ノードへ戻す。
+void TsNnMctsController::resetTree() {
+  root_ = std::make_unique<TsNnMctsNode>(nullptr, 1.0, nullptr);
+}
+
 // TsNnMctsPolicy: ポリシーをPlayerテンプレートへ提供。
 TsNnMctsPolicy::TsNnMctsPolicy(
     std::shared_ptr<TsNnMctsInferenceEngine> inference, TsNnMctsConfig config)
@@ -187,5 +489,9 @@ std::shared_ptr<Move> TsNnMctsPolicy::decideMove(
     const Board& board, const std::vector<std::shared_ptr<Move>>& legal_moves,
     Side side) {
   // TODO: 時間制約やモードに応じて探索回数/温度を調整する。
-  return mcts_.runSearch(board, legal_moves, side);
+  auto selected = mcts_.runSearch(board, legal_moves, side);
+  if (selected != nullptr) {
+    mcts_.advance(*selected);
+  }
+  return selected;
 }
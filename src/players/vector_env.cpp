@@ -0,0 +1,332 @@
+// ファイル: src/players/vector_env.cpp
+// 役割:
+// 環境の初期化・行動の解決と適用・観測の書き出しを環境単位の処理として実装し、常駐ワーカーで全環境へ並列に適用する。
+// 背景:
+// 行動の検証を適用より先に全環境で済ませるため、不正な行動が1つでもあれば盤面を一切動かさずに失敗できる。
+
+#include "tsge/players/vector_env.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/players/match_runner.hpp"
+
+namespace {
+
+// ワーカーが1度に取る環境の数
+constexpr size_t CHUNK = 8;
+
+// 途中の手順を記録しただけで、盤面を進める手がまだ決まっていないことを表すchosen
+constexpr size_t PENDING = SIZE_MAX;
+
+// 手の手順(昇順)がprefixを多重集合として含むなら、残りの手順をvisitへ渡してtrueを返す
+template <typename Visit>
+bool visitRemainingSteps(std::span<const size_t> steps,
+                         std::span<const size_t> prefix, Visit&& visit) {
+  if (!std::includes(steps.begin(), steps.end(), prefix.begin(),
+                     prefix.end())) {
+    return false;
+  }
+  size_t j = 0;
+  for (const size_t step : steps) {
+    if (j < prefix.size() && prefix[j] == step) {
+      ++j;
+    } else {
+      visit(step);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+VectorEnv::VectorEnv(const std::array<std::unique_ptr<Card>, 111>& cardpool,
+                     const VectorEnvConfig& config, uint64_t base_seed)
+    : template_board_(cardpool),
+      config_(config),
+      envs_(config.num_envs),
+      rewards_(config.num_envs, 0.0F),
+      dones_(config.num_envs, 0),
+      invalid_(config.num_envs, 0),
+      seeds_(config.num_envs, 0) {
+  if (config_.num_envs == 0 || config_.threads == 0) {
+    throw std::invalid_argument("VectorEnv requires num_envs > 0, threads > 0");
+  }
+  workers_.reserve(config_.threads - 1);
+  for (size_t i = 1; i < config_.threads; ++i) {
+    workers_.emplace_back([this] { workerLoop(); });
+  }
+  std::vector<uint64_t> seeds(config_.num_envs);
+  for (size_t i = 0; i < seeds.size(); ++i) {
+    seeds[i] = matchSeed(base_seed, i);
+  }
+  try {
+    reset(seeds);
+  } catch (...) {
+    // デストラクタは呼ばれないため、ここでワーカーを止めてから投げ直す
+    stopWorkers();
+    throw;
+  }
+}
+
+VectorEnv::~VectorEnv() { stopWorkers(); }
+
+void VectorEnv::stopWorkers() {
+  {
+    const std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  job_ready_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void VectorEnv::reset(std::span<const uint64_t> seeds) {
+  if (seeds.size() != envs_.size()) {
+    throw std::invalid_argument("VectorEnv::reset: expected " +
+                                std::to_string(envs_.size()) + " seeds");
+  }
+  std::copy(seeds.begin(), seeds.end(), seeds_.begin());
+  forEachEnv(&VectorEnv::resetEnv);
+}
+
+void VectorEnv::step(std::span<const int> actions) {
+  if (actions.size() != envs_.size()) {
+    throw std::invalid_argument("VectorEnv::step: expected " +
+                                std::to_string(envs_.size()) + " actions");
+  }
+  actions_ = actions;
+  forEachEnv(&VectorEnv::resolveAction);
+  const auto invalid = std::find(invalid_.begin(), invalid_.end(), 1);
+  if (invalid != invalid_.end()) {
+    const auto env = static_cast<size_t>(invalid - invalid_.begin());
+    throw std::invalid_argument(
+        "VectorEnv::step: illegal action " + std::to_string(actions[env]) +
+        " for env " + std::to_string(env));
+  }
+  forEachEnv(&VectorEnv::applyAction);
+}
+
+void VectorEnv::observe(float* features_out, uint8_t* legal_mask_out) {
+  features_out_ = features_out;
+  legal_mask_out_ = legal_mask_out;
+  forEachEnv(&VectorEnv::observeEnv);
+}
+
+void VectorEnv::resetEnv(size_t index) {
+  auto& env = envs_[index];
+  env.seed = seeds_[index];
+  env.episode = 0;
+  rewards_[index] = 0.0F;
+  dones_[index] = 0;
+  startEpisode(env);
+}
+
+// 行動を途中の手順へ足し、それを含む合法手が1つに決まれば盤面を進める手とする。
+// 足した手順をまだ伸ばせる手があれば、手順を記録するだけにする(chosen = PENDING)。
+void VectorEnv::resolveAction(size_t index) {
+  auto& env = envs_[index];
+  const int action = actions_[index];
+  invalid_[index] = 1;
+  if (action < 0 || static_cast<size_t>(action) >= ActionIndex::SIZE) {
+    return;
+  }
+  const auto step = static_cast<size_t>(action);
+  if (step == ActionIndex::PASS_OFFSET && !env.prefix.empty()) {
+    // 途中の手順をそのまま1つの手として確定する
+    for (size_t i = 0; i < env.legal_moves.size(); ++i) {
+      const auto steps = moveSteps(env, i);
+      if (std::ranges::equal(steps, env.prefix)) {
+        env.chosen = i;
+        invalid_[index] = 0;
+        return;
+      }
+    }
+    return;
+  }
+
+  env.next_prefix.assign(env.prefix.begin(), env.prefix.end());
+  env.next_prefix.insert(std::ranges::upper_bound(env.next_prefix, step),
+                         step);
+  size_t complete = PENDING;
+  bool extendable = false;
+  for (size_t i = 0; i < env.legal_moves.size(); ++i) {
+    const auto steps = moveSteps(env, i);
+    if (!std::includes(steps.begin(), steps.end(), env.next_prefix.begin(),
+                       env.next_prefix.end())) {
+      continue;
+    }
+    if (steps.size() == env.next_prefix.size()) {
+      complete = std::min(complete, i);
+    } else {
+      extendable = true;
+    }
+  }
+  if (complete == PENDING && !extendable) {
+    return;
+  }
+  env.chosen = extendable ? PENDING : complete;
+  invalid_[index] = 0;
+}
+
+void VectorEnv::applyAction(size_t index) {
+  auto& env = envs_[index];
+  if (env.chosen == PENDING) {
+    std::swap(env.prefix, env.next_prefix);
+    rewards_[index] = 0.0F;
+    dones_[index] = 0;
+    return;
+  }
+  auto winner =
+      absorb(env, PhaseMachine::step(*env.board, env.legal_moves, env.chosen));
+  ++env.steps;
+  const bool truncated =
+      !winner.has_value() && env.steps >= config_.max_episode_steps;
+  if (!winner.has_value() && !truncated) {
+    rewards_[index] = 0.0F;
+    dones_[index] = 0;
+    return;
+  }
+  rewards_[index] = !winner.has_value() || *winner == Side::NEUTRAL ? 0.0F
+                    : *winner == Side::USSR                          ? 1.0F
+                                                                     : -1.0F;
+  dones_[index] = 1;
+  ++env.episode;
+  startEpisode(env);
+}
+
+void VectorEnv::observeEnv(size_t index) {
+  const auto& env = envs_[index];
+  if (features_out_ != nullptr) {
+    const Side viewer = env.side == Side::USA ? Side::USA : Side::USSR;
+    FeatureEncoder::encode(*env.board, viewer,
+                           features_out_ + (index * FeatureEncoder::SIZE));
+  }
+  if (legal_mask_out_ != nullptr) {
+    uint8_t* mask = legal_mask_out_ + (index * ActionIndex::SIZE);
+    if (env.prefix.empty()) {
+      ActionIndex::writeLegalMask(env.legal_moves, mask);
+      return;
+    }
+    // 途中の手順を含む手の残りの手順と、途中で確定できるならPASSを立てる
+    std::memset(mask, 0, ActionIndex::SIZE);
+    for (size_t i = 0; i < env.legal_moves.size(); ++i) {
+      const auto steps = moveSteps(env, i);
+      const bool matches = visitRemainingSteps(
+          steps, env.prefix, [mask](size_t step) { mask[step] = 1; });
+      if (matches && steps.size() == env.prefix.size()) {
+        mask[ActionIndex::PASS_OFFSET] = 1;
+      }
+    }
+  }
+}
+
+std::span<const size_t> VectorEnv::moveSteps(const Env& env, size_t move) {
+  const size_t begin = move == 0 ? 0 : env.move_step_end[move - 1];
+  return std::span<const size_t>(env.move_steps).subspan(
+      begin, env.move_step_end[move] - begin);
+}
+
+void VectorEnv::startEpisode(Env& env) {
+  env.rng.seed(matchSeed(env.seed, env.episode));
+  env.board.emplace(template_board_);
+  Board& board = *env.board;
+  board.getRandomizer().setRng(&env.rng);
+  board.getDeck().addEarlyWarCards();
+  board.pushState(StateType::TURN_START);
+  env.steps = 0;
+  if (absorb(env, PhaseMachine::step(board)).has_value()) {
+    throw std::runtime_error("VectorEnv: episode ended before the first move");
+  }
+}
+
+std::optional<Side> VectorEnv::absorb(
+    Env& env, std::tuple<std::vector<std::shared_ptr<Move>>, Side,
+                         std::optional<Side>>&& result) {
+  auto& [legal_moves, side, winner] = result;
+  env.prefix.clear();
+  if (winner.has_value() || legal_moves.empty()) {
+    env.legal_moves.clear();
+    env.move_steps.clear();
+    env.move_step_end.clear();
+    env.side = Side::NEUTRAL;
+    return winner.value_or(Side::NEUTRAL);
+  }
+  env.legal_moves = std::move(legal_moves);
+  env.side = side;
+  env.move_steps.clear();
+  env.move_step_end.clear();
+  for (const auto& move : env.legal_moves) {
+    if (move != nullptr) {
+      ActionIndex::influenceSteps(*move, env.move_steps);
+    }
+    env.move_step_end.push_back(env.move_steps.size());
+  }
+  return std::nullopt;
+}
+
+void VectorEnv::forEachEnv(Job job) {
+  {
+    const std::lock_guard lock(mutex_);
+    job_ = job;
+    next_env_.store(0, std::memory_order_relaxed);
+    running_workers_ = workers_.size();
+    ++generation_;
+  }
+  job_ready_.notify_all();
+  drain();
+  std::unique_lock lock(mutex_);
+  job_done_.wait(lock, [this] { return running_workers_ == 0; });
+  if (first_error_) {
+    auto error = std::exchange(first_error_, nullptr);
+    std::rethrow_exception(error);
+  }
+}
+
+void VectorEnv::drain() {
+  const size_t count = envs_.size();
+  while (true) {
+    const size_t begin = next_env_.fetch_add(CHUNK, std::memory_order_relaxed);
+    if (begin >= count) {
+      return;
+    }
+    const size_t end = std::min(begin + CHUNK, count);
+    for (size_t index = begin; index < end; ++index) {
+      try {
+        (this->*job_)(index);
+      } catch (...) {
+        const std::lock_guard lock(mutex_);
+        if (!first_error_) {
+          first_error_ = std::current_exception();
+        }
+      }
+    }
+  }
+}
+
+void VectorEnv::workerLoop() {
+  uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock lock(mutex_);
+      job_ready_.wait(lock,
+                      [&] { return stopping_ || generation_ != seen; });
+      if (stopping_) {
+        return;
+      }
+      seen = generation_;
+    }
+    drain();
+    const std::lock_guard lock(mutex_);
+    if (--running_workers_ == 0) {
+      job_done_.notify_one();
+    }
+  }
+}
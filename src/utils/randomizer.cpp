@@ -14,6 +14,10 @@ Randomizer::Randomizer() {
 }
 
 int Randomizer::rollDice() {
+  if (dice_rolled_ < forced_dice_.size()) {
+    return forced_dice_[dice_rolled_++];
+  }
+  ++dice_rolled_;
   std::uniform_int_distribution<int> dice(1, 6);
   auto& rng = (external_rng_ != nullptr) ? *external_rng_ : rng_;
   return dice(rng);
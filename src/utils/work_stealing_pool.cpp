@@ -0,0 +1,134 @@
+// ファイル: src/utils/work_stealing_pool.cpp
+// 役割:
+// ワーカーの起動・停止、仕事の投入先の決定、自分のキューからの取得と他キューからの盗み、完了待ちを実装する。
+// 背景:
+// 仕事1つは対局1局ほどの粒度なので、キューはミューテックス付きの両端キューで十分で、ロック無しの実装は使わない。
+
+#include "tsge/utils/work_stealing_pool.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// 現在のスレッドが属するプールとワーカー番号(ワーカー以外ではnullptr)
+thread_local const WorkStealingPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(size_t threads) {
+  if (threads == 0) {
+    throw std::invalid_argument("WorkStealingPool requires threads > 0");
+  }
+  queues_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  threads_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    threads_.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::unique_lock lock(state_mutex_);
+    all_done_.wait(lock, [this] {
+      return pending_.load(std::memory_order_acquire) == 0;
+    });
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkStealingPool::submit(Task task) {
+  const size_t target =
+      current_pool == this
+          ? current_worker
+          : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                queues_.size();
+  pending_.fetch_add(1, std::memory_order_acq_rel);
+  {
+    // 待機に入る直前のワーカーが通知を取りこぼさないよう、状態ロックの下で増やす。
+    // 積む前に数えるので、取得側で数が負に回り込むことはない。
+    const std::lock_guard lock(state_mutex_);
+    queued_.fetch_add(1, std::memory_order_release);
+  }
+  {
+    const std::lock_guard lock(queues_[target]->mutex);
+    queues_[target]->tasks.push_back(std::move(task));
+  }
+  work_available_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+  std::unique_lock lock(state_mutex_);
+  all_done_.wait(lock, [this] {
+    return pending_.load(std::memory_order_acquire) == 0;
+  });
+  if (first_error_) {
+    auto error = std::exchange(first_error_, nullptr);
+    std::rethrow_exception(error);
+  }
+}
+
+bool WorkStealingPool::tryTake(size_t self, Task& task) {
+  {
+    auto& own = *queues_[self];
+    const std::lock_guard lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+  // 自分の直後のワーカーから順に見て、最も古い仕事を盗む
+  for (size_t offset = 1; offset < queues_.size(); ++offset) {
+    auto& victim = *queues_[(self + offset) % queues_.size()];
+    const std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      queued_.fetch_sub(1, std::memory_order_acq_rel);
+      stolen_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::workerLoop(size_t self) {
+  current_pool = this;
+  current_worker = self;
+  Task task;
+  while (true) {
+    if (!tryTake(self, task)) {
+      std::unique_lock lock(state_mutex_);
+      work_available_.wait(lock, [this] {
+        return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+      });
+      if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+      continue;
+    }
+    try {
+      task();
+    } catch (...) {
+      const std::lock_guard lock(state_mutex_);
+      if (!first_error_) {
+        first_error_ = std::current_exception();
+      }
+    }
+    task = nullptr;
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      const std::lock_guard lock(state_mutex_);
+      all_done_.notify_all();
+    }
+  }
+}
@@ -0,0 +1,143 @@
+// ファイル: tests/actions/action_index_test.cpp
+// 役割:
+// 行動添字の割り当てが全区画で逆写像と往復し、影響力の分解と合法手マスクが期待どおりに立つことを検証する。
+// 背景:
+// 添字は学習済みモデルの方策ヘッドとの契約なので、区画の位置がずれたら即座に検出できるようにする。
+
+#include "tsge/actions/action_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/actions/card_specific_moves.hpp"
+#include "tsge/core/board.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace {
+
+constexpr auto CARD = static_cast<CardEnum>(20);
+
+}  // namespace
+
+TEST(ActionIndexTest, EveryIndexRoundTrips) {
+  const Board board(implementedCardpool());
+  for (size_t index = 0; index < ActionIndex::SIZE; ++index) {
+    const auto move = ActionIndex::indexToMove(index, Side::USA, board);
+    ASSERT_NE(move, nullptr);
+    EXPECT_EQ(move->getSide(), Side::USA);
+    ASSERT_EQ(ActionIndex::moveToIndex(*move), index) << "index " << index;
+  }
+  EXPECT_THROW(static_cast<void>(
+                   ActionIndex::indexToMove(ActionIndex::SIZE, Side::USSR,
+                                            board)),
+               std::out_of_range);
+}
+
+TEST(ActionIndexTest, DecodedEventFollowsCanEvent) {
+  const Board board(implementedCardpool());
+  const auto decode = [&board](CardEnum card) {
+    const size_t index =
+        ActionIndex::moveToIndex(ActionEventMove(card, Side::USA, true));
+    const auto move = std::dynamic_pointer_cast<ActionEventMove>(
+        ActionIndex::indexToMove(index, Side::USA, board));
+    EXPECT_NE(move, nullptr);
+    return move != nullptr && move->shouldTriggerEvent();
+  };
+  // 中国カードはイベントを起こせず、合法手生成もfalseの手を作る
+  EXPECT_FALSE(decode(CardEnum::CHINA_CARD));
+  EXPECT_TRUE(decode(CardEnum::DUCK_AND_COVER));
+}
+
+TEST(ActionIndexTest, LayoutIsStable) {
+  // 区画の位置はモデルとの契約なので値で固定する
+  EXPECT_EQ(ActionIndex::SIZE, 48175U);
+  EXPECT_EQ(ActionIndex::moveToIndex(HeadlineCardSelectMove(CARD, Side::USSR)),
+            20U);
+  EXPECT_EQ(ActionIndex::moveToIndex(
+                ActionCoupMove(CARD, Side::USSR, CountryEnum::IRAN)),
+            ActionIndex::COUP_OFFSET + (20 * 86) +
+                static_cast<size_t>(CountryEnum::IRAN));
+  EXPECT_EQ(ActionIndex::moveToIndex(PassMove(Side::USA)),
+            ActionIndex::SIZE - 1);
+  EXPECT_EQ(ActionIndex::kindOf(ActionIndex::REALIGNMENT_OFFSET),
+            ActionIndex::Kind::REALIGNMENT);
+  EXPECT_EQ(ActionIndex::kindOf(ActionIndex::PASS_OFFSET - 1),
+            ActionIndex::Kind::EVENT_REMOVE_INFLUENCE);
+}
+
+TEST(ActionIndexTest, RelatedMoveTypesShareSlots) {
+  const RealignmentRequestMove request(CARD, Side::USSR, CountryEnum::IRAN,
+                                       {CountryEnum::IRAQ}, 2);
+  EXPECT_EQ(ActionIndex::moveToIndex(request),
+            ActionIndex::moveToIndex(
+                ActionRealigmentMove(CARD, Side::USSR, CountryEnum::IRAN)));
+
+  const DeStalinizationRemoveMove destalinization(
+      CARD, Side::USSR, std::map<CountryEnum, int>{{CountryEnum::CUBA, 1}});
+  EXPECT_EQ(ActionIndex::moveToIndex(destalinization),
+            ActionIndex::moveToIndex(EventRemoveInfluenceMove(
+                CARD, Side::USSR,
+                std::map<CountryEnum, int>{{CountryEnum::CUBA, 1}})));
+}
+
+TEST(ActionIndexTest, InfluenceMovesFactorizeIntoSteps) {
+  const ActionPlaceInfluenceMove placement(
+      CARD, Side::USSR,
+      std::map<CountryEnum, int>{{CountryEnum::IRAN, 2},
+                                 {CountryEnum::IRAQ, 1}});
+  const auto iran = ActionIndex::moveToIndex(ActionPlaceInfluenceMove(
+      CARD, Side::USSR, std::map<CountryEnum, int>{{CountryEnum::IRAN, 1}}));
+  const auto iraq = ActionIndex::moveToIndex(ActionPlaceInfluenceMove(
+      CARD, Side::USSR, std::map<CountryEnum, int>{{CountryEnum::IRAQ, 1}}));
+
+  std::vector<size_t> steps;
+  ActionIndex::influenceSteps(placement, steps);
+  std::vector<size_t> expected{iran, iran, iraq};
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(steps, expected);
+  EXPECT_EQ(ActionIndex::moveToIndex(placement), expected.front());
+
+  const EventRemoveAllInfluenceMove remove_all(
+      CARD, Side::USA, {CountryEnum::IRAQ, CountryEnum::IRAN});
+  steps.clear();
+  ActionIndex::influenceSteps(remove_all, steps);
+  ASSERT_EQ(steps.size(), 2U);
+  EXPECT_LT(steps[0], steps[1]);
+  EXPECT_EQ(ActionIndex::kindOf(steps[0]),
+            ActionIndex::Kind::EVENT_REMOVE_INFLUENCE);
+}
+
+TEST(ActionIndexTest, MaskWritersMarkLegalSteps) {
+  const std::vector<std::shared_ptr<Move>> legal{
+      std::make_shared<ActionCoupMove>(CARD, Side::USSR, CountryEnum::IRAN),
+      std::make_shared<ActionPlaceInfluenceMove>(
+          CARD, Side::USSR,
+          std::map<CountryEnum, int>{{CountryEnum::IRAQ, 1},
+                                     {CountryEnum::SYRIA, 1}}),
+      std::make_shared<PassMove>(Side::USSR)};
+
+  // 前の手番の値が残らないことも確かめる
+  std::vector<uint8_t> mask(ActionIndex::SIZE, 1);
+  std::vector<uint64_t> bits(ActionIndex::MASK_WORDS, ~uint64_t{0});
+  ActionIndex::writeLegalMask(legal, mask.data());
+  ActionIndex::writeLegalBitmask(legal, bits.data());
+
+  std::vector<size_t> expected;
+  for (const auto& move : legal) {
+    ActionIndex::influenceSteps(*move, expected);
+  }
+  size_t marked = 0;
+  for (size_t index = 0; index < ActionIndex::SIZE; ++index) {
+    const bool in_expected =
+        std::find(expected.begin(), expected.end(), index) != expected.end();
+    EXPECT_EQ(mask[index] == 1, in_expected) << "index " << index;
+    EXPECT_EQ(((bits[index / 64] >> (index % 64)) & 1U) == 1U, in_expected);
+    marked += mask[index];
+  }
+  EXPECT_EQ(marked, 4U);
+}
@@ -838,3 +838,49 @@ TEST_F(MoveTest, DeStalinizationRemoveMove_ExcludeOpponentControlledTargets) {
               0);
   }
 }
+
+TEST_F(MoveTest, GetKeyMatchesForEqualMoves) {
+  const std::map<CountryEnum, int> targets{{CountryEnum::JAPAN, 2},
+                                           {CountryEnum::CUBA, 1}};
+  ActionPlaceInfluenceMove place_a(CardEnum::DUCK_AND_COVER, Side::USA,
+                                   targets);
+  ActionPlaceInfluenceMove place_b(CardEnum::DUCK_AND_COVER, Side::USA,
+                                   targets);
+  ASSERT_TRUE(place_a == place_b);
+  EXPECT_EQ(place_a.getKey(), place_b.getKey());
+
+  RealignmentRequestMove request_a(CardEnum::FIDEL, Side::USSR,
+                                   CountryEnum::ITALY, {CountryEnum::FRANCE},
+                                   1);
+  RealignmentRequestMove request_b(CardEnum::FIDEL, Side::USSR,
+                                   CountryEnum::ITALY, {CountryEnum::FRANCE},
+                                   1);
+  EXPECT_EQ(request_a.getKey(), request_b.getKey());
+
+  PassMove pass_a(Side::USA);
+  PassMove pass_b(Side::USA);
+  EXPECT_EQ(pass_a.getKey(), pass_b.getKey());
+}
+
+TEST_F(MoveTest, GetKeyDistinguishesPayloadAndType) {
+  ActionPlaceInfluenceMove place_japan(CardEnum::DUCK_AND_COVER, Side::USA,
+                                       {{CountryEnum::JAPAN, 1}});
+  ActionPlaceInfluenceMove place_cuba(CardEnum::DUCK_AND_COVER, Side::USA,
+                                      {{CountryEnum::CUBA, 1}});
+  EventPlaceInfluenceMove event_japan(CardEnum::DUCK_AND_COVER, Side::USA,
+                                      {{CountryEnum::JAPAN, 1}});
+  EXPECT_NE(place_japan.getKey(), place_cuba.getKey());
+  EXPECT_NE(place_japan.getKey(), event_japan.getKey());
+
+  ActionCoupMove coup_ussr(CardEnum::FIDEL, Side::USSR, CountryEnum::IRAN);
+  ActionCoupMove coup_usa(CardEnum::FIDEL, Side::USA, CountryEnum::IRAN);
+  ActionRealigmentMove realign(CardEnum::FIDEL, Side::USSR, CountryEnum::IRAN);
+  EXPECT_NE(coup_ussr.getKey(), coup_usa.getKey());
+  EXPECT_NE(coup_ussr.getKey(), realign.getKey());
+
+  RealignmentRequestMove first_op(CardEnum::FIDEL, Side::USSR,
+                                  CountryEnum::ITALY, {}, 2);
+  RealignmentRequestMove second_op(CardEnum::FIDEL, Side::USSR,
+                                   CountryEnum::ITALY, {CountryEnum::ITALY}, 1);
+  EXPECT_NE(first_op.getKey(), second_op.getKey());
+}
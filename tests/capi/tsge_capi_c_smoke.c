@@ -0,0 +1,51 @@
+/*
+ * ファイル: tests/capi/tsge_capi_c_smoke.c
+ * 役割:
+ * ヘッダをCコンパイラで読み込み、環境の作成から1手の適用・破棄までをCから呼べることを確かめる。
+ * 背景:
+ * C++のテストだけではヘッダにC++の構文が紛れ込んでも気づけないため。
+ */
+
+#include <stdlib.h>
+
+#include "tsge/capi/tsge_capi.h"
+
+/* 成功なら0、失敗した段階に応じて正の値を返す */
+int tsgeCapiCSmoke(void) {
+  tsge_env_config config;
+  tsge_env* env = NULL;
+  uint8_t* mask = NULL;
+  int32_t action = -1;
+  float reward = 0.0F;
+  uint8_t done = 0;
+  size_t i = 0;
+  int result = 0;
+
+  tsge_env_config_init(&config);
+  if (tsge_env_create(&config, &env) != TSGE_OK) {
+    return 1;
+  }
+  mask = (uint8_t*)malloc(tsge_action_size());
+  if (mask == NULL) {
+    tsge_env_destroy(env);
+    return 2;
+  }
+  if (tsge_env_observe(env, NULL, mask) != TSGE_OK) {
+    result = 3;
+  }
+  for (i = 0; result == 0 && i < tsge_action_size(); ++i) {
+    if (mask[i] != 0) {
+      action = (int32_t)i;
+      break;
+    }
+  }
+  if (result == 0 && action < 0) {
+    result = 4;
+  }
+  if (result == 0 && tsge_env_step(env, &action, &reward, &done) != TSGE_OK) {
+    result = 5;
+  }
+  free(mask);
+  tsge_env_destroy(env);
+  return result;
+}
@@ -0,0 +1,230 @@
+// ファイル: tests/capi/tsge_capi_test.cpp
+// 役割:
+// 共有ライブラリのC言語APIだけを使い、環境の作成・観測・1手の適用・やり直しと、失敗が状態コードとメッセージで返ることを検証する。
+// 背景:
+// 学習側は例外もC++の型も受け取れないため、境界での変換と呼び出し側バッファへの書き込みを外から確かめる。
+
+#include "tsge/capi/tsge_capi.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C" int tsgeCapiCSmoke(void);
+
+namespace {
+
+// 各環境のマスクから立っている添字を乱数で1つずつ選ぶ
+std::vector<int32_t> sampleActions(const std::vector<uint8_t>& masks,
+                                   size_t num_envs, std::mt19937_64& rng) {
+  const size_t actions_per_env = tsge_action_size();
+  std::vector<int32_t> actions(num_envs, -1);
+  for (size_t env = 0; env < num_envs; ++env) {
+    std::vector<int32_t> legal;
+    for (size_t i = 0; i < actions_per_env; ++i) {
+      if (masks[(env * actions_per_env) + i] != 0) {
+        legal.push_back(static_cast<int32_t>(i));
+      }
+    }
+    if (!legal.empty()) {
+      std::uniform_int_distribution<size_t> pick(0, legal.size() - 1);
+      actions[env] = legal[pick(rng)];
+    }
+  }
+  return actions;
+}
+
+class CapiEnv {
+ public:
+  explicit CapiEnv(const tsge_env_config& config) {
+    EXPECT_EQ(tsge_env_create(&config, &env_), TSGE_OK) << tsge_last_error();
+  }
+  ~CapiEnv() { tsge_env_destroy(env_); }
+  CapiEnv(const CapiEnv&) = delete;
+  CapiEnv& operator=(const CapiEnv&) = delete;
+  CapiEnv(CapiEnv&&) = delete;
+  CapiEnv& operator=(CapiEnv&&) = delete;
+
+  tsge_env* get() { return env_; }
+
+ private:
+  tsge_env* env_ = nullptr;
+};
+
+tsge_env_config batchConfig(size_t num_envs, size_t threads) {
+  tsge_env_config config;
+  tsge_env_config_init(&config);
+  config.num_envs = num_envs;
+  config.threads = threads;
+  config.max_episode_steps = 30;
+  config.seed = 17;
+  // 多くの手を進める検証はOpsだけのプールで速く回す
+  config.cardpool = TSGE_CARDPOOL_OPS_ONLY;
+  return config;
+}
+
+}  // namespace
+
+TEST(TsgeCapiTest, HeaderCompilesAndRunsAsC) { EXPECT_EQ(tsgeCapiCSmoke(), 0); }
+
+TEST(TsgeCapiTest, ReportsSizesAndVersion) {
+  EXPECT_EQ(tsge_abi_version(), static_cast<uint32_t>(TSGE_ABI_VERSION));
+  EXPECT_GT(tsge_feature_size(), 0U);
+  EXPECT_GT(tsge_action_size(), 0U);
+}
+
+TEST(TsgeCapiTest, BatchStepObserveMatchesSeparateCalls) {
+  constexpr size_t NUM_ENVS = 6;
+  CapiEnv fused(batchConfig(NUM_ENVS, 3));
+  CapiEnv separate(batchConfig(NUM_ENVS, 1));
+  ASSERT_EQ(tsge_env_num_envs(fused.get()), NUM_ENVS);
+
+  const size_t feature_size = NUM_ENVS * tsge_feature_size();
+  const size_t mask_size = NUM_ENVS * tsge_action_size();
+  std::vector<float> fused_features(feature_size);
+  std::vector<uint8_t> fused_masks(mask_size);
+  std::vector<float> features(feature_size);
+  std::vector<uint8_t> masks(mask_size);
+  ASSERT_EQ(tsge_env_observe(fused.get(), fused_features.data(),
+                             fused_masks.data()),
+            TSGE_OK);
+  std::mt19937_64 rng(5);
+  size_t finished = 0;
+  for (int i = 0; i < 80; ++i) {
+    ASSERT_EQ(tsge_env_observe(separate.get(), features.data(), masks.data()),
+              TSGE_OK);
+    ASSERT_EQ(features, fused_features);
+    ASSERT_EQ(masks, fused_masks);
+    const auto actions = sampleActions(masks, NUM_ENVS, rng);
+
+    std::vector<float> rewards(NUM_ENVS, -2.0F);
+    std::vector<uint8_t> dones(NUM_ENVS, 9);
+    std::vector<float> fused_rewards(NUM_ENVS, -2.0F);
+    std::vector<uint8_t> fused_dones(NUM_ENVS, 9);
+    ASSERT_EQ(tsge_env_step(separate.get(), actions.data(), rewards.data(),
+                            dones.data()),
+              TSGE_OK)
+        << tsge_last_error();
+    ASSERT_EQ(tsge_env_step_observe(fused.get(), actions.data(),
+                                    fused_rewards.data(), fused_dones.data(),
+                                    fused_features.data(), fused_masks.data()),
+              TSGE_OK)
+        << tsge_last_error();
+    EXPECT_EQ(rewards, fused_rewards);
+    EXPECT_EQ(dones, fused_dones);
+    for (const uint8_t done : dones) {
+      EXPECT_LE(done, 1);
+      finished += done;
+    }
+  }
+  EXPECT_GT(finished, 0U);
+
+  std::vector<int32_t> sides(NUM_ENVS, -1);
+  ASSERT_EQ(tsge_env_sides_to_move(fused.get(), sides.data()), TSGE_OK);
+  for (const int32_t side : sides) {
+    EXPECT_TRUE(side == 0 || side == 1);
+  }
+}
+
+TEST(TsgeCapiTest, ResetRestartsFromSeeds) {
+  CapiEnv env(batchConfig(2, 2));
+  const std::vector<uint64_t> seeds{3, 4};
+  std::vector<float> before(2 * tsge_feature_size());
+  std::vector<uint8_t> masks(2 * tsge_action_size());
+  ASSERT_EQ(tsge_env_reset(env.get(), seeds.data()), TSGE_OK);
+  ASSERT_EQ(tsge_env_observe(env.get(), before.data(), masks.data()), TSGE_OK);
+  std::mt19937_64 rng(8);
+  for (int i = 0; i < 4; ++i) {
+    const auto actions = sampleActions(masks, 2, rng);
+    ASSERT_EQ(tsge_env_step_observe(env.get(), actions.data(), nullptr,
+                                    nullptr, nullptr, masks.data()),
+              TSGE_OK);
+  }
+  ASSERT_EQ(tsge_env_reset(env.get(), seeds.data()), TSGE_OK);
+  std::vector<float> after(2 * tsge_feature_size());
+  ASSERT_EQ(tsge_env_observe(env.get(), after.data(), nullptr), TSGE_OK);
+  EXPECT_EQ(before, after);
+}
+
+TEST(TsgeCapiTest, FailuresReturnStatusAndMessage) {
+  tsge_env_config config;
+  tsge_env_config_init(&config);
+  config.num_envs = 0;
+  tsge_env* env = nullptr;
+  EXPECT_EQ(tsge_env_create(&config, &env), TSGE_INVALID_ARGUMENT);
+  EXPECT_EQ(env, nullptr);
+  EXPECT_NE(std::strlen(tsge_last_error()), 0U);
+  EXPECT_EQ(tsge_env_create(nullptr, &env), TSGE_INVALID_ARGUMENT);
+  EXPECT_EQ(tsge_env_step(nullptr, nullptr, nullptr, nullptr),
+            TSGE_INVALID_ARGUMENT);
+  tsge_env_destroy(nullptr);
+
+  CapiEnv valid(batchConfig(1, 1));
+  std::vector<uint8_t> mask(tsge_action_size());
+  ASSERT_EQ(tsge_env_observe(valid.get(), nullptr, mask.data()), TSGE_OK);
+  EXPECT_STREQ(tsge_last_error(), "");
+  int32_t illegal = -1;
+  for (size_t i = 0; i < mask.size(); ++i) {
+    if (mask[i] == 0) {
+      illegal = static_cast<int32_t>(i);
+      break;
+    }
+  }
+  EXPECT_EQ(tsge_env_step(valid.get(), &illegal, nullptr, nullptr),
+            TSGE_INVALID_ARGUMENT);
+  EXPECT_NE(std::string(tsge_last_error()).find("illegal action"),
+            std::string::npos);
+  std::vector<uint8_t> after(tsge_action_size());
+  ASSERT_EQ(tsge_env_observe(valid.get(), nullptr, after.data()), TSGE_OK);
+  EXPECT_EQ(mask, after);
+}
+
+// 既定のプールは実装済みのイベントだけを持ち、同じ種でもOpsだけのプールとは別の対局になる
+TEST(TsgeCapiTest, DefaultCardpoolIsImplementedAndSelectable) {
+  tsge_env_config config;
+  tsge_env_config_init(&config);
+  EXPECT_EQ(config.cardpool, TSGE_CARDPOOL_IMPLEMENTED);
+  CapiEnv implemented(config);
+  config.cardpool = TSGE_CARDPOOL_OPS_ONLY;
+  CapiEnv ops_only(config);
+
+  std::vector<float> implemented_features(tsge_feature_size());
+  std::vector<uint8_t> implemented_mask(tsge_action_size());
+  std::vector<float> ops_only_features(tsge_feature_size());
+  std::vector<uint8_t> ops_only_mask(tsge_action_size());
+  std::mt19937_64 rng(2);
+  bool diverged = false;
+  for (int i = 0; i < 20 && !diverged; ++i) {
+    ASSERT_EQ(tsge_env_observe(implemented.get(), implemented_features.data(),
+                               implemented_mask.data()),
+              TSGE_OK);
+    ASSERT_EQ(tsge_env_observe(ops_only.get(), ops_only_features.data(),
+                               ops_only_mask.data()),
+              TSGE_OK);
+    if (implemented_features != ops_only_features ||
+        implemented_mask != ops_only_mask) {
+      diverged = true;
+      break;
+    }
+    const auto actions = sampleActions(implemented_mask, 1, rng);
+    ASSERT_EQ(tsge_env_step(implemented.get(), actions.data(), nullptr,
+                            nullptr),
+              TSGE_OK)
+        << tsge_last_error();
+    ASSERT_EQ(tsge_env_step(ops_only.get(), actions.data(), nullptr, nullptr),
+              TSGE_OK)
+        << tsge_last_error();
+  }
+  EXPECT_TRUE(diverged);
+
+  config.cardpool = static_cast<tsge_cardpool>(7);
+  tsge_env* env = nullptr;
+  EXPECT_EQ(tsge_env_create(&config, &env), TSGE_INVALID_ARGUMENT);
+  EXPECT_EQ(env, nullptr);
+  EXPECT_NE(std::string(tsge_last_error()).find("cardpool"),
+            std::string::npos);
+}
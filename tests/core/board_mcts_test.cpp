@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <map>
+#include <random>
 
 #include "tsge/core/board.hpp"
 #include "tsge/game_state/card.hpp"
@@ -216,4 +217,58 @@ TEST_F(BoardMCTSTest, CopyForMCTS_HidesDeck) {
             board_.getDeck().getDeck().size());
   EXPECT_EQ(ussr_copy.getDeck().getDeck()[0], CardEnum::DUMMY);
   EXPECT_EQ(ussr_copy.getDeck().getDeck()[1], CardEnum::DUMMY);
-}
\ No newline at end of file
+}
+TEST_F(BoardMCTSTest, CopiedDeckShufflesWithCopiedRandomizer) {
+  auto& discard = board_.getDeck().getDiscardPile();
+  for (int i = 1; i <= 40; ++i) {
+    discard.push_back(static_cast<CardEnum>(i));
+  }
+
+  // コピー先に同じシードの外部RNGを設定すれば、元Boardの乱数状態に関係なく
+  // 同じ順序でシャッフルされる(Deckがコピー先のRandomizerを参照している)。
+  Board first_copy = board_;
+  Board second_copy = board_;
+  std::mt19937_64 first_rng(42);
+  std::mt19937_64 second_rng(42);
+  first_copy.getRandomizer().setRng(&first_rng);
+  second_copy.getRandomizer().setRng(&second_rng);
+
+  first_copy.getDeck().reshuffleFromDiscard();
+  board_.getRandomizer().rollDice();
+  second_copy.getDeck().reshuffleFromDiscard();
+
+  EXPECT_EQ(first_copy.getDeck().getDeck(), second_copy.getDeck().getDeck());
+  EXPECT_EQ(board_.getDeck().getDiscardPile().size(), 40U);
+}
+
+TEST_F(BoardMCTSTest, ObservableHashIgnoresHiddenOpponentCards) {
+  board_.addCardToHand(Side::USSR, CardEnum::FIDEL);
+  board_.addCardToHand(Side::USA, CardEnum::NUCLEAR_TEST_BAN);
+  Board other(board_);
+  other.clearHand(Side::USA);
+  other.addCardToHand(Side::USA, CardEnum::DUCK_AND_COVER);
+
+  // USSRからは相手の手札の中身が見えない
+  EXPECT_EQ(board_.getObservableHash(Side::USSR),
+            other.getObservableHash(Side::USSR));
+  EXPECT_NE(board_.getObservableHash(Side::USA),
+            other.getObservableHash(Side::USA));
+  EXPECT_EQ(board_.getObservableHash(Side::USSR),
+            board_.copyForMCTS(Side::USSR).getObservableHash(Side::USSR));
+}
+
+TEST_F(BoardMCTSTest, ObservableHashReflectsVisibleState) {
+  Board other(board_);
+  other.getWorldMap().getCountry(CountryEnum::JAPAN).addInfluence(Side::USA, 1);
+  EXPECT_NE(board_.getObservableHash(Side::USSR),
+            other.getObservableHash(Side::USSR));
+
+  // 手札の並び順は区別しない
+  board_.addCardToHand(Side::USSR, CardEnum::FIDEL);
+  board_.addCardToHand(Side::USSR, CardEnum::DUCK_AND_COVER);
+  Board reordered(cardpool_);
+  reordered.addCardToHand(Side::USSR, CardEnum::DUCK_AND_COVER);
+  reordered.addCardToHand(Side::USSR, CardEnum::FIDEL);
+  EXPECT_EQ(board_.getObservableHash(Side::USSR),
+            reordered.getObservableHash(Side::USSR));
+}
@@ -0,0 +1,289 @@
+// ファイル: tests/core/board_snapshot_test.cpp
+// 役割:
+// Board::serialize/deserializeが対局中のどの局面でもバイト単位で往復し、復元した盤面から同じ乱数で指し進めると元の盤面と同じ対局になることを検証する。
+// 背景:
+// スナップショットは状態スタック上の入力要求まで書き出すため、記述子の書き漏れがあると復元した盤面の合法手だけが黙って変わる。
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/actions/command.hpp"
+#include "tsge/core/board.hpp"
+#include "tsge/core/game_record.hpp"
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/game_state/cards.hpp"
+#include "tsge/players/feature_encoder.hpp"
+#include "tsge/players/match_runner.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace {
+
+std::vector<std::byte> snapshot(const Board& board) {
+  std::vector<std::byte> bytes(Board::SNAPSHOT_CAPACITY);
+  bytes.resize(board.serialize(bytes));
+  return bytes;
+}
+
+std::vector<float> features(const Board& board, Side side) {
+  std::vector<float> out(FeatureEncoder::SIZE);
+  FeatureEncoder::encode(board, side, out.data());
+  return out;
+}
+
+GameRecord recordedMatch(uint64_t seed) {
+  const std::array<MatchPolicyFactory, 2> policies{makeMatchPolicy("random"),
+                                                   makeMatchPolicy("random")};
+  GameRecord record;
+  static_cast<void>(playMatch(opsOnlyCardpool(), policies, seed,
+                              MatchConfig{}.max_steps, &record));
+  return record;
+}
+
+// 同じ添字の規則で指し進め、各判断の合法手の数と勝者を並べる
+std::vector<size_t> playOut(Board& board,
+                            std::vector<std::shared_ptr<Move>> legal_moves,
+                            size_t first_choice) {
+  std::vector<size_t> trace;
+  size_t choice = first_choice;
+  for (size_t step = 0; step < 4000 && !legal_moves.empty(); ++step) {
+    auto [next_moves, side, winner] =
+        PhaseMachine::step(board, legal_moves, choice % legal_moves.size());
+    if (winner.has_value()) {
+      trace.push_back(1000 + static_cast<size_t>(*winner));
+      break;
+    }
+    trace.push_back(next_moves.size());
+    legal_moves = std::move(next_moves);
+    choice = (step * 7) + 3;
+  }
+  return trace;
+}
+
+// イベント付きの入力要求を作れるよう、一部に実際のカードを置いたプール
+const std::array<std::unique_ptr<Card>, 111>& eventCardpool() {
+  static const auto* pool = [] {
+    auto* cards = new std::array<std::unique_ptr<Card>, 111>();
+    (*cards)[static_cast<size_t>(CardEnum::DUCK_AND_COVER)] =
+        std::make_unique<DuckAndCover>();
+    (*cards)[static_cast<size_t>(CardEnum::COMECON)] =
+        std::make_unique<Comecon>();
+    (*cards)[static_cast<size_t>(CardEnum::MARSHALL_PLAN)] =
+        std::make_unique<MarshallPlan>();
+    (*cards)[static_cast<size_t>(CardEnum::EAST_EUROPEAN_UNREST)] =
+        std::make_unique<EastEuropeanUnrest>();
+    (*cards)[static_cast<size_t>(CardEnum::DE_STALINIZATION)] =
+        std::make_unique<DeStainization>();
+    return cards;
+  }();
+  return *pool;
+}
+
+const RequestCommand* requestAt(Board& board, size_t index) {
+  const auto& state = board.getStates()[index];
+  const auto* command = std::get_if<CommandPtr>(&state);
+  return command != nullptr
+             ? dynamic_cast<const RequestCommand*>(command->get())
+             : nullptr;
+}
+
+}  // namespace
+
+TEST(BoardSnapshotTest, RoundTripIsExactThroughoutAGame) {
+  ReplayDriver replay(opsOnlyCardpool(), recordedMatch(13));
+  ASSERT_GT(replay.size(), 100U);
+  // 同じBoardへ上書きし続け、前の局面の状態が残らないことも確かめる
+  Board restored(opsOnlyCardpool());
+  do {
+    const auto bytes = snapshot(replay.board());
+    restored.deserialize(bytes);
+    ASSERT_EQ(snapshot(restored), bytes) << "decision " << replay.position();
+    for (const Side side : {Side::USSR, Side::USA}) {
+      EXPECT_EQ(features(restored, side), features(replay.board(), side));
+      EXPECT_EQ(restored.getObservableHash(side),
+                replay.board().getObservableHash(side));
+    }
+  } while (replay.next());
+  EXPECT_TRUE(replay.winner().has_value());
+}
+
+TEST(BoardSnapshotTest, RestoredBoardPlaysOnIdentically) {
+  ReplayDriver replay(opsOnlyCardpool(), recordedMatch(5));
+  for (const size_t checkpoint :
+       {size_t{0}, replay.size() / 4, replay.size() / 2, replay.size() - 1}) {
+    replay.seek(checkpoint);
+    Board original(replay.board());
+    Board restored(opsOnlyCardpool());
+    restored.deserialize(snapshot(original));
+
+    std::mt19937_64 original_rng(77);
+    std::mt19937_64 restored_rng(77);
+    original.getRandomizer().setRng(&original_rng);
+    restored.getRandomizer().setRng(&restored_rng);
+    const size_t choice = replay.record().choices[checkpoint];
+    const auto original_trace =
+        playOut(original, replay.legalMoves(), choice);
+    const auto restored_trace =
+        playOut(restored, replay.legalMoves(), choice);
+    EXPECT_FALSE(original_trace.empty());
+    EXPECT_EQ(restored_trace, original_trace) << "checkpoint " << checkpoint;
+    EXPECT_EQ(snapshot(restored), snapshot(original));
+  }
+}
+
+TEST(BoardSnapshotTest, PendingCommandsAndRequestsRoundTrip) {
+  const auto& pool = eventCardpool();
+  const auto& comecon = pool[static_cast<size_t>(CardEnum::COMECON)];
+  const auto& unrest =
+      pool[static_cast<size_t>(CardEnum::EAST_EUROPEAN_UNREST)];
+
+  Board board(pool);
+  board.getDeck().addEarlyWarCards();
+  auto& world_map = board.getWorldMap();
+  world_map.getCountry(CountryEnum::POLAND).addInfluence(Side::USSR, 3);
+  world_map.getCountry(CountryEnum::EAST_GERMANY).addInfluence(Side::USSR, 2);
+  world_map.getCountry(CountryEnum::FRANCE).addInfluence(Side::USA, 4);
+  world_map.getCountry(CountryEnum::ITALY).addInfluence(Side::USA, 1);
+  board.getPlayerHand(Side::USSR) = {CardEnum::COMECON,
+                                     CardEnum::DE_STALINIZATION};
+  board.getPlayerHand(Side::USA) = {CardEnum::MARSHALL_PLAN};
+  board.getDefconTrack().setDefcon(3);
+  board.getSpaceTrack().advanceSpaceTrack(Side::USA, 6);
+  board.getMilopsTrack().advanceMilopsTrack(Side::USSR, 2);
+  board.changeVp(-7);
+  board.giveChinaCardTo(Side::USA, false);
+  board.setHeadlineCard(Side::USA, CardEnum::MARSHALL_PLAN);
+  board.addCardEffectInProgress(CardEnum::MARSHALL_PLAN);
+  board.addCardEffectInThisTurn(Side::USSR, CardEnum::COMECON);
+
+  board.pushState(StateType::TURN_END);
+  board.pushState(std::make_shared<ChangeVpCommand>(Side::USA, 2));
+  board.pushState(std::make_shared<DefconVpCommand>(Side::USA, 5, -1));
+  board.pushState(std::make_shared<ChangeDefconCommand>(-1));
+  board.pushState(std::make_shared<PlaceInfluenceCommand>(
+      Side::USSR, comecon,
+      std::map<CountryEnum, int>{{CountryEnum::CUBA, 2},
+                                 {CountryEnum::IRAQ, 1}}));
+  board.pushState(std::make_shared<ActionRealigmentCommand>(
+      Side::USA, comecon, CountryEnum::IRAN));
+  board.pushState(std::make_shared<ActionCoupCommand>(Side::USSR, comecon,
+                                                      CountryEnum::ITALY));
+  board.pushState(std::make_shared<ActionSpaceRaceCommand>(Side::USA, comecon));
+  board.pushState(
+      std::make_shared<SetHeadlineCardCommand>(Side::USSR, CardEnum::COMECON));
+  board.pushState(std::make_shared<FinalizeCardPlayCommand>(
+      Side::USSR, CardEnum::COMECON, true));
+  board.pushState(
+      std::make_shared<DiscardCommand>(Side::USA, CardEnum::MARSHALL_PLAN));
+  board.pushState(std::make_shared<ScoreRegionCommand>(Region::EUROPE));
+  board.pushState(std::make_shared<SoutheastAsiaScoringCommand>());
+  board.pushState(std::make_shared<RemoveInfluenceCommand>(
+      Side::USA, std::map<CountryEnum, int>{{CountryEnum::FRANCE, 2}}));
+  board.pushState(std::make_shared<RemoveAllInfluenceCommand>(
+      Side::USSR, CountryEnum::POLAND));
+  const size_t first_request = board.getStates().size();
+  board.pushState(std::make_shared<RequestCommand>(
+      Side::USA, RequestDescriptor::spaceTrackDiscard()));
+  board.pushState(std::make_shared<RequestCommand>(
+      Side::USSR, RequestDescriptor::actionForCard(CardEnum::COMECON)));
+  board.pushState(std::make_shared<RequestCommand>(
+      Side::USSR, RequestDescriptor::realignment(CardEnum::COMECON,
+                                                 {CountryEnum::ITALY}, 2, 0)));
+  board.pushState(std::make_shared<RequestCommand>(
+      Side::USSR, RequestDescriptor::additionalOpsRealignment(
+                      CardEnum::COMECON,
+                      {CountryEnum::ITALY, CountryEnum::FRANCE}, 1)));
+  board.pushState(std::make_shared<RequestCommand>(
+      Side::USSR, RequestDescriptor::deStalinizationPlace(
+                      CardEnum::DE_STALINIZATION, 2)));
+  board.pushState(std::make_shared<RequestCommand>(Side::USA, *unrest, 2));
+  board.pushState(std::make_shared<RequestCommand>(Side::USSR, *comecon));
+
+  const auto bytes = snapshot(board);
+  Board restored(pool);
+  restored.deserialize(bytes);
+  EXPECT_EQ(snapshot(restored), bytes);
+  EXPECT_EQ(restored.getVp(), -7);
+  EXPECT_EQ(restored.getChinaCardOwner(), Side::USA);
+  EXPECT_FALSE(restored.isChinaCardFaceUp());
+  EXPECT_EQ(restored.getPlayerHand(Side::USSR),
+            board.getPlayerHand(Side::USSR));
+  EXPECT_EQ(restored.getDeck().getDeck(), board.getDeck().getDeck());
+  EXPECT_EQ(restored.getCardEffectsInProgress(),
+            board.getCardEffectsInProgress());
+
+  ASSERT_EQ(restored.getStates().size(), board.getStates().size());
+  for (size_t i = first_request; i < board.getStates().size(); ++i) {
+    const auto* expected = requestAt(board, i);
+    const auto* actual = requestAt(restored, i);
+    ASSERT_NE(expected, nullptr);
+    ASSERT_NE(actual, nullptr);
+    EXPECT_EQ(actual->getSide(), expected->getSide());
+    EXPECT_EQ(actual->getDescriptor(), expected->getDescriptor());
+    const auto expected_moves = expected->legalMoves(board);
+    const auto actual_moves = actual->legalMoves(restored);
+    ASSERT_EQ(actual_moves.size(), expected_moves.size()) << "state " << i;
+    for (size_t m = 0; m < expected_moves.size(); ++m) {
+      EXPECT_EQ(actual_moves[m]->getKey(), expected_moves[m]->getKey());
+    }
+  }
+  // 入力要求の合法手が空でないことで、比較が素通りしていないことを確かめる
+  EXPECT_FALSE(requestAt(board, board.getStates().size() - 1)
+                   ->legalMoves(board)
+                   .empty());
+
+  // 復元した盤面でも積まれたCommandが同じように適用される
+  std::mt19937_64 board_rng(3);
+  std::mt19937_64 restored_rng(3);
+  board.getRandomizer().setRng(&board_rng);
+  restored.getRandomizer().setRng(&restored_rng);
+  while (!board.getStates().empty() &&
+         std::holds_alternative<CommandPtr>(board.getStates().back())) {
+    if (requestAt(board, board.getStates().size() - 1) != nullptr) {
+      board.getStates().pop_back();
+      restored.getStates().pop_back();
+      continue;
+    }
+    for (Board* target : {&board, &restored}) {
+      auto command = std::get<CommandPtr>(target->getStates().back());
+      target->getStates().pop_back();
+      command->apply(*target);
+    }
+  }
+  EXPECT_EQ(snapshot(restored), snapshot(board));
+}
+
+TEST(BoardSnapshotTest, RejectsUnserializableCommandsAndBadInput) {
+  Board board(opsOnlyCardpool());
+  board.getDeck().addEarlyWarCards();
+  board.pushState(StateType::TURN_START);
+
+  std::array<std::byte, 16> small{};
+  EXPECT_THROW(static_cast<void>(board.serialize(small)), std::length_error);
+
+  auto bytes = snapshot(board);
+  Board restored(opsOnlyCardpool());
+  EXPECT_THROW(restored.deserialize(std::span(bytes).first(bytes.size() - 1)),
+               std::runtime_error);
+  bytes.push_back(std::byte{0});
+  EXPECT_THROW(restored.deserialize(bytes), std::runtime_error);
+  bytes.pop_back();
+  bytes[0] = std::byte{'X'};
+  EXPECT_THROW(restored.deserialize(bytes), std::runtime_error);
+
+  board.pushState(std::make_shared<LambdaCommand>([](Board&) {}));
+  EXPECT_THROW(static_cast<void>(snapshot(board)), std::runtime_error);
+  board.getStates().pop_back();
+  board.pushState(std::make_shared<RequestCommand>(
+      Side::USSR,
+      [](const Board&) { return std::vector<std::shared_ptr<Move>>{}; }));
+  EXPECT_THROW(static_cast<void>(snapshot(board)), std::runtime_error);
+
+  EXPECT_THROW(RequestCommand(Side::USSR, RequestDescriptor{}),
+               std::invalid_argument);
+}
@@ -0,0 +1,241 @@
+// ファイル: tests/core/game_policy_test.cpp
+// 役割:
+// Gameが異なる2種類のポリシー型で終局まで進み、両プレイヤーに手を知らせること、AnyPolicyが保持するポリシーへ委譲することを検証する。
+// 背景:
+// GameをTestPolicy専用から任意のポリシーの組へ広げたため、静的な呼び分けと型消去の両方の経路を確かめる。
+
+#include "tsge/core/game.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/players/mcts_policy.hpp"
+#include "tsge/players/rollout_policy.hpp"
+#include "tsge/players/tsnnmcts.hpp"
+
+namespace {
+
+class PolicyCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  PolicyCard(CardEnum id, int ops, Side side)
+      : Card(id, "Policy", ops, side, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+const std::array<std::unique_ptr<Card>, 111>& policyCardpool() {
+  static const auto cardpool = [] {
+    std::array<std::unique_ptr<Card>, 111> pool{};
+    constexpr std::array<Side, 3> SIDES{Side::USSR, Side::USA, Side::NEUTRAL};
+    for (int i = 0; i < 111; ++i) {
+      const auto id = static_cast<CardEnum>(i);
+      const int ops = mcts::scoringRegion(id) ? 0 : 1 + (i % 2);
+      pool[static_cast<size_t>(i)] = std::make_unique<PolicyCard>(
+          id, ops, SIDES[static_cast<size_t>(i % 3)]);
+    }
+    return pool;
+  }();
+  return cardpool;
+}
+
+// 種で決まる一様ランダムな手を指し、(board, move)形式で観測した手を数える
+class SeededPolicy {
+ public:
+  explicit SeededPolicy(uint64_t seed = 1) : rng_{seed} {}
+
+  std::shared_ptr<Move> decideMove(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& legal_moves, Side side) {
+    sides.push_back(side);
+    std::uniform_int_distribution<size_t> pick(0, legal_moves.size() - 1);
+    return legal_moves[pick(rng_)];
+  }
+
+  void observeMove(const Board& /*board*/, const Move& /*move*/) {
+    ++observed;
+  }
+
+  std::vector<Side> sides;
+  size_t observed = 0;
+
+ private:
+  std::mt19937_64 rng_;
+};
+
+// 種で決まる一様ランダムな手を指し、(move)形式で観測した手を数える。ムーブのみ可能。
+class MoveOnlyPolicy {
+ public:
+  MoveOnlyPolicy(std::unique_ptr<size_t> observed, uint64_t seed)
+      : observed_{std::move(observed)}, rng_{seed} {}
+
+  std::shared_ptr<Move> decideMove(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& legal_moves, Side side) {
+    sides.push_back(side);
+    std::uniform_int_distribution<size_t> pick(0, legal_moves.size() - 1);
+    return legal_moves[pick(rng_)];
+  }
+
+  void observeMove(const Move& /*move*/) { ++*observed_; }
+
+  [[nodiscard]] size_t observed() const { return *observed_; }
+
+  std::vector<Side> sides;
+
+ private:
+  std::unique_ptr<size_t> observed_;
+  std::mt19937_64 rng_;
+};
+
+// SeededPolicyと同じ乱数で合法手の添字だけを返す
+class SeededIndexPolicy {
+ public:
+  explicit SeededIndexPolicy(uint64_t seed) : rng_{seed} {}
+
+  size_t decideMoveIndex(const Board& /*board*/,
+                         const std::vector<std::shared_ptr<Move>>& legal_moves,
+                         Side /*side*/) {
+    ++decisions;
+    std::uniform_int_distribution<size_t> pick(0, legal_moves.size() - 1);
+    return pick(rng_);
+  }
+
+  size_t decisions = 0;
+
+ private:
+  std::mt19937_64 rng_;
+};
+
+// 観測を持たないポリシー
+class ThrowingPolicy {
+ public:
+  std::shared_ptr<Move> decideMove(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& /*legal_moves*/,
+      Side /*side*/) {
+    throw std::runtime_error("ThrowingPolicy");
+  }
+};
+
+void setUpGame(Board& board, std::mt19937_64& rng) {
+  board.getRandomizer().setRng(&rng);
+  board.getDeck().addEarlyWarCards();
+  board.pushState(StateType::TURN_START);
+}
+
+}  // namespace
+
+static_assert(DecisionPolicy<TestPolicy>);
+static_assert(DecisionPolicy<MCTSPolicy>);
+static_assert(DecisionPolicy<TsNnMctsPolicy>);
+static_assert(DecisionPolicy<AnyPolicy>);
+static_assert(DecisionPolicy<SeededIndexPolicy>);
+static_assert(!DecisionPolicy<int>);
+
+TEST(GamePolicyTest, MixedPoliciesPlayToCompletion) {
+  Game<SeededPolicy, MoveOnlyPolicy> game(
+      Player<SeededPolicy>{},
+      Player<MoveOnlyPolicy>{MoveOnlyPolicy{std::make_unique<size_t>(0), 2}},
+      policyCardpool());
+  std::mt19937_64 rng(5);
+  setUpGame(game.getBoard(), rng);
+  game.next();
+
+  const auto& ussr = game.getPlayer1().getPolicy();
+  const auto& usa = game.getPlayer2().getPolicy();
+  // TESTビルドでは席を入れ替えないので、player1がUSSR・player2がUSA
+  ASSERT_FALSE(ussr.sides.empty());
+  ASSERT_FALSE(usa.sides.empty());
+  for (const auto side : ussr.sides) {
+    EXPECT_EQ(side, Side::USSR);
+  }
+  for (const auto side : usa.sides) {
+    EXPECT_EQ(side, Side::USA);
+  }
+  // 両プレイヤーが全ての手を観測する
+  const size_t moves = ussr.sides.size() + usa.sides.size();
+  EXPECT_EQ(ussr.observed, moves);
+  EXPECT_EQ(usa.observed(), moves);
+}
+
+TEST(GamePolicyTest, AnyPolicyDelegatesToWrappedPolicy) {
+  Game<AnyPolicy> game(Player<AnyPolicy>{AnyPolicy{SeededPolicy{1}}},
+                       Player<AnyPolicy>{AnyPolicy{SeededPolicy{2}}},
+                       policyCardpool());
+  std::mt19937_64 rng(5);
+  setUpGame(game.getBoard(), rng);
+  game.next();
+
+  auto* ussr = game.getPlayer1().getPolicy().target<SeededPolicy>();
+  auto* usa = game.getPlayer2().getPolicy().target<SeededPolicy>();
+  ASSERT_NE(ussr, nullptr);
+  ASSERT_NE(usa, nullptr);
+  EXPECT_EQ(game.getPlayer1().getPolicy().target<MoveOnlyPolicy>(), nullptr);
+  EXPECT_EQ(ussr->observed, ussr->sides.size() + usa->sides.size());
+
+  // 型消去しても同じポリシーなら静的な呼び分けと同じ対局になる
+  Game<SeededPolicy> direct(Player<SeededPolicy>{SeededPolicy{1}},
+                            Player<SeededPolicy>{SeededPolicy{2}},
+                            policyCardpool());
+  std::mt19937_64 direct_rng(5);
+  setUpGame(direct.getBoard(), direct_rng);
+  direct.next();
+  EXPECT_EQ(direct.getPlayer1().getPolicy().sides.size(), ussr->sides.size());
+  EXPECT_EQ(direct.getBoard().getVp(), game.getBoard().getVp());
+}
+
+TEST(GamePolicyTest, PolicyErrorsPropagate) {
+  AnyPolicy policy{ThrowingPolicy{}};
+  Board board(policyCardpool());
+  const std::vector<std::shared_ptr<Move>> legal_moves{
+      std::make_shared<PassMove>(Side::USSR)};
+  EXPECT_THROW(static_cast<void>(
+                   policy.decideMove(board, legal_moves, Side::USSR)),
+               std::runtime_error);
+  // 観測を持たないポリシーへの通知は何もしない
+  EXPECT_NO_THROW(policy.observeMove(board, *legal_moves.front()));
+}
+
+TEST(GamePolicyTest, IndexPoliciesPlayTheSameGameAsMovePolicies) {
+  Game<SeededIndexPolicy, AnyPolicy> indexed(
+      Player<SeededIndexPolicy>{SeededIndexPolicy{1}},
+      Player<AnyPolicy>{AnyPolicy{SeededIndexPolicy{2}}}, policyCardpool());
+  std::mt19937_64 indexed_rng(9);
+  setUpGame(indexed.getBoard(), indexed_rng);
+  indexed.next();
+
+  Game<SeededPolicy> direct(Player<SeededPolicy>{SeededPolicy{1}},
+                            Player<SeededPolicy>{SeededPolicy{2}},
+                            policyCardpool());
+  std::mt19937_64 direct_rng(9);
+  setUpGame(direct.getBoard(), direct_rng);
+  direct.next();
+
+  EXPECT_EQ(indexed.getPlayer1().getPolicy().decisions,
+            direct.getPlayer1().getPolicy().sides.size());
+  EXPECT_EQ(indexed.getBoard().getVp(), direct.getBoard().getVp());
+  EXPECT_EQ(indexed.getBoard().getTurnTrack().getTurn(),
+            direct.getBoard().getTurnTrack().getTurn());
+
+  // 添字を返すポリシーもPlayer経由で手として取り出せる
+  Player<SeededIndexPolicy> player{SeededIndexPolicy{3}};
+  Board board(policyCardpool());
+  const std::vector<std::shared_ptr<Move>> legal_moves{
+      std::make_shared<PassMove>(Side::USSR)};
+  EXPECT_EQ(player.decideMove(board, legal_moves, Side::USSR),
+            legal_moves.front());
+}
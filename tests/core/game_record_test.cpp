@@ -0,0 +1,232 @@
+// ファイル: tests/core/game_record_test.cpp
+// 役割:
+// 棋譜の符号化・ファイルの読み書きが往復で一致し、記録した対局を再生すると終局と途中の局面が元の対局と一致することを検証する。
+// 背景:
+// 棋譜は判断の列だけを持つため、乱数の流れや合法手の並びがずれると再生した局面が黙って別物になる。
+
+#include "tsge/core/game_record.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tsge/players/feature_encoder.hpp"
+#include "tsge/players/match_runner.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace {
+
+class GameRecordTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "game_record_test_" +
+            std::to_string(::getpid()) + "_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".tsgr";
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  std::string path_;
+};
+
+GameRecord sampleRecord(uint64_t seed, bool with_stats) {
+  GameRecord record;
+  record.seed = seed;
+  record.winner = Side::USA;
+  for (uint32_t i = 0; i < 200; ++i) {
+    record.choices.push_back((i * 7) % 23);
+    if (with_stats) {
+      record.stats.push_back(
+          {1000 + (i % 5), static_cast<float>(i % 9) / 8.0F - 0.5F});
+    }
+  }
+  record.choices.push_back(300);
+  if (with_stats) {
+    record.stats.push_back({0, -1.0F});
+  }
+  return record;
+}
+
+// 記録付きで1局指す
+GameRecord recordedMatch(uint64_t seed, MatchResult& result) {
+  const std::array<MatchPolicyFactory, 2> policies{makeMatchPolicy("random"),
+                                                   makeMatchPolicy("random")};
+  GameRecord record;
+  result = playMatch(opsOnlyCardpool(), policies, seed,
+                     MatchConfig{}.max_steps, &record);
+  return record;
+}
+
+std::vector<float> features(const ReplayDriver& replay) {
+  std::vector<float> out(FeatureEncoder::SIZE);
+  FeatureEncoder::encode(replay.board(), Side::USSR, out.data());
+  return out;
+}
+
+}  // namespace
+
+TEST_F(GameRecordTest, EncodeDecodeRoundTrip) {
+  const auto plain = sampleRecord(0xDEADBEEFCAFEF00DULL, false);
+  std::vector<uint8_t> bytes;
+  plain.encode(bytes);
+  EXPECT_EQ(GameRecord::decode(bytes), plain);
+  // 小さな添字は1バイトずつ(種8・勝者1・フラグ1・個数2・添字300の2バイト)
+  EXPECT_EQ(bytes.size(), 8U + 1U + 1U + 2U + 200U + 2U);
+
+  const auto with_stats = sampleRecord(1, true);
+  bytes.clear();
+  with_stats.encode(bytes);
+  const auto decoded = GameRecord::decode(bytes);
+  EXPECT_EQ(decoded.choices, with_stats.choices);
+  ASSERT_EQ(decoded.stats.size(), with_stats.stats.size());
+  for (size_t i = 0; i < decoded.stats.size(); ++i) {
+    EXPECT_EQ(decoded.stats[i].visits, with_stats.stats[i].visits);
+    EXPECT_NEAR(decoded.stats[i].value, with_stats.stats[i].value, 1e-4);
+  }
+
+  GameRecord unfinished;
+  unfinished.choices = {1, 2};
+  bytes.clear();
+  unfinished.encode(bytes);
+  EXPECT_FALSE(GameRecord::decode(bytes).winner.has_value());
+
+  unfinished.stats = {{1, 0.0F}};
+  EXPECT_THROW(unfinished.encode(bytes), std::invalid_argument);
+}
+
+TEST_F(GameRecordTest, DecodeRejectsCorruptPayloads) {
+  std::vector<uint8_t> bytes;
+  sampleRecord(3, true).encode(bytes);
+  EXPECT_THROW(
+      GameRecord::decode(std::span(bytes).first(bytes.size() - 1)),
+      std::runtime_error);
+  bytes.push_back(0);
+  EXPECT_THROW(GameRecord::decode(bytes), std::runtime_error);
+  bytes.pop_back();
+  bytes[8] = 9;  // 勝者の符号
+  EXPECT_THROW(GameRecord::decode(bytes), std::runtime_error);
+}
+
+TEST_F(GameRecordTest, WriterAndReaderRoundTripManyGames) {
+  std::vector<GameRecord> records;
+  for (uint64_t seed = 0; seed < 50; ++seed) {
+    auto record = sampleRecord(seed, false);
+    record.choices.resize(seed * 3);
+    record.winner = seed % 4 == 3 ? std::nullopt
+                                  : std::optional(static_cast<Side>(seed % 4));
+    records.push_back(record);
+  }
+  {
+    // 小さなバッファで途中の書き出しも通す
+    GameRecordWriter writer(path_, 128);
+    for (const auto& record : records) {
+      writer.write(record);
+    }
+    EXPECT_EQ(writer.gamesWritten(), records.size());
+  }
+  GameRecordReader reader(path_);
+  GameRecord record;
+  size_t count = 0;
+  while (reader.next(record)) {
+    ASSERT_LT(count, records.size());
+    EXPECT_EQ(record, records[count]);
+    ++count;
+  }
+  EXPECT_EQ(count, records.size());
+}
+
+TEST_F(GameRecordTest, ReaderRejectsForeignAndTruncatedFiles) {
+  {
+    std::ofstream output(path_, std::ios::binary);
+    output << "not a record file";
+  }
+  EXPECT_THROW(GameRecordReader{path_}, std::runtime_error);
+
+  {
+    GameRecordWriter writer(path_);
+    writer.write(sampleRecord(5, false));
+  }
+  std::string contents;
+  {
+    std::ifstream input(path_, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(input),
+                    std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream output(path_, std::ios::binary | std::ios::trunc);
+    output << contents.substr(0, contents.size() - 10);
+  }
+  GameRecordReader reader(path_);
+  GameRecord record;
+  EXPECT_THROW(reader.next(record), std::runtime_error);
+}
+
+TEST_F(GameRecordTest, ReplayReachesTheRecordedResult) {
+  MatchResult result;
+  const auto record = recordedMatch(21, result);
+  ASSERT_TRUE(result.winner.has_value());
+  ASSERT_EQ(record.choices.size(), result.moves);
+
+  ReplayDriver replay(opsOnlyCardpool(), record);
+  size_t applied = 0;
+  while (replay.next()) {
+    ++applied;
+  }
+  EXPECT_EQ(applied, result.moves);
+  EXPECT_EQ(replay.winner(), result.winner);
+  EXPECT_EQ(replay.board().getVp(), result.final_vp);
+  EXPECT_EQ(replay.board().getTurnTrack().getTurn(), result.turns);
+}
+
+TEST_F(GameRecordTest, SeekRebuildsIntermediatePositions) {
+  MatchResult result;
+  auto record = recordedMatch(8, result);
+  {
+    GameRecordWriter writer(path_);
+    writer.write(record);
+  }
+  GameRecordReader reader(path_);
+  ASSERT_TRUE(reader.next(record));
+
+  ReplayDriver replay(opsOnlyCardpool(), record);
+  const std::vector<size_t> checkpoints{0, 1, 37, record.choices.size() / 2,
+                                        record.choices.size() - 1};
+  std::vector<std::vector<float>> expected;
+  std::vector<size_t> legal_counts;
+  for (const size_t checkpoint : checkpoints) {
+    replay.seek(checkpoint);
+    expected.push_back(features(replay));
+    legal_counts.push_back(replay.legalMoves().size());
+  }
+  replay.seek(record.choices.size());
+  EXPECT_EQ(replay.winner(), result.winner);
+
+  // 逆順に戻っても同じ局面になる
+  for (size_t i = checkpoints.size(); i-- > 0;) {
+    replay.seek(checkpoints[i]);
+    EXPECT_EQ(replay.position(), checkpoints[i]);
+    EXPECT_EQ(features(replay), expected[i]);
+    EXPECT_EQ(replay.legalMoves().size(), legal_counts[i]);
+  }
+  EXPECT_THROW(replay.seek(record.choices.size() + 1), std::out_of_range);
+}
+
+TEST_F(GameRecordTest, ReplayRejectsInconsistentRecords) {
+  GameRecord record;
+  record.seed = 4;
+  record.choices = {100000};
+  ReplayDriver out_of_range(opsOnlyCardpool(), record);
+  EXPECT_THROW(out_of_range.next(), std::runtime_error);
+
+  MatchResult result;
+  record = recordedMatch(2, result);
+  record.choices.push_back(0);
+  ReplayDriver too_long(opsOnlyCardpool(), record);
+  EXPECT_THROW(too_long.seek(record.choices.size()), std::runtime_error);
+}
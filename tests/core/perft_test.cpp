@@ -0,0 +1,163 @@
+// ファイル: tests/core/perft_test.cpp
+// 役割:
+// コーパスの局面でのperftの数を固定値と比べ、合法手生成の変更で手の数が変わったことを検出する。あわせて数がスレッド数や辿る順序によらないことを確かめる。
+// 背景:
+// 固定値はこの実装で数えたもので、生成の不具合の修正で変わるのは正当な場合がある。その場合は変わった分類と理由を確かめてから更新する。
+
+#include "tsge/core/perft.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "tsge/actions/action_index.hpp"
+#include "tsge/core/position_text.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace {
+
+Board corpusBoard(const std::string& name) {
+  static const auto corpus = loadPositionCorpus(TSGE_POSITION_CORPUS);
+  const auto found = std::ranges::find(corpus, name, &CorpusPosition::name);
+  if (found == corpus.end()) {
+    throw std::invalid_argument("no corpus position " + name);
+  }
+  Board board(cardpoolByName(found->cardpool));
+  readPositionText(found->text, board);
+  return board;
+}
+
+PerftResult perft(const std::string& name, int depth,
+                  PerftDice dice = PerftDice::SEEDED, size_t threads = 1) {
+  PerftConfig config;
+  config.depth = depth;
+  config.dice = dice;
+  config.threads = threads;
+  return runPerft(corpusBoard(name), config);
+}
+
+uint64_t decisions(const PerftResult& result, StateType state) {
+  return result.total.decisions[static_cast<size_t>(state)];
+}
+
+uint64_t moves(const PerftResult& result, ActionIndex::Kind kind) {
+  return result.total.moves[static_cast<size_t>(kind)];
+}
+
+}  // namespace
+
+TEST(PerftTest, EarlyWarTurnStartCounts) {
+  EXPECT_EQ(perft("early_war_turn_start", 0).total.nodes, 1U);
+  EXPECT_EQ(perft("early_war_turn_start", 1).total.nodes, 8U);
+  EXPECT_EQ(perft("early_war_turn_start", 2).total.nodes, 64U);
+
+  const auto result = perft("early_war_turn_start", 3);
+  EXPECT_EQ(result.total.nodes, 63904U);
+  EXPECT_EQ(result.total.terminals, 0U);
+  EXPECT_EQ(decisions(result, StateType::HEADLINE_CARD_SELECT_USSR), 1U);
+  EXPECT_EQ(decisions(result, StateType::HEADLINE_CARD_SELECT_USA), 8U);
+  EXPECT_EQ(decisions(result, StateType::AR_USSR), 64U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::HEADLINE), 72U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::EVENT), 448U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::SPACE_RACE), 224U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::COUP), 5120U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::REALIGNMENT), 5120U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::PLACE_INFLUENCE), 52992U);
+}
+
+TEST(PerftTest, ActionRoundCounts) {
+  EXPECT_EQ(perft("early_war_ar", 1).total.nodes, 672U);
+  EXPECT_EQ(perft("mid_war_ar", 1).total.nodes, 1464U);
+  EXPECT_EQ(perft("late_war_ar", 1).total.nodes, 370U);
+
+  const auto result = perft("early_war_ar", 2, PerftDice::SEEDED, 2);
+  EXPECT_EQ(result.total.nodes, 448162U);
+  EXPECT_EQ(decisions(result, StateType::AR_USSR), 1U);
+  EXPECT_EQ(decisions(result, StateType::AR_USA), 646U);
+  EXPECT_EQ(result.total.decisions[PERFT_REQUEST_DECISION], 26U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::EVENT), 4529U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::COUP), 26928U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::REALIGNMENT), 27163U);
+  EXPECT_EQ(moves(result, ActionIndex::Kind::PLACE_INFLUENCE), 389566U);
+}
+
+TEST(PerftTest, CardEventRequestCounts) {
+  const auto place = perft("de_stalinization_place", 1);
+  EXPECT_EQ(place.total.nodes, 3160U);
+  EXPECT_EQ(place.total.decisions[PERFT_REQUEST_DECISION], 1U);
+  EXPECT_EQ(moves(place, ActionIndex::Kind::EVENT_PLACE_INFLUENCE), 3160U);
+
+  const auto chain = perft("realignment_chain", 2);
+  EXPECT_EQ(chain.total.nodes, 12934U);
+  EXPECT_EQ(chain.total.decisions[PERFT_REQUEST_DECISION], 21U);
+  EXPECT_EQ(decisions(chain, StateType::AR_USA), 1U);
+}
+
+TEST(PerftTest, EnumeratedDiceBranchOnEveryOutcome) {
+  // 継続20手はそれぞれ2個のサイコロで36通り、打ち切りの1手は振らない
+  const auto result = perft("realignment_chain", 1, PerftDice::ENUMERATE);
+  EXPECT_EQ(result.total.nodes, 20U * 36U + 1U);
+  ASSERT_EQ(result.root_moves.size(), 21U);
+  EXPECT_EQ(std::ranges::count_if(
+                result.root_moves,
+                [](const PerftCounts& counts) { return counts.nodes == 1; }),
+            1);
+  // 出目を決め直すstepは1手につき、最初の1回と出目の組ごとの1回と1個目の出目ごとの1回
+  EXPECT_EQ(result.total.steps, 1U + 20U * (1U + 6U + 36U) + 1U);
+}
+
+TEST(PerftTest, CountsDoNotDependOnThreads) {
+  const std::pair<const char*, PerftDice> cases[] = {
+      {"early_war_turn_start", PerftDice::SEEDED},
+      {"realignment_chain", PerftDice::ENUMERATE},
+  };
+  for (const auto& [name, dice] : cases) {
+    const int depth = dice == PerftDice::SEEDED ? 3 : 1;
+    const auto serial = perft(name, depth, dice, 1);
+    const auto parallel = perft(name, depth, dice, 4);
+    EXPECT_EQ(parallel.total.nodes, serial.total.nodes);
+    EXPECT_EQ(parallel.total.steps, serial.total.steps);
+    EXPECT_EQ(parallel.total.decisions, serial.total.decisions);
+    EXPECT_EQ(parallel.total.moves, serial.total.moves);
+    ASSERT_EQ(parallel.root_moves.size(), serial.root_moves.size());
+    PerftCounts sum;
+    for (size_t i = 0; i < serial.root_moves.size(); ++i) {
+      EXPECT_EQ(parallel.root_moves[i].nodes, serial.root_moves[i].nodes)
+          << i;
+      sum += serial.root_moves[i];
+    }
+    EXPECT_EQ(sum.nodes, serial.total.nodes);
+  }
+}
+
+TEST(PerftTest, CountsFinishedGamesAsTerminals) {
+  Board board(opsOnlyCardpool());
+  readPositionText("state USSR_WIN_END\n", board);
+  PerftConfig config;
+  config.depth = 2;
+  const auto result = runPerft(board, config);
+  EXPECT_EQ(result.total.nodes, 0U);
+  EXPECT_EQ(result.total.terminals, 1U);
+  EXPECT_TRUE(result.root_moves.empty());
+}
+
+TEST(PerftTest, RejectsInvalidConfig) {
+  const Board board = corpusBoard("early_war_turn_start");
+  PerftConfig config;
+  config.depth = -1;
+  EXPECT_THROW(static_cast<void>(runPerft(board, config)),
+               std::invalid_argument);
+  config.depth = 1;
+  config.threads = 0;
+  EXPECT_THROW(static_cast<void>(runPerft(board, config)),
+               std::invalid_argument);
+  EXPECT_EQ(perftDecisionName(PERFT_REQUEST_DECISION), "REQUEST");
+  EXPECT_EQ(perftDecisionName(static_cast<size_t>(StateType::AR_USA)),
+            "AR_USA");
+  EXPECT_EQ(perftMoveClassName(PERFT_OTHER_MOVE_CLASS), "OTHER");
+  EXPECT_EQ(perftMoveClassName(static_cast<size_t>(ActionIndex::Kind::PASS)),
+            "PASS");
+}
@@ -1,5 +1,7 @@
 #include "phase_machine_test_helper.hpp"
 
+#include <stdexcept>
+
 TEST_F(PhaseMachineTest, BoardArPlayerFunctionalityTest) {
   // 初期状態確認
   EXPECT_EQ(board.getCurrentArPlayer(), Side::NEUTRAL);
@@ -124,3 +126,39 @@ TEST_F(PhaseMachineTest, SpaceTrackDiscardMoveRemovesCardAndResumesTurn) {
   EXPECT_EQ(std::get<1>(next_result), Side::USA);
   EXPECT_FALSE(std::get<0>(next_result).empty());
 }
+
+// 添字で回答しても手で回答した場合と同じ局面へ進み、範囲外の添字は盤面を変えずに拒否する
+TEST_F(PhaseMachineTest, StepByIndexMatchesStepByMove) {
+  board.clearHand(Side::USSR);
+  board.clearHand(Side::USA);
+  board.addCardToHand(Side::USSR, CardEnum::FIDEL);
+  board.addCardToHand(Side::USSR, CardEnum::DUCK_AND_COVER);
+  board.addCardToHand(Side::USA, CardEnum::NUCLEAR_TEST_BAN);
+
+  prepareDeckWithDummyCards(60);
+
+  board.getSpaceTrack().advanceSpaceTrack(Side::USSR, 6);
+  board.getSpaceTrack().advanceSpaceTrack(Side::USA, 3);
+  board.pushState(StateType::TURN_END);
+
+  auto initial_result = PhaseMachine::step(board, std::nullopt);
+  const auto moves = std::get<0>(initial_result);
+  ASSERT_FALSE(moves.empty());
+  const size_t states_before = board.getStates().size();
+  EXPECT_THROW(PhaseMachine::step(board, moves, moves.size()),
+               std::out_of_range);
+  EXPECT_EQ(board.getStates().size(), states_before);
+
+  const size_t chosen = moves.size() - 1;
+  Board by_move_board(board);
+  auto by_move = PhaseMachine::step(
+      by_move_board, std::optional<std::shared_ptr<Move>>{moves[chosen]});
+  auto by_index = PhaseMachine::step(board, moves, chosen);
+
+  EXPECT_EQ(std::get<1>(by_index), std::get<1>(by_move));
+  EXPECT_EQ(std::get<0>(by_index).size(), std::get<0>(by_move).size());
+  EXPECT_EQ(board.getPlayerHand(Side::USSR),
+            by_move_board.getPlayerHand(Side::USSR));
+  EXPECT_EQ(board.getDeck().getDiscardPile(),
+            by_move_board.getDeck().getDiscardPile());
+}
@@ -0,0 +1,293 @@
+// ファイル: tests/core/position_text_test.cpp
+// 役割:
+// 局面テキストが対局中のどの局面でも盤面を正確に往復させ、誤った行を行番号付きで拒み、同梱のコーパスの全局面が読めて指し始められることを検証する。
+// 背景:
+// 計測は同梱のコーパスを前提にするため、書式や列挙子名の変更でコーパスが黙って読めなくなると比較の条件が崩れる。
+
+#include "tsge/core/position_text.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tsge/core/game_record.hpp"
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/players/match_runner.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace {
+
+std::vector<std::byte> snapshot(const Board& board) {
+  std::vector<std::byte> bytes(Board::SNAPSHOT_CAPACITY);
+  bytes.resize(board.serialize(bytes));
+  return bytes;
+}
+
+GameRecord recordedMatch(uint64_t seed) {
+  const std::array<MatchPolicyFactory, 2> policies{makeMatchPolicy("random"),
+                                                   makeMatchPolicy("random")};
+  GameRecord record;
+  static_cast<void>(playMatch(opsOnlyCardpool(), policies, seed,
+                              MatchConfig{}.max_steps, &record));
+  return record;
+}
+
+// textを読んだときの例外の文言。読めればその旨を返す。
+std::string readError(const std::string& text, Board& board) {
+  try {
+    readPositionText(text, board);
+  } catch (const std::runtime_error& error) {
+    return error.what();
+  }
+  return "accepted";
+}
+
+constexpr const char* SMALL_POSITION = R"(# 手書きの局面
+turn 3
+action_round 2 1      # USSR USA
+ar_player USA
+defcon 2
+vp -4
+space 3 5
+space_tried 0 1
+milops 1 2
+china USA down
+influence POLAND 4 0
+influence FRANCE 0 3
+influence USSR 999 2
+hand USSR COMECON NATO
+hand USA MARSHALL_PLAN
+deck FIDEL BLOCKADE
+removed CHINA_CARD
+effects USA NATO
+state TURN_END
+state AR_USA
+)";
+
+}  // namespace
+
+TEST(PositionTextTest, RoundTripIsExactThroughoutAGame) {
+  ReplayDriver replay(opsOnlyCardpool(), recordedMatch(17));
+  ASSERT_GT(replay.size(), 100U);
+  Board restored(opsOnlyCardpool());
+  do {
+    const std::string text = writePositionText(replay.board());
+    readPositionText(text, restored);
+    ASSERT_EQ(snapshot(restored), snapshot(replay.board()))
+        << "decision " << replay.position() << "\n"
+        << text;
+    EXPECT_EQ(writePositionText(restored), text);
+  } while (replay.next());
+}
+
+TEST(PositionTextTest, ReadsHandWrittenPositions) {
+  Board board(opsOnlyCardpool());
+  readPositionText(SMALL_POSITION, board);
+
+  EXPECT_EQ(board.getTurnTrack().getTurn(), 3);
+  EXPECT_EQ(board.getActionRoundTrack().getActionRound(Side::USSR), 2);
+  EXPECT_EQ(board.getActionRoundTrack().getActionRound(Side::USA), 1);
+  EXPECT_EQ(board.getCurrentArPlayer(), Side::USA);
+  EXPECT_EQ(board.getDefconTrack().getDefcon(), 2);
+  EXPECT_EQ(board.getVp(), -4);
+  EXPECT_EQ(board.getSpaceTrack().getSpaceTrackPosition(Side::USA), 5);
+  EXPECT_EQ(board.getSpaceTrack().getSpaceTried(Side::USA), 1);
+  EXPECT_EQ(board.getMilopsTrack().getMilops(Side::USA), 2);
+  EXPECT_EQ(board.getChinaCardOwner(), Side::USA);
+  EXPECT_FALSE(board.isChinaCardFaceUp());
+  const auto& world_map = board.getWorldMap();
+  EXPECT_EQ(world_map.getCountry(CountryEnum::POLAND).getInfluence(Side::USSR),
+            4);
+  EXPECT_EQ(world_map.getCountry(CountryEnum::FRANCE).getInfluence(Side::USA),
+            3);
+  // 書かない国は0、書かない超大国の欄は初期値のまま
+  EXPECT_EQ(
+      world_map.getCountry(CountryEnum::NORTH_KOREA).getInfluence(Side::USSR),
+      0);
+  EXPECT_EQ(world_map.getCountry(CountryEnum::USA).getInfluence(Side::USA),
+            999);
+  EXPECT_EQ(world_map.getCountry(CountryEnum::USSR).getInfluence(Side::USA),
+            2);
+  EXPECT_EQ(board.getPlayerHand(Side::USSR),
+            (std::vector<CardEnum>{CardEnum::COMECON, CardEnum::NATO}));
+  EXPECT_EQ(board.getDeck().getDeck(),
+            (std::vector<CardEnum>{CardEnum::FIDEL, CardEnum::BLOCKADE}));
+  EXPECT_EQ(board.getDeck().getRemovedCards(),
+            std::vector<CardEnum>{CardEnum::CHINA_CARD});
+  EXPECT_EQ(board.getCardsEffectsInThisTurn(Side::USA),
+            std::vector<CardEnum>{CardEnum::NATO});
+  ASSERT_EQ(board.getStates().size(), 2U);
+
+  // 読んだ盤面をそのまま指し始められる
+  std::mt19937_64 rng(1);
+  board.getRandomizer().setRng(&rng);
+  const auto [legal_moves, side, winner] = PhaseMachine::step(board);
+  EXPECT_EQ(side, Side::USA);
+  EXPECT_FALSE(legal_moves.empty());
+  EXPECT_FALSE(winner.has_value());
+}
+
+TEST(PositionTextTest, RejectsMalformedLinesWithoutTouchingTheBoard) {
+  Board board(opsOnlyCardpool());
+  readPositionText(SMALL_POSITION, board);
+  const auto before = snapshot(board);
+
+  const std::vector<std::pair<std::string, std::string>> cases{
+      {"turn 3\nfoo 1\n", "position line 2: unknown key: foo"},
+      {"turn 11\n", "position line 1: turn out of range: 11"},
+      {"defcon x\n", "position line 1: not an integer: x"},
+      {"vp 1 2\n", "position line 1: vp takes 1 values"},
+      {"hand USSR NOT_A_CARD\n", "position line 1: unknown card: NOT_A_CARD"},
+      {"hand\n", "position line 1: hand is missing a value"},
+      {"hand NEUTRAL\n", "position line 1: side must be USSR or USA"},
+      {"influence ATLANTIS 1 0\n",
+       "position line 1: unknown country: ATLANTIS"},
+      {"defcon 3\ndefcon 4\n", "position line 2: duplicate defcon"},
+      {"hand USA\nhand USA NATO\n", "position line 2: duplicate hand USA"},
+      {"turn 1\naction_round 7 0\n",
+       "position line 2: action_round 7 is not reachable"},
+      {"action_round 1 1\nturn 2\n",
+       "position line 2: turn must precede action_round"},
+      {"china USA sideways\n",
+       "position line 1: china face must be up or down"},
+      {"state NOT_A_STATE\n", "position line 1: unknown state: NOT_A_STATE"},
+      {"command 0\n", "position line 1: malformed command"},
+      {"command zz\n", "position line 1: malformed command"},
+      {"command ff\n", "position line 1: ByteReader: invalid command"},
+      {"command 0500020000\n", "position line 1: trailing bytes in command"},
+  };
+  for (const auto& [text, message] : cases) {
+    EXPECT_EQ(readError(text, board), message) << text;
+    EXPECT_EQ(snapshot(board), before) << text;
+  }
+}
+
+TEST(PositionTextTest, CorpusPositionsLoadAndStartPlaying) {
+  const auto corpus = loadPositionCorpus(TSGE_POSITION_CORPUS);
+  std::set<std::string> names;
+  for (const auto& position : corpus) {
+    names.insert(position.name);
+  }
+  // 計測が名前で参照する局面
+  for (const char* name :
+       {"early_war_turn_start", "early_war_ar", "mid_war_ar", "late_war_ar",
+        "four_ops_ussr_ar", "four_ops_usa_ar", "de_stalinization_ar",
+        "de_stalinization_place", "realignment_chain"}) {
+    EXPECT_TRUE(names.contains(name)) << name;
+  }
+
+  for (const auto& position : corpus) {
+    SCOPED_TRACE(position.name);
+    Board board(cardpoolByName(position.cardpool));
+    readPositionText(position.text, board);
+    const std::string text = writePositionText(board);
+    Board reread(cardpoolByName(position.cardpool));
+    readPositionText(text, reread);
+    EXPECT_EQ(snapshot(reread), snapshot(board));
+    // DUMMYは未選択や隠した札を表す番兵なので、札の並びには現れない
+    for (const auto* cards :
+         {&board.getDeck().getDeck(), &board.getDeck().getDiscardPile(),
+          &board.getPlayerHand(Side::USSR), &board.getPlayerHand(Side::USA)}) {
+      EXPECT_EQ(std::ranges::count(*cards, CardEnum::DUMMY), 0);
+    }
+
+    std::mt19937_64 rng(3);
+    board.getRandomizer().setRng(&rng);
+    const auto [legal_moves, side, winner] = PhaseMachine::step(board);
+    EXPECT_FALSE(legal_moves.empty());
+    EXPECT_NE(side, Side::NEUTRAL);
+    EXPECT_FALSE(winner.has_value());
+  }
+}
+
+TEST(PositionTextTest, CorpusCardpoolsNeverDealDummy) {
+  for (const char* name : {"ops_only", "implemented"}) {
+    SCOPED_TRACE(name);
+    const auto& cardpool = cardpoolByName(name);
+    EXPECT_EQ(cardpool[static_cast<size_t>(CardEnum::DUMMY)], nullptr);
+    Board board(cardpool);
+    std::mt19937_64 rng(5);
+    board.getRandomizer().setRng(&rng);
+    board.getDeck().addEarlyWarCards();
+    EXPECT_EQ(std::ranges::count(board.getDeck().getDeck(), CardEnum::DUMMY),
+              0);
+  }
+  // ops_onlyは全カードを初期戦として扱うので、China CardとDUMMY以外の109枚
+  Board board(opsOnlyCardpool());
+  std::mt19937_64 rng(5);
+  board.getRandomizer().setRng(&rng);
+  board.getDeck().addEarlyWarCards();
+  EXPECT_EQ(board.getDeck().getDeck().size(), 109U);
+}
+
+TEST(PositionTextTest, ImplementedCardpoolOffersOnlyRealEvents) {
+  const std::set<CardEnum> real{
+      CardEnum::ASIA_SCORING, CardEnum::EUROPE_SCORING,
+      CardEnum::MIDDLE_EAST_SCORING, CardEnum::CENTRAL_AMERICA_SCORING,
+      CardEnum::AFRICA_SCORING, CardEnum::SOUTH_AMERICA_SCORING,
+      CardEnum::SOUTHEAST_ASIA_SCORING, CardEnum::DUCK_AND_COVER,
+      CardEnum::CHINA_CARD, CardEnum::FIDEL, CardEnum::NUCLEAR_TEST_BAN,
+      CardEnum::COMECON, CardEnum::DECOLONIZATION,
+      CardEnum::COLONIAL_REAR_GUARDS, CardEnum::PUPPET_GOVERNMENTS,
+      CardEnum::OAS_FOUNDED, CardEnum::LIBERATION_THEOLOGY,
+      CardEnum::WARSAW_PACT_FORMED, CardEnum::MARSHALL_PLAN,
+      CardEnum::USSURI_RIVER_SKIRMISH, CardEnum::REFORMER,
+      CardEnum::SPECIAL_RELATIONSHIP, CardEnum::SOUTH_AFRICAN_UNREST,
+      CardEnum::JUNTA, CardEnum::SOCIALIST_GOVERNMENTS,
+      CardEnum::VOICE_OF_AMERICA, CardEnum::MARINE_BARRACKS_BOMBING,
+      CardEnum::SUEZ_CRISIS, CardEnum::EAST_EUROPEAN_UNREST,
+      CardEnum::PERSHING_II_DEPLOYED, CardEnum::MUSLIM_REVOLUTION,
+      CardEnum::DE_STALINIZATION};
+  ASSERT_EQ(real.size(), 32U);
+  const auto& cardpool = implementedCardpool();
+  const Board board(cardpool);
+  size_t eventable = 0;
+  for (size_t i = 1; i < cardpool.size(); ++i) {
+    const auto card = static_cast<CardEnum>(i);
+    ASSERT_NE(cardpool[i], nullptr) << i;
+    // 残りのカードは何も起こさないイベントの手を出さない
+    if (!real.contains(card)) {
+      EXPECT_FALSE(cardpool[i]->canEvent(board)) << i;
+    } else if (cardpool[i]->canEvent(board)) {
+      ++eventable;
+    }
+  }
+  EXPECT_GT(eventable, 0U);
+  // Opsだけのプールではどのカードもイベントの手を選べる
+  EXPECT_TRUE(opsOnlyCardpool()[static_cast<size_t>(CardEnum::FIVE_YEAR_PLAN)]
+                  ->canEvent(board));
+}
+
+TEST(PositionTextTest, CorpusParserRejectsInconsistentFiles) {
+  EXPECT_THROW(static_cast<void>(parsePositionCorpus("turn 1\n")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(parsePositionCorpus("position a\nturn 1\n")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(parsePositionCorpus(
+                   "position a\ncardpool ops_only\nposition a\n"
+                   "cardpool ops_only\n")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(parsePositionCorpus(
+                   "position a\ncardpool ops_only\ncardpool implemented\n")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(loadPositionCorpus("/nonexistent/x.tsp")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(cardpoolByName("unknown")),
+               std::invalid_argument);
+
+  const auto corpus = parsePositionCorpus(
+      "# 注釈\n\nposition a\ncardpool ops_only\ndefcon 3\n"
+      "position b\ncardpool implemented\n");
+  ASSERT_EQ(corpus.size(), 2U);
+  EXPECT_EQ(corpus[0].name, "a");
+  EXPECT_EQ(corpus[0].cardpool, "ops_only");
+  EXPECT_EQ(corpus[0].text, "defcon 3\n");
+  EXPECT_EQ(corpus[1].cardpool, "implemented");
+}
@@ -0,0 +1,151 @@
+// ファイル: tests/players/board_evaluator_test.cpp
+// 役割:
+// 評価関数の特徴量が盤面どおりに集計され、差分更新が全体の再計算と一致し、重みファイルを読めることを検証する。
+// 背景:
+// 打ち切り評価の符号や差分更新の取りこぼしは探索全体を静かに歪めるため、単体で固定しておく。
+
+#include "tsge/players/board_evaluator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class EvaluatorCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  EvaluatorCard(CardEnum id, int ops)
+      : Card(id, "Evaluator", ops, Side::NEUTRAL, WarPeriod::EARLY_WAR, false) {
+  }
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+class BoardEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      cardpool_[static_cast<size_t>(i)] = std::make_unique<EvaluatorCard>(
+          static_cast<CardEnum>(i), 1 + (i % 4));
+    }
+  }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+}  // namespace
+
+TEST_F(BoardEvaluatorTest, VpEvaluatorIsSideSymmetric) {
+  Board board(cardpool_);
+  board.changeVp(5);
+  const mcts::VpBoardEvaluator evaluator;
+
+  EXPECT_DOUBLE_EQ(evaluator.evaluate(board, Side::USSR), std::tanh(0.5));
+  EXPECT_DOUBLE_EQ(evaluator.evaluate(board, Side::USA), -std::tanh(0.5));
+}
+
+TEST_F(BoardEvaluatorTest, FeaturesReflectBoard) {
+  Board board(cardpool_);
+  mcts::EvaluationFeatures initial;
+  initial.refresh(board);
+
+  board.getWorldMap().getCountry(CountryEnum::NIGERIA).addInfluence(Side::USSR,
+                                                                    1);
+  board.getMilopsTrack().advanceMilopsTrack(Side::USSR, 5);
+  board.getSpaceTrack().advanceSpaceTrack(Side::USA, 2);
+  board.giveChinaCardTo(Side::USA, false);
+  board.addCardToHand(Side::USSR, static_cast<CardEnum>(7));  // Ops 4
+
+  mcts::EvaluationFeatures features;
+  features.refresh(board);
+
+  EXPECT_EQ(features.battlegrounds, initial.battlegrounds + 1);
+  // DEFCON 5でUSAは軍事行動0なので5点失い、USSRは失わない
+  EXPECT_EQ(features.milops_penalty, 5);
+  EXPECT_EQ(features.space, -2);
+  EXPECT_DOUBLE_EQ(features.china_card, -0.5);
+  EXPECT_EQ(features.hand_ops, 4);
+  constexpr size_t africa = 3;  // EvaluationFeatures::REGIONSでの位置
+  EXPECT_GT(features.region_scores[africa], initial.region_scores[africa]);
+}
+
+TEST_F(BoardEvaluatorTest, RefreshCountryMatchesFullRefresh) {
+  Board board(cardpool_);
+  mcts::EvaluationFeatures incremental;
+  incremental.refresh(board);
+
+  auto& iran = board.getWorldMap().getCountry(CountryEnum::IRAN);
+  const Side previous = iran.getControlSide();
+  iran.addInfluence(Side::USSR, 4);
+  incremental.refreshCountry(board, CountryEnum::IRAN, previous);
+
+  mcts::EvaluationFeatures full;
+  full.refresh(board);
+  EXPECT_EQ(incremental.battlegrounds, full.battlegrounds);
+  EXPECT_EQ(incremental.region_scores, full.region_scores);
+}
+
+TEST_F(BoardEvaluatorTest, HeuristicEvaluatorFavoursLeadingSide) {
+  Board board(cardpool_);
+  const mcts::HeuristicBoardEvaluator evaluator;
+  const double before = evaluator.evaluate(board, Side::USSR);
+
+  for (const auto country : {CountryEnum::NIGERIA, CountryEnum::ALGERIA,
+                             CountryEnum::ZAIRE, CountryEnum::ANGOLA}) {
+    board.getWorldMap().getCountry(country).addInfluence(Side::USSR, 4);
+  }
+  const double after = evaluator.evaluate(board, Side::USSR);
+
+  EXPECT_GT(after, before);
+  EXPECT_DOUBLE_EQ(evaluator.evaluate(board, Side::USA), -after);
+  EXPECT_LE(after, 1.0);
+}
+
+TEST(HeuristicEvaluatorWeightsTest, ParsesNamedWeights) {
+  std::istringstream input(
+      "# 重みファイル\n"
+      "vp 2.0\n"
+      "\n"
+      "battlegrounds 1.5  # コメント\n"
+      "scale 20\n");
+
+  const auto weights = mcts::HeuristicEvaluatorWeights::parse(input);
+
+  EXPECT_DOUBLE_EQ(weights.vp, 2.0);
+  EXPECT_DOUBLE_EQ(weights.battlegrounds, 1.5);
+  EXPECT_DOUBLE_EQ(weights.scale, 20.0);
+  EXPECT_DOUBLE_EQ(weights.space, mcts::HeuristicEvaluatorWeights{}.space);
+}
+
+TEST(HeuristicEvaluatorWeightsTest, RejectsInvalidInput) {
+  std::istringstream unknown("unknown 1.0\n");
+  EXPECT_THROW(mcts::HeuristicEvaluatorWeights::parse(unknown),
+               std::runtime_error);
+
+  std::istringstream not_number("vp high\n");
+  EXPECT_THROW(mcts::HeuristicEvaluatorWeights::parse(not_number),
+               std::runtime_error);
+
+  std::istringstream bad_scale("scale 0\n");
+  EXPECT_THROW(mcts::HeuristicEvaluatorWeights::parse(bad_scale),
+               std::runtime_error);
+
+  EXPECT_THROW(mcts::HeuristicEvaluatorWeights::loadFromFile(
+                   "/nonexistent/evaluator_weights.txt"),
+               std::runtime_error);
+}
@@ -0,0 +1,340 @@
+// ファイル: tests/players/cpu_mlp_engine_test.cpp
+// 役割:
+// CPU推論のGEMMが素朴な行列積と一致し、量子化重み・重みファイル・合法手へのsoftmaxが正しく扱われることを検証する。
+// 背景:
+// SIMD版のブロック端や量子化の丸めの誤りは学習済みモデルの強さを静かに落とすため、参照実装と突き合わせる。
+
+#include "tsge/players/cpu_mlp_engine.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/actions/action_index.hpp"
+#include "tsge/game_state/card.hpp"
+#include "tsge/players/feature_encoder.hpp"
+
+namespace {
+
+CpuMlpLayer randomLayer(uint32_t inputs, uint32_t outputs,
+                        CpuMlpActivation activation, std::mt19937& rng) {
+  std::uniform_real_distribution<float> dist(-0.5F, 0.5F);
+  CpuMlpLayer layer;
+  layer.inputs = inputs;
+  layer.outputs = outputs;
+  layer.activation = activation;
+  layer.weights_f32.resize(static_cast<size_t>(inputs) * outputs);
+  for (auto& weight : layer.weights_f32) {
+    weight = dist(rng);
+  }
+  layer.bias.resize(outputs);
+  for (auto& bias : layer.bias) {
+    bias = dist(rng);
+  }
+  return layer;
+}
+
+// 入力37(8の端数あり)、残差付きの胴体2層、方策19
+CpuMlpModel randomModel(uint32_t seed,
+                        CpuMlpWeightType type = CpuMlpWeightType::FLOAT32) {
+  std::mt19937 rng(seed);
+  std::vector<CpuMlpLayer> trunk;
+  trunk.push_back(randomLayer(37, 24, CpuMlpActivation::RELU, rng));
+  trunk.push_back(randomLayer(24, 24, CpuMlpActivation::RELU, rng));
+  trunk.back().residual = true;
+  for (auto& layer : trunk) {
+    layer = layer.quantized(type);
+  }
+  return {std::move(trunk),
+          randomLayer(24, 19, CpuMlpActivation::NONE, rng).quantized(type),
+          randomLayer(24, 1, CpuMlpActivation::NONE, rng).quantized(type)};
+}
+
+// 参照実装: 量子化前のfloat重みでそのまま計算する
+std::vector<float> referenceLayer(const CpuMlpLayer& layer,
+                                  const std::vector<float>& input) {
+  std::vector<float> output(layer.outputs);
+  for (size_t o = 0; o < layer.outputs; ++o) {
+    double sum = layer.bias[o];
+    for (size_t i = 0; i < layer.inputs; ++i) {
+      sum += static_cast<double>(layer.weights_f32[(o * layer.inputs) + i]) *
+             input[i];
+    }
+    auto value = static_cast<float>(sum);
+    if (layer.activation == CpuMlpActivation::RELU) {
+      value = std::max(value, 0.0F);
+    }
+    output[o] = layer.residual ? value + input[o] : value;
+  }
+  return output;
+}
+
+std::vector<float> randomInputs(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0F, 1.0F);
+  std::vector<float> inputs(count);
+  for (auto& value : inputs) {
+    value = dist(rng);
+  }
+  return inputs;
+}
+
+struct ForwardOutput {
+  std::vector<float> logits;
+  std::vector<float> values;
+};
+
+ForwardOutput runForward(const CpuMlpModel& model,
+                         const std::vector<float>& inputs, size_t batch,
+                         CpuMlpKernelIsa isa) {
+  ForwardOutput output{std::vector<float>(batch * model.getPolicySize()),
+                       std::vector<float>(batch)};
+  model.forward(inputs, batch, output.logits, output.values, isa);
+  return output;
+}
+
+class MlpCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  explicit MlpCard(CardEnum id)
+      : Card(id, "Mlp", 2, Side::NEUTRAL, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(CpuMlpModelTest, ScalarForwardMatchesReference) {
+  const auto model = randomModel(1);
+  const auto inputs = randomInputs(37, 2);
+
+  const auto output = runForward(model, inputs, 1, CpuMlpKernelIsa::SCALAR);
+
+  auto hidden = inputs;
+  for (const auto& layer : model.getTrunk()) {
+    hidden = referenceLayer(layer, hidden);
+  }
+  std::mt19937 rng(1);
+  // randomModelと同じ順に乱数を消費してヘッドを作り直す
+  randomLayer(37, 24, CpuMlpActivation::RELU, rng);
+  randomLayer(24, 24, CpuMlpActivation::RELU, rng);
+  const auto policy = referenceLayer(
+      randomLayer(24, 19, CpuMlpActivation::NONE, rng), hidden);
+  const auto value =
+      referenceLayer(randomLayer(24, 1, CpuMlpActivation::NONE, rng), hidden);
+  for (size_t i = 0; i < policy.size(); ++i) {
+    EXPECT_NEAR(output.logits[i], policy[i], 1e-4);
+  }
+  EXPECT_NEAR(output.values[0], std::tanh(value[0]), 1e-4);
+}
+
+TEST(CpuMlpModelTest, SimdMatchesScalarForAllWeightTypes) {
+  if (!isCpuMlpKernelIsaSupported(CpuMlpKernelIsa::AVX2_FMA)) {
+    GTEST_SKIP() << "AVX2/FMA is not available";
+  }
+  constexpr size_t batch = 7;  // 4盤面ブロックの端数を含める
+  const auto inputs = randomInputs(batch * 37, 3);
+  for (const auto type : {CpuMlpWeightType::FLOAT32,
+                          CpuMlpWeightType::BFLOAT16, CpuMlpWeightType::INT8}) {
+    const auto model = randomModel(4, type);
+    const auto scalar =
+        runForward(model, inputs, batch, CpuMlpKernelIsa::SCALAR);
+    const auto simd =
+        runForward(model, inputs, batch, CpuMlpKernelIsa::AVX2_FMA);
+    for (size_t i = 0; i < scalar.logits.size(); ++i) {
+      EXPECT_NEAR(simd.logits[i], scalar.logits[i], 1e-4);
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      EXPECT_NEAR(simd.values[i], scalar.values[i], 1e-4);
+    }
+  }
+}
+
+TEST(CpuMlpModelTest, BatchRowsAreIndependent) {
+  const auto model = randomModel(5);
+  constexpr size_t batch = 5;
+  const auto inputs = randomInputs(batch * 37, 6);
+  const auto batched = runForward(model, inputs, batch,
+                                  activeCpuMlpKernelIsa());
+
+  for (size_t b = 0; b < batch; ++b) {
+    const std::vector<float> single(inputs.begin() + (b * 37),
+                                    inputs.begin() + ((b + 1) * 37));
+    const auto output = runForward(model, single, 1, activeCpuMlpKernelIsa());
+    for (size_t i = 0; i < model.getPolicySize(); ++i) {
+      EXPECT_FLOAT_EQ(output.logits[i],
+                      batched.logits[(b * model.getPolicySize()) + i]);
+    }
+  }
+}
+
+TEST(CpuMlpModelTest, QuantizedWeightsStayClose) {
+  const auto exact = randomModel(7);
+  const auto inputs = randomInputs(4 * 37, 8);
+  const auto reference =
+      runForward(exact, inputs, 4, CpuMlpKernelIsa::SCALAR);
+  for (const auto& [type, tolerance] :
+       {std::pair{CpuMlpWeightType::BFLOAT16, 0.05},
+        std::pair{CpuMlpWeightType::INT8, 0.1}}) {
+    const auto output = runForward(randomModel(7, type), inputs, 4,
+                                   CpuMlpKernelIsa::SCALAR);
+    for (size_t i = 0; i < reference.logits.size(); ++i) {
+      EXPECT_NEAR(output.logits[i], reference.logits[i], tolerance);
+    }
+  }
+}
+
+TEST(CpuMlpModelTest, SaveAndParseRoundTrip) {
+  const auto model = randomModel(9, CpuMlpWeightType::INT8);
+  std::stringstream buffer;
+  model.save(buffer);
+
+  const auto loaded = CpuMlpModel::parse(buffer);
+
+  const auto inputs = randomInputs(2 * 37, 10);
+  const auto expected = runForward(model, inputs, 2, CpuMlpKernelIsa::SCALAR);
+  const auto actual = runForward(loaded, inputs, 2, CpuMlpKernelIsa::SCALAR);
+  EXPECT_EQ(actual.logits, expected.logits);
+  EXPECT_EQ(actual.values, expected.values);
+}
+
+TEST(CpuMlpModelTest, RejectsBrokenInput) {
+  std::istringstream bad_magic("XXXX");
+  EXPECT_THROW(CpuMlpModel::parse(bad_magic), std::runtime_error);
+
+  std::stringstream truncated;
+  randomModel(11).save(truncated);
+  const auto bytes = truncated.str();
+  std::istringstream cut(bytes.substr(0, bytes.size() / 2));
+  EXPECT_THROW(CpuMlpModel::parse(cut), std::runtime_error);
+
+  EXPECT_THROW(CpuMlpModel::loadFromFile("/nonexistent/model.tsmp"),
+               std::runtime_error);
+
+  std::mt19937 rng(12);
+  EXPECT_THROW(
+      CpuMlpModel({randomLayer(4, 6, CpuMlpActivation::RELU, rng)},
+                  randomLayer(5, 3, CpuMlpActivation::NONE, rng),
+                  randomLayer(6, 1, CpuMlpActivation::NONE, rng)),
+      std::invalid_argument);
+}
+
+TEST(CpuMlpInferenceEngineTest, PolicyFollowsLegalMoveOrder) {
+  std::array<std::unique_ptr<Card>, 111> cardpool{};
+  for (int i = 0; i < 111; ++i) {
+    cardpool[static_cast<size_t>(i)] =
+        std::make_unique<MlpCard>(static_cast<CardEnum>(i));
+  }
+  const Board board(cardpool);
+
+  // 方策ロジットがバイアスそのもの(0, 1, 2, 3)になるモデル
+  CpuMlpLayer policy_head;
+  policy_head.inputs = FeatureEncoder::SIZE;
+  policy_head.outputs = 4;
+  policy_head.weights_f32.assign(policy_head.inputs * 4, 0.0F);
+  policy_head.bias = {0.0F, 1.0F, 2.0F, 3.0F};
+  CpuMlpLayer value_head;
+  value_head.inputs = FeatureEncoder::SIZE;
+  value_head.outputs = 1;
+  value_head.weights_f32.assign(value_head.inputs, 0.0F);
+  value_head.bias = {0.5F};
+  auto model = std::make_shared<const CpuMlpModel>(
+      std::vector<CpuMlpLayer>{}, policy_head, value_head);
+
+  const std::vector<std::shared_ptr<Move>> moves{
+      std::make_shared<PassMove>(Side::USSR),
+      std::make_shared<PassMove>(Side::USA)};
+  // 1手目を添字3、2手目を添字1へ写す
+  CpuMlpInferenceEngine engine(
+      model, {}, [&moves](const Move& move, size_t /*policy_size*/) {
+        return &move == moves[0].get() ? size_t{3} : size_t{1};
+      });
+
+  const auto result = engine.evaluate(board, moves, Side::USSR);
+
+  ASSERT_EQ(result.policy.size(), 2U);
+  EXPECT_NEAR(result.policy[0] + result.policy[1], 1.0, 1e-9);
+  EXPECT_NEAR(result.policy[0], 1.0 / (1.0 + std::exp(-2.0)), 1e-6);
+  EXPECT_NEAR(result.value, std::tanh(0.5), 1e-6);
+
+  const std::array<const Board*, 2> boards{&board, &board};
+  const std::array<const std::vector<std::shared_ptr<Move>>*, 2> batch_moves{
+      &moves, &moves};
+  const std::array<Side, 2> sides{Side::USSR, Side::USA};
+  const auto batch = engine.evaluateBatch(boards, batch_moves, sides);
+  ASSERT_EQ(batch.size(), 2U);
+  EXPECT_EQ(batch[1].policy, result.policy);
+}
+
+// move_index省略時は手順ごとの確率の積が事前確率になり、最初の国が同じ影響力配置も区別される。
+TEST(CpuMlpInferenceEngineTest, DefaultPriorSeparatesPlacementPatterns) {
+  std::array<std::unique_ptr<Card>, 111> cardpool{};
+  for (int i = 0; i < 111; ++i) {
+    cardpool[static_cast<size_t>(i)] =
+        std::make_unique<MlpCard>(static_cast<CardEnum>(i));
+  }
+  const Board board(cardpool);
+
+  constexpr auto CARD = static_cast<CardEnum>(7);
+  const auto step = [](CountryEnum country) {
+    return ActionIndex::PLACE_INFLUENCE_OFFSET +
+           (static_cast<size_t>(CARD) * ActionIndex::COUNTRY_COUNT) +
+           static_cast<size_t>(country);
+  };
+  // 入力1つで、方策ロジットがバイアスそのものになるモデル
+  CpuMlpLayer policy_head;
+  policy_head.inputs = 1;
+  policy_head.outputs = static_cast<uint32_t>(ActionIndex::SIZE);
+  policy_head.weights_f32.assign(ActionIndex::SIZE, 0.0F);
+  policy_head.bias.assign(ActionIndex::SIZE, 0.0F);
+  policy_head.bias[step(CountryEnum::WEST_GERMANY)] = 1.0F;
+  policy_head.bias[step(CountryEnum::ITALY)] = 2.0F;
+  CpuMlpLayer value_head;
+  value_head.inputs = 1;
+  value_head.outputs = 1;
+  value_head.weights_f32.assign(1, 0.0F);
+  value_head.bias = {0.0F};
+  auto model = std::make_shared<const CpuMlpModel>(
+      std::vector<CpuMlpLayer>{}, policy_head, value_head);
+  CpuMlpInferenceEngine engine(
+      model, [](const Board& /*board*/, Side /*side*/, std::span<float> out) {
+        out[0] = 0.0F;
+      });
+
+  using Placement = std::map<CountryEnum, int>;
+  const std::vector<std::shared_ptr<Move>> moves{
+      std::make_shared<ActionPlaceInfluenceMove>(
+          CARD, Side::USSR,
+          Placement{{CountryEnum::WEST_GERMANY, 1}, {CountryEnum::ITALY, 1}}),
+      std::make_shared<ActionPlaceInfluenceMove>(
+          CARD, Side::USSR,
+          Placement{{CountryEnum::WEST_GERMANY, 1}, {CountryEnum::FRANCE, 1}}),
+      std::make_shared<ActionPlaceInfluenceMove>(
+          CARD, Side::USSR, Placement{{CountryEnum::WEST_GERMANY, 2}})};
+  ASSERT_EQ(ActionIndex::moveToIndex(*moves[0]),
+            ActionIndex::moveToIndex(*moves[1]));
+
+  const auto result = engine.evaluate(board, moves, Side::USSR);
+
+  // 各手の値はロジットの和(3, 1, 2)から手順数×正規化定数を引いたもので、
+  // 手順数が揃っているため比はexp(3):exp(1):exp(2)になる
+  const double total = std::exp(3.0) + std::exp(1.0) + std::exp(2.0);
+  ASSERT_EQ(result.policy.size(), 3U);
+  EXPECT_NEAR(result.policy[0], std::exp(3.0) / total, 1e-6);
+  EXPECT_NEAR(result.policy[1], std::exp(1.0) / total, 1e-6);
+  EXPECT_NEAR(result.policy[2], std::exp(2.0) / total, 1e-6);
+}
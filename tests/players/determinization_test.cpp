@@ -0,0 +1,189 @@
+// ファイル: tests/players/determinization_test.cpp
+// 役割:
+// 見えないカード集合が公開情報を正しく除外し、標本が手札と山札へ過不足なく分配されることを検証する。
+// 背景:
+// 捨て札や除外カードが相手の手札に紛れ込む誤りを回帰として防ぎ、制約付き標本化の挙動を固定するため。
+
+#include "tsge/players/determinization.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class DummyCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  DummyCard(CardEnum id, WarPeriod war_period)
+      : Card(id, "Dummy", 2, Side::NEUTRAL, war_period, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+// 1〜40をEarly War、41〜80をMid War、81〜110をLate Warとするカードプール。
+class DeterminizationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      WarPeriod period = WarPeriod::LATE_WAR;
+      if (i <= 40) {
+        period = WarPeriod::EARLY_WAR;
+      } else if (i <= 80) {
+        period = WarPeriod::MID_WAR;
+      }
+      cardpool_[static_cast<size_t>(i)] =
+          std::make_unique<DummyCard>(static_cast<CardEnum>(i), period);
+    }
+  }
+
+  static CardEnum card(int index) { return static_cast<CardEnum>(index); }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+}  // namespace
+
+TEST_F(DeterminizationTest, UnseenExcludesPublicInformation) {
+  Board board(cardpool_);
+  board.addCardToHand(Side::USSR, card(10));
+  board.addCardToHand(Side::USA, card(11));
+  board.getDeck().getDiscardPile().push_back(card(12));
+  board.getDeck().getRemovedCards().push_back(card(13));
+  board.setHeadlineCard(Side::USSR, card(14));
+  board.setHeadlineCard(Side::USA, card(15));
+
+  const auto unseen =
+      mcts::DeterminizationSampler::computeUnseen(board, Side::USSR);
+
+  EXPECT_FALSE(unseen.test(CardEnum::DUMMY));
+  EXPECT_FALSE(unseen.test(CardEnum::CHINA_CARD));
+  EXPECT_FALSE(unseen.test(card(10)));  // 自分の手札
+  EXPECT_TRUE(unseen.test(card(11)));   // 相手の手札
+  EXPECT_FALSE(unseen.test(card(12)));  // 捨て札
+  EXPECT_FALSE(unseen.test(card(13)));  // 除外カード
+  EXPECT_FALSE(unseen.test(card(14)));  // 自分のヘッドライン
+  EXPECT_TRUE(unseen.test(card(15)));   // 宇宙開発で優位でなければ見えない
+  EXPECT_FALSE(unseen.test(card(41)));  // ターン1ではMid Warは未投入
+  // Early Warの1〜40からCHINA_CARDと公開済みの4枚を除く
+  EXPECT_EQ(unseen.count(), 40U - 1U - 4U);
+}
+
+TEST_F(DeterminizationTest, UnseenIncludesLaterWarPeriodsByTurn) {
+  Board board(cardpool_);
+  for (int turn = 1; turn < 8; ++turn) {
+    board.getTurnTrack().nextTurn();
+  }
+
+  const auto unseen =
+      mcts::DeterminizationSampler::computeUnseen(board, Side::USA);
+
+  EXPECT_TRUE(unseen.test(card(41)));
+  EXPECT_TRUE(unseen.test(card(110)));
+  EXPECT_EQ(unseen.count(), 110U - 1U);  // CHINA_CARDのみ除外
+}
+
+TEST_F(DeterminizationTest, SamplePartitionsUnseenCards) {
+  Board board(cardpool_);
+  for (int i = 1; i <= 8; ++i) {
+    board.addCardToHand(Side::USA, card(20 + i));
+  }
+  board.addCardToHand(Side::USSR, card(1));
+  const mcts::DeterminizationSampler sampler(board, Side::USSR);
+  std::mt19937_64 rng(42);
+
+  std::vector<CardEnum> hand;
+  std::vector<CardEnum> deck;
+  for (int trial = 0; trial < 20; ++trial) {
+    sampler.sample(rng, hand, deck);
+    ASSERT_EQ(hand.size(), 8U);
+
+    mcts::CardSet seen;
+    for (const auto card : hand) {
+      EXPECT_FALSE(seen.test(card));
+      seen.set(card);
+    }
+    for (const auto card : deck) {
+      EXPECT_FALSE(seen.test(card));
+      seen.set(card);
+    }
+    EXPECT_EQ(seen, sampler.getUnseen());
+  }
+}
+
+TEST_F(DeterminizationTest, ConstraintsFixAndForbidHandCards) {
+  Board board(cardpool_);
+  for (int i = 1; i <= 3; ++i) {
+    board.addCardToHand(Side::USA, card(20 + i));
+  }
+  mcts::DeterminizationConstraints constraints;
+  constraints.opponent_must_hold.set(card(30));
+  constraints.opponent_cannot_hold.set(card(31));
+  constraints.opponent_cannot_hold.set(card(32));
+  const mcts::DeterminizationSampler sampler(board, Side::USSR, constraints);
+  std::mt19937_64 rng(7);
+
+  std::vector<CardEnum> hand;
+  std::vector<CardEnum> deck;
+  for (int trial = 0; trial < 200; ++trial) {
+    sampler.sample(rng, hand, deck);
+    ASSERT_EQ(hand.size(), 3U);
+    EXPECT_NE(std::find(hand.begin(), hand.end(), card(30)), hand.end());
+    EXPECT_EQ(std::find(hand.begin(), hand.end(), card(31)), hand.end());
+    EXPECT_EQ(std::find(hand.begin(), hand.end(), card(32)), hand.end());
+    EXPECT_NE(std::find(deck.begin(), deck.end(), card(31)), deck.end());
+  }
+}
+
+TEST_F(DeterminizationTest, WeightsBiasHandSelection) {
+  Board board(cardpool_);
+  board.addCardToHand(Side::USA, card(20));
+  mcts::DeterminizationConstraints constraints;
+  constraints.hand_weights.assign(mcts::CardSet::CAPACITY, 1.0);
+  constraints.hand_weights[25] = 1000.0;
+  constraints.hand_weights[26] = 0.0;
+  const mcts::DeterminizationSampler sampler(board, Side::USSR, constraints);
+  std::mt19937_64 rng(3);
+
+  std::vector<CardEnum> hand;
+  std::vector<CardEnum> deck;
+  int heavy = 0;
+  for (int trial = 0; trial < 500; ++trial) {
+    sampler.sample(rng, hand, deck);
+    ASSERT_EQ(hand.size(), 1U);
+    EXPECT_NE(hand[0], card(26));
+    heavy += hand[0] == card(25) ? 1 : 0;
+  }
+  EXPECT_GT(heavy, 400);
+}
+
+TEST_F(DeterminizationTest, ApplyRewritesOpponentHandAndDeck) {
+  Board board(cardpool_);
+  board.addCardToHand(Side::USA, card(2));
+  board.addCardToHand(Side::USA, card(3));
+  const mcts::DeterminizationSampler sampler(board, Side::USSR);
+
+  Board copy = board.copyForMCTS(Side::USSR);
+  std::mt19937_64 rng(11);
+  sampler.apply(copy, rng);
+
+  const auto& hand = copy.getPlayerHand(Side::USA);
+  ASSERT_EQ(hand.size(), 2U);
+  for (const auto card : hand) {
+    EXPECT_TRUE(sampler.getUnseen().test(card));
+  }
+  EXPECT_EQ(copy.getDeck().getDeck().size() + hand.size(),
+            sampler.getUnseen().count());
+}
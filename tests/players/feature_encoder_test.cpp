@@ -0,0 +1,191 @@
+// ファイル: tests/players/feature_encoder_test.cpp
+// 役割:
+// 特徴量レイアウトの各区画が盤面どおりに埋まり、視点の入れ替え・int8版・並列バッチ版が単体版と一致することを検証する。
+// 背景:
+// レイアウトは学習済みモデルとの契約なので、位置や符号がずれたら版を上げずに気付けるよう固定しておく。
+
+#include "tsge/players/feature_encoder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class EncoderCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  explicit EncoderCard(CardEnum id)
+      : Card(id, "Encoder", 2, Side::NEUTRAL, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+class FeatureEncoderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      cardpool_[static_cast<size_t>(i)] =
+          std::make_unique<EncoderCard>(static_cast<CardEnum>(i));
+    }
+  }
+
+  static float countryValue(const std::vector<float>& features, size_t plane,
+                            CountryEnum country) {
+    return features[FeatureEncoder::COUNTRY_OFFSET +
+                    (plane * FeatureEncoder::COUNTRY_COUNT) +
+                    static_cast<size_t>(country)];
+  }
+
+  static float trackValue(const std::vector<float>& features, size_t feature) {
+    return features[FeatureEncoder::TRACK_OFFSET + feature];
+  }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+std::vector<float> encodeFloat(const Board& board, Side viewer) {
+  std::vector<float> features(FeatureEncoder::SIZE, -1.0F);
+  FeatureEncoder::encode(board, viewer, features.data());
+  return features;
+}
+
+}  // namespace
+
+TEST_F(FeatureEncoderTest, CountryPlanesFollowViewer) {
+  Board board(cardpool_);
+  board.getWorldMap().getCountry(CountryEnum::NIGERIA).addInfluence(Side::USSR,
+                                                                    2);
+
+  const auto ussr = encodeFloat(board, Side::USSR);
+  const auto usa = encodeFloat(board, Side::USA);
+
+  EXPECT_EQ(countryValue(ussr, FeatureEncoder::OWN_INFLUENCE,
+                         CountryEnum::NIGERIA),
+            2.0F);
+  EXPECT_EQ(countryValue(ussr, FeatureEncoder::OWN_CONTROL,
+                         CountryEnum::NIGERIA),
+            1.0F);
+  EXPECT_EQ(countryValue(usa, FeatureEncoder::OPPONENT_INFLUENCE,
+                         CountryEnum::NIGERIA),
+            2.0F);
+  EXPECT_EQ(countryValue(usa, FeatureEncoder::OPPONENT_CONTROL,
+                         CountryEnum::NIGERIA),
+            1.0F);
+  EXPECT_EQ(countryValue(ussr, FeatureEncoder::STABILITY,
+                         CountryEnum::NIGERIA),
+            1.0F);
+  EXPECT_EQ(countryValue(ussr, FeatureEncoder::BATTLEGROUND,
+                         CountryEnum::NIGERIA),
+            1.0F);
+  const auto africa = static_cast<size_t>(Region::AFRICA);
+  const auto europe = static_cast<size_t>(Region::EUROPE);
+  EXPECT_EQ(countryValue(ussr, FeatureEncoder::REGION_FIRST + africa,
+                         CountryEnum::NIGERIA),
+            1.0F);
+  EXPECT_EQ(countryValue(ussr, FeatureEncoder::REGION_FIRST + europe,
+                         CountryEnum::NIGERIA),
+            0.0F);
+}
+
+TEST_F(FeatureEncoderTest, TracksAndHandAreViewerRelative) {
+  Board board(cardpool_);
+  board.changeVp(3);
+  board.getMilopsTrack().advanceMilopsTrack(Side::USA, 2);
+  board.getSpaceTrack().advanceSpaceTrack(Side::USSR, 1);
+  board.giveChinaCardTo(Side::USA, true);
+  board.addCardToHand(Side::USSR, static_cast<CardEnum>(20));
+  board.addCardToHand(Side::USSR, static_cast<CardEnum>(21));
+  board.addCardToHand(Side::USA, static_cast<CardEnum>(30));
+
+  const auto ussr = encodeFloat(board, Side::USSR);
+  const auto usa = encodeFloat(board, Side::USA);
+
+  EXPECT_EQ(trackValue(ussr, FeatureEncoder::VP), 3.0F);
+  EXPECT_EQ(trackValue(usa, FeatureEncoder::VP), -3.0F);
+  EXPECT_EQ(trackValue(usa, FeatureEncoder::OWN_MILOPS), 2.0F);
+  EXPECT_EQ(trackValue(ussr, FeatureEncoder::OPPONENT_MILOPS), 2.0F);
+  EXPECT_EQ(trackValue(ussr, FeatureEncoder::OWN_SPACE), 1.0F);
+  EXPECT_EQ(trackValue(ussr, FeatureEncoder::VIEWER_IS_USSR), 1.0F);
+  EXPECT_EQ(trackValue(usa, FeatureEncoder::VIEWER_IS_USSR), 0.0F);
+  EXPECT_EQ(trackValue(usa, FeatureEncoder::OWN_CHINA_CARD), 1.0F);
+  EXPECT_EQ(trackValue(ussr, FeatureEncoder::OPPONENT_CHINA_CARD), 1.0F);
+  EXPECT_EQ(trackValue(ussr, FeatureEncoder::OWN_HAND_SIZE), 2.0F);
+  EXPECT_EQ(trackValue(ussr, FeatureEncoder::OPPONENT_HAND_SIZE), 1.0F);
+
+  // 手札は視点プレイヤーのものだけが見える
+  EXPECT_EQ(ussr[FeatureEncoder::HAND_OFFSET + 20], 1.0F);
+  EXPECT_EQ(ussr[FeatureEncoder::HAND_OFFSET + 30], 0.0F);
+  EXPECT_EQ(usa[FeatureEncoder::HAND_OFFSET + 30], 1.0F);
+  EXPECT_EQ(usa[FeatureEncoder::HAND_OFFSET + 20], 0.0F);
+}
+
+TEST_F(FeatureEncoderTest, Int8MatchesFloatLayout) {
+  Board board(cardpool_);
+  board.changeVp(-5);
+  board.getWorldMap().getCountry(CountryEnum::IRAN).addInfluence(Side::USA, 3);
+  board.addCardToHand(Side::USA, static_cast<CardEnum>(40));
+
+  const auto floats = encodeFloat(board, Side::USA);
+  std::vector<int8_t> bytes(FeatureEncoder::SIZE, -1);
+  FeatureEncoder::encode(board, Side::USA, bytes.data());
+
+  for (size_t i = 0; i < FeatureEncoder::SIZE; ++i) {
+    EXPECT_EQ(static_cast<float>(bytes[i]), floats[i]) << "index " << i;
+  }
+}
+
+TEST_F(FeatureEncoderTest, ParallelBatchMatchesSingleEncode) {
+  std::vector<std::unique_ptr<Board>> storage;
+  std::vector<const Board*> boards;
+  std::vector<Side> viewers;
+  for (int i = 0; i < 7; ++i) {
+    auto board = std::make_unique<Board>(cardpool_);
+    board->changeVp(i);
+    board->getWorldMap()
+        .getCountry(static_cast<CountryEnum>(10 + i))
+        .addInfluence(Side::USSR, i + 1);
+    boards.push_back(board.get());
+    viewers.push_back(i % 2 == 0 ? Side::USSR : Side::USA);
+    storage.push_back(std::move(board));
+  }
+
+  std::vector<float> batch(boards.size() * FeatureEncoder::SIZE, -1.0F);
+  WorkStealingPool pool(2);
+  FeatureEncoder::encodeBatch(boards, viewers, batch.data(), &pool);
+
+  for (size_t i = 0; i < boards.size(); ++i) {
+    const auto single = encodeFloat(*boards[i], viewers[i]);
+    const std::vector<float> row(
+        batch.begin() + static_cast<std::ptrdiff_t>(i * FeatureEncoder::SIZE),
+        batch.begin() +
+            static_cast<std::ptrdiff_t>((i + 1) * FeatureEncoder::SIZE));
+    EXPECT_EQ(row, single) << "board " << i;
+  }
+}
+
+TEST_F(FeatureEncoderTest, RejectsNeutralViewer) {
+  const Board board(cardpool_);
+  std::vector<float> features(FeatureEncoder::SIZE);
+  EXPECT_THROW(FeatureEncoder::encode(board, Side::NEUTRAL, features.data()),
+               std::invalid_argument);
+
+  const std::array<const Board*, 1> boards{&board};
+  const std::array<Side, 2> viewers{Side::USSR, Side::USA};
+  WorkStealingPool pool(1);
+  EXPECT_THROW(
+      FeatureEncoder::encodeBatch(boards, viewers, features.data(), &pool),
+      std::invalid_argument);
+}
@@ -0,0 +1,149 @@
+// ファイル: tests/players/hand_belief_test.cpp
+// 役割:
+// 観測した相手の手に応じてカードごとの重みが期待どおりの向きに動き、周辺確率が手札枚数と整合することを検証する。
+// 背景:
+// 尤度比の掛け先を取り違えると決定化が逆方向に偏るため、代表的な観測ごとに振る舞いを固定する。
+
+#include "tsge/players/hand_belief.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class BeliefCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  BeliefCard(CardEnum id, int ops, Side side)
+      : Card(id, "Belief", ops, side, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+// 1〜3はスコアリングカード(Ops 0)、4以降はOps 1〜4を順に割り当てる。
+// 偶数番はUSA、奇数番はUSSRのイベントを持つ。
+class HandBeliefTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      const int ops = i <= 3 ? 0 : 1 + (i % 4);
+      const Side side = i % 2 == 0 ? Side::USA : Side::USSR;
+      cardpool_[static_cast<size_t>(i)] =
+          std::make_unique<BeliefCard>(static_cast<CardEnum>(i), ops, side);
+    }
+  }
+
+  static CardEnum card(int index) { return static_cast<CardEnum>(index); }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+}  // namespace
+
+TEST_F(HandBeliefTest, IgnoresViewerMoves) {
+  Board board(cardpool_);
+  mcts::OpponentHandBelief belief(Side::USSR);
+  const ActionEventMove move(card(8), Side::USSR, true);
+
+  belief.observe(board, move);
+
+  for (int i = 1; i < 111; ++i) {
+    EXPECT_DOUBLE_EQ(belief.getWeight(card(i)), 1.0);
+  }
+}
+
+TEST_F(HandBeliefTest, OpsPlayLowersHigherOpsCards) {
+  Board board(cardpool_);
+  mcts::OpponentHandBelief belief(Side::USSR);
+  // カード6はOps 3・USAイベント。USAがOpsで使っても相手へのイベント譲渡は無い。
+  const ActionPlaceInfluenceMove move(card(6), Side::USA,
+                                      {{CountryEnum::ITALY, 3}});
+
+  belief.observe(board, move);
+
+  EXPECT_FLOAT_EQ(belief.getWeight(card(10)), 1.0F);  // Ops 3(同じ)
+  EXPECT_FLOAT_EQ(belief.getWeight(card(5)), 1.0F);   // Ops 2(低い)
+  EXPECT_FLOAT_EQ(belief.getWeight(card(7)), 0.85F);  // Ops 4
+  // スコアリングカードは残り6ラウンド中で出さなかった分だけ下がる
+  EXPECT_FLOAT_EQ(belief.getWeight(card(2)), 5.0F / 6.0F);
+}
+
+TEST_F(HandBeliefTest, GivingAwayEventLowersOtherPlayable) {
+  Board board(cardpool_);
+  mcts::OpponentHandBelief belief(Side::USA);
+  // カード6はOps 3・USAイベント。USSRがOpsで使うと相手(USA)のイベントが起きる。
+  const ActionCoupMove move(card(6), Side::USSR, CountryEnum::ITALY);
+
+  belief.observe(board, move);
+
+  EXPECT_FLOAT_EQ(belief.getWeight(card(10)), 1.0F);  // Ops 3だがUSA側
+  EXPECT_FLOAT_EQ(belief.getWeight(card(7)), 0.85F * 0.8F);  // Ops 4・USSR側
+  EXPECT_FLOAT_EQ(belief.getWeight(card(5)), 1.0F);          // Ops 2
+}
+
+TEST_F(HandBeliefTest, HeadlineWithoutScoringLowersScoringCards) {
+  Board board(cardpool_);
+  mcts::OpponentHandBelief belief(Side::USSR);
+  const HeadlineCardSelectMove move(card(8), Side::USA);
+
+  belief.observe(board, move);
+
+  EXPECT_FLOAT_EQ(belief.getWeight(card(1)), 0.7F);
+  EXPECT_FLOAT_EQ(belief.getWeight(card(8)), 1.0F);
+}
+
+TEST_F(HandBeliefTest, TurnChangeRelaxesTowardUniform) {
+  Board board(cardpool_);
+  mcts::OpponentHandBelief belief(Side::USSR);
+  belief.observe(board, HeadlineCardSelectMove(card(8), Side::USA));
+  ASSERT_FLOAT_EQ(belief.getWeight(card(1)), 0.7F);
+
+  board.getTurnTrack().nextTurn();
+  belief.observe(board, HeadlineCardSelectMove(card(1), Side::USA));
+
+  EXPECT_FLOAT_EQ(belief.getWeight(card(2)), 1.0F - (0.3F * 0.25F));
+}
+
+TEST_F(HandBeliefTest, MarginalsSumToHandSize) {
+  Board board(cardpool_);
+  for (int i = 0; i < 5; ++i) {
+    board.addCardToHand(Side::USA, card(20 + i));
+  }
+  board.addCardToHand(Side::USSR, card(30));
+  mcts::OpponentHandBelief belief(Side::USSR);
+  belief.observe(board, ActionEventMove(card(7), Side::USA, true));
+
+  const auto marginals = belief.marginals(board);
+
+  EXPECT_NEAR(std::accumulate(marginals.begin(), marginals.end(), 0.0), 5.0,
+              1e-6);
+  EXPECT_DOUBLE_EQ(marginals[30], 0.0);  // 自分の手札
+  EXPECT_DOUBLE_EQ(marginals[6], 0.0);   // CHINA_CARD
+  EXPECT_LT(marginals[1], marginals[20]);
+}
+
+TEST_F(HandBeliefTest, ConstraintsCarryWeights) {
+  Board board(cardpool_);
+  mcts::OpponentHandBelief belief(Side::USSR);
+  belief.observe(board, HeadlineCardSelectMove(card(8), Side::USA));
+
+  const auto constraints = belief.toConstraints();
+
+  ASSERT_EQ(constraints.hand_weights.size(), mcts::CardSet::CAPACITY);
+  EXPECT_FLOAT_EQ(static_cast<float>(constraints.hand_weights[1]), 0.7F);
+  EXPECT_TRUE(constraints.opponent_must_hold.empty());
+}
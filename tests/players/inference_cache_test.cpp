@@ -0,0 +1,209 @@
+// ファイル: tests/players/inference_cache_test.cpp
+// 役割:
+// CachedInferenceEngineが観測状態と合法手列の組で結果を再利用し、容量を超えるとLRUで追い出すことを検証する。
+// 背景:
+// キャッシュキーに隠れ情報が混ざると決定化ごとにミスし、逆に足りないと別局面の結果を返すため、その両方を固定する。
+
+#include "tsge/players/inference_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class DummyCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  DummyCard(CardEnum id, WarPeriod war_period)
+      : Card(id, "Dummy", 2, Side::NEUTRAL, war_period, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+// CountingInference: 呼び出し回数を数え、valueに通し番号を入れて返す。
+class CountingInference final : public TsNnMctsInferenceEngine {
+ public:
+  TsNnMctsInferenceResult evaluate(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side /*side*/) override {
+    TsNnMctsInferenceResult result;
+    result.policy.assign(legal_moves.size(), 1.0);
+    result.value = static_cast<double>(++calls_);
+    return result;
+  }
+
+  std::vector<TsNnMctsInferenceResult> evaluateBatch(
+      std::span<const Board* const> boards,
+      std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+      std::span<const Side> sides) override {
+    batch_sizes_.push_back(boards.size());
+    return TsNnMctsInferenceEngine::evaluateBatch(boards, legal_moves, sides);
+  }
+
+  [[nodiscard]] int getCalls() const { return calls_; }
+  [[nodiscard]] const std::vector<size_t>& getBatchSizes() const {
+    return batch_sizes_;
+  }
+
+ private:
+  int calls_ = 0;
+  std::vector<size_t> batch_sizes_;
+};
+
+class InferenceCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      cardpool_[static_cast<size_t>(i)] = std::make_unique<DummyCard>(
+          static_cast<CardEnum>(i), WarPeriod::EARLY_WAR);
+    }
+  }
+
+  static std::vector<std::shared_ptr<Move>> makeMoves(
+      std::initializer_list<CardEnum> cards) {
+    std::vector<std::shared_ptr<Move>> moves;
+    for (const auto card : cards) {
+      moves.push_back(
+          std::make_shared<ActionEventMove>(card, Side::USSR, false));
+    }
+    return moves;
+  }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+}  // namespace
+
+TEST_F(InferenceCacheTest, RepeatedPositionHitsCache) {
+  auto inner = std::make_shared<CountingInference>();
+  CachedInferenceEngine cache(inner);
+  Board board(cardpool_);
+  const auto moves = makeMoves({CardEnum::FIDEL, CardEnum::DUCK_AND_COVER});
+
+  const auto first = cache.evaluate(board, moves, Side::USSR);
+  const auto second = cache.evaluate(board, moves, Side::USSR);
+
+  EXPECT_EQ(inner->getCalls(), 1);
+  EXPECT_DOUBLE_EQ(second.value, first.value);
+  EXPECT_EQ(second.policy, first.policy);
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.size, 1U);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+}
+
+// 相手の手札だけが違う決定化は同じ観測状態として扱う。
+TEST_F(InferenceCacheTest, DeterminizationsShareObservableEntry) {
+  auto inner = std::make_shared<CountingInference>();
+  CachedInferenceEngine cache(inner);
+  const auto moves = makeMoves({CardEnum::FIDEL});
+
+  Board first(cardpool_);
+  first.addCardToHand(Side::USA, CardEnum::NUCLEAR_TEST_BAN);
+  Board second(cardpool_);
+  second.addCardToHand(Side::USA, CardEnum::DUCK_AND_COVER);
+
+  (void)cache.evaluate(first, moves, Side::USSR);
+  (void)cache.evaluate(second, moves, Side::USSR);
+  EXPECT_EQ(inner->getCalls(), 1);
+
+  // 相手側から見ると手札の中身が違うので別の局面になる。
+  (void)cache.evaluate(first, moves, Side::USA);
+  (void)cache.evaluate(second, moves, Side::USA);
+  EXPECT_EQ(inner->getCalls(), 3);
+}
+
+TEST_F(InferenceCacheTest, LegalMoveOrderIsPartOfKey) {
+  auto inner = std::make_shared<CountingInference>();
+  CachedInferenceEngine cache(inner);
+  Board board(cardpool_);
+
+  const auto forward = makeMoves({CardEnum::FIDEL, CardEnum::DUCK_AND_COVER});
+  const auto reversed = makeMoves({CardEnum::DUCK_AND_COVER, CardEnum::FIDEL});
+  (void)cache.evaluate(board, forward, Side::USSR);
+  (void)cache.evaluate(board, reversed, Side::USSR);
+
+  EXPECT_EQ(inner->getCalls(), 2);
+  EXPECT_NE(hashLegalMoves(makeMoves({CardEnum::FIDEL})),
+            hashLegalMoves(makeMoves({CardEnum::DUCK_AND_COVER})));
+}
+
+TEST_F(InferenceCacheTest, EvictsLeastRecentlyUsedEntry) {
+  auto inner = std::make_shared<CountingInference>();
+  InferenceCacheConfig config;
+  config.capacity = 2;
+  config.num_shards = 1;
+  CachedInferenceEngine cache(inner, config);
+  Board board(cardpool_);
+  const auto a = makeMoves({CardEnum::FIDEL});
+  const auto b = makeMoves({CardEnum::DUCK_AND_COVER});
+  const auto c = makeMoves({CardEnum::NUCLEAR_TEST_BAN});
+
+  (void)cache.evaluate(board, a, Side::USSR);
+  (void)cache.evaluate(board, b, Side::USSR);
+  (void)cache.evaluate(board, a, Side::USSR);  // aを最近使った側へ
+  (void)cache.evaluate(board, c, Side::USSR);  // bが追い出される
+  EXPECT_EQ(inner->getCalls(), 3);
+
+  (void)cache.evaluate(board, a, Side::USSR);
+  EXPECT_EQ(inner->getCalls(), 3);
+  (void)cache.evaluate(board, b, Side::USSR);
+  EXPECT_EQ(inner->getCalls(), 4);
+
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.evictions, 2U);
+  EXPECT_EQ(stats.size, 2U);
+}
+
+TEST_F(InferenceCacheTest, BatchEvaluatesOnlyDistinctMisses) {
+  auto inner = std::make_shared<CountingInference>();
+  CachedInferenceEngine cache(inner);
+  Board board(cardpool_);
+  const auto a = makeMoves({CardEnum::FIDEL});
+  const auto b = makeMoves({CardEnum::DUCK_AND_COVER});
+  (void)cache.evaluate(board, a, Side::USSR);
+
+  const std::vector<const Board*> boards(4, &board);
+  const std::vector<const std::vector<std::shared_ptr<Move>>*> moves = {
+      &a, &b, &b, &a};
+  const std::vector<Side> sides(4, Side::USSR);
+  const auto results = cache.evaluateBatch(boards, moves, sides);
+
+  ASSERT_EQ(results.size(), 4U);
+  EXPECT_EQ(inner->getBatchSizes(), std::vector<size_t>{1});
+  EXPECT_DOUBLE_EQ(results[0].value, 1.0);
+  EXPECT_DOUBLE_EQ(results[1].value, 2.0);
+  EXPECT_DOUBLE_EQ(results[2].value, 2.0);
+  EXPECT_DOUBLE_EQ(results[3].value, 1.0);
+  EXPECT_EQ(cache.getStats().misses, 2U);
+  EXPECT_EQ(cache.getStats().hits, 3U);
+}
+
+TEST_F(InferenceCacheTest, ClearDropsEntries) {
+  auto inner = std::make_shared<CountingInference>();
+  CachedInferenceEngine cache(inner);
+  Board board(cardpool_);
+  const auto moves = makeMoves({CardEnum::FIDEL});
+
+  (void)cache.evaluate(board, moves, Side::USSR);
+  cache.clear();
+  (void)cache.evaluate(board, moves, Side::USSR);
+
+  EXPECT_EQ(inner->getCalls(), 2);
+  EXPECT_EQ(cache.getStats().size, 1U);
+}
@@ -0,0 +1,346 @@
+// ファイル: tests/players/inference_server_test.cpp
+// 役割:
+// InferenceServerが複数スレッドの要求をバッチへまとめ、各要求へ正しい結果を返すことを検証する。
+// 背景:
+// 対局スレッドをまたいだ動的バッチは取り違えや取りこぼしが起きやすいため、結果の対応と計測値を回帰として固定する。
+
+#include "tsge/players/inference_server.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class DummyCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  DummyCard(CardEnum id, WarPeriod war_period)
+      : Card(id, "Dummy", 2, Side::NEUTRAL, war_period, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+// CountingInference: policyを合法手数、valueを手番から決めて返し、バッチサイズを記録する。
+class CountingInference final : public TsNnMctsInferenceEngine {
+ public:
+  TsNnMctsInferenceResult evaluate(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) override {
+    TsNnMctsInferenceResult result;
+    result.policy.assign(legal_moves.size(),
+                         1.0 / static_cast<double>(legal_moves.size()));
+    result.value = side == Side::USSR ? 0.25 : -0.25;
+    return result;
+  }
+
+  std::vector<TsNnMctsInferenceResult> evaluateBatch(
+      std::span<const Board* const> boards,
+      std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+      std::span<const Side> sides) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batch_sizes_.push_back(boards.size());
+    }
+    return TsNnMctsInferenceEngine::evaluateBatch(boards, legal_moves, sides);
+  }
+
+  [[nodiscard]] std::vector<size_t> getBatchSizes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batch_sizes_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<size_t> batch_sizes_;
+};
+
+// ThrowingInference: USAの手番を含むバッチでは例外を投げ、USSRだけなら一様な結果を返す。
+class ThrowingInference final : public TsNnMctsInferenceEngine {
+ public:
+  TsNnMctsInferenceResult evaluate(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side side) override {
+    if (side == Side::USA) {
+      throw std::runtime_error("backend failed");
+    }
+    TsNnMctsInferenceResult result;
+    result.policy.assign(legal_moves.size(), 1.0);
+    return result;
+  }
+};
+
+class InferenceServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      cardpool_[static_cast<size_t>(i)] = std::make_unique<DummyCard>(
+          static_cast<CardEnum>(i), WarPeriod::EARLY_WAR);
+    }
+  }
+
+  static std::vector<std::shared_ptr<Move>> makePassMoves(size_t count,
+                                                          Side side) {
+    std::vector<std::shared_ptr<Move>> moves;
+    for (size_t i = 0; i < count; ++i) {
+      moves.push_back(std::make_shared<PassMove>(side));
+    }
+    return moves;
+  }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+}  // namespace
+
+TEST_F(InferenceServerTest, ConcurrentClientsReceiveTheirOwnResults) {
+  constexpr int THREADS = 8;
+  constexpr int REQUESTS_PER_THREAD = 50;
+
+  auto backend = std::make_shared<CountingInference>();
+  InferenceServerConfig config;
+  config.num_evaluators = 2;
+  config.max_batch_size = 16;
+  auto server = std::make_shared<InferenceServer>(backend, config);
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(THREADS, 0);
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      InferenceServerClient client(server);
+      Board board(cardpool_);
+      const Side side = t % 2 == 0 ? Side::USSR : Side::USA;
+      const auto moves = makePassMoves(static_cast<size_t>(t + 1), side);
+      for (int i = 0; i < REQUESTS_PER_THREAD; ++i) {
+        auto result = client.evaluate(board, moves, side);
+        const double expected_value = side == Side::USSR ? 0.25 : -0.25;
+        if (result.policy.size() != moves.size() ||
+            result.value != expected_value) {
+          ++failures[static_cast<size_t>(t)];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int t = 0; t < THREADS; ++t) {
+    EXPECT_EQ(failures[static_cast<size_t>(t)], 0) << "thread " << t;
+  }
+  const auto metrics = server->getMetrics();
+  EXPECT_EQ(metrics.requests,
+            static_cast<uint64_t>(THREADS * REQUESTS_PER_THREAD));
+  EXPECT_GE(metrics.batches, 1U);
+  EXPECT_LE(metrics.batches, metrics.requests);
+  EXPECT_GT(metrics.batch_fill_rate, 0.0);
+  EXPECT_LE(metrics.batch_fill_rate, 1.0);
+  EXPECT_LE(metrics.mean_queue_latency, metrics.max_queue_latency);
+
+  size_t evaluated = 0;
+  for (size_t size : backend->getBatchSizes()) {
+    EXPECT_LE(size, config.max_batch_size);
+    evaluated += size;
+  }
+  EXPECT_EQ(evaluated, metrics.requests);
+}
+
+// 小さなバッチを大量に投げると、最後の結果を返すコールバックと待ち側の復帰が
+// 頻繁に競合する。ThreadSanitizer(ENABLE_TSAN)の下で、待ち側が戻った後に
+// 完了状態へ触れないことを確かめる。
+TEST_F(InferenceServerTest, ManySmallClientBatchesCompleteWithoutRaces) {
+  constexpr int THREADS = 8;
+  constexpr int BATCHES_PER_THREAD = 300;
+
+  auto backend = std::make_shared<CountingInference>();
+  InferenceServerConfig config;
+  config.num_evaluators = 4;
+  config.max_batch_size = 2;
+  config.batch_timeout = std::chrono::microseconds(0);
+  auto server = std::make_shared<InferenceServer>(backend, config);
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(THREADS, 0);
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      InferenceServerClient client(server);
+      Board board(cardpool_);
+      const auto ussr_moves = makePassMoves(2, Side::USSR);
+      const auto usa_moves = makePassMoves(3, Side::USA);
+      for (int i = 0; i < BATCHES_PER_THREAD; ++i) {
+        const size_t size = static_cast<size_t>(1 + (i + t) % 3);
+        std::vector<const Board*> boards(size, &board);
+        std::vector<const std::vector<std::shared_ptr<Move>>*> moves;
+        std::vector<Side> sides;
+        for (size_t j = 0; j < size; ++j) {
+          const bool ussr = j % 2 == 0;
+          moves.push_back(ussr ? &ussr_moves : &usa_moves);
+          sides.push_back(ussr ? Side::USSR : Side::USA);
+        }
+        auto results = client.evaluateBatch(boards, moves, sides);
+        for (size_t j = 0; j < size; ++j) {
+          if (results[j].policy.size() != moves[j]->size()) {
+            ++failures[static_cast<size_t>(t)];
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int t = 0; t < THREADS; ++t) {
+    EXPECT_EQ(failures[static_cast<size_t>(t)], 0) << "thread " << t;
+  }
+  EXPECT_EQ(server->getMetrics().requests,
+            static_cast<uint64_t>(THREADS * BATCHES_PER_THREAD * 2));
+}
+
+// 締め切りを長くすると、同時に投入された別スレッドの要求が1つのバッチにまとまる。
+TEST_F(InferenceServerTest, GathersRequestsFromDifferentThreadsIntoOneBatch) {
+  constexpr int THREADS = 4;
+
+  auto backend = std::make_shared<CountingInference>();
+  InferenceServerConfig config;
+  config.max_batch_size = THREADS;
+  config.batch_timeout = std::chrono::seconds(5);
+  auto server = std::make_shared<InferenceServer>(backend, config);
+
+  std::latch start(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&] {
+      InferenceServerClient client(server);
+      Board board(cardpool_);
+      const auto moves = makePassMoves(2, Side::USSR);
+      start.arrive_and_wait();
+      auto result = client.evaluate(board, moves, Side::USSR);
+      EXPECT_EQ(result.policy.size(), 2U);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(backend->getBatchSizes(), std::vector<size_t>{THREADS});
+  const auto metrics = server->getMetrics();
+  EXPECT_EQ(metrics.batches, 1U);
+  EXPECT_DOUBLE_EQ(metrics.batch_fill_rate, 1.0);
+}
+
+TEST_F(InferenceServerTest, ClientBatchIsSplitByServerLimit) {
+  auto backend = std::make_shared<CountingInference>();
+  InferenceServerConfig config;
+  config.max_batch_size = 3;
+  config.batch_timeout = std::chrono::microseconds(0);
+  auto server = std::make_shared<InferenceServer>(backend, config);
+  InferenceServerClient client(server);
+
+  Board board(cardpool_);
+  const auto ussr_moves = makePassMoves(3, Side::USSR);
+  const auto usa_moves = makePassMoves(5, Side::USA);
+  std::vector<const Board*> boards(7, &board);
+  std::vector<const std::vector<std::shared_ptr<Move>>*> moves;
+  std::vector<Side> sides;
+  for (int i = 0; i < 7; ++i) {
+    const bool ussr = i % 2 == 0;
+    moves.push_back(ussr ? &ussr_moves : &usa_moves);
+    sides.push_back(ussr ? Side::USSR : Side::USA);
+  }
+
+  auto results = client.evaluateBatch(boards, moves, sides);
+
+  ASSERT_EQ(results.size(), 7U);
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].policy.size(), moves[i]->size());
+    EXPECT_DOUBLE_EQ(results[i].value, sides[i] == Side::USSR ? 0.25 : -0.25);
+  }
+  for (size_t size : backend->getBatchSizes()) {
+    EXPECT_LE(size, 3U);
+  }
+}
+
+TEST_F(InferenceServerTest, PolicyRunsThroughServerClient) {
+  auto backend = std::make_shared<CountingInference>();
+  auto server = std::make_shared<InferenceServer>(backend);
+  TsNnMctsConfig config;
+  config.num_simulations = 0;
+  config.add_dirichlet_noise = false;
+  TsNnMctsPolicy policy(std::make_shared<InferenceServerClient>(server),
+                        config);
+
+  Board board(cardpool_);
+  const auto moves = makePassMoves(3, Side::USSR);
+  auto selected = policy.decideMove(board, moves, Side::USSR);
+
+  EXPECT_NE(selected, nullptr);
+  EXPECT_EQ(server->getMetrics().requests, 1U);
+}
+
+// 推論器の例外は評価スレッドを止めず、要求した側のevaluateBatchから投げ直される。
+TEST_F(InferenceServerTest, BackendErrorsReachTheCaller) {
+  InferenceServerConfig config;
+  config.batch_timeout = std::chrono::microseconds(0);
+  auto server = std::make_shared<InferenceServer>(
+      std::make_shared<ThrowingInference>(), config);
+  InferenceServerClient client(server);
+
+  Board board(cardpool_);
+  const auto usa_moves = makePassMoves(2, Side::USA);
+  const auto ussr_moves = makePassMoves(3, Side::USSR);
+  EXPECT_THROW(static_cast<void>(client.evaluate(board, usa_moves, Side::USA)),
+               std::runtime_error);
+
+  // 評価スレッドは生きていて、次の要求は通常どおり評価される
+  const auto result = client.evaluate(board, ussr_moves, Side::USSR);
+  EXPECT_EQ(result.policy.size(), ussr_moves.size());
+}
+
+// 満杯でないバッチは締め切りまで眠って待ち、その間CPUを使い続けない。
+TEST_F(InferenceServerTest, PartialBatchSleepsUntilDeadline) {
+  auto backend = std::make_shared<CountingInference>();
+  InferenceServerConfig config;
+  config.max_batch_size = 8;
+  config.batch_timeout = std::chrono::milliseconds(200);
+  auto server = std::make_shared<InferenceServer>(backend, config);
+  InferenceServerClient client(server);
+  Board board(cardpool_);
+  const auto moves = makePassMoves(2, Side::USSR);
+
+  const std::clock_t cpu_start = std::clock();
+  const auto wall_start = std::chrono::steady_clock::now();
+  static_cast<void>(client.evaluate(board, moves, Side::USSR));
+  const auto wall = std::chrono::steady_clock::now() - wall_start;
+  const double cpu_seconds =
+      static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+  EXPECT_GE(wall, config.batch_timeout);
+  // 回り続ければ締め切りまでの200ミリ秒をほぼ丸ごと使う
+  EXPECT_LT(cpu_seconds, 0.1);
+}
+
+TEST(InferenceServerConstructionTest, RejectsNullBackend) {
+  EXPECT_THROW(InferenceServer(nullptr), std::invalid_argument);
+  EXPECT_THROW(InferenceServerClient(nullptr), std::invalid_argument);
+}
@@ -0,0 +1,162 @@
+// ファイル: tests/players/match_runner_test.cpp
+// 役割:
+// 対局ランナーが陣営ごとのポリシーで終局まで指し、並列実行でも対局の結果が通し番号だけで決まり、集計が1局ごとの結果と一致することを検証する。
+// 背景:
+// 自己対戦の結果でポリシーを比べるため、スレッド数を変えると結果が変わる・集計が合わないといったずれを防ぐ。
+
+#include "tsge/players/match_runner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+#include "tsge/players/rollout_policy.hpp"
+
+namespace {
+
+class RunnerCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  RunnerCard(CardEnum id, int ops, Side side)
+      : Card(id, "Runner", ops, side, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+const std::array<std::unique_ptr<Card>, 111>& runnerCardpool() {
+  static const auto cardpool = [] {
+    std::array<std::unique_ptr<Card>, 111> pool{};
+    constexpr std::array<Side, 3> SIDES{Side::USSR, Side::USA, Side::NEUTRAL};
+    for (int i = 0; i < 111; ++i) {
+      const auto id = static_cast<CardEnum>(i);
+      const int ops = mcts::scoringRegion(id) ? 0 : 1 + (i % 2);
+      pool[static_cast<size_t>(i)] = std::make_unique<RunnerCard>(
+          id, ops, SIDES[static_cast<size_t>(i % 3)]);
+    }
+    return pool;
+  }();
+  return cardpool;
+}
+
+// 先頭の合法手を指し、自分の手番と観測した手の数を数える
+class FirstMovePolicy final : public MatchPolicy {
+ public:
+  FirstMovePolicy(size_t& decided, size_t& observed)
+      : decided_{decided}, observed_{observed} {}
+
+  std::shared_ptr<Move> decideMove(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side /*side*/) override {
+    ++decided_;
+    return legal_moves.front();
+  }
+
+  void observeMove(const Board& /*board*/, const Move& /*move*/) override {
+    ++observed_;
+  }
+
+ private:
+  size_t& decided_;
+  size_t& observed_;
+};
+
+}  // namespace
+
+TEST(MatchRunnerTest, PlayMatchConsultsBothSidesAndObservesEveryMove) {
+  std::array<size_t, 2> decided{};
+  std::array<size_t, 2> observed{};
+  const std::array<MatchPolicyFactory, 2> policies{
+      [&](uint64_t /*seed*/) {
+        return std::make_unique<FirstMovePolicy>(decided[0], observed[0]);
+      },
+      [&](uint64_t /*seed*/) {
+        return std::make_unique<FirstMovePolicy>(decided[1], observed[1]);
+      }};
+
+  const auto result = playMatch(runnerCardpool(), policies, 7, 400);
+
+  EXPECT_EQ(result.seed, 7U);
+  EXPECT_GT(decided[0], 0U);
+  EXPECT_GT(decided[1], 0U);
+  EXPECT_EQ(decided[0] + decided[1], result.moves);
+  EXPECT_EQ(observed[0], result.moves);
+  EXPECT_EQ(observed[1], result.moves);
+  EXPECT_GE(result.turns, 1);
+}
+
+TEST(MatchRunnerTest, ResultsDependOnlyOnGameIndex) {
+  MatchConfig config;
+  config.games = 6;
+  config.seed = 11;
+  config.max_steps = 300;
+  config.policies = {makeMatchPolicy("random"), makeMatchPolicy("heuristic")};
+
+  auto collect = [&](size_t threads) {
+    config.threads = threads;
+    std::map<size_t, MatchResult> results;
+    std::mutex mutex;
+    const auto summary =
+        runMatches(runnerCardpool(), config, [&](const MatchResult& result) {
+          const std::lock_guard lock(mutex);
+          EXPECT_TRUE(results.emplace(result.game_index, result).second);
+        });
+    EXPECT_EQ(summary.games, config.games);
+    size_t moves = 0;
+    size_t outcomes = 0;
+    for (const auto& [index, result] : results) {
+      moves += result.moves;
+      EXPECT_EQ(result.seed, matchSeed(config.seed, index));
+    }
+    for (const size_t count : summary.outcomes) {
+      outcomes += count;
+    }
+    EXPECT_EQ(summary.moves, moves);
+    EXPECT_EQ(outcomes, config.games);
+    EXPECT_GT(summary.movesPerSecond(), 0.0);
+    return results;
+  };
+
+  const auto serial = collect(1);
+  const auto parallel = collect(3);
+  ASSERT_EQ(serial.size(), config.games);
+  ASSERT_EQ(parallel.size(), config.games);
+  for (const auto& [index, result] : serial) {
+    const auto& other = parallel.at(index);
+    EXPECT_EQ(result.winner, other.winner) << "game " << index;
+    EXPECT_EQ(result.final_vp, other.final_vp) << "game " << index;
+    EXPECT_EQ(result.moves, other.moves) << "game " << index;
+  }
+  EXPECT_NE(matchSeed(config.seed, 0), matchSeed(config.seed, 1));
+}
+
+TEST(MatchRunnerTest, RejectsInvalidConfiguration) {
+  EXPECT_NO_THROW(static_cast<void>(makeMatchPolicy("mcts")));
+  EXPECT_NO_THROW(static_cast<void>(makeMatchPolicy("mcts:50")));
+  EXPECT_THROW(static_cast<void>(makeMatchPolicy("mcts:0")),
+               std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(makeMatchPolicy("mcts:x")),
+               std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(makeMatchPolicy("alphabeta")),
+               std::invalid_argument);
+
+  MatchConfig config;
+  config.policies = {makeMatchPolicy("random"), nullptr};
+  EXPECT_THROW(runMatches(runnerCardpool(), config), std::invalid_argument);
+  config.policies[1] = makeMatchPolicy("random");
+  config.games = 0;
+  EXPECT_THROW(runMatches(runnerCardpool(), config), std::invalid_argument);
+}
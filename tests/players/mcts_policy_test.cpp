@@ -0,0 +1,294 @@
+// ファイル: tests/players/mcts_policy_test.cpp
+// 役割:
+// mcts::Nodeの段階的展開(Progressive Widening)が訪問回数に応じて子を実体化することと、
+// SO-ISMCTSが決定化をまたいで1本の木を共有することを検証する。
+// 背景:
+// 数千手ある配置ノードで全子の盤面を先に作らないことと、決定化ごとに木を複製しないことを回帰として保証するため。
+
+#include "tsge/players/mcts_policy.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "tsge/core/board.hpp"
+#include "tsge/core/phase_machine.hpp"
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class DummyCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  DummyCard(CardEnum id, WarPeriod war_period)
+      : Card(id, "Dummy", 2, Side::NEUTRAL, war_period, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+class MctsNodeTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      cardpool_[static_cast<size_t>(i)] = std::make_unique<DummyCard>(
+          static_cast<CardEnum>(i), WarPeriod::EARLY_WAR);
+    }
+  }
+
+  std::unique_ptr<mcts::Node> makeExpandedRoot(size_t move_count) {
+    Board board(cardpool_);
+    auto root = std::make_unique<mcts::Node>(std::move(board), nullptr,
+                                             Side::USSR,
+                                             mcts::DeterminizedState{{}, 0});
+    std::vector<std::shared_ptr<Move>> moves;
+    for (size_t i = 0; i < move_count; ++i) {
+      moves.push_back(std::make_shared<PassMove>(Side::USSR));
+    }
+    root->expand(moves);
+    return root;
+  }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+enum class ScriptedOutcome : uint8_t { USSR_WIN, USA_WIN, DRAW, USA_REPLY };
+
+// ScriptedMove: 適用するとoutcomeに応じて終局状態か相手のRequestを積む合成Move。
+// USA_REPLYではUSAの手札1枚ごとに応手(勝ち)を1つ用意するため、応手の集合が決定化に依存する。
+class ScriptedMove final : public Move {
+ public:
+  ScriptedMove(Side side, int id, ScriptedOutcome outcome)
+      : Move{CardEnum::DUMMY, side}, id_{id}, outcome_{outcome} {}
+
+  [[nodiscard]] std::vector<CommandPtr> toCommand(
+      const std::unique_ptr<Card>& /*card*/,
+      const Board& /*board*/) const override {
+    const auto outcome = outcome_;
+    return {std::make_shared<LambdaCommand>([outcome](Board& board) {
+      switch (outcome) {
+        case ScriptedOutcome::USSR_WIN:
+          board.pushState(StateType::USSR_WIN_END);
+          break;
+        case ScriptedOutcome::USA_WIN:
+          board.pushState(StateType::USA_WIN_END);
+          break;
+        case ScriptedOutcome::DRAW:
+          board.pushState(StateType::DRAW_END);
+          break;
+        case ScriptedOutcome::USA_REPLY:
+          board.pushState(std::make_shared<RequestCommand>(
+              Side::USA, [](const Board& current) {
+                std::vector<std::shared_ptr<Move>> replies;
+                for (const auto card : current.getPlayerHand(Side::USA)) {
+                  replies.push_back(std::make_shared<ScriptedMove>(
+                      Side::USA, 100 + static_cast<int>(card),
+                      ScriptedOutcome::USA_WIN));
+                }
+                return replies;
+              }));
+          break;
+      }
+    })};
+  }
+
+  [[nodiscard]] bool operator==(const Move& other) const override {
+    const auto* other_cast = dynamic_cast<const ScriptedMove*>(&other);
+    return other_cast != nullptr && other_cast->getSide() == getSide() &&
+           other_cast->id_ == id_;
+  }
+
+  [[nodiscard]] uint64_t getKey() const override {
+    return combineMoveKey(Move::getKey(), static_cast<uint64_t>(id_));
+  }
+
+  [[nodiscard]] int getId() const { return id_; }
+
+ private:
+  int id_;
+  ScriptedOutcome outcome_;
+};
+
+// 呼ばれた回数を数え、常に同じ値を返す評価関数
+class CountingEvaluator final : public mcts::BoardEvaluator {
+ public:
+  [[nodiscard]] double evaluate(const Board& /*board*/,
+                                Side side) const override {
+    calls_.fetch_add(1);
+    return side == Side::USSR ? 0.25 : -0.25;
+  }
+
+  [[nodiscard]] int getCalls() const { return calls_.load(); }
+
+ private:
+  mutable std::atomic<int> calls_{0};
+};
+
+class InformationSetSearchTest : public MctsNodeTest {
+ protected:
+  // ルートでUSSRが選ぶ3手: USAの応手待ち(USAは必ず勝てる) / 即勝ち / 引き分け。
+  // USAの手札2枚と山札6枚がUSSRから見えない。
+  Board makeRootBoard() {
+    Board board(cardpool_);
+    board.addCardToHand(Side::USA, static_cast<CardEnum>(1));
+    board.addCardToHand(Side::USA, static_cast<CardEnum>(2));
+    for (int card = 3; card <= 8; ++card) {
+      board.getDeck().getDeck().push_back(static_cast<CardEnum>(card));
+    }
+    board.pushState(std::make_shared<RequestCommand>(
+        Side::USSR, [](const Board& /*board*/) {
+          return std::vector<std::shared_ptr<Move>>{
+              std::make_shared<ScriptedMove>(Side::USSR, 0,
+                                             ScriptedOutcome::USA_REPLY),
+              std::make_shared<ScriptedMove>(Side::USSR, 1,
+                                             ScriptedOutcome::USSR_WIN),
+              std::make_shared<ScriptedMove>(Side::USSR, 2,
+                                             ScriptedOutcome::DRAW)};
+        }));
+    return board;
+  }
+};
+
+}  // namespace
+
+TEST(ProgressiveWideningTest, LimitGrowsWithVisitsAndIsClamped) {
+  mcts::ProgressiveWideningConfig config;
+  config.k = 2.0;
+  config.alpha = 0.5;
+
+  EXPECT_EQ(mcts::progressiveWideningLimit(0, 1000, config), 2U);
+  EXPECT_EQ(mcts::progressiveWideningLimit(100, 1000, config), 20U);
+  EXPECT_EQ(mcts::progressiveWideningLimit(101, 1000, config), 21U);
+  EXPECT_EQ(mcts::progressiveWideningLimit(1000000, 1000, config), 1000U);
+  EXPECT_EQ(mcts::progressiveWideningLimit(10, 0, config), 0U);
+
+  config.k = 0.1;
+  EXPECT_EQ(mcts::progressiveWideningLimit(1, 1000, config), 1U);
+}
+
+TEST_F(MctsNodeTest, ExpandDoesNotMaterializeChildren) {
+  auto root = makeExpandedRoot(500);
+
+  EXPECT_TRUE(root->isExpanded());
+  EXPECT_EQ(root->getCandidateCount(), 500U);
+  EXPECT_TRUE(root->getChildren().empty());
+}
+
+TEST_F(MctsNodeTest, WideningLimitsMaterializedChildren) {
+  auto root = makeExpandedRoot(500);
+  mcts::ProgressiveWideningConfig widening;
+  widening.k = 1.0;
+  widening.alpha = 0.5;
+
+  for (int i = 0; i < 100; ++i) {
+    auto* child = root->selectBestChild(1.4, widening);
+    ASSERT_NE(child, nullptr);
+    child->backpropagate(0.5);
+  }
+
+  // 最後の選択時点の訪問回数99に対する上限ceil(sqrt(99)) = 10まで実体化される。
+  EXPECT_EQ(root->getVisits(), 100);
+  EXPECT_EQ(root->getChildren().size(), 10U);
+  for (const auto& child : root->getChildren()) {
+    EXPECT_GT(child->getVisits(), 0);
+  }
+}
+
+TEST_F(MctsNodeTest, DisabledWideningVisitsEveryCandidateFirst) {
+  auto root = makeExpandedRoot(20);
+  mcts::ProgressiveWideningConfig widening;
+  widening.enabled = false;
+
+  for (int i = 0; i < 20; ++i) {
+    auto* child = root->selectBestChild(1.4, widening);
+    ASSERT_NE(child, nullptr);
+    EXPECT_EQ(child->getVisits(), 0);
+    child->backpropagate(0.0);
+  }
+  EXPECT_EQ(root->getChildren().size(), 20U);
+}
+
+TEST_F(InformationSetSearchTest, SingleObserverFindsImmediateWin) {
+  const Board board = makeRootBoard();
+  mcts::MCTSExecutor executor(std::sqrt(2.0), 4, {},
+                              mcts::SearchMode::SINGLE_OBSERVER);
+
+  auto best = executor.search(board, Side::USSR, 400,
+                              std::chrono::milliseconds(10000));
+
+  ASSERT_NE(best, nullptr);
+  const auto* scripted = dynamic_cast<const ScriptedMove*>(best.get());
+  ASSERT_NE(scripted, nullptr);
+  EXPECT_EQ(scripted->getId(), 1);
+}
+
+// 1本の木に全決定化の統計が集まり、ノード数は反復回数で抑えられる。
+TEST_F(InformationSetSearchTest, TreeIsSharedAcrossDeterminizations) {
+  const Board board = makeRootBoard();
+  // 負け筋の応手ノードにも十分訪問させるため探索項を大きくする。
+  mcts::MCTSExecutor executor(5.0, 1, {}, mcts::SearchMode::SINGLE_OBSERVER);
+
+  constexpr int ITERATIONS = 400;
+  auto root = executor.buildInformationSetTree(
+      board, Side::USSR, ITERATIONS, std::chrono::milliseconds(10000));
+
+  EXPECT_EQ(root->getVisits(), ITERATIONS);
+  EXPECT_LE(root->countNodes(), static_cast<size_t>(ITERATIONS) + 1);
+  ASSERT_EQ(root->getChildren().size(), 3U);
+
+  const mcts::InformationSetNode* reply_node = nullptr;
+  for (const auto& child : root->getChildren()) {
+    const auto* move =
+        dynamic_cast<const ScriptedMove*>(child->getMove().get());
+    ASSERT_NE(move, nullptr);
+    // ルートの手は全決定化で合法なので、利用可能回数は選ばれた回数以上になる。
+    EXPECT_GE(child->getAvailability(), child->getVisits());
+    if (move->getId() == 0) {
+      reply_node = child.get();
+    }
+  }
+  ASSERT_NE(reply_node, nullptr);
+  ASSERT_GT(reply_node->getVisits(), 0);
+
+  // USAの応手は決定化された手札ごとに異なるため、2枚の手札より多くの応手が1つの情報集合に集まる。
+  EXPECT_GT(reply_node->getChildren().size(), 2U);
+  for (const auto& reply : reply_node->getChildren()) {
+    EXPECT_LE(reply->getAvailability(), reply_node->getVisits());
+    // USAの勝ちはUSA視点の正値として積まれる。
+    EXPECT_DOUBLE_EQ(reply->getAverageValue(), 1.0);
+  }
+}
+
+// ロールアウト深さ0では、応手待ちの葉をそのまま評価関数で打ち切る。
+TEST_F(InformationSetSearchTest, ZeroDepthPlayoutUsesEvaluator) {
+  const Board board = makeRootBoard();
+  auto evaluator = std::make_shared<CountingEvaluator>();
+  mcts::PlayoutConfig playout;
+  playout.rollout_depth = 0;
+  playout.evaluator = evaluator;
+  mcts::MCTSExecutor executor(std::sqrt(2.0), 1, {},
+                              mcts::SearchMode::SINGLE_OBSERVER, playout);
+
+  auto root = executor.buildInformationSetTree(
+      board, Side::USSR, 50, std::chrono::milliseconds(10000));
+
+  // 応手待ちのノードを初めて展開したときだけ評価関数が呼ばれる
+  EXPECT_EQ(evaluator->getCalls(), 1);
+  for (const auto& child : root->getChildren()) {
+    const auto* move =
+        dynamic_cast<const ScriptedMove*>(child->getMove().get());
+    ASSERT_NE(move, nullptr);
+    if (move->getId() == 0) {
+      EXPECT_GT(child->getVisits(), 0);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+// ファイル: tests/players/mcts_select_kernel_test.cpp
+// 役割:
+// PUCT/UCB1選択カーネルのスカラー版とAVX2版が同じ子を選ぶことを検証する。
+// 背景:
+// 実行時ディスパッチで実装が切り替わっても探索結果が変わらないことを保証するため。
+
+#include "tsge/players/mcts_select_kernel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct ChildStats {
+  std::vector<float> q;
+  std::vector<float> prior;
+  std::vector<int32_t> visits;
+};
+
+ChildStats makeRandomStats(size_t size, uint64_t seed, int32_t max_visits) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<float> q_dist(-1.0F, 1.0F);
+  std::uniform_real_distribution<float> prior_dist(0.0F, 1.0F);
+  std::uniform_int_distribution<int32_t> visit_dist(0, max_visits);
+  ChildStats stats;
+  for (size_t i = 0; i < size; ++i) {
+    stats.q.push_back(q_dist(rng));
+    stats.prior.push_back(prior_dist(rng));
+    stats.visits.push_back(visit_dist(rng));
+  }
+  return stats;
+}
+
+// 倍精度の参照実装で最大スコアを求める。
+double referencePuctBest(const ChildStats& stats, double scale) {
+  double best = -INFINITY;
+  for (size_t i = 0; i < stats.q.size(); ++i) {
+    best = std::max(best, stats.q[i] + scale * stats.prior[i] /
+                                           (1.0 + stats.visits[i]));
+  }
+  return best;
+}
+
+double puctScore(const ChildStats& stats, double scale, size_t index) {
+  return stats.q[index] +
+         scale * stats.prior[index] / (1.0 + stats.visits[index]);
+}
+
+std::vector<mcts::SelectKernelIsa> supportedIsas() {
+  std::vector<mcts::SelectKernelIsa> isas = {mcts::SelectKernelIsa::SCALAR};
+  if (mcts::isSelectKernelIsaSupported(mcts::SelectKernelIsa::AVX2)) {
+    isas.push_back(mcts::SelectKernelIsa::AVX2);
+  }
+  return isas;
+}
+
+}  // namespace
+
+TEST(MctsSelectKernelTest, ReciprocalTablesMatchDirectComputation) {
+  for (int32_t n : {0, 1, 2, 7, 100, mcts::SELECT_KERNEL_TABLE_SIZE - 1,
+                    mcts::SELECT_KERNEL_TABLE_SIZE, 100000}) {
+    EXPECT_FLOAT_EQ(mcts::reciprocalOnePlus(n), 1.0F / (1.0F + n));
+    if (n > 0) {
+      EXPECT_FLOAT_EQ(mcts::reciprocalSqrt(n), 1.0F / std::sqrt(n));
+    }
+  }
+}
+
+TEST(MctsSelectKernelTest, PuctMatchesReferenceForAllSizes) {
+  for (const auto isa : supportedIsas()) {
+    for (size_t size : {1U, 7U, 8U, 9U, 10U, 63U, 500U, 5000U}) {
+      const auto stats = makeRandomStats(size, size, 20000);
+      const float scale = 1.5F * std::sqrt(1234.0F);
+      const size_t index =
+          mcts::puctArgmax(stats.q, stats.prior, stats.visits, scale, isa);
+      ASSERT_LT(index, size);
+      EXPECT_NEAR(puctScore(stats, scale, index),
+                  referencePuctBest(stats, scale), 1e-5)
+          << "size=" << size << " isa=" << static_cast<int>(isa);
+    }
+  }
+}
+
+TEST(MctsSelectKernelTest, PuctPrefersFirstIndexOnTies) {
+  for (const auto isa : supportedIsas()) {
+    std::vector<float> q(37, 0.25F);
+    std::vector<float> prior(37, 0.5F);
+    std::vector<int32_t> visits(37, 3);
+    EXPECT_EQ(mcts::puctArgmax(q, prior, visits, 2.0F, isa), 0U);
+
+    q[29] = 0.75F;
+    q[33] = 0.75F;
+    EXPECT_EQ(mcts::puctArgmax(q, prior, visits, 2.0F, isa), 29U);
+  }
+}
+
+TEST(MctsSelectKernelTest, PuctReturnsZeroForEmptyInput) {
+  const std::vector<float> empty_f;
+  const std::vector<int32_t> empty_i;
+  EXPECT_EQ(mcts::puctArgmax(empty_f, empty_f, empty_i, 1.0F), 0U);
+}
+
+TEST(MctsSelectKernelTest, UcbReturnsFirstUnvisitedChild) {
+  for (const auto isa : supportedIsas()) {
+    auto stats = makeRandomStats(40, 7, 50);
+    for (auto& visit : stats.visits) {
+      visit = std::max(visit, 1);
+    }
+    stats.visits[17] = 0;
+    stats.visits[35] = 0;
+    EXPECT_EQ(mcts::ucbArgmax(stats.q, stats.visits, 1.4F, isa), 17U);
+  }
+}
+
+TEST(MctsSelectKernelTest, UcbMatchesReferenceWhenAllVisited) {
+  for (const auto isa : supportedIsas()) {
+    for (size_t size : {3U, 8U, 10U, 129U, 5000U}) {
+      auto stats = makeRandomStats(size, size + 11, 9000);
+      for (auto& visit : stats.visits) {
+        visit = std::max(visit, 1);
+      }
+      const float scale = 1.4F * std::sqrt(std::log(10001.0F));
+      const size_t index = mcts::ucbArgmax(stats.q, stats.visits, scale, isa);
+      ASSERT_LT(index, size);
+
+      double best = -INFINITY;
+      for (size_t i = 0; i < size; ++i) {
+        best = std::max(best, stats.q[i] + scale / std::sqrt(stats.visits[i]));
+      }
+      EXPECT_NEAR(stats.q[index] + scale / std::sqrt(stats.visits[index]), best,
+                  1e-5);
+    }
+  }
+}
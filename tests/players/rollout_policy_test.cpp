@@ -0,0 +1,155 @@
+// ファイル: tests/players/rollout_policy_test.cpp
+// 役割:
+// ルールベースのロールアウトポリシーがDEFCON自滅を避け、支配を得る配置と優勢時のスコアリングを選ぶことを検証する。
+// 背景:
+// 規則の重みを調整しても、プレイアウトの質を支える最低限の振る舞いが崩れないことを回帰として保証するため。
+
+#include "tsge/players/rollout_policy.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class RolloutCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  RolloutCard(CardEnum id, int ops)
+      : Card(id, "Rollout", ops, Side::NEUTRAL, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+class RolloutPolicyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 111; ++i) {
+      const auto id = static_cast<CardEnum>(i);
+      cardpool_[static_cast<size_t>(i)] =
+          std::make_unique<RolloutCard>(id, mcts::scoringRegion(id) ? 0 : 3);
+    }
+  }
+
+  // regionの全ての国にsideの影響力を大きく置いて支配させる
+  static void dominate(Board& board, Region region, Side side) {
+    auto& world_map = board.getWorldMap();
+    for (size_t i = 0; i < world_map.getCountriesCount(); ++i) {
+      auto& country = world_map.getCountry(static_cast<CountryEnum>(i));
+      if (country.hasRegion(region)) {
+        country.addInfluence(side, 10);
+      }
+    }
+  }
+
+  std::array<std::unique_ptr<Card>, 111> cardpool_{};
+};
+
+mcts::HeuristicRolloutConfig greedyConfig() {
+  mcts::HeuristicRolloutConfig config;
+  config.epsilon = 0.0;
+  return config;
+}
+
+}  // namespace
+
+TEST_F(RolloutPolicyTest, UniformPolicyReturnsLegalMove) {
+  Board board(cardpool_);
+  const mcts::UniformRolloutPolicy policy;
+  std::mt19937_64 rng(1);
+
+  EXPECT_EQ(policy.selectMove(board, {}, rng), nullptr);
+
+  const std::vector<std::shared_ptr<Move>> moves{
+      std::make_shared<PassMove>(Side::USSR),
+      std::make_shared<PassMove>(Side::USA)};
+  for (int trial = 0; trial < 20; ++trial) {
+    const auto move = policy.selectMove(board, moves, rng);
+    EXPECT_TRUE(move == moves[0] || move == moves[1]);
+  }
+}
+
+TEST_F(RolloutPolicyTest, AvoidsDefconSuicideCoup) {
+  Board board(cardpool_);
+  board.getDefconTrack().setDefcon(2);
+  board.getWorldMap().getCountry(CountryEnum::NIGERIA).addInfluence(Side::USA,
+                                                                    2);
+  // 候補数1で必ず非網羅評価にし、自滅手ばかり引いても探し直すことも確認する
+  mcts::HeuristicRolloutConfig config = greedyConfig();
+  config.candidates = 1;
+  const mcts::HeuristicRolloutPolicy policy(config);
+  std::vector<std::shared_ptr<Move>> moves;
+  for (int i = 0; i < 10; ++i) {
+    moves.push_back(std::make_shared<ActionCoupMove>(
+        static_cast<CardEnum>(20), Side::USSR, CountryEnum::NIGERIA));
+  }
+  const auto safe = std::make_shared<ActionSpaceRaceMove>(
+      static_cast<CardEnum>(20), Side::USSR);
+  moves.push_back(safe);
+  std::mt19937_64 rng(2);
+
+  for (int trial = 0; trial < 50; ++trial) {
+    EXPECT_EQ(policy.selectMove(board, moves, rng), safe);
+  }
+}
+
+TEST_F(RolloutPolicyTest, PrefersGainingBattlegroundControl) {
+  Board board(cardpool_);
+  const mcts::HeuristicRolloutPolicy policy(greedyConfig());
+  const auto battleground = std::make_shared<ActionPlaceInfluenceMove>(
+      static_cast<CardEnum>(20), Side::USSR,
+      std::map<CountryEnum, int>{{CountryEnum::NIGERIA, 1}});
+  const auto weak = std::make_shared<ActionPlaceInfluenceMove>(
+      static_cast<CardEnum>(20), Side::USSR,
+      std::map<CountryEnum, int>{{CountryEnum::MOROCCO, 1}});
+  const std::vector<std::shared_ptr<Move>> moves{weak, battleground};
+  std::mt19937_64 rng(3);
+
+  EXPECT_EQ(policy.selectMove(board, moves, rng), battleground);
+}
+
+TEST_F(RolloutPolicyTest, PlaysScoringCardOnlyWhenAhead) {
+  const mcts::HeuristicRolloutPolicy policy(greedyConfig());
+  const auto scoring = std::make_shared<ActionEventMove>(
+      CardEnum::AFRICA_SCORING, Side::USSR, true);
+  const auto other = std::make_shared<ActionEventMove>(
+      static_cast<CardEnum>(20), Side::USSR, true);
+  const std::vector<std::shared_ptr<Move>> moves{other, scoring};
+  std::mt19937_64 rng(4);
+
+  Board ahead(cardpool_);
+  dominate(ahead, Region::AFRICA, Side::USSR);
+  EXPECT_EQ(policy.selectMove(ahead, moves, rng), scoring);
+
+  Board behind(cardpool_);
+  dominate(behind, Region::AFRICA, Side::USA);
+  EXPECT_EQ(policy.selectMove(behind, moves, rng), other);
+}
+
+TEST_F(RolloutPolicyTest, SummaryCountsRegionControl) {
+  Board board(cardpool_);
+  dominate(board, Region::AFRICA, Side::USSR);
+
+  const mcts::RolloutSummary summary(board);
+  const auto africa = static_cast<size_t>(Region::AFRICA);
+
+  EXPECT_EQ(summary.battlegrounds[africa][0], 5);
+  EXPECT_GT(summary.controlled[africa][0], summary.battlegrounds[africa][0]);
+  EXPECT_EQ(summary.controlled[africa][1], 0);
+  EXPECT_GT(summary.regionLead(Region::AFRICA, Side::USSR), 0);
+  EXPECT_EQ(summary.regionLead(Region::AFRICA, Side::USA),
+            -summary.regionLead(Region::AFRICA, Side::USSR));
+}
@@ -0,0 +1,165 @@
+// ファイル: tests/players/training_shard_test.cpp
+// 役割:
+// 学習データのシャードが複数スレッドからの追記を取りこぼさず、確定・未確定のどちらでも読み戻せることを検証する。
+// 背景:
+// 自己対戦の出力は長時間かけて溜めるため、レコードの欠落や確定前の異常終了で全体が読めなくなる事態を防ぎたい。
+
+#include "tsge/players/training_shard.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tsge/game_state/card.hpp"
+
+namespace {
+
+class ShardCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  explicit ShardCard(CardEnum id)
+      : Card(id, "Shard", 2, Side::NEUTRAL, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+class TrainingShardTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "training_shard_test_" +
+            std::to_string(::getpid()) + "_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".tstr";
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  std::string path_;
+};
+
+TrainingRecord recordWithSeed(uint64_t seed) {
+  TrainingRecord record;
+  record.game_seed = seed;
+  record.ply = static_cast<uint16_t>(seed % 500);
+  record.value = seed % 2 == 0 ? 1.0F : -1.0F;
+  return record;
+}
+
+}  // namespace
+
+TEST_F(TrainingShardTest, ConcurrentAppendsAreAllReadBack) {
+  constexpr size_t threads = 4;
+  constexpr size_t per_thread = 250;
+  {
+    TrainingShardWriter writer(path_, threads * per_thread);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&writer, t] {
+        for (size_t i = 0; i < per_thread; ++i) {
+          EXPECT_TRUE(writer.append(recordWithSeed((t * per_thread) + i)));
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    EXPECT_FALSE(writer.append(recordWithSeed(9999)));
+    EXPECT_EQ(writer.size(), threads * per_thread);
+    writer.finalize();
+  }
+
+  const TrainingShardReader reader(path_);
+  ASSERT_TRUE(reader.isFinalized());
+  const auto records = reader.records();
+  ASSERT_EQ(records.size(), threads * per_thread);
+  std::set<uint64_t> seeds;
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_TRUE(reader.isCommitted(i));
+    EXPECT_EQ(records[i].ply, records[i].game_seed % 500);
+    seeds.insert(records[i].game_seed);
+  }
+  EXPECT_EQ(seeds.size(), threads * per_thread);
+}
+
+TEST_F(TrainingShardTest, UnfinalizedShardIsReadable) {
+  TrainingShardWriter writer(path_, 100);
+  ASSERT_TRUE(writer.append(recordWithSeed(7)));
+  ASSERT_TRUE(writer.append(recordWithSeed(8)));
+
+  // 確定前(異常終了した状態に相当)でも書き込み完了の印が付いた分は読める
+  const TrainingShardReader reader(path_);
+  EXPECT_FALSE(reader.isFinalized());
+  ASSERT_EQ(reader.records().size(), 2U);
+  EXPECT_TRUE(reader.isCommitted(1));
+  EXPECT_EQ(reader.records()[1].game_seed, 8U);
+  EXPECT_FALSE(reader.isCommitted(2));
+}
+
+TEST_F(TrainingShardTest, RejectsForeignFile) {
+  {
+    std::ofstream output(path_, std::ios::binary);
+    output << std::string(128, 'x');
+  }
+  EXPECT_THROW(TrainingShardReader{path_}, std::runtime_error);
+  EXPECT_THROW(TrainingShardReader{"/nonexistent/shard.tstr"},
+               std::runtime_error);
+  EXPECT_THROW(TrainingShardWriter("/nonexistent/shard.tstr", 10),
+               std::runtime_error);
+}
+
+TEST(TrainingRecordTest, PolicyMergesStepsAndNormalizes) {
+  constexpr auto card = static_cast<CardEnum>(20);
+  const std::vector<std::shared_ptr<Move>> moves{
+      std::make_shared<ActionCoupMove>(card, Side::USSR, CountryEnum::IRAN),
+      // どちらも最初の手順がIRAQなので同じ添字へ合算される
+      std::make_shared<ActionPlaceInfluenceMove>(
+          card, Side::USSR, std::map<CountryEnum, int>{{CountryEnum::IRAQ, 2}}),
+      std::make_shared<ActionPlaceInfluenceMove>(
+          card, Side::USSR, std::map<CountryEnum, int>{{CountryEnum::IRAQ, 1}}),
+      std::make_shared<PassMove>(Side::USSR)};
+  const std::vector<double> visits{2.0, 3.0, 3.0, 0.0};
+
+  TrainingRecord record;
+  record.setPolicy(moves, visits);
+
+  ASSERT_EQ(record.policy_count, 2U);
+  EXPECT_EQ(record.policy_index[0], ActionIndex::moveToIndex(*moves[1]));
+  EXPECT_FLOAT_EQ(record.policy_prob[0], 0.75F);
+  EXPECT_EQ(record.policy_index[1], ActionIndex::moveToIndex(*moves[0]));
+  EXPECT_FLOAT_EQ(record.policy_prob[1], 0.25F);
+}
+
+TEST(TrainingRecordTest, PositionUsesFeatureEncoder) {
+  std::array<std::unique_ptr<Card>, 111> cardpool{};
+  for (int i = 0; i < 111; ++i) {
+    cardpool[static_cast<size_t>(i)] =
+        std::make_unique<ShardCard>(static_cast<CardEnum>(i));
+  }
+  Board board(cardpool);
+  board.changeVp(4);
+
+  TrainingRecord record;
+  record.setPosition(board, Side::USA);
+
+  EXPECT_EQ(record.side, static_cast<uint8_t>(Side::USA));
+  EXPECT_EQ(record.turn, board.getTurnTrack().getTurn());
+  EXPECT_EQ(record.features[FeatureEncoder::TRACK_OFFSET + FeatureEncoder::VP],
+            -4);
+}
@@ -6,6 +6,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -49,13 +50,127 @@ class DummyInference final : public TsNnMctsInferenceEngine {
       result.policy[preferred_index] = preferred_prior_;
     }
     result.value = 0.2;
+    evaluate_calls_ += 1;
     return result;
   }
 
+  [[nodiscard]] int getEvaluateCalls() const { return evaluate_calls_; }
+
  private:
   double preferred_prior_;
+  int evaluate_calls_ = 0;
+};
+
+std::array<std::unique_ptr<Card>, 111> makeDummyCardpool() {
+  std::array<std::unique_ptr<Card>, 111> cardpool{};
+  for (int i = 0; i < 111; ++i) {
+    cardpool[static_cast<size_t>(i)] = std::make_unique<DummyCard>(
+        static_cast<CardEnum>(i), WarPeriod::EARLY_WAR);
+  }
+  return cardpool;
+}
+
+// ScriptedOutcome: 合成ゲームでの手の結果。
+enum class ScriptedOutcome : uint8_t { USSR_WIN, USA_WIN, DRAW, USA_REPLY };
+
+// ScriptedMove: 適用するとoutcomeに応じて終局状態か相手のRequestを積む合成Move。
+// PhaseMachine::stepを通した探索ループを、実カードに依存せず検証するために使う。
+class ScriptedMove final : public Move {
+ public:
+  ScriptedMove(Side side, int id, ScriptedOutcome outcome)
+      : Move{CardEnum::DUMMY, side}, id_{id}, outcome_{outcome} {}
+
+  [[nodiscard]] std::vector<CommandPtr> toCommand(
+      const std::unique_ptr<Card>& /*card*/,
+      const Board& /*board*/) const override {
+    const auto outcome = outcome_;
+    return {std::make_shared<LambdaCommand>([outcome](Board& board) {
+      switch (outcome) {
+        case ScriptedOutcome::USSR_WIN:
+          board.pushState(StateType::USSR_WIN_END);
+          break;
+        case ScriptedOutcome::USA_WIN:
+          board.pushState(StateType::USA_WIN_END);
+          break;
+        case ScriptedOutcome::DRAW:
+          board.pushState(StateType::DRAW_END);
+          break;
+        case ScriptedOutcome::USA_REPLY:
+          board.pushState(std::make_shared<RequestCommand>(
+              Side::USA, [](const Board& /*board*/) {
+                return std::vector<std::shared_ptr<Move>>{
+                    std::make_shared<ScriptedMove>(Side::USA, 10,
+                                                   ScriptedOutcome::USA_WIN),
+                    std::make_shared<ScriptedMove>(Side::USA, 11,
+                                                   ScriptedOutcome::DRAW)};
+              }));
+          break;
+      }
+    })};
+  }
+
+  [[nodiscard]] bool operator==(const Move& other) const override {
+    const auto* other_cast = dynamic_cast<const ScriptedMove*>(&other);
+    return other_cast != nullptr && other_cast->getSide() == getSide() &&
+           other_cast->id_ == id_;
+  }
+
+  [[nodiscard]] uint64_t getKey() const override {
+    return combineMoveKey(Move::getKey(), static_cast<uint64_t>(id_));
+  }
+
+ private:
+  int id_;
+  ScriptedOutcome outcome_;
 };
 
+// ルートでUSSRが選ぶ3手: 即勝ち / USAの応手待ち(USAは勝ち手を持つ) / 引き分け。
+std::vector<std::shared_ptr<Move>> makeScriptedRootMoves() {
+  return {std::make_shared<ScriptedMove>(Side::USSR, 0,
+                                         ScriptedOutcome::USA_REPLY),
+          std::make_shared<ScriptedMove>(Side::USSR, 1,
+                                         ScriptedOutcome::USSR_WIN),
+          std::make_shared<ScriptedMove>(Side::USSR, 2, ScriptedOutcome::DRAW)};
+}
+
+// BatchRecordingInference: 一様なpolicyと値0を返し、evaluateBatchのバッチサイズを記録する。
+class BatchRecordingInference final : public TsNnMctsInferenceEngine {
+ public:
+  TsNnMctsInferenceResult evaluate(
+      const Board& /*board*/,
+      const std::vector<std::shared_ptr<Move>>& legal_moves,
+      Side /*side*/) override {
+    TsNnMctsInferenceResult result;
+    result.policy.assign(legal_moves.size(), 1.0);
+    return result;
+  }
+
+  std::vector<TsNnMctsInferenceResult> evaluateBatch(
+      std::span<const Board* const> boards,
+      std::span<const std::vector<std::shared_ptr<Move>>* const> legal_moves,
+      std::span<const Side> sides) override {
+    batch_sizes_.push_back(boards.size());
+    return TsNnMctsInferenceEngine::evaluateBatch(boards, legal_moves, sides);
+  }
+
+  [[nodiscard]] const std::vector<size_t>& getBatchSizes() const {
+    return batch_sizes_;
+  }
+
+ private:
+  std::vector<size_t> batch_sizes_;
+};
+
+std::vector<std::shared_ptr<Move>> makeRealignmentMoves(
+    const std::vector<CountryEnum>& targets) {
+  std::vector<std::shared_ptr<Move>> moves;
+  for (const auto target : targets) {
+    moves.push_back(std::make_shared<RealignmentRequestMove>(
+        CardEnum::FIDEL, Side::USSR, target, std::vector<CountryEnum>{}, 2));
+  }
+  return moves;
+}
+
 }  // namespace
 
 // TsNnMctsPolicy雛形テスト: 推論器が返したpriorに従って手が選ばれるか確認。
@@ -85,3 +200,227 @@ TEST(TsNnMctsPolicySkeletonTest, PicksMoveWithHighestPrior) {
   ASSERT_NE(selected_move, nullptr);
   EXPECT_EQ(selected_move->getCard(), CardEnum::FIDEL);
 }
+
+// 部分木再利用: 同じ合法手集合(順序違い)での再探索は推論を呼ばずに統計を引き継ぐ。
+TEST(TsNnMctsReuseTest, ReusesRootWhenChildrenMatchLegalMoves) {
+  auto cardpool = makeDummyCardpool();
+  Board board(cardpool);
+
+  auto inference = std::make_shared<DummyInference>(0.9);
+  TsNnMctsConfig config;
+  config.add_dirichlet_noise = false;
+  config.num_simulations = 0;  // 再利用の記帳だけを検証する。
+  TsNnMctsController controller(inference, config);
+
+  const auto first_moves = makeRealignmentMoves(
+      {CountryEnum::ITALY, CountryEnum::FRANCE, CountryEnum::JAPAN});
+  auto first = controller.runSearch(board, first_moves, Side::USSR);
+  ASSERT_EQ(first, first_moves[1]);
+  EXPECT_EQ(inference->getEvaluateCalls(), 1);
+  const int root_visits = controller.getRoot().getVisitCount();
+
+  // 別インスタンス・別順序の同じ手集合を渡す。
+  const auto second_moves = makeRealignmentMoves(
+      {CountryEnum::JAPAN, CountryEnum::FRANCE, CountryEnum::ITALY});
+  auto second = controller.runSearch(board, second_moves, Side::USSR);
+
+  EXPECT_EQ(inference->getEvaluateCalls(), 1);
+  EXPECT_EQ(second, second_moves[1]);
+  const auto& stats = controller.getReuseStats();
+  EXPECT_EQ(stats.searches, 2);
+  EXPECT_EQ(stats.reused_roots, 1);
+  EXPECT_EQ(stats.simulations_saved, root_visits);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+  EXPECT_EQ(controller.getRoot().getChildren()[0]->getMove(),
+            second_moves[0].get());
+}
+
+// 合法手集合が変わった場合は木を破棄して新たに評価する。
+TEST(TsNnMctsReuseTest, DiscardsRootWhenLegalMovesDiffer) {
+  auto cardpool = makeDummyCardpool();
+  Board board(cardpool);
+
+  auto inference = std::make_shared<DummyInference>(0.9);
+  TsNnMctsConfig config;
+  config.add_dirichlet_noise = false;
+  config.num_simulations = 0;  // 再利用の記帳だけを検証する。
+  TsNnMctsController controller(inference, config);
+
+  controller.runSearch(
+      board, makeRealignmentMoves({CountryEnum::ITALY, CountryEnum::FRANCE}),
+      Side::USSR);
+  controller.runSearch(
+      board, makeRealignmentMoves({CountryEnum::ITALY, CountryEnum::JAPAN}),
+      Side::USSR);
+
+  EXPECT_EQ(inference->getEvaluateCalls(), 2);
+  EXPECT_EQ(controller.getReuseStats().reused_roots, 0);
+}
+
+// advance: 指された手の子を新ルートとして残し、その統計を引き継ぐ。
+TEST(TsNnMctsReuseTest, AdvanceKeepsPlayedChildStatistics) {
+  auto cardpool = makeDummyCardpool();
+  Board board(cardpool);
+
+  auto inference = std::make_shared<DummyInference>(0.9);
+  TsNnMctsConfig config;
+  config.add_dirichlet_noise = false;
+  config.num_simulations = 0;  // 再利用の記帳だけを検証する。
+  TsNnMctsController controller(inference, config);
+
+  const auto moves = makeRealignmentMoves(
+      {CountryEnum::ITALY, CountryEnum::FRANCE, CountryEnum::JAPAN});
+  controller.runSearch(board, moves, Side::USSR);
+  const auto* played_child = controller.getRoot().getChildren()[2].get();
+  const int played_visits = played_child->getVisitCount();
+  const double played_value = played_child->getValueSum();
+
+  const auto observed = makeRealignmentMoves({CountryEnum::JAPAN});
+  controller.advance(*observed[0]);
+
+  EXPECT_EQ(&controller.getRoot(), played_child);
+  EXPECT_EQ(controller.getRoot().getParent(), nullptr);
+  EXPECT_EQ(controller.getRoot().getVisitCount(), played_visits);
+  EXPECT_DOUBLE_EQ(controller.getRoot().getValueSum(), played_value);
+
+  // 木に存在しない手を観測した場合は空のルートへ戻る。
+  controller.advance(*makeRealignmentMoves({CountryEnum::CUBA})[0]);
+  EXPECT_EQ(controller.getRoot().getVisitCount(), 0);
+  EXPECT_TRUE(controller.getRoot().getChildren().empty());
+}
+
+// alignChildren: 子の並べ替え後もSoAミラーと子ノードの対応が保たれる。
+TEST(TsNnMctsReuseTest, AlignChildrenKeepsStatisticsWithChildren) {
+  TsNnMctsNode root(nullptr, 1.0, nullptr);
+  const auto moves = makeRealignmentMoves(
+      {CountryEnum::ITALY, CountryEnum::FRANCE, CountryEnum::JAPAN});
+  root.expand(moves, {0.2, 0.7, 0.1});
+  root.getMutableChildren()[1]->backup(1.0, Side::USSR);
+  root.getMutableChildren()[1]->backup(1.0, Side::USSR);
+
+  const auto reordered = makeRealignmentMoves(
+      {CountryEnum::FRANCE, CountryEnum::JAPAN, CountryEnum::ITALY});
+  ASSERT_TRUE(root.alignChildren(reordered));
+  EXPECT_EQ(root.getChildren()[0]->getVisitCount(), 2);
+  EXPECT_DOUBLE_EQ(root.getChildren()[0]->getPrior(), 0.7);
+
+  // 訪問済みの子(FRANCE)がQ値により選ばれる。
+  EXPECT_EQ(root.selectChild(1.5), root.getChildren()[0].get());
+  EXPECT_EQ(root.findChild(*reordered[1]), root.getChildren()[1].get());
+
+  EXPECT_FALSE(root.alignChildren(makeRealignmentMoves(
+      {CountryEnum::FRANCE, CountryEnum::JAPAN, CountryEnum::CUBA})));
+}
+
+// 探索ループ: PhaseMachine::stepで盤面を進め、即勝ちの手へ訪問が集中する。
+TEST(TsNnMctsSearchTest, SimulationsFindImmediateWin) {
+  auto cardpool = makeDummyCardpool();
+  Board board(cardpool);
+  const auto root_moves = makeScriptedRootMoves();
+
+  auto inference = std::make_shared<BatchRecordingInference>();
+  TsNnMctsConfig config;
+  config.add_dirichlet_noise = false;
+  config.num_simulations = 64;
+  config.batch_size = 4;
+  config.seed = 7;
+  TsNnMctsController controller(inference, config);
+
+  auto selected = controller.runSearch(board, root_moves, Side::USSR);
+
+  ASSERT_EQ(selected, root_moves[1]);
+  const auto& children = controller.getRoot().getChildren();
+  ASSERT_EQ(children.size(), 3U);
+  EXPECT_GT(children[1]->getVisitCount(), children[0]->getVisitCount());
+  EXPECT_GT(children[1]->getVisitCount(), children[2]->getVisitCount());
+  EXPECT_DOUBLE_EQ(children[1]->getValueSum(),
+                   static_cast<double>(children[1]->getVisitCount()));
+  EXPECT_LE(controller.getRoot().getVisitCount(), 1 + config.num_simulations);
+}
+
+// 視点: USAの応手ノードではUSAの勝ちがUSA視点の正値、USSRの手には負値として積まれる。
+TEST(TsNnMctsSearchTest, BackupUsesMoverPerspective) {
+  auto cardpool = makeDummyCardpool();
+  Board board(cardpool);
+  const auto root_moves = makeScriptedRootMoves();
+
+  auto inference = std::make_shared<BatchRecordingInference>();
+  TsNnMctsConfig config;
+  config.add_dirichlet_noise = false;
+  config.num_simulations = 64;
+  config.batch_size = 1;
+  config.c_puct = 10.0;  // 応手ノードまで十分に探索させる。
+  config.seed = 11;
+  TsNnMctsController controller(inference, config);
+
+  controller.runSearch(board, root_moves, Side::USSR);
+
+  const auto& reply_node = *controller.getRoot().getChildren()[0];
+  ASSERT_TRUE(reply_node.isExpanded());
+  const auto& usa_win = *reply_node.getChildren()[0];
+  ASSERT_GT(usa_win.getVisitCount(), 0);
+  EXPECT_EQ(usa_win.getOwner(), Side::USA);
+  EXPECT_DOUBLE_EQ(usa_win.getValueSum(),
+                   static_cast<double>(usa_win.getVisitCount()));
+  EXPECT_LT(reply_node.getValueSum(), 0.0);
+}
+
+// バッチ: 葉はbatch_size以下の単位でevaluateBatchへ渡され、仮想損失は全て戻される。
+TEST(TsNnMctsSearchTest, LeavesAreEvaluatedInBatches) {
+  auto cardpool = makeDummyCardpool();
+  Board board(cardpool);
+  const auto root_moves = makeScriptedRootMoves();
+
+  auto inference = std::make_shared<BatchRecordingInference>();
+  TsNnMctsConfig config;
+  config.add_dirichlet_noise = false;
+  config.num_simulations = 32;
+  config.batch_size = 4;
+  config.seed = 3;
+  TsNnMctsController controller(inference, config);
+
+  controller.runSearch(board, root_moves, Side::USSR);
+
+  ASSERT_FALSE(inference->getBatchSizes().empty());
+  for (const size_t size : inference->getBatchSizes()) {
+    EXPECT_GE(size, 1U);
+    EXPECT_LE(size, 4U);
+  }
+
+  // 仮想損失が残っていれば子の訪問合計がルート訪問数-1と一致しない。
+  const auto& root = controller.getRoot();
+  int child_visits = 0;
+  for (const auto& child : root.getChildren()) {
+    child_visits += child->getVisitCount();
+  }
+  EXPECT_EQ(child_visits, root.getVisitCount() - 1);
+}
+
+// 小さな木: 同じバッチで同じ葉が再選択されても、評価後にその値でバックアップし、
+// ルートの訪問数は探索回数ちょうどだけ増える。
+TEST(TsNnMctsSearchTest, DuplicateLeavesInBatchAreBackedUp) {
+  auto cardpool = makeDummyCardpool();
+  Board board(cardpool);
+  // 唯一の手はUSAの応手待ちなので、最初のバッチは全て同じ葉を選ぶ
+  const std::vector<std::shared_ptr<Move>> root_moves{
+      std::make_shared<ScriptedMove>(Side::USSR, 0,
+                                     ScriptedOutcome::USA_REPLY)};
+
+  auto inference = std::make_shared<BatchRecordingInference>();
+  TsNnMctsConfig config;
+  config.add_dirichlet_noise = false;
+  config.num_simulations = 16;
+  config.batch_size = 8;
+  config.seed = 5;
+  TsNnMctsController controller(inference, config);
+
+  controller.runSearch(board, root_moves, Side::USSR);
+
+  const auto& root = controller.getRoot();
+  EXPECT_EQ(root.getVisitCount(), 1 + config.num_simulations);
+  ASSERT_EQ(root.getChildren().size(), 1U);
+  EXPECT_EQ(root.getChildren()[0]->getVisitCount(), config.num_simulations);
+  // 同じ葉は1回だけ評価される
+  ASSERT_FALSE(inference->getBatchSizes().empty());
+  EXPECT_EQ(inference->getBatchSizes().front(), 1U);
+}
@@ -0,0 +1,338 @@
+// ファイル: tests/players/vector_env_test.cpp
+// 役割:
+// ベクトル化環境が観測のマスクどおりの行動で全環境を進め、終局した環境を自動で作り直し、スレッド数によらず同じ軌跡になることを検証する。
+// 背景:
+// 学習データは環境の並列度を変えても再現できる必要があり、不正な行動で一部の環境だけが進むと軌跡が壊れるため。
+
+#include "tsge/players/vector_env.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "tsge/actions/move.hpp"
+#include "tsge/game_state/card.hpp"
+#include "tsge/players/rollout_policy.hpp"
+
+namespace {
+
+class EnvCard final : public Card {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-length)
+  EnvCard(CardEnum id, int ops, Side side)
+      : Card(id, "Env", ops, side, WarPeriod::EARLY_WAR, false) {}
+
+  [[nodiscard]] std::vector<CommandPtr> event(
+      Side /*side*/, const Board& /*board*/) const override {
+    return {};
+  }
+
+  [[nodiscard]] bool canEvent(const Board& /*board*/) const override {
+    return true;
+  }
+};
+
+const std::array<std::unique_ptr<Card>, 111>& envCardpool() {
+  static const auto cardpool = [] {
+    std::array<std::unique_ptr<Card>, 111> pool{};
+    constexpr std::array<Side, 3> SIDES{Side::USSR, Side::USA, Side::NEUTRAL};
+    for (int i = 0; i < 111; ++i) {
+      const auto id = static_cast<CardEnum>(i);
+      const int ops = mcts::scoringRegion(id) ? 0 : 1 + (i % 2);
+      pool[static_cast<size_t>(i)] = std::make_unique<EnvCard>(
+          id, ops, SIDES[static_cast<size_t>(i % 3)]);
+    }
+    return pool;
+  }();
+  return cardpool;
+}
+
+// 各環境のマスクから立っている添字を乱数で1つずつ選ぶ
+std::vector<int> sampleActions(const std::vector<uint8_t>& masks,
+                               size_t num_envs, std::mt19937_64& rng) {
+  std::vector<int> actions(num_envs);
+  for (size_t env = 0; env < num_envs; ++env) {
+    std::vector<int> legal;
+    for (size_t i = 0; i < ActionIndex::SIZE; ++i) {
+      if (masks[(env * ActionIndex::SIZE) + i] != 0) {
+        legal.push_back(static_cast<int>(i));
+      }
+    }
+    EXPECT_FALSE(legal.empty());
+    std::uniform_int_distribution<size_t> pick(0, legal.size() - 1);
+    actions[env] = legal[pick(rng)];
+  }
+  return actions;
+}
+
+struct Trajectory {
+  std::vector<int> actions;
+  std::vector<float> rewards;
+  std::vector<uint8_t> dones;
+  std::vector<float> features;
+};
+
+Trajectory run(size_t threads, size_t steps) {
+  constexpr size_t NUM_ENVS = 12;
+  VectorEnv env(envCardpool(),
+                {.num_envs = NUM_ENVS,
+                 .threads = threads,
+                 .max_episode_steps = 40},
+                7);
+  std::vector<float> features(NUM_ENVS * FeatureEncoder::SIZE);
+  std::vector<uint8_t> masks(NUM_ENVS * ActionIndex::SIZE);
+  std::mt19937_64 rng(3);
+  Trajectory trajectory;
+  for (size_t i = 0; i < steps; ++i) {
+    env.observe(features.data(), masks.data());
+    const auto actions = sampleActions(masks, NUM_ENVS, rng);
+    env.step(actions);
+    trajectory.actions.insert(trajectory.actions.end(), actions.begin(),
+                              actions.end());
+    trajectory.rewards.insert(trajectory.rewards.end(), env.rewards().begin(),
+                              env.rewards().end());
+    trajectory.dones.insert(trajectory.dones.end(), env.dones().begin(),
+                            env.dones().end());
+  }
+  env.observe(features.data(), nullptr);
+  trajectory.features = features;
+  return trajectory;
+}
+
+// 最初の国が同じで配置が異なる影響力配置の手の組
+struct PlacementFork {
+  std::vector<int> history;
+  size_t first = 0;
+  size_t second = 0;
+};
+
+// 1環境を乱数で進め、合法手に最初の手順が同じ2つの影響力配置が並ぶ局面を探す
+PlacementFork findPlacementFork(const VectorEnvConfig& config) {
+  VectorEnv env(envCardpool(), config);
+  std::vector<uint8_t> mask(ActionIndex::SIZE);
+  std::mt19937_64 rng(5);
+  PlacementFork fork;
+  for (int i = 0; i < 2000; ++i) {
+    const auto& moves = env.legalMoves(0);
+    for (size_t a = 0; a < moves.size(); ++a) {
+      for (size_t b = a + 1; b < moves.size(); ++b) {
+        const auto* first =
+            dynamic_cast<const ActionPlaceInfluenceMove*>(moves[a].get());
+        const auto* second =
+            dynamic_cast<const ActionPlaceInfluenceMove*>(moves[b].get());
+        if (first != nullptr && second != nullptr &&
+            env.pendingSteps(0).empty() &&
+            ActionIndex::moveToIndex(*first) ==
+                ActionIndex::moveToIndex(*second)) {
+          fork.first = a;
+          fork.second = b;
+          return fork;
+        }
+      }
+    }
+    env.observe(nullptr, mask.data());
+    fork.history.push_back(sampleActions(mask, 1, rng).front());
+    env.step(std::span<const int>(&fork.history.back(), 1));
+  }
+  ADD_FAILURE() << "no placement fork found";
+  return fork;
+}
+
+}  // namespace
+
+TEST(VectorEnvTest, MaskMatchesLegalMoves) {
+  VectorEnv env(envCardpool(), {.num_envs = 3, .threads = 2});
+  std::vector<uint8_t> masks(3 * ActionIndex::SIZE, 1);
+  env.observe(nullptr, masks.data());
+  for (size_t i = 0; i < env.size(); ++i) {
+    ASSERT_FALSE(env.legalMoves(i).empty());
+    EXPECT_NE(env.sideToMove(i), Side::NEUTRAL);
+    size_t set = 0;
+    for (size_t a = 0; a < ActionIndex::SIZE; ++a) {
+      set += masks[(i * ActionIndex::SIZE) + a];
+    }
+    EXPECT_GT(set, 0U);
+    std::vector<uint8_t> expected(ActionIndex::SIZE);
+    ActionIndex::writeLegalMask(env.legalMoves(i), expected.data());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+                           masks.begin() + static_cast<std::ptrdiff_t>(
+                                               i * ActionIndex::SIZE)));
+    for (const auto& move : env.legalMoves(i)) {
+      EXPECT_EQ(masks[(i * ActionIndex::SIZE) +
+                      ActionIndex::moveToIndex(*move)],
+                1);
+    }
+  }
+}
+
+TEST(VectorEnvTest, FinishedEpisodesAreResetAutomatically) {
+  constexpr size_t NUM_ENVS = 4;
+  VectorEnv env(envCardpool(), {.num_envs = NUM_ENVS,
+                                .threads = 2,
+                                .max_episode_steps = 10});
+  std::vector<uint8_t> masks(NUM_ENVS * ActionIndex::SIZE);
+  std::mt19937_64 rng(11);
+  std::vector<size_t> dones(NUM_ENVS, 0);
+  // 影響力の配置は1単位ずつ選ぶため、Opsが2以下のこのカードでは1手に最大2回の行動を使う
+  for (size_t i = 0; i < 120; ++i) {
+    env.observe(nullptr, masks.data());
+    env.step(sampleActions(masks, NUM_ENVS, rng));
+    for (size_t e = 0; e < NUM_ENVS; ++e) {
+      dones[e] += env.dones()[e];
+      if (env.dones()[e] == 0) {
+        EXPECT_EQ(env.rewards()[e], 0.0F);
+      }
+      // 作り直した環境はすぐに次の手番を待っている
+      EXPECT_FALSE(env.legalMoves(e).empty());
+    }
+  }
+  for (size_t e = 0; e < NUM_ENVS; ++e) {
+    EXPECT_GE(dones[e], 6U);
+    EXPECT_EQ(env.episodes(e), dones[e]);
+  }
+}
+
+TEST(VectorEnvTest, TrajectoryDoesNotDependOnThreadCount) {
+  const auto serial = run(1, 50);
+  const auto parallel = run(4, 50);
+  EXPECT_EQ(serial.actions, parallel.actions);
+  EXPECT_EQ(serial.rewards, parallel.rewards);
+  EXPECT_EQ(serial.dones, parallel.dones);
+  EXPECT_EQ(serial.features, parallel.features);
+}
+
+TEST(VectorEnvTest, ResetRestartsFromSeeds) {
+  VectorEnv env(envCardpool(), {.num_envs = 2, .threads = 1});
+  std::vector<float> before(2 * FeatureEncoder::SIZE);
+  std::vector<uint8_t> masks(2 * ActionIndex::SIZE);
+  const std::vector<uint64_t> seeds{5, 9};
+  env.reset(seeds);
+  env.observe(before.data(), masks.data());
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 5; ++i) {
+    env.step(sampleActions(masks, 2, rng));
+    env.observe(nullptr, masks.data());
+  }
+  env.reset(seeds);
+  std::vector<float> after(2 * FeatureEncoder::SIZE);
+  env.observe(after.data(), nullptr);
+  EXPECT_EQ(before, after);
+  EXPECT_EQ(env.episodes(0), 0U);
+}
+
+TEST(VectorEnvTest, IllegalActionLeavesEveryEnvUntouched) {
+  VectorEnv env(envCardpool(), {.num_envs = 2, .threads = 2});
+  std::vector<float> before(2 * FeatureEncoder::SIZE);
+  std::vector<uint8_t> masks(2 * ActionIndex::SIZE);
+  env.observe(before.data(), masks.data());
+  std::mt19937_64 rng(1);
+  auto actions = sampleActions(masks, 2, rng);
+  // 2番目の環境だけ合法手に無い添字にする
+  for (size_t i = 0; i < ActionIndex::SIZE; ++i) {
+    if (masks[ActionIndex::SIZE + i] == 0) {
+      actions[1] = static_cast<int>(i);
+      break;
+    }
+  }
+  EXPECT_THROW(env.step(actions), std::invalid_argument);
+  actions[1] = -1;
+  EXPECT_THROW(env.step(actions), std::invalid_argument);
+  std::vector<float> after(2 * FeatureEncoder::SIZE);
+  env.observe(after.data(), nullptr);
+  EXPECT_EQ(before, after);
+}
+
+TEST(VectorEnvTest, RejectsBadArguments) {
+  EXPECT_THROW(VectorEnv(envCardpool(), {.num_envs = 0}),
+               std::invalid_argument);
+  EXPECT_THROW(VectorEnv(envCardpool(), {.num_envs = 1, .threads = 0}),
+               std::invalid_argument);
+  VectorEnv env(envCardpool(), {.num_envs = 2, .threads = 1});
+  const std::vector<int> actions{0};
+  EXPECT_THROW(env.step(actions), std::invalid_argument);
+  const std::vector<uint64_t> seeds{1, 2, 3};
+  EXPECT_THROW(env.reset(seeds), std::invalid_argument);
+}
+
+// 分解モードでは、最初の国が同じ別々の影響力配置にもそれぞれの手順列で届く
+TEST(VectorEnvTest, PlacementPatternsSharingFirstStepAreBothReachable) {
+  const VectorEnvConfig config{.num_envs = 1, .threads = 1};
+  const auto fork = findPlacementFork(config);
+  for (const size_t target : {fork.first, fork.second}) {
+    VectorEnv env(envCardpool(), config);
+    for (const int action : fork.history) {
+      env.step(std::span<const int>(&action, 1));
+    }
+    const auto move = env.legalMoves(0)[target];
+    const auto& placement =
+        static_cast<const ActionPlaceInfluenceMove&>(*move);
+    const Side side = env.sideToMove(0);
+    std::vector<size_t> steps;
+    ActionIndex::influenceSteps(*move, steps);
+    ASSERT_GE(steps.size(), 2U);
+    std::map<CountryEnum, int> before;
+    for (const auto& [country, amount] : placement.getTargetCountries()) {
+      before[country] =
+          env.board(0).getWorldMap().getCountry(country).getInfluence(side);
+    }
+
+    std::vector<uint8_t> mask(ActionIndex::SIZE);
+    for (size_t i = 0; i < steps.size(); ++i) {
+      env.observe(nullptr, mask.data());
+      ASSERT_EQ(mask[steps[i]], 1) << "step " << i;
+      const int action = static_cast<int>(steps[i]);
+      env.step(std::span<const int>(&action, 1));
+      if (i + 1 < steps.size()) {
+        // 途中の手順では盤面は進まず、選んだ手順が記録される
+        EXPECT_EQ(env.sideToMove(0), side);
+        EXPECT_EQ(env.dones()[0], 0);
+        EXPECT_EQ(env.pendingSteps(0).size(), i + 1);
+      }
+    }
+    EXPECT_TRUE(env.pendingSteps(0).empty());
+    for (const auto& [country, amount] : placement.getTargetCountries()) {
+      EXPECT_EQ(
+          env.board(0).getWorldMap().getCountry(country).getInfluence(side),
+          before[country] + amount)
+          << "country " << static_cast<int>(country);
+    }
+  }
+}
+
+// 途中の手順がある間は、それを含まない手の手順(最初は選べたもの)を受け付けない
+TEST(VectorEnvTest, PendingStepsRejectUnrelatedActions) {
+  const VectorEnvConfig config{.num_envs = 1, .threads = 1};
+  const auto fork = findPlacementFork(config);
+  VectorEnv env(envCardpool(), config);
+  for (const int action : fork.history) {
+    env.step(std::span<const int>(&action, 1));
+  }
+  std::vector<uint8_t> top(ActionIndex::SIZE);
+  env.observe(nullptr, top.data());
+  const int placement = static_cast<int>(
+      ActionIndex::moveToIndex(*env.legalMoves(0)[fork.first]));
+  env.step(std::span<const int>(&placement, 1));
+  ASSERT_EQ(env.pendingSteps(0).size(), 1U);
+
+  std::vector<uint8_t> pending(ActionIndex::SIZE);
+  env.observe(nullptr, pending.data());
+  int unrelated = -1;
+  for (size_t i = 0; i < ActionIndex::SIZE && unrelated < 0; ++i) {
+    if (top[i] != 0 && pending[i] == 0) {
+      unrelated = static_cast<int>(i);
+    }
+  }
+  ASSERT_GE(unrelated, 0);
+  EXPECT_THROW(env.step(std::span<const int>(&unrelated, 1)),
+               std::invalid_argument);
+  EXPECT_EQ(env.pendingSteps(0).size(), 1U);
+}
@@ -0,0 +1,63 @@
+// ファイル: tests/utils/work_stealing_pool_test.cpp
+// 役割:
+// スレッドプールが投入された仕事と仕事の中から追加された仕事を全て1回ずつ実行し、偏った投入を他のワーカーが盗んで分担することを検証する。
+// 背景:
+// 対局の取りこぼしや二重実行は集計をずらすだけで気付きにくいため、実行回数そのものを数えて確かめる。
+
+#include "tsge/utils/work_stealing_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingPoolTest, RunsEveryTaskOnce) {
+  constexpr size_t tasks = 1000;
+  std::vector<std::atomic<int>> runs(tasks);
+  WorkStealingPool pool(4);
+  for (size_t i = 0; i < tasks; ++i) {
+    pool.submit([&runs, i] { runs[i].fetch_add(1); });
+  }
+  pool.wait();
+  for (size_t i = 0; i < tasks; ++i) {
+    EXPECT_EQ(runs[i].load(), 1) << "task " << i;
+  }
+}
+
+TEST(WorkStealingPoolTest, IdleWorkersStealNestedTasks) {
+  // 1つの仕事が子を全て自分のキューへ積むため、他のワーカーは盗まない限り働けない
+  constexpr size_t children = 64;
+  std::atomic<size_t> done{0};
+  WorkStealingPool pool(4);
+  pool.submit([&pool, &done] {
+    for (size_t i = 0; i < children; ++i) {
+      pool.submit([&done] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        done.fetch_add(1);
+      });
+    }
+  });
+  pool.wait();
+  EXPECT_EQ(done.load(), children);
+  EXPECT_GT(pool.stolenCount(), 0U);
+}
+
+TEST(WorkStealingPoolTest, WaitRethrowsTaskError) {
+  std::atomic<int> finished{0};
+  WorkStealingPool pool(2);
+  pool.submit([] { throw std::runtime_error("task failed"); });
+  pool.submit([&finished] { finished.fetch_add(1); });
+  EXPECT_THROW(pool.wait(), std::runtime_error);
+  EXPECT_EQ(finished.load(), 1);
+  // 例外は1度だけ投げ直され、プールは引き続き使える
+  pool.submit([&finished] { finished.fetch_add(1); });
+  EXPECT_NO_THROW(pool.wait());
+  EXPECT_EQ(finished.load(), 2);
+}
+
+TEST(WorkStealingPoolTest, RejectsZeroThreads) {
+  EXPECT_THROW(WorkStealingPool{0}, std::invalid_argument);
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+# ファイル: tools/bench_compare.py
+# 役割:
+# tsge_benchがJSONで出力した2つの結果を計測名で突き合わせ、変化率がしきい値を超えて遅くなった計測を報告する。
+# 背景:
+# 局面ごとの計測は数百件になり目で比べきれないため、悪化だけを拾って終了コードで知らせ、変更の前後比較や定期実行に組み込めるようにする。
+#
+# 使い方:
+#   tsge_bench --benchmark_out=base.json --benchmark_out_format=json
+#   (変更後) tsge_bench --benchmark_out=new.json --benchmark_out_format=json
+#   tools/bench_compare.py base.json new.json [--threshold=0.05]
+#                          [--metric=real_time|cpu_time] [--filter=REGEX]
+#                          [--allow-missing]
+# 悪化した計測、候補で失敗した計測(SkipWithErrorなど)、候補に無い計測があれば
+# 終了コード1、無ければ0。--allow-missingなら候補に無い計測は報告だけにする。
+
+import argparse
+import json
+import re
+import sys
+
+TO_NANOSECONDS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path, metric, pattern):
+    """(計測名からナノ秒の時間への辞書, 失敗した計測名からメッセージへの辞書)。
+
+    繰り返し計測なら平均を使う。
+    """
+    with open(path, encoding="utf-8") as file:
+        benchmarks = json.load(file)["benchmarks"]
+    has_mean = any(entry.get("aggregate_name") == "mean" for entry in benchmarks)
+    times = {}
+    errors = {}
+    for entry in benchmarks:
+        if entry.get("error_occurred"):
+            name = entry.get("run_name", entry["name"])
+            if pattern is None or pattern.search(name):
+                errors[name] = entry.get("error_message", "")
+            continue
+        if has_mean:
+            if entry.get("aggregate_name") != "mean":
+                continue
+            name = entry["run_name"]
+        else:
+            if entry.get("run_type") == "aggregate":
+                continue
+            name = entry["name"]
+        if pattern is not None and not pattern.search(name):
+            continue
+        unit = TO_NANOSECONDS[entry.get("time_unit", "ns")]
+        times[name] = entry[metric] * unit
+    return times, errors
+
+
+def format_time(nanoseconds):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if nanoseconds >= scale:
+            return f"{nanoseconds / scale:.3f} {unit}"
+    return f"{nanoseconds:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two tsge_bench JSON results.")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown reported as a regression")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"),
+                        default="cpu_time")
+    parser.add_argument("--filter", default=None,
+                        help="only compare benchmarks matching this regex")
+    parser.add_argument("--allow-missing", action="store_true",
+                        help="do not fail on benchmarks absent from the "
+                        "candidate")
+    args = parser.parse_args()
+    if args.threshold < 0:
+        parser.error("--threshold must not be negative")
+
+    pattern = re.compile(args.filter) if args.filter else None
+    try:
+        baseline, baseline_errors = load_times(args.baseline, args.metric,
+                                               pattern)
+        candidate, candidate_errors = load_times(args.candidate, args.metric,
+                                                 pattern)
+    except (OSError, KeyError, ValueError) as error:
+        print(f"bench_compare: {error}", file=sys.stderr)
+        return 2
+
+    regressions = 0
+    missing = 0
+    names = baseline.keys() | baseline_errors.keys() | candidate_errors.keys()
+    width = max((len(name) for name in names), default=4)
+    print(f"{'name':<{width}}  {'baseline':>12}  {'candidate':>12}  change")
+    for name, before in baseline.items():
+        if name in candidate_errors:
+            continue
+        if name not in candidate:
+            missing += 1
+            print(f"{name:<{width}}  {format_time(before):>12}  "
+                  f"{'-':>12}  MISSING")
+            continue
+        after = candidate[name]
+        change = (after - before) / before if before > 0 else 0.0
+        if change > args.threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            verdict = "improved"
+        else:
+            verdict = ""
+        print(f"{name:<{width}}  {format_time(before):>12}  "
+              f"{format_time(after):>12}  {change:+7.1%} {verdict}".rstrip())
+    for name in candidate.keys() - baseline.keys():
+        print(f"{name:<{width}}  {'-':>12}  "
+              f"{format_time(candidate[name]):>12}  NEW")
+    # 候補で失敗した計測は、基準で測れていたかによらず失敗として数える
+    for name, message in sorted(candidate_errors.items()):
+        before = format_time(baseline[name]) if name in baseline else "-"
+        print(f"{name:<{width}}  {before:>12}  {'-':>12}  ERROR: {message}")
+    for name, message in sorted(baseline_errors.items()):
+        if name not in candidate_errors:
+            print(f"{name:<{width}}  {'-':>12}  {'-':>12}  "
+                  f"baseline error: {message}")
+
+    failed_missing = 0 if args.allow_missing else missing
+    print(f"# compared={len(baseline.keys() & candidate.keys())} "
+          f"regressions={regressions} errors={len(candidate_errors)} "
+          f"missing={missing} threshold={args.threshold:.1%} "
+          f"metric={args.metric}")
+    return 1 if regressions or candidate_errors or failed_missing else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,181 @@
+// ファイル: tools/tsge_perft.cpp
+// 役割:
+// コーパスの局面から深さdまでの判断の列を数え、到達局面の数を判断の状態・手の種類ごとに出力して、毎秒の局面数とstep数を報告する。
+// 背景:
+// 合法手生成を変えたときに数の変化と速さを同じコマンドで確かめられるようにする。数の固定値はperft_testに置く。
+//
+// 使い方:
+//   tsge_perft --position=NAME [--corpus=PATH] [--depth=N] [--seed=N]
+//              [--threads=N] [--dice=seeded|enumerate] [--divide]
+//   tsge_perft --list [--corpus=PATH]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "tsge/core/perft.hpp"
+#include "tsge/core/position_text.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace {
+
+// "--name=value"ならvalueを、それ以外ならnulloptを返す
+std::optional<std::string> flagValue(std::string_view arg,
+                                     std::string_view name) {
+  if (arg.size() > name.size() + 3 && arg.starts_with("--") &&
+      arg.substr(2, name.size()) == name && arg[name.size() + 2] == '=') {
+    return std::string(arg.substr(name.size() + 3));
+  }
+  return std::nullopt;
+}
+
+uint64_t parseCount(const std::string& value, const char* name) {
+  size_t parsed = 0;
+  uint64_t count = 0;
+  try {
+    count = std::stoull(value, &parsed);
+  } catch (const std::exception&) {
+    parsed = 0;
+  }
+  if (parsed != value.size() || value.empty() || value[0] == '-') {
+    throw std::invalid_argument(std::string("invalid --") + name + ": " +
+                                value);
+  }
+  return count;
+}
+
+PerftDice parseDice(const std::string& value) {
+  if (value == "seeded") {
+    return PerftDice::SEEDED;
+  }
+  if (value == "enumerate") {
+    return PerftDice::ENUMERATE;
+  }
+  throw std::invalid_argument("invalid --dice: " + value);
+}
+
+void printUsage() {
+  std::fputs(
+      "usage: tsge_perft --position=NAME [--corpus=PATH] [--depth=N]\n"
+      "                  [--seed=N] [--threads=N]\n"
+      "                  [--dice=seeded|enumerate] [--divide]\n"
+      "       tsge_perft --list [--corpus=PATH]\n",
+      stderr);
+}
+
+unsigned long long asUll(uint64_t value) {
+  return static_cast<unsigned long long>(value);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string corpus_path = "bench/positions/corpus.tsp";
+  std::string position_name;
+  PerftConfig config;
+  config.depth = 2;
+  config.threads = std::max(1U, std::thread::hardware_concurrency());
+  bool divide = false;
+  bool list = false;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg = argv[i];
+      if (arg == "--help" || arg == "-h") {
+        printUsage();
+        return 0;
+      }
+      if (arg == "--divide") {
+        divide = true;
+      } else if (arg == "--list") {
+        list = true;
+      } else if (auto value = flagValue(arg, "corpus")) {
+        corpus_path = *value;
+      } else if (auto value = flagValue(arg, "position")) {
+        position_name = *value;
+      } else if (auto value = flagValue(arg, "depth")) {
+        config.depth = static_cast<int>(
+            std::min<uint64_t>(parseCount(*value, "depth"), 64));
+      } else if (auto value = flagValue(arg, "seed")) {
+        config.seed = parseCount(*value, "seed");
+      } else if (auto value = flagValue(arg, "threads")) {
+        config.threads = parseCount(*value, "threads");
+      } else if (auto value = flagValue(arg, "dice")) {
+        config.dice = parseDice(*value);
+      } else {
+        throw std::invalid_argument("unknown argument: " + std::string(arg));
+      }
+    }
+    if (!list && position_name.empty()) {
+      throw std::invalid_argument("--position is required");
+    }
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "tsge_perft: %s\n", error.what());
+    printUsage();
+    return 2;
+  }
+
+  try {
+    const auto corpus = loadPositionCorpus(corpus_path);
+    if (list) {
+      for (const auto& position : corpus) {
+        std::printf("%s\t%s\n", position.name.c_str(),
+                    position.cardpool.c_str());
+      }
+      return 0;
+    }
+    const auto found = std::ranges::find(corpus, position_name,
+                                         &CorpusPosition::name);
+    if (found == corpus.end()) {
+      throw std::invalid_argument("no position " + position_name + " in " +
+                                  corpus_path);
+    }
+    Board board(cardpoolByName(found->cardpool));
+    readPositionText(found->text, board);
+
+    std::printf("# position=%s depth=%d dice=%s seed=%llu threads=%zu\n",
+                position_name.c_str(), config.depth,
+                config.dice == PerftDice::SEEDED ? "seeded" : "enumerate",
+                asUll(config.seed), config.threads);
+    const PerftResult result = runPerft(board, config);
+
+    if (divide) {
+      for (size_t i = 0; i < result.root_moves.size(); ++i) {
+        std::printf("move %zu\t%llu\n", i,
+                    asUll(result.root_moves[i].nodes));
+      }
+    }
+    for (size_t i = 0; i < PERFT_DECISION_COUNT; ++i) {
+      if (result.total.decisions[i] != 0) {
+        std::printf("decision %s\t%llu\n",
+                    std::string(perftDecisionName(i)).c_str(),
+                    asUll(result.total.decisions[i]));
+      }
+    }
+    for (size_t i = 0; i < PERFT_MOVE_CLASS_COUNT; ++i) {
+      if (result.total.moves[i] != 0) {
+        std::printf("moves %s\t%llu\n",
+                    std::string(perftMoveClassName(i)).c_str(),
+                    asUll(result.total.moves[i]));
+      }
+    }
+    std::printf(
+        "# nodes=%llu terminals=%llu steps=%llu elapsed_s=%.3f "
+        "nodes_per_s=%.1f steps_per_s=%.1f\n",
+        asUll(result.total.nodes), asUll(result.total.terminals),
+        asUll(result.total.steps),
+        std::chrono::duration<double>(result.elapsed).count(),
+        result.nodesPerSecond(), result.stepsPerSecond());
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "tsge_perft: %s\n", error.what());
+    return 1;
+  }
+  return 0;
+}
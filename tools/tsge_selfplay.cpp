@@ -0,0 +1,155 @@
+// ファイル: tools/tsge_selfplay.cpp
+// 役割:
+// 陣営ごとのポリシーを指定して多数の対局を並列に指し、1局ごとの結果を逐次出力して、最後に対局数と手数の毎秒の処理量を報告する。
+// 背景:
+// ポリシーの強さと対局エンジンの速度を、テストやベンチマークに組み込まずにコマンド1つで測れるようにする。
+//
+// 使い方:
+//   tsge_selfplay [--games=N] [--threads=N] [--seed=N] [--max-steps=N]
+//                 [--ussr=POLICY] [--usa=POLICY] [--quiet]
+//   POLICYは random / heuristic / mcts[:iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "tsge/players/match_runner.hpp"
+#include "tsge/players/ops_only_cardpool.hpp"
+
+namespace {
+
+const char* outcomeName(const MatchResult& result) {
+  if (!result.winner.has_value()) {
+    return "TRUNCATED";
+  }
+  switch (*result.winner) {
+    case Side::USSR:
+      return "USSR";
+    case Side::USA:
+      return "USA";
+    default:
+      return "DRAW";
+  }
+}
+
+// "--name=value"ならvalueを、それ以外ならnulloptを返す
+std::optional<std::string> flagValue(std::string_view arg,
+                                     std::string_view name) {
+  if (arg.size() > name.size() + 3 && arg.starts_with("--") &&
+      arg.substr(2, name.size()) == name && arg[name.size() + 2] == '=') {
+    return std::string(arg.substr(name.size() + 3));
+  }
+  return std::nullopt;
+}
+
+uint64_t parseCount(const std::string& value, const char* name) {
+  size_t parsed = 0;
+  uint64_t count = 0;
+  try {
+    count = std::stoull(value, &parsed);
+  } catch (const std::exception&) {
+    parsed = 0;
+  }
+  if (parsed != value.size() || value.empty() || value[0] == '-') {
+    throw std::invalid_argument(std::string("invalid --") + name + ": " +
+                                value);
+  }
+  return count;
+}
+
+void printUsage() {
+  std::fputs(
+      "usage: tsge_selfplay [--games=N] [--threads=N] [--seed=N]\n"
+      "                     [--max-steps=N] [--ussr=POLICY] [--usa=POLICY]\n"
+      "                     [--quiet]\n"
+      "  POLICY: random | heuristic | mcts[:iterations]\n",
+      stderr);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  MatchConfig config;
+  config.games = 100;
+  config.threads = std::max(1U, std::thread::hardware_concurrency());
+  std::string ussr_spec = "heuristic";
+  std::string usa_spec = "heuristic";
+  bool quiet = false;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg = argv[i];
+      if (arg == "--help" || arg == "-h") {
+        printUsage();
+        return 0;
+      }
+      if (arg == "--quiet") {
+        quiet = true;
+      } else if (auto value = flagValue(arg, "games")) {
+        config.games = parseCount(*value, "games");
+      } else if (auto value = flagValue(arg, "threads")) {
+        config.threads = parseCount(*value, "threads");
+      } else if (auto value = flagValue(arg, "seed")) {
+        config.seed = parseCount(*value, "seed");
+      } else if (auto value = flagValue(arg, "max-steps")) {
+        config.max_steps = parseCount(*value, "max-steps");
+      } else if (auto value = flagValue(arg, "ussr")) {
+        ussr_spec = *value;
+      } else if (auto value = flagValue(arg, "usa")) {
+        usa_spec = *value;
+      } else {
+        throw std::invalid_argument("unknown argument: " + std::string(arg));
+      }
+    }
+    config.policies = {makeMatchPolicy(ussr_spec), makeMatchPolicy(usa_spec)};
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "tsge_selfplay: %s\n", error.what());
+    printUsage();
+    return 2;
+  }
+
+  std::printf("# games=%zu threads=%zu seed=%llu ussr=%s usa=%s\n",
+              config.games, config.threads,
+              static_cast<unsigned long long>(config.seed), ussr_spec.c_str(),
+              usa_spec.c_str());
+  if (!quiet) {
+    std::printf("game\tseed\twinner\tvp\tturns\tmoves\twall_ms\n");
+  }
+  MatchSummary summary;
+  try {
+    summary = runMatches(
+        opsOnlyCardpool(), config, [quiet](const MatchResult& result) {
+          if (quiet) {
+            return;
+          }
+          std::printf(
+              "%zu\t%llu\t%s\t%d\t%d\t%zu\t%.3f\n", result.game_index,
+              static_cast<unsigned long long>(result.seed),
+              outcomeName(result), result.final_vp, result.turns,
+              result.moves,
+              std::chrono::duration<double, std::milli>(result.wall_time)
+                  .count());
+          std::fflush(stdout);
+        });
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "tsge_selfplay: %s\n", error.what());
+    return 1;
+  }
+
+  std::printf(
+      "# ussr=%zu usa=%zu draw=%zu truncated=%zu\n"
+      "# games=%zu moves=%zu elapsed_s=%.3f games_per_s=%.3f "
+      "moves_per_s=%.1f\n",
+      summary.outcomes[0], summary.outcomes[1], summary.outcomes[2],
+      summary.outcomes[3], summary.games, summary.moves,
+      std::chrono::duration<double>(summary.elapsed).count(),
+      summary.gamesPerSecond(), summary.movesPerSecond());
+  return 0;
+}